@@ -0,0 +1,211 @@
+#include <gl/pogl.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "POGLExampleWindow.h"
+using namespace std::chrono;
+
+static const POGL_CHAR SIMPLE_EFFECT_VS[] = { R"(
+	#version 330
+
+	layout(location = 0) in vec3 position;
+
+	void main()
+	{
+		gl_Position = vec4(position, 1.0);
+	}
+)"};
+
+static const POGL_CHAR SIMPLE_EFFECT_FS[] = { R"(
+	#version 330
+
+	layout(location = 0) out vec4 color;
+
+	void main()
+	{
+		color = vec4(1, 1, 1, 1);
+	}
+)" };
+
+// The size of the buffer we are updating
+static const POGL_UINT32 BUFFER_SIZE = 1024 * 1024;
+
+// Number of frames we measure for each test
+static const POGL_UINT32 WARMUP_FRAMES = 10;
+static const POGL_UINT32 MEASURED_FRAMES = 60;
+
+static const POGLBufferUpdateStrategy::Enum STRATEGIES[] = {
+	POGLBufferUpdateStrategy::MAP,
+	POGLBufferUpdateStrategy::ORPHAN,
+	POGLBufferUpdateStrategy::SUB_DATA,
+	POGLBufferUpdateStrategy::UNSYNCHRONIZED
+};
+static const POGL_UINT32 NUM_STRATEGIES = sizeof(STRATEGIES) / sizeof(POGLBufferUpdateStrategy::Enum);
+static const char* STRATEGY_NAMES[] = { "MAP", "ORPHAN", "SUB_DATA", "UNSYNCHRONIZED" };
+
+static const POGL_UINT32 UPDATE_SIZES[] = { 256, 1024, 4096, 16384, 65536, 262144, 524288, 786432, BUFFER_SIZE };
+static const POGL_UINT32 NUM_UPDATE_SIZES = sizeof(UPDATE_SIZES) / sizeof(POGL_UINT32);
+
+static const POGL_UINT32 UPDATE_FREQUENCIES[] = { 1, 2, 4, 8, 16 };
+static const POGL_UINT32 NUM_UPDATE_FREQUENCIES = sizeof(UPDATE_FREQUENCIES) / sizeof(POGL_UINT32);
+
+/*!
+	\brief Update the buffer "updatesPerFrame" times each frame and draw the updated part of it
+
+	\return The average frame time in milliseconds
+*/
+POGL_DOUBLE Measure(IPOGLDevice* device, IPOGLRenderContext* context, IPOGLProgram* program, IPOGLVertexBuffer* vertexBuffer,
+	POGLBufferUpdateStrategy::Enum strategy, POGL_UINT32 updateSize, POGL_UINT32 updatesPerFrame)
+{
+	vertexBuffer->SetUpdateStrategy(strategy);
+	const POGL_UINT32 vertexSize = sizeof(POGL_POSITION_VERTEX);
+	const POGL_UINT32 numVertices = updateSize / vertexSize;
+	const POGL_UINT32 numRanges = BUFFER_SIZE / (numVertices * vertexSize);
+
+	auto start = high_resolution_clock::now();
+	for (POGL_UINT32 frame = 0; frame < WARMUP_FRAMES + MEASURED_FRAMES; ++frame) {
+		if (frame == WARMUP_FRAMES)
+			start = high_resolution_clock::now();
+
+		IPOGLRenderState* state = context->Apply(program);
+		state->Clear(POGLClearType::COLOR);
+		state->SetVertexBuffer(vertexBuffer);
+		for (POGL_UINT32 i = 0; i < updatesPerFrame; ++i) {
+			const POGL_UINT32 range = (frame * updatesPerFrame + i) % numRanges;
+			const POGL_UINT32 offset = range * numVertices * vertexSize;
+			POGL_POSITION_VERTEX* vertices = (POGL_POSITION_VERTEX*)context->Map(vertexBuffer, offset, numVertices * vertexSize, POGLResourceMapType::WRITE);
+			for (POGL_UINT32 v = 0; v < numVertices; ++v) {
+				vertices[v].position = POGL_VECTOR3(-1.0f + 2.0f * v / numVertices, 0.0f, 0.0f);
+			}
+			context->Unmap(vertexBuffer);
+			state->Draw(numVertices, range * numVertices);
+		}
+		state->Release();
+		device->EndFrame();
+		POGLProcessEvents();
+	}
+
+	const auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+	return (POGL_DOUBLE)elapsed / (1000.0 * MEASURED_FRAMES);
+}
+
+/*!
+	\brief Retrieves the index of the fastest strategy
+*/
+POGL_UINT32 Fastest(const POGL_DOUBLE* times)
+{
+	POGL_UINT32 fastest = 0;
+	for (POGL_UINT32 i = 1; i < NUM_STRATEGIES; ++i) {
+		if (times[i] < times[fastest])
+			fastest = i;
+	}
+	return fastest;
+}
+
+int main()
+{
+	POGL_HANDLE windowHandle = POGLCreateExampleWindow(POGL_SIZE(1024, 768), POGL_TOCHAR("Example: Buffer Update Benchmark"));
+
+	POGL_DEVICE_INFO deviceInfo = { 0 };
+#ifdef _DEBUG
+	deviceInfo.flags = POGLDeviceInfoFlags::DEBUG_MODE;
+#else
+	deviceInfo.flags = 0;
+#endif
+	deviceInfo.windowHandle = windowHandle;
+	deviceInfo.colorBits = 32;
+	deviceInfo.depthBits = 16;
+	deviceInfo.pixelFormat = POGLPixelFormat::R8G8B8A8;
+
+	try {
+		IPOGLDevice* device = POGLCreateDevice(&deviceInfo);
+		IPOGLRenderContext* context = device->GetRenderContext();
+
+		IPOGLShader* vertexShader = context->CreateShaderFromMemory(SIMPLE_EFFECT_VS, sizeof(SIMPLE_EFFECT_VS), POGLShaderType::VERTEX_SHADER);
+		IPOGLShader* fragmentShader = context->CreateShaderFromMemory(SIMPLE_EFFECT_FS, sizeof(SIMPLE_EFFECT_FS), POGLShaderType::FRAGMENT_SHADER);
+		IPOGLShader* shaders[] = { vertexShader, fragmentShader };
+		IPOGLProgram* program = context->CreateProgramFromShaders(shaders, 2);
+		vertexShader->Release();
+		fragmentShader->Release();
+
+		//
+		// Immutable buffers are never persistently mapped, which means that all update strategies can be tested on it
+		//
+
+		IPOGLVertexBuffer* vertexBuffer = context->CreateVertexBuffer((const POGL_POSITION_VERTEX*)nullptr, BUFFER_SIZE, POGLPrimitiveType::POINT, POGLBufferUsage::IMMUTABLE);
+
+		POGL_BUFFER_UPDATE_THRESHOLDS thresholds = *device->GetBufferUpdateThresholds();
+
+		//
+		// Measure how the update size affects the strategies. Updates once per frame
+		//
+
+		std::cout << "Update size (bytes), one update per frame [ms per frame]" << std::endl;
+		POGL_UINT32 subDataMaxSize = 0;
+		bool subDataFastest = true;
+		POGL_FLOAT orphanMinRatio = 1.0f;
+		for (POGL_UINT32 i = 0; i < NUM_UPDATE_SIZES; ++i) {
+			POGL_DOUBLE times[NUM_STRATEGIES];
+			std::cout << UPDATE_SIZES[i] << ":";
+			for (POGL_UINT32 s = 0; s < NUM_STRATEGIES; ++s) {
+				times[s] = Measure(device, context, program, vertexBuffer, STRATEGIES[s], UPDATE_SIZES[i], 1);
+				std::cout << " " << STRATEGY_NAMES[s] << "=" << times[s];
+			}
+			std::cout << std::endl;
+
+			// glBufferSubData is used for all updates up to the largest size where it's the fastest strategy
+			const POGL_UINT32 fastest = Fastest(times);
+			if (subDataFastest && STRATEGIES[fastest] == POGLBufferUpdateStrategy::SUB_DATA)
+				subDataMaxSize = UPDATE_SIZES[i];
+			else
+				subDataFastest = false;
+
+			const POGL_FLOAT ratio = (POGL_FLOAT)UPDATE_SIZES[i] / (POGL_FLOAT)BUFFER_SIZE;
+			if (STRATEGIES[fastest] == POGLBufferUpdateStrategy::ORPHAN && ratio < orphanMinRatio)
+				orphanMinRatio = ratio;
+		}
+
+		//
+		// Measure how the update frequency affects partial updates
+		//
+
+		std::cout << "Updates per frame, " << UPDATE_SIZES[NUM_UPDATE_SIZES / 2] << " bytes each [ms per frame]" << std::endl;
+		POGL_FLOAT unsynchronizedMinFrequency = (POGL_FLOAT)UPDATE_FREQUENCIES[NUM_UPDATE_FREQUENCIES - 1] * 2.0f;
+		for (POGL_UINT32 i = 0; i < NUM_UPDATE_FREQUENCIES; ++i) {
+			const POGL_DOUBLE mapTime = Measure(device, context, program, vertexBuffer, POGLBufferUpdateStrategy::MAP, UPDATE_SIZES[NUM_UPDATE_SIZES / 2], UPDATE_FREQUENCIES[i]);
+			const POGL_DOUBLE unsyncTime = Measure(device, context, program, vertexBuffer, POGLBufferUpdateStrategy::UNSYNCHRONIZED, UPDATE_SIZES[NUM_UPDATE_SIZES / 2], UPDATE_FREQUENCIES[i]);
+			std::cout << UPDATE_FREQUENCIES[i] << ": MAP=" << mapTime << " UNSYNCHRONIZED=" << unsyncTime << std::endl;
+			if (unsyncTime < mapTime && (POGL_FLOAT)UPDATE_FREQUENCIES[i] < unsynchronizedMinFrequency)
+				unsynchronizedMinFrequency = (POGL_FLOAT)UPDATE_FREQUENCIES[i];
+		}
+
+		//
+		// Use the calibrated thresholds for buffers using the adaptive strategy
+		//
+
+		thresholds.subDataMaxSize = subDataMaxSize;
+		thresholds.orphanMinRatio = orphanMinRatio;
+		thresholds.unsynchronizedMinFrequency = unsynchronizedMinFrequency;
+		device->SetBufferUpdateThresholds(&thresholds);
+
+		std::cout << "Calibrated thresholds:" << std::endl;
+		std::cout << " subDataMaxSize = " << thresholds.subDataMaxSize << std::endl;
+		std::cout << " orphanMinRatio = " << thresholds.orphanMinRatio << std::endl;
+		std::cout << " unsynchronizedMinFrequency = " << thresholds.unsynchronizedMinFrequency << std::endl;
+
+		POGL_DEVICE_STATISTICS statistics;
+		device->GetStatistics(&statistics);
+		std::cout << "Buffer stalls: " << statistics.bufferStallCount << " (" << statistics.bufferStallTime << " ms)" << std::endl;
+
+		vertexBuffer->Release();
+		program->Release();
+		context->Release();
+		device->Release();
+	}
+	catch (POGLException e) {
+		POGLAlert(e);
+	}
+
+	POGLDestroyExampleWindow(windowHandle);
+	return 0;
+}
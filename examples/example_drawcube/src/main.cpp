@@ -111,6 +111,12 @@ int main()
 
 		IPOGLRenderState* state = context->Apply(program);
 
+		//
+		// Resolve the uniform names once, so that the render loop doesn't have to look them up by name
+		//
+
+		const POGL_UINT32 modelMatrixID = device->GetUniformID("ModelMatrix");
+
 		//
 		// Poll the opened window's events. This is NOT part of the POGL library
 		//
@@ -131,7 +137,7 @@ int main()
 			// Retrieve the ModelMatrix for the currently bound program
 			//
 
-			IPOGLUniform* modelMatrixUniform = state->FindUniformByName("ModelMatrix");
+			IPOGLUniform* modelMatrixUniform = state->FindUniformByID(modelMatrixID);
 
 			//
 			// Draw four translated and rotated cubes onto the screen
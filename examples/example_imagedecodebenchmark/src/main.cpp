@@ -0,0 +1,122 @@
+#include <gl/pogl.h>
+#include <gl/poglext.h>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <chrono>
+#include "POGLExampleWindow.h"
+using namespace std::chrono;
+
+static const POGL_CHAR* IMAGES[] = {
+	POGL_TOCHAR("texture0.tga"),
+	POGL_TOCHAR("texture1.tga"),
+	POGL_TOCHAR("texture2.tga"),
+	POGL_TOCHAR("texture3.tga")
+};
+static const POGL_UINT32 NUM_IMAGES = sizeof(IMAGES) / sizeof(POGL_CHAR*);
+
+// Number of times each image is decoded for each test
+static const POGL_UINT32 WARMUP_ITERATIONS = 100;
+static const POGL_UINT32 MEASURED_ITERATIONS = 10000;
+
+// Number of times each image is loaded into a texture
+static const POGL_UINT32 MEASURED_LOADS = 500;
+
+/*!
+	\brief Decode the image into memory using the supplied format
+
+	\return The decode throughput in megabytes of decoded pixels per second
+*/
+POGL_DOUBLE MeasureDecode(const std::vector<POGL_BYTE>& file, const POGLX_IMAGE_INFO& info, POGLTextureFormat::Enum format)
+{
+	const POGL_UINT32 bytesPerPixel = info.format == POGLTextureFormat::BGR ? 3 : 4;
+	const POGL_UINT32 imageSize = info.size.width * info.size.height * bytesPerPixel;
+	std::vector<POGL_BYTE> pixels(imageSize);
+
+	auto start = high_resolution_clock::now();
+	for (POGL_UINT32 i = 0; i < WARMUP_ITERATIONS + MEASURED_ITERATIONS; ++i) {
+		if (i == WARMUP_ITERATIONS)
+			start = high_resolution_clock::now();
+		POGLXDecodeTGAImage(&file[0], file.size(), format, &pixels[0]);
+	}
+
+	const auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+	return ((POGL_DOUBLE)imageSize * MEASURED_ITERATIONS) / (POGL_DOUBLE)(elapsed > 0 ? elapsed : 1);
+}
+
+/*!
+	\brief Decode and upload the image into a new texture "MEASURED_LOADS" times
+
+	\return The average time it takes to load the image in milliseconds
+*/
+POGL_DOUBLE MeasureLoad(IPOGLDevice* device, IPOGLRenderContext* context, const std::vector<POGL_BYTE>& file)
+{
+	auto start = high_resolution_clock::now();
+	for (POGL_UINT32 i = 0; i < MEASURED_LOADS; ++i) {
+		IPOGLTexture2D* texture = POGLXLoadTGAImageFromMemory(context, &file[0], file.size());
+		texture->Release();
+	}
+	device->EndFrame();
+	POGLProcessEvents();
+
+	const auto elapsed = duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+	return (POGL_DOUBLE)elapsed / (1000.0 * MEASURED_LOADS);
+}
+
+int main()
+{
+	POGL_HANDLE windowHandle = POGLCreateExampleWindow(POGL_SIZE(1024, 768), POGL_TOCHAR("Example: Image Decode Benchmark"));
+
+	POGL_DEVICE_INFO deviceInfo = { 0 };
+#ifdef _DEBUG
+	deviceInfo.flags = POGLDeviceInfoFlags::DEBUG_MODE;
+#else
+	deviceInfo.flags = 0;
+#endif
+	deviceInfo.windowHandle = windowHandle;
+	deviceInfo.colorBits = 32;
+	deviceInfo.depthBits = 16;
+	deviceInfo.pixelFormat = POGLPixelFormat::R8G8B8A8;
+
+	try {
+		IPOGLDevice* device = POGLCreateDevice(&deviceInfo);
+		IPOGLRenderContext* context = device->GetRenderContext();
+
+		//
+		// Decode each image into memory, both in the format it's stored in and with the red and blue channels swapped
+		//
+
+		std::cout << "Image, decode throughput [MB/s], load time [ms]" << std::endl;
+		for (POGL_UINT32 i = 0; i < NUM_IMAGES; ++i) {
+			std::ifstream stream(IMAGES[i], std::ios::binary);
+			const std::vector<POGL_BYTE> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+			if (file.empty()) {
+				std::cout << IMAGES[i] << ": not found" << std::endl;
+				continue;
+			}
+
+			POGLX_IMAGE_INFO info;
+			POGLXGetTGAImageInfo(&file[0], file.size(), &info);
+			const POGLTextureFormat::Enum swizzledFormat = info.format == POGLTextureFormat::BGR ? POGLTextureFormat::RGB : POGLTextureFormat::RGBA;
+			const bool compressed = file[2] == 10;
+
+			const POGL_DOUBLE nativeThroughput = MeasureDecode(file, info, info.format);
+			const POGL_DOUBLE swizzledThroughput = MeasureDecode(file, info, swizzledFormat);
+			const POGL_DOUBLE loadTime = MeasureLoad(device, context, file);
+			std::cout << IMAGES[i] << " (" << info.size.width << "x" << info.size.height << (compressed ? ", RLE" : ", raw") << "):"
+				<< " native=" << nativeThroughput
+				<< " swizzled=" << swizzledThroughput
+				<< " load=" << loadTime << std::endl;
+		}
+
+		context->Release();
+		device->Release();
+	}
+	catch (POGLException e) {
+		POGLAlert(e);
+	}
+
+	POGLDestroyExampleWindow(windowHandle);
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include <gl/pogl.h>
+#include <gl/poglext.h>
+#include <iostream>
+#include "POGLExampleWindow.h"
+
+static const POGL_CHAR* IMAGES[] = {
+	POGL_TOCHAR("texture0.tga"),
+	POGL_TOCHAR("texture1.tga"),
+	POGL_TOCHAR("texture2.tga"),
+	POGL_TOCHAR("texture3.tga")
+};
+static const POGL_UINT32 NUM_IMAGES = sizeof(IMAGES) / sizeof(POGL_CHAR*);
+
+// Where each image is drawn on the screen
+static const POGL_FLOAT TRANSLATIONS[][2] = {
+	{ -1.0f, 1.0f },
+	{ 1.0f, 1.0f },
+	{ -1.0f, -1.0f },
+	{ 1.0f, -1.0f }
+};
+
+int main()
+{
+	// Create a window
+	POGL_HANDLE windowHandle = POGLCreateExampleWindow(POGL_SIZE(1024, 768), POGL_TOCHAR("Example: Image Loader"));
+
+	// Create a POGL device based on the supplied information
+	POGL_DEVICE_INFO deviceInfo = { 0 };
+#ifdef _DEBUG
+	deviceInfo.flags = POGLDeviceInfoFlags::DEBUG_MODE;
+#else
+	deviceInfo.flags = 0;
+#endif
+	deviceInfo.windowHandle = windowHandle;
+	deviceInfo.colorBits = 32;
+	deviceInfo.depthBits = 16;
+	deviceInfo.pixelFormat = POGLPixelFormat::R8G8B8A8;
+	IPOGLDevice* device = POGLCreateDevice(&deviceInfo);
+
+	try {
+		IPOGLRenderContext* context = device->GetRenderContext();
+
+		IPOGLShader* vertexShader = context->CreateShaderFromFile(POGL_TOCHAR("simple.vs"), POGLShaderType::VERTEX_SHADER);
+		IPOGLShader* fragmentShader = context->CreateShaderFromFile(POGL_TOCHAR("simple.fs"), POGLShaderType::FRAGMENT_SHADER);
+		IPOGLShader* shaders[] = { vertexShader, fragmentShader };
+		IPOGLProgram* program = context->CreateProgramFromShaders(shaders, 2);
+		vertexShader->Release();
+		fragmentShader->Release();
+
+		// 
+		// Create a fullscreen quad vertex buffer with the appropriate texture coordinates.
+		//
+
+		const POGL_POSITION_TEXCOORD_VERTEX VERTICES[] = {
+			POGL_POSITION_TEXCOORD_VERTEX(POGL_VECTOR3(1.0f, -1.0f, 0.0f), POGL_VECTOR2(0.0f, 0.0f)),
+			POGL_POSITION_TEXCOORD_VERTEX(POGL_VECTOR3(1.0f, 1.0f, 0.0f), POGL_VECTOR2(0.0f, 1.0f)),
+			POGL_POSITION_TEXCOORD_VERTEX(POGL_VECTOR3(-1.0f, 1.0f, 0.0f), POGL_VECTOR2(1.0f, 1.0f)),
+			POGL_POSITION_TEXCOORD_VERTEX(POGL_VECTOR3(-1.0f, -1.0f, 0.0f), POGL_VECTOR2(1.0f, 0.0f))
+		};
+		IPOGLVertexBuffer* fullscreenVB = context->CreateVertexBuffer(VERTICES, sizeof(VERTICES), POGLPrimitiveType::TRIANGLE, POGLBufferUsage::IMMUTABLE);
+
+		const POGL_UINT8 INDICES[] = {
+			0, 1, 2,
+			2, 3, 0
+		};
+		IPOGLIndexBuffer* fullscreenIB = context->CreateIndexBuffer(INDICES, sizeof(INDICES), POGLVertexType::UNSIGNED_BYTE, POGLBufferUsage::IMMUTABLE);
+
+		//
+		// Queue all images at once. They are read and decoded in parallel by the loader's worker threads. Each request
+		// returns a grey placeholder texture until its image has been uploaded.
+		//
+
+		IPOGLXImageLoader* loader = POGLXCreateImageLoader(context, 0, nullptr);
+		IPOGLXImageRequest* requests[NUM_IMAGES];
+		for (POGL_UINT32 i = 0; i < NUM_IMAGES; ++i) {
+			requests[i] = loader->Load(IMAGES[i]);
+		}
+
+		bool loaded = false;
+		while (POGLProcessEvents()) {
+			//
+			// Upload the images decoded since the last frame
+			//
+
+			loader->Update(context);
+			if (!loaded && loader->GetNumPending() == 0) {
+				for (POGL_UINT32 i = 0; i < NUM_IMAGES; ++i) {
+					if (requests[i]->HasFailed())
+						std::cout << IMAGES[i] << " could not be loaded" << std::endl;
+				}
+				loaded = true;
+			}
+
+			//
+			// Draw the textures onto the screen
+			//
+
+			IPOGLRenderState* state = context->Apply(program);
+			state->Clear(POGLClearType::COLOR | POGLClearType::DEPTH);
+
+			auto textureUniform = state->FindUniformByName("Texture");
+			auto translateUniform = state->FindUniformByName("Translate");
+			auto scaleUniform = state->FindUniformByName("Scale");
+			state->SetVertexBuffer(fullscreenVB);
+			state->SetIndexBuffer(fullscreenIB);
+
+			for (POGL_UINT32 i = 0; i < NUM_IMAGES; ++i) {
+				IPOGLTexture2D* texture = requests[i]->GetTexture();
+				textureUniform->SetTexture(texture);
+				translateUniform->SetFloat(TRANSLATIONS[i][0], TRANSLATIONS[i][1]);
+				scaleUniform->SetFloat(0.5f, 0.5f);
+				state->DrawIndexed();
+				texture->Release();
+			}
+
+			state->Release();
+
+			//
+			// End the current frame
+			//
+
+			device->EndFrame();
+		}
+
+		for (POGL_UINT32 i = 0; i < NUM_IMAGES; ++i) {
+			requests[i]->Release();
+		}
+		loader->Release();
+
+		program->Release();
+		fullscreenVB->Release();
+		fullscreenIB->Release();
+		context->Release();
+		device->Release();
+	}
+	catch (POGLException e) {
+		POGLAlert(e);
+	}
+
+	// Destroy the example window
+	POGLDestroyExampleWindow(windowHandle);
+
+	// Quit application
+	return 0;
+}
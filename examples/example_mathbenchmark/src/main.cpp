@@ -0,0 +1,319 @@
+#include <gl/pogl.h>
+#include <gl/poglmath.h>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+using namespace std::chrono;
+
+static const char* INSTRUCTION_SET_NAMES[] = { "SCALAR", "SSE2", "SSE41", "AVX", "NEON" };
+
+// Number of distinct inputs the single-value functions cycle through. Must be a power of two
+static const POGL_UINT32 NUM_INPUTS = 1024;
+
+// Number of times each single-value function is called
+static const POGL_UINT32 SINGLE_CALLS = 1000000;
+
+// Number of items in each batch and the number of times each batch function is called
+static const POGL_UINT32 BATCH_SIZE = 10000;
+static const POGL_UINT32 BATCH_CALLS = 200;
+
+// Number of joints in the skinning benchmark. About the size of a character skeleton
+static const POGL_UINT32 NUM_JOINTS = 100;
+
+/*!
+	\brief The inputs and outputs for all benchmarks. The inputs are random, so that the compiler can't precompute anything
+*/
+struct Data
+{
+	std::vector<POGL_MAT4> matrices;
+	std::vector<POGL_MAT4> invertible;
+	std::vector<POGL_VECTOR3> vectors;
+	std::vector<POGL_FLOAT> xs, ys, zs;
+	std::vector<POGL_AABB> aabbs;
+	std::vector<POGL_SPHERE> spheres;
+	std::vector<POGL_TRSF> poses;
+	std::vector<POGL_INT32> parents;
+	POGL_FRUSTUM frustum;
+
+	std::vector<POGL_MAT4> outMatrices;
+	std::vector<POGL_MAT4> outPalette;
+	std::vector<POGL_VECTOR3> outVectors;
+	std::vector<POGL_FLOAT> outXs, outYs, outZs;
+	std::vector<POGL_AABB> outAABBs;
+	std::vector<POGL_UINT32> outMask;
+	std::vector<POGL_UINT32> outIndices;
+	POGL_FLOAT outFloat;
+
+	Data() : outFloat(0.0f) {
+		std::mt19937 generator(1234);
+		std::uniform_real_distribution<POGL_FLOAT> values(-100.0f, 100.0f);
+		std::uniform_real_distribution<POGL_FLOAT> sizes(0.0f, 20.0f);
+		std::uniform_real_distribution<POGL_FLOAT> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<POGL_FLOAT> scales(0.5f, 1.5f);
+
+		const POGL_UINT32 count = (std::max)(BATCH_SIZE, NUM_INPUTS);
+		matrices.resize(count);
+		invertible.resize(count);
+		vectors.resize(count);
+		xs.resize(count); ys.resize(count); zs.resize(count);
+		aabbs.resize(count);
+		spheres.resize(count);
+		for (POGL_UINT32 i = 0; i < count; ++i) {
+			for (POGL_UINT32 j = 0; j < 16; ++j) {
+				matrices[i].vec[j] = values(generator) * 0.1f;
+				invertible[i].vec[j] = values(generator) * 0.1f;
+			}
+			for (POGL_UINT32 j = 0; j < 4; ++j)
+				invertible[i].m[j][j] += 40.0f;
+
+			vectors[i] = POGL_VECTOR3(values(generator), values(generator), values(generator));
+			xs[i] = vectors[i].x;
+			ys[i] = vectors[i].y;
+			zs[i] = vectors[i].z;
+			aabbs[i].min = POGL_VECTOR3(values(generator), values(generator), values(generator));
+			aabbs[i].max = POGL_VECTOR3(aabbs[i].min.x + sizes(generator), aabbs[i].min.y + sizes(generator), aabbs[i].min.z + sizes(generator));
+			spheres[i].center = POGL_VECTOR3(values(generator), values(generator), values(generator));
+			spheres[i].radius = sizes(generator);
+		}
+
+		// A skeleton where each joint has one of the earlier joints as its parent
+		poses.resize(NUM_JOINTS);
+		parents.resize(NUM_JOINTS);
+		for (POGL_UINT32 i = 0; i < NUM_JOINTS; ++i) {
+			poses[i].translation = POGL_VEC3F(unit(generator), unit(generator), unit(generator));
+			poses[i].rotation = POGLNormalize(POGL_QUATF(unit(generator), unit(generator), unit(generator), unit(generator)));
+			poses[i].scale = POGL_VEC3F(scales(generator), scales(generator), scales(generator));
+			parents[i] = i == 0 ? -1 : std::uniform_int_distribution<POGL_INT32>(0, i - 1)(generator);
+		}
+
+		POGL_MAT4 projection, view, viewProjection;
+		POGLMat4Perspective(60.0f, 1.5f, 0.1f, 80.0f, &projection);
+		POGLMat4LookAt(POGL_VECTOR3(0.0f, 0.0f, 0.0f), POGL_VECTOR3(1.0f, 0.5f, -1.0f), POGL_VECTOR3(0.0f, 1.0f, 0.0f), &view);
+		POGLMat4Multiply(projection, view, &viewProjection);
+		POGLFrustumExtract(viewProjection, &frustum);
+
+		outMatrices.resize(count);
+		outPalette.resize(count);
+		outVectors.resize(count);
+		outXs.resize(count); outYs.resize(count); outZs.resize(count);
+		outAABBs.resize(count);
+		outMask.resize((count + 31) / 32);
+		outIndices.resize(count);
+	}
+};
+
+/*!
+	\brief The measured times for one function on every instruction set
+*/
+struct Row
+{
+	Row(const std::string& _name, POGL_UINT32 _itemsPerCall) : name(_name), itemsPerCall(_itemsPerCall) {
+		for (POGL_UINT32 i = 0; i < POGLMathInstructionSet::COUNT; ++i)
+			nanoseconds[i] = -1.0;
+	}
+
+	std::string name;
+	POGL_UINT32 itemsPerCall;
+
+	/* The time it takes to process one item in nanoseconds, or a negative value if not measured */
+	POGL_DOUBLE nanoseconds[POGLMathInstructionSet::COUNT];
+};
+
+/*!
+	\brief Call the supplied function "calls" times after a short warmup
+
+	\return The average time per item in nanoseconds
+*/
+template<typename Func>
+POGL_DOUBLE Measure(POGL_UINT32 calls, POGL_UINT32 itemsPerCall, Func func)
+{
+	for (POGL_UINT32 i = 0; i < calls / 10; ++i)
+		func(i & (NUM_INPUTS - 1));
+
+	const auto start = high_resolution_clock::now();
+	for (POGL_UINT32 i = 0; i < calls; ++i)
+		func(i & (NUM_INPUTS - 1));
+	const auto elapsed = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+	return (POGL_DOUBLE)elapsed / ((POGL_DOUBLE)calls * itemsPerCall);
+}
+
+/*!
+	\brief Keeps track of the row each measurement belongs to
+*/
+class Benchmarks
+{
+public:
+	Benchmarks(std::vector<Row>* rows, POGLMathInstructionSet::Enum instructionSet)
+		: mRows(rows), mInstructionSet(instructionSet), mIndex(0) {
+	}
+
+	template<typename Func>
+	void Single(const char* name, Func func) {
+		GetRow(name, 1)->nanoseconds[mInstructionSet] = Measure(SINGLE_CALLS, 1, func);
+	}
+
+	template<typename Func>
+	void Batch(const char* name, POGL_UINT32 itemsPerCall, Func func) {
+		GetRow(name, itemsPerCall)->nanoseconds[mInstructionSet] = Measure(BATCH_CALLS, itemsPerCall, func);
+	}
+
+private:
+	Row* GetRow(const char* name, POGL_UINT32 itemsPerCall) {
+		if (mIndex == mRows->size())
+			mRows->push_back(Row(name, itemsPerCall));
+		return &(*mRows)[mIndex++];
+	}
+
+	std::vector<Row>* mRows;
+	POGLMathInstructionSet::Enum mInstructionSet;
+	size_t mIndex;
+};
+
+/*!
+	\brief Measure the single-value functions with the instruction set that is currently selected
+*/
+void RunSingle(Data& d, Benchmarks& b)
+{
+	b.Single("POGLMat4Multiply", [&](POGL_UINT32 i) { POGLMat4Multiply(d.matrices[i], d.matrices[i + 1], &d.outMatrices[i]); });
+	b.Single("POGLMat4Transpose", [&](POGL_UINT32 i) { POGLMat4Transpose(d.matrices[i], &d.outMatrices[i]); });
+	b.Single("POGLMat4Inverse", [&](POGL_UINT32 i) { POGLMat4Inverse(d.invertible[i], &d.outMatrices[i]); });
+	b.Single("POGLMat4Translate", [&](POGL_UINT32 i) { POGLMat4Translate(d.vectors[i], &d.outMatrices[i]); });
+	b.Single("POGLMat4Rotate", [&](POGL_UINT32 i) { POGLMat4Rotate(d.vectors[i].x, d.matrices[i], d.vectors[i + 1], &d.outMatrices[i]); });
+	b.Single("POGLMat4Scale", [&](POGL_UINT32 i) { POGLMat4Scale(d.vectors[i], &d.outMatrices[i]); });
+	b.Single("POGLMat4Ortho", [&](POGL_UINT32 i) { POGLMat4Ortho(-d.xs[i], d.xs[i + 1], -d.ys[i], d.ys[i + 1], 0.1f, 100.0f, &d.outMatrices[i]); });
+	b.Single("POGLMat4Perspective", [&](POGL_UINT32 i) { POGLMat4Perspective(45.0f, 1.5f, 0.1f, d.zs[i], &d.outMatrices[i]); });
+	b.Single("POGLMat4LookAt", [&](POGL_UINT32 i) { POGLMat4LookAt(d.vectors[i], d.vectors[i + 1], POGL_VECTOR3(0.0f, 1.0f, 0.0f), &d.outMatrices[i]); });
+	b.Single("POGLVec3Length", [&](POGL_UINT32 i) { d.outFloat += POGLVec3Length(d.vectors[i]); });
+	b.Single("POGLVec3SqrdLength", [&](POGL_UINT32 i) { d.outFloat += POGLVec3SqrdLength(d.vectors[i]); });
+	b.Single("POGLVec3Normalize", [&](POGL_UINT32 i) { d.outVectors[i] = d.vectors[i]; POGLVec3Normalize(&d.outVectors[i]); });
+	b.Single("POGLVec3Cross", [&](POGL_UINT32 i) { POGLVec3Cross(d.vectors[i], d.vectors[i + 1], &d.outVectors[i]); });
+	b.Single("POGLVec3Perp", [&](POGL_UINT32 i) { POGLVec3Perp(d.vectors[i], &d.outVectors[i]); });
+	b.Single("POGLFrustumExtract", [&](POGL_UINT32 i) { POGLFrustumExtract(d.matrices[i], &d.frustum); });
+
+	//
+	// The inline math types. These don't depend on the instruction set, but they're measured here so that they can
+	// be compared with the exported functions
+	//
+
+	b.Single("POGL_MAT4F * POGL_MAT4F", [&](POGL_UINT32 i) { d.outMatrices[i] = POGL_MAT4F(d.matrices[i]) * POGL_MAT4F(d.matrices[i + 1]); });
+	b.Single("POGLTransformPoint", [&](POGL_UINT32 i) { d.outVectors[i] = POGLTransformPoint(d.matrices[i], d.vectors[i]); });
+	b.Single("POGLCompose", [&](POGL_UINT32 i) { d.outMatrices[i] = POGLCompose(d.poses[i % NUM_JOINTS]); });
+	b.Single("POGLNlerp", [&](POGL_UINT32 i) {
+		d.poses[i % NUM_JOINTS].rotation = POGLNlerp(d.poses[i % NUM_JOINTS].rotation, d.poses[(i + 1) % NUM_JOINTS].rotation, 0.5f);
+	});
+	b.Single("POGLSlerp", [&](POGL_UINT32 i) {
+		d.poses[i % NUM_JOINTS].rotation = POGLSlerp(d.poses[i % NUM_JOINTS].rotation, d.poses[(i + 1) % NUM_JOINTS].rotation, 0.5f);
+	});
+	b.Single("POGLRotate", [&](POGL_UINT32 i) { d.outVectors[i] = POGLRotate(d.poses[i % NUM_JOINTS].rotation, d.vectors[i]); });
+}
+
+/*!
+	\brief Measure the batch functions with the instruction set that is currently selected
+*/
+void RunBatch(Data& d, Benchmarks& b)
+{
+	b.Batch("POGLMat4MultiplyArray", BATCH_SIZE, [&](POGL_UINT32 i) {
+		POGLMat4MultiplyArray(d.matrices[i], &d.matrices[0], BATCH_SIZE, &d.outMatrices[0]);
+	});
+	b.Batch("POGLVec3TransformPoints", BATCH_SIZE, [&](POGL_UINT32 i) {
+		POGLVec3TransformPoints(d.matrices[i], &d.vectors[0], BATCH_SIZE, &d.outVectors[0]);
+	});
+	b.Batch("POGLVec3TransformVectors", BATCH_SIZE, [&](POGL_UINT32 i) {
+		POGLVec3TransformVectors(d.matrices[i], &d.vectors[0], BATCH_SIZE, &d.outVectors[0]);
+	});
+	b.Batch("POGLVec3TransformPointsSoA", BATCH_SIZE, [&](POGL_UINT32 i) {
+		POGLVec3TransformPointsSoA(d.matrices[i], &d.xs[0], &d.ys[0], &d.zs[0], BATCH_SIZE, &d.outXs[0], &d.outYs[0], &d.outZs[0]);
+	});
+	b.Batch("POGLAABBTransform", BATCH_SIZE, [&](POGL_UINT32 i) {
+		POGLAABBTransform(d.matrices[i], &d.aabbs[0], BATCH_SIZE, &d.outAABBs[0]);
+	});
+	b.Batch("POGLFrustumCullSpheres", BATCH_SIZE, [&](POGL_UINT32) {
+		POGLFrustumCullSpheres(d.frustum, &d.spheres[0], BATCH_SIZE, &d.outMask[0]);
+	});
+	b.Batch("POGLFrustumCullAABBs", BATCH_SIZE, [&](POGL_UINT32) {
+		POGLFrustumCullAABBs(d.frustum, &d.aabbs[0], BATCH_SIZE, &d.outMask[0]);
+	});
+	b.Batch("POGLVisibilityMaskToIndices", BATCH_SIZE, [&](POGL_UINT32) {
+		POGLVisibilityMaskToIndices(&d.outMask[0], BATCH_SIZE, &d.outIndices[0]);
+	});
+	b.Batch("POGLSkinningPalette", NUM_JOINTS, [&](POGL_UINT32) {
+		POGLSkinningPalette(&d.poses[0], &d.parents[0], &d.matrices[0], NUM_JOINTS, &d.outMatrices[0], &d.outPalette[0]);
+	});
+}
+
+/*!
+	\brief Print the measured times. The batch functions also get their throughput in millions of items per second
+*/
+void Print(const std::vector<Row>& rows, const bool* measured)
+{
+	std::cout << "Function [ns/item]";
+	for (POGL_UINT32 i = 0; i < POGLMathInstructionSet::COUNT; ++i) {
+		if (measured[i])
+			std::cout << ", " << INSTRUCTION_SET_NAMES[i];
+	}
+	std::cout << std::endl;
+
+	std::cout << std::fixed << std::setprecision(2);
+	for (size_t r = 0; r < rows.size(); ++r) {
+		const Row& row = rows[r];
+		std::cout << row.name << ":";
+		for (POGL_UINT32 i = 0; i < POGLMathInstructionSet::COUNT; ++i) {
+			if (!measured[i])
+				continue;
+
+			std::cout << " " << INSTRUCTION_SET_NAMES[i] << "=" << row.nanoseconds[i];
+			if (row.itemsPerCall > 1)
+				std::cout << " (" << 1000.0 / row.nanoseconds[i] << " M/s)";
+		}
+		std::cout << std::endl;
+	}
+}
+
+int main()
+{
+	Data data;
+	const POGLMathInstructionSet::Enum selected = POGLMathGetInstructionSet();
+	std::cout << "Selected instruction set: " << INSTRUCTION_SET_NAMES[selected] << std::endl;
+
+	// Every function is measured with every instruction set supported by the CPU
+	std::vector<Row> rows;
+	bool measured[POGLMathInstructionSet::COUNT] = { false };
+	for (POGL_UINT32 i = 0; i < POGLMathInstructionSet::COUNT; ++i) {
+		const POGLMathInstructionSet::Enum instructionSet = (POGLMathInstructionSet::Enum)i;
+		if (!POGLMathSetInstructionSet(instructionSet))
+			continue;
+
+		Benchmarks benchmarks(&rows, instructionSet);
+		RunSingle(data, benchmarks);
+		RunBatch(data, benchmarks);
+		measured[i] = true;
+	}
+	Print(rows, measured);
+
+	// The batch functions split across all cores with the best instruction set
+	const POGL_UINT32 numThreads = (std::max)(std::thread::hardware_concurrency(), 1U);
+	POGLMathSetInstructionSet(selected);
+	POGLMathSetBatchThreads(numThreads, 1024);
+	std::vector<Row> threadedRows;
+	Benchmarks benchmarks(&threadedRows, selected);
+	RunBatch(data, benchmarks);
+	POGLMathSetBatchThreads(1, 0);
+
+	std::cout << std::endl << "Batch functions on " << numThreads << " threads [ns/item]" << std::endl;
+	for (size_t r = 0; r < threadedRows.size(); ++r) {
+		const Row& row = threadedRows[r];
+		if (row.itemsPerCall >= BATCH_SIZE) {
+			std::cout << row.name << ": " << INSTRUCTION_SET_NAMES[selected] << "=" << row.nanoseconds[selected]
+				<< " (" << 1000.0 / row.nanoseconds[selected] << " M/s)" << std::endl;
+		}
+	}
+
+	// Prevents the compiler from removing the calculations
+	std::cout << std::endl << "Checksum: " << data.outFloat + data.outMatrices[0].vec[0] + data.outVectors[0].x << std::endl;
+	return 0;
+}
@@ -0,0 +1,661 @@
+#include <gl/pogl.h>
+#include <gl/poglmath.h>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <cstring>
+#include <cmath>
+
+// Number of random inputs each function is verified with
+static const POGL_UINT32 NUM_SAMPLES = 100000;
+
+static const char* INSTRUCTION_SET_NAMES[] = { "SCALAR", "SSE2", "SSE41", "AVX", "NEON" };
+
+//
+// The maximum number of ULP each function is allowed to differ from the scalar version. The matrix multiplication, the transpose
+// and the cross product perform the same operations in the same order and must be bit-for-bit identical
+//
+
+static const POGL_UINT32 MAT4_MULTIPLY_MAX_ULPS = 0;
+static const POGL_UINT32 MAT4_TRANSPOSE_MAX_ULPS = 0;
+static const POGL_UINT32 VEC3_CROSS_MAX_ULPS = 0;
+static const POGL_UINT32 VEC3_SQRDLENGTH_MAX_ULPS = 1;
+static const POGL_UINT32 VEC3_LENGTH_MAX_ULPS = 1;
+static const POGL_UINT32 VEC3_NORMALIZE_MAX_ULPS = 2;
+
+// The batch functions perform the same operations in the same order as the scalar version
+static const POGL_UINT32 BATCH_MAX_ULPS = 0;
+
+// Number of items in each batch. It's not a multiple of the SIMD width, so that the remainder loops are verified as well
+static const POGL_UINT32 BATCH_SIZE = 10003;
+
+// The inline math types may be compiled with other floating-point settings than the library, so they're compared with a tolerance
+static const POGL_FLOAT INLINE_TOLERANCE = 1e-6f;
+
+// Quaternion identities are verified with a tolerance, because the two sides are calculated in different ways
+static const POGL_FLOAT QUATERNION_TOLERANCE = 1e-5f;
+
+// The largest error allowed for the mathematical properties, relative to the size of the values involved
+static const POGL_FLOAT PROPERTY_TOLERANCE = 1e-4f;
+
+// The inverse is calculated with different algorithms, so it's compared with a tolerance relative to the largest value instead
+static const POGL_FLOAT MAT4_INVERSE_TOLERANCE = 1e-5f;
+
+/*!
+	\brief Retrieves the number of representable floats between a and b
+*/
+POGL_UINT32 UlpDistance(POGL_FLOAT a, POGL_FLOAT b)
+{
+	if (a == b)
+		return 0;
+	if (std::isnan(a) || std::isnan(b))
+		return UINT32_MAX;
+
+	POGL_INT32 ia, ib;
+	memcpy(&ia, &a, sizeof(ia));
+	memcpy(&ib, &b, sizeof(ib));
+
+	// Map the sign-magnitude representation to a continuous range of integers
+	const POGL_INT64 la = ia < 0 ? (POGL_INT64)INT32_MIN - ia : ia;
+	const POGL_INT64 lb = ib < 0 ? (POGL_INT64)INT32_MIN - ib : ib;
+	const POGL_INT64 distance = la > lb ? la - lb : lb - la;
+	return distance > UINT32_MAX ? UINT32_MAX : (POGL_UINT32)distance;
+}
+
+/*!
+	\brief The largest error found for one function
+*/
+struct Result
+{
+	Result() : maxUlps(0), maxError(0.0f), failures(0) {}
+
+	POGL_UINT32 maxUlps;
+	POGL_FLOAT maxError;
+	POGL_UINT32 failures;
+
+	void CompareUlps(const POGL_FLOAT* actual, const POGL_FLOAT* expected, POGL_UINT32 count, POGL_UINT32 allowedUlps) {
+		bool failed = false;
+		for (POGL_UINT32 i = 0; i < count; ++i) {
+			const POGL_UINT32 ulps = UlpDistance(actual[i], expected[i]);
+			if (ulps > maxUlps)
+				maxUlps = ulps;
+			if (ulps > allowedUlps)
+				failed = true;
+		}
+		if (failed)
+			failures++;
+	}
+
+	void CompareRelative(const POGL_FLOAT* actual, const POGL_FLOAT* expected, POGL_UINT32 count, POGL_FLOAT tolerance) {
+		POGL_FLOAT largest = 1.0f;
+		for (POGL_UINT32 i = 0; i < count; ++i)
+			largest = (std::max)(largest, fabsf(expected[i]));
+
+		bool failed = false;
+		for (POGL_UINT32 i = 0; i < count; ++i) {
+			const POGL_FLOAT error = fabsf(actual[i] - expected[i]) / largest;
+			if (error > maxError || std::isnan(error))
+				maxError = error;
+			if (!(error <= tolerance))
+				failed = true;
+		}
+		if (failed)
+			failures++;
+	}
+
+	bool Print(const char* name) const {
+		std::cout << "  " << name << ": " << (failures == 0 ? "OK" : "FAILED") << " (max " << maxUlps << " ULP, max relative error " << maxError
+			<< ", " << failures << " failures)" << std::endl;
+		return failures == 0;
+	}
+};
+
+/*!
+	\brief Generate a random matrix. Diagonally dominant matrices are always invertible and well-conditioned
+*/
+POGL_MAT4 RandomMatrix(std::mt19937& generator, bool diagonallyDominant)
+{
+	std::uniform_real_distribution<POGL_FLOAT> distribution(-10.0f, 10.0f);
+	POGL_MAT4 m;
+	for (POGL_UINT32 i = 0; i < 16; ++i)
+		m.vec[i] = distribution(generator);
+	if (diagonallyDominant) {
+		for (POGL_UINT32 i = 0; i < 4; ++i)
+			m.m[i][i] += m.m[i][i] < 0.0f ? -40.0f : 40.0f;
+	}
+	return m;
+}
+
+POGL_VECTOR3 RandomVector(std::mt19937& generator)
+{
+	std::uniform_real_distribution<POGL_FLOAT> distribution(-100.0f, 100.0f);
+	const POGL_FLOAT x = distribution(generator);
+	const POGL_FLOAT y = distribution(generator);
+	const POGL_FLOAT z = distribution(generator);
+	return POGL_VECTOR3(x, y, z);
+}
+
+POGL_FLOAT* Floats(std::vector<POGL_VECTOR3>& v) { return v[0].vec; }
+POGL_FLOAT* Floats(std::vector<POGL_MAT4>& v) { return v[0].vec; }
+POGL_FLOAT* Floats(std::vector<POGL_AABB>& v) { return v[0].min.vec; }
+
+POGL_QUATF RandomRotation(std::mt19937& generator)
+{
+	std::uniform_real_distribution<POGL_FLOAT> distribution(-1.0f, 1.0f);
+	const POGL_FLOAT x = distribution(generator);
+	const POGL_FLOAT y = distribution(generator);
+	const POGL_FLOAT z = distribution(generator);
+	const POGL_FLOAT w = distribution(generator);
+	return POGLNormalize(POGL_QUATF(x, y, z, w));
+}
+
+POGL_TRSF RandomPose(std::mt19937& generator)
+{
+	std::uniform_real_distribution<POGL_FLOAT> translations(-10.0f, 10.0f);
+	std::uniform_real_distribution<POGL_FLOAT> scales(0.5f, 1.5f);
+	POGL_TRSF pose;
+	pose.translation = POGL_VEC3F(translations(generator), translations(generator), translations(generator));
+	pose.rotation = RandomRotation(generator);
+	pose.scale = POGL_VEC3F(scales(generator), scales(generator), scales(generator));
+	return pose;
+}
+
+/*!
+	\brief Execute the supplied batch function with the scalar version and the supplied instruction set
+*/
+template<typename T, typename Func>
+void CompareBatch(POGLMathInstructionSet::Enum instructionSet, POGL_UINT32 count, Func func, Result* result) {
+	std::vector<T> expected(count), actual(count);
+	POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+	func(&expected[0]);
+	POGLMathSetInstructionSet(instructionSet);
+	func(&actual[0]);
+	result->CompareUlps(Floats(actual), Floats(expected), count * sizeof(T) / sizeof(POGL_FLOAT), BATCH_MAX_ULPS);
+}
+
+/*!
+	\brief Compare the batch functions executed with the supplied instruction set against the scalar version
+
+	\return true if all functions are within their bounds
+*/
+bool VerifyBatch(POGLMathInstructionSet::Enum instructionSet)
+{
+	std::mt19937 generator(5678);
+	std::uniform_real_distribution<POGL_FLOAT> distribution(-100.0f, 100.0f);
+	std::uniform_real_distribution<POGL_FLOAT> sizes(0.0f, 20.0f);
+
+	const POGL_MAT4 m = RandomMatrix(generator, false);
+	std::vector<POGL_MAT4> matrices(BATCH_SIZE);
+	std::vector<POGL_VECTOR3> points(BATCH_SIZE);
+	std::vector<POGL_FLOAT> xs(BATCH_SIZE), ys(BATCH_SIZE), zs(BATCH_SIZE);
+	std::vector<POGL_AABB> aabbs(BATCH_SIZE);
+	std::vector<POGL_SPHERE> spheres(BATCH_SIZE);
+	for (POGL_UINT32 i = 0; i < BATCH_SIZE; ++i) {
+		matrices[i] = RandomMatrix(generator, false);
+		points[i] = RandomVector(generator);
+		xs[i] = points[i].x;
+		ys[i] = points[i].y;
+		zs[i] = points[i].z;
+		aabbs[i].min = RandomVector(generator);
+		aabbs[i].max = POGL_VECTOR3(aabbs[i].min.x + sizes(generator), aabbs[i].min.y + sizes(generator), aabbs[i].min.z + sizes(generator));
+		spheres[i].center = RandomVector(generator);
+		spheres[i].radius = sizes(generator);
+	}
+
+	// A camera in the middle of the random volumes, so that some are visible and some are not
+	POGL_MAT4 projection, view, viewProjection;
+	POGLMat4Perspective(60.0f, 1.5f, 0.1f, 80.0f, &projection);
+	POGLMat4LookAt(POGL_VECTOR3(0.0f, 0.0f, 0.0f), POGL_VECTOR3(1.0f, 0.5f, -1.0f), POGL_VECTOR3(0.0f, 1.0f, 0.0f), &view);
+	POGLMat4Multiply(projection, view, &viewProjection);
+	POGL_FRUSTUM frustum;
+	POGLFrustumExtract(viewProjection, &frustum);
+
+	Result multiplyArray, transformPoints, transformVectors, transformSoA, transformAABBs, cullSpheres, cullAABBs;
+
+	CompareBatch<POGL_MAT4>(instructionSet, BATCH_SIZE, [&](POGL_MAT4* out) {
+		POGLMat4MultiplyArray(m, &matrices[0], BATCH_SIZE, out);
+	}, &multiplyArray);
+	CompareBatch<POGL_VECTOR3>(instructionSet, BATCH_SIZE, [&](POGL_VECTOR3* out) {
+		POGLVec3TransformPoints(m, &points[0], BATCH_SIZE, out);
+	}, &transformPoints);
+	CompareBatch<POGL_VECTOR3>(instructionSet, BATCH_SIZE, [&](POGL_VECTOR3* out) {
+		POGLVec3TransformVectors(m, &points[0], BATCH_SIZE, out);
+	}, &transformVectors);
+	CompareBatch<POGL_AABB>(instructionSet, BATCH_SIZE, [&](POGL_AABB* out) {
+		POGLAABBTransform(m, &aabbs[0], BATCH_SIZE, out);
+	}, &transformAABBs);
+
+	// The SoA results are compared with the AoS results of the scalar version
+	std::vector<POGL_VECTOR3> expectedPoints(BATCH_SIZE);
+	POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+	POGLVec3TransformPoints(m, &points[0], BATCH_SIZE, &expectedPoints[0]);
+	POGLMathSetInstructionSet(instructionSet);
+	std::vector<POGL_FLOAT> outXs(BATCH_SIZE), outYs(BATCH_SIZE), outZs(BATCH_SIZE);
+	POGLVec3TransformPointsSoA(m, &xs[0], &ys[0], &zs[0], BATCH_SIZE, &outXs[0], &outYs[0], &outZs[0]);
+	for (POGL_UINT32 i = 0; i < BATCH_SIZE; ++i) {
+		const POGL_FLOAT actual[3] = { outXs[i], outYs[i], outZs[i] };
+		transformSoA.CompareUlps(actual, expectedPoints[i].vec, 3, BATCH_MAX_ULPS);
+	}
+
+	// Culling must give exactly the same visibility. The bits are compared as a whole
+	const POGL_UINT32 numWords = (BATCH_SIZE + 31) / 32;
+	std::vector<POGL_UINT32> expectedMask(numWords), actualMask(numWords);
+	POGL_UINT32 numVisibleSpheres = 0, numVisibleAABBs = 0;
+	std::vector<POGL_UINT32> indices(BATCH_SIZE);
+
+	POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+	POGLFrustumCullSpheres(frustum, &spheres[0], BATCH_SIZE, &expectedMask[0]);
+	POGLMathSetInstructionSet(instructionSet);
+	POGLFrustumCullSpheres(frustum, &spheres[0], BATCH_SIZE, &actualMask[0]);
+	if (expectedMask != actualMask)
+		cullSpheres.failures++;
+	numVisibleSpheres = POGLVisibilityMaskToIndices(&actualMask[0], BATCH_SIZE, &indices[0]);
+
+	POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+	POGLFrustumCullAABBs(frustum, &aabbs[0], BATCH_SIZE, &expectedMask[0]);
+	POGLMathSetInstructionSet(instructionSet);
+	POGLFrustumCullAABBs(frustum, &aabbs[0], BATCH_SIZE, &actualMask[0]);
+	if (expectedMask != actualMask)
+		cullAABBs.failures++;
+	numVisibleAABBs = POGLVisibilityMaskToIndices(&actualMask[0], BATCH_SIZE, &indices[0]);
+
+	// A random joint hierarchy, where each parent comes before its children
+	std::vector<POGL_TRSF> poses(BATCH_SIZE);
+	std::vector<POGL_INT32> parents(BATCH_SIZE);
+	for (POGL_UINT32 i = 0; i < BATCH_SIZE; ++i) {
+		poses[i] = RandomPose(generator);
+		parents[i] = i == 0 ? -1 : std::uniform_int_distribution<POGL_INT32>(-1, i - 1)(generator);
+	}
+
+	Result skinningWorlds, skinningPalette;
+	std::vector<POGL_MAT4> expectedWorlds(BATCH_SIZE), actualWorlds(BATCH_SIZE), expectedPalette(BATCH_SIZE), actualPalette(BATCH_SIZE);
+	POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+	POGLSkinningPalette(&poses[0], &parents[0], &matrices[0], BATCH_SIZE, &expectedWorlds[0], &expectedPalette[0]);
+	POGLMathSetInstructionSet(instructionSet);
+	POGLSkinningPalette(&poses[0], &parents[0], &matrices[0], BATCH_SIZE, &actualWorlds[0], &actualPalette[0]);
+	skinningWorlds.CompareUlps(Floats(actualWorlds), Floats(expectedWorlds), BATCH_SIZE * 16, BATCH_MAX_ULPS);
+	skinningPalette.CompareUlps(Floats(actualPalette), Floats(expectedPalette), BATCH_SIZE * 16, BATCH_MAX_ULPS);
+
+	bool ok = true;
+	ok &= multiplyArray.Print("POGLMat4MultiplyArray");
+	ok &= transformPoints.Print("POGLVec3TransformPoints");
+	ok &= transformVectors.Print("POGLVec3TransformVectors");
+	ok &= transformSoA.Print("POGLVec3TransformPointsSoA");
+	ok &= transformAABBs.Print("POGLAABBTransform");
+	ok &= cullSpheres.Print("POGLFrustumCullSpheres");
+	std::cout << "    " << numVisibleSpheres << " of " << BATCH_SIZE << " visible" << std::endl;
+	ok &= cullAABBs.Print("POGLFrustumCullAABBs");
+	std::cout << "    " << numVisibleAABBs << " of " << BATCH_SIZE << " visible" << std::endl;
+	ok &= skinningWorlds.Print("POGLSkinningPalette (world matrices)");
+	ok &= skinningPalette.Print("POGLSkinningPalette (palette)");
+	return ok;
+}
+
+/*!
+	\brief Compare every function executed with the supplied instruction set against the scalar version
+
+	\return true if all functions are within their bounds
+*/
+bool Verify(POGLMathInstructionSet::Enum instructionSet)
+{
+	// The same inputs are used for every instruction set
+	std::mt19937 generator(1234);
+
+	Result multiply, transpose, inverse, cross, sqrdLength, length, normalize;
+	bool singularDetected = true;
+
+	for (POGL_UINT32 i = 0; i < NUM_SAMPLES; ++i) {
+		const POGL_MAT4 a = RandomMatrix(generator, false);
+		const POGL_MAT4 b = RandomMatrix(generator, false);
+		const POGL_MAT4 invertible = RandomMatrix(generator, true);
+		const POGL_VECTOR3 v1 = RandomVector(generator);
+		const POGL_VECTOR3 v2 = RandomVector(generator);
+
+		POGL_MAT4 expectedMat4, actualMat4;
+		POGL_VECTOR3 expectedVec3, actualVec3;
+
+		POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+		POGLMat4Multiply(a, b, &expectedMat4);
+		POGLMathSetInstructionSet(instructionSet);
+		POGLMat4Multiply(a, b, &actualMat4);
+		multiply.CompareUlps(actualMat4.vec, expectedMat4.vec, 16, MAT4_MULTIPLY_MAX_ULPS);
+
+		// The output is allowed to be one of the inputs
+		actualMat4 = a;
+		POGLMat4Multiply(actualMat4, b, &actualMat4);
+		multiply.CompareUlps(actualMat4.vec, expectedMat4.vec, 16, MAT4_MULTIPLY_MAX_ULPS);
+
+		POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+		POGLMat4Transpose(a, &expectedMat4);
+		POGLMathSetInstructionSet(instructionSet);
+		actualMat4 = a;
+		POGLMat4Transpose(actualMat4, &actualMat4);
+		transpose.CompareUlps(actualMat4.vec, expectedMat4.vec, 16, MAT4_TRANSPOSE_MAX_ULPS);
+
+		POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+		POGLMat4Inverse(invertible, &expectedMat4);
+		POGLMathSetInstructionSet(instructionSet);
+		if (POGLMat4Inverse(invertible, &actualMat4))
+			inverse.CompareRelative(actualMat4.vec, expectedMat4.vec, 16, MAT4_INVERSE_TOLERANCE);
+		else
+			inverse.failures++;
+
+		POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+		POGLVec3Cross(v1, v2, &expectedVec3);
+		POGLMathSetInstructionSet(instructionSet);
+		POGLVec3Cross(v1, v2, &actualVec3);
+		cross.CompareUlps(actualVec3.vec, expectedVec3.vec, 3, VEC3_CROSS_MAX_ULPS);
+
+		POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+		POGL_FLOAT expected = POGLVec3SqrdLength(v1);
+		POGLMathSetInstructionSet(instructionSet);
+		POGL_FLOAT actual = POGLVec3SqrdLength(v1);
+		sqrdLength.CompareUlps(&actual, &expected, 1, VEC3_SQRDLENGTH_MAX_ULPS);
+
+		POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+		expected = POGLVec3Length(v1);
+		POGLMathSetInstructionSet(instructionSet);
+		actual = POGLVec3Length(v1);
+		length.CompareUlps(&actual, &expected, 1, VEC3_LENGTH_MAX_ULPS);
+
+		POGLMathSetInstructionSet(POGLMathInstructionSet::SCALAR);
+		expectedVec3 = v1;
+		POGLVec3Normalize(&expectedVec3);
+		POGLMathSetInstructionSet(instructionSet);
+		actualVec3 = v1;
+		POGLVec3Normalize(&actualVec3);
+		normalize.CompareUlps(actualVec3.vec, expectedVec3.vec, 3, VEC3_NORMALIZE_MAX_ULPS);
+	}
+
+	// A matrix with two identical columns has no inverse
+	POGL_MAT4 singular = RandomMatrix(generator, false);
+	for (POGL_UINT32 row = 0; row < 4; ++row)
+		singular.m[3][row] = singular.m[2][row];
+	POGL_MAT4 unused;
+	POGLMathSetInstructionSet(instructionSet);
+	singularDetected = !POGLMat4Inverse(singular, &unused);
+
+	std::cout << INSTRUCTION_SET_NAMES[instructionSet] << ":" << std::endl;
+	bool ok = true;
+	ok &= multiply.Print("POGLMat4Multiply");
+	ok &= transpose.Print("POGLMat4Transpose");
+	ok &= inverse.Print("POGLMat4Inverse");
+	std::cout << "  POGLMat4Inverse (singular): " << (singularDetected ? "OK" : "FAILED") << std::endl;
+	ok &= singularDetected;
+	ok &= cross.Print("POGLVec3Cross");
+	ok &= sqrdLength.Print("POGLVec3SqrdLength");
+	ok &= length.Print("POGLVec3Length");
+	ok &= normalize.Print("POGLVec3Normalize");
+	ok &= VerifyBatch(instructionSet);
+	return ok;
+}
+
+/*!
+	\brief Compare the header-only math types against the exported functions
+
+	\return true if all functions are within their bounds
+*/
+bool VerifyInline()
+{
+	std::mt19937 generator(4321);
+	Result multiply, transpose, transformPoint, transformVector, cross;
+	Result compose, decompose, rotate, dualQuat, slerp;
+
+	for (POGL_UINT32 i = 0; i < NUM_SAMPLES; ++i) {
+		const POGL_MAT4 a = RandomMatrix(generator, false);
+		const POGL_MAT4 b = RandomMatrix(generator, false);
+		const POGL_VECTOR3 v1 = RandomVector(generator);
+		const POGL_VECTOR3 v2 = RandomVector(generator);
+
+		POGL_MAT4 expectedMat4;
+		POGLMat4Multiply(a, b, &expectedMat4);
+		POGL_MAT4F actualMat4 = POGL_MAT4F(a) * POGL_MAT4F(b);
+		multiply.CompareRelative(actualMat4.vec, expectedMat4.vec, 16, INLINE_TOLERANCE);
+
+		POGLMat4Transpose(a, &expectedMat4);
+		actualMat4 = POGLTranspose(a);
+		transpose.CompareUlps(actualMat4.vec, expectedMat4.vec, 16, 0);
+
+		POGL_VECTOR3 expectedVec3;
+		POGLVec3TransformPoints(a, &v1, 1, &expectedVec3);
+		POGL_VEC3F actualVec3 = POGLTransformPoint(a, v1);
+		transformPoint.CompareRelative(actualVec3.Data(), expectedVec3.vec, 3, INLINE_TOLERANCE);
+
+		POGLVec3TransformVectors(a, &v1, 1, &expectedVec3);
+		actualVec3 = POGLTransformVector(a, v1);
+		transformVector.CompareRelative(actualVec3.Data(), expectedVec3.vec, 3, INLINE_TOLERANCE);
+
+		POGLVec3Cross(v1, v2, &expectedVec3);
+		actualVec3 = POGLCross(v1, v2);
+		cross.CompareRelative(actualVec3.Data(), expectedVec3.vec, 3, INLINE_TOLERANCE);
+
+		// The inline composition must match the local matrix of a root joint
+		const POGL_TRSF pose = RandomPose(generator);
+		const POGL_INT32 root = -1;
+		POGL_MAT4 world;
+		POGLSkinningPalette(&pose, &root, nullptr, 1, &world, nullptr);
+		actualMat4 = POGLCompose(pose);
+		compose.CompareRelative(actualMat4.vec, world.vec, 16, INLINE_TOLERANCE);
+
+		// Decomposing gives the same transform, although the quaternion might be negated
+		POGL_TRSF decomposed;
+		if (POGLDecompose(actualMat4, &decomposed)) {
+			const POGL_MAT4F recomposed = POGLCompose(decomposed);
+			decompose.CompareRelative(recomposed.vec, actualMat4.vec, 16, QUATERNION_TOLERANCE);
+		}
+		else
+			decompose.failures++;
+
+		// Rotating with the quaternion is the same as transforming with its matrix
+		actualVec3 = POGLRotate(pose.rotation, v1);
+		const POGL_VEC3F rotated = POGLTransformVector(POGLToMatrix(pose.rotation), v1);
+		rotate.CompareRelative(actualVec3.Data(), rotated.Data(), 3, QUATERNION_TOLERANCE);
+
+		// A dual quaternion transforms points like a rotation followed by a translation
+		const POGL_DUALQUATF dq = POGL_DUALQUATF::FromRotationTranslation(pose.rotation, pose.translation);
+		actualVec3 = POGLTransformPoint(dq, v1);
+		const POGL_VEC3F transformed = POGLTransformPoint(POGLToMatrix(dq), v1);
+		const POGL_VEC3F expectedTransformed = POGLRotate(pose.rotation, v1) + pose.translation;
+		dualQuat.CompareRelative(actualVec3.Data(), expectedTransformed.Data(), 3, QUATERNION_TOLERANCE);
+		dualQuat.CompareRelative(transformed.Data(), expectedTransformed.Data(), 3, QUATERNION_TOLERANCE);
+
+		// Slerp halfway between two rotations is equally far from both, and nlerp is close to it
+		const POGL_QUATF q1 = RandomRotation(generator);
+		const POGL_QUATF q2 = RandomRotation(generator);
+		const POGL_QUATF halfway = POGLSlerp(q1, q2, 0.5f);
+		const POGL_FLOAT angles[2] = { fabsf(POGLDot(halfway, q1)), fabsf(POGLDot(halfway, q2)) };
+		slerp.CompareRelative(&angles[0], &angles[1], 1, QUATERNION_TOLERANCE);
+		const POGL_QUATF start = POGLSlerp(q1, q2, 0.0f);
+		const POGL_QUATF end = POGLNlerp(q1, q2, 1.0f);
+		const POGL_FLOAT endpoints[2] = { fabsf(POGLDot(start, q1)), fabsf(POGLDot(end, q2)) };
+		const POGL_FLOAT ones[2] = { 1.0f, 1.0f };
+		slerp.CompareRelative(endpoints, ones, 2, QUATERNION_TOLERANCE);
+	}
+
+	std::cout << "Inline math types:" << std::endl;
+	bool ok = true;
+	ok &= multiply.Print("POGL_MAT4F * POGL_MAT4F");
+	ok &= transpose.Print("POGLTranspose");
+	ok &= transformPoint.Print("POGLTransformPoint");
+	ok &= transformVector.Print("POGLTransformVector");
+	ok &= cross.Print("POGLCross");
+	ok &= compose.Print("POGLCompose");
+	ok &= decompose.Print("POGLDecompose");
+	ok &= rotate.Print("POGLRotate");
+	ok &= dualQuat.Print("POGL_DUALQUATF");
+	ok &= slerp.Print("POGLSlerp");
+	return ok;
+}
+
+/*!
+	\brief Verify mathematical properties that must hold for every instruction set, such as M * inverse(M) = I
+
+	Unlike the comparisons with the scalar version these also catch bugs in the scalar version itself
+
+	\return true if all properties hold
+*/
+bool VerifyProperties(POGLMathInstructionSet::Enum instructionSet)
+{
+	POGLMathSetInstructionSet(instructionSet);
+	std::mt19937 generator(8765);
+	std::uniform_real_distribution<POGL_FLOAT> angles(-360.0f, 360.0f);
+	const POGL_MAT4 identity;
+	const POGL_FLOAT zero = 0.0f;
+	const POGL_FLOAT one = 1.0f;
+
+	Result inverse, transposeInvolution, transposeProduct, crossOrthogonal, crossAntiCommutative, normalize, rotate, scale, translate;
+
+	for (POGL_UINT32 i = 0; i < NUM_SAMPLES; ++i) {
+		const POGL_MAT4 a = RandomMatrix(generator, false);
+		const POGL_MAT4 b = RandomMatrix(generator, false);
+		const POGL_MAT4 invertible = RandomMatrix(generator, true);
+		const POGL_VECTOR3 v1 = RandomVector(generator);
+		const POGL_VECTOR3 v2 = RandomVector(generator);
+
+		// inverse(M) * M = M * inverse(M) = I
+		POGL_MAT4 inverted, product;
+		if (POGLMat4Inverse(invertible, &inverted)) {
+			POGLMat4Multiply(inverted, invertible, &product);
+			inverse.CompareRelative(product.vec, identity.vec, 16, PROPERTY_TOLERANCE);
+			POGLMat4Multiply(invertible, inverted, &product);
+			inverse.CompareRelative(product.vec, identity.vec, 16, PROPERTY_TOLERANCE);
+		}
+		else
+			inverse.failures++;
+
+		// transpose(transpose(M)) = M
+		POGL_MAT4 transposed, transposedTwice;
+		POGLMat4Transpose(a, &transposed);
+		POGLMat4Transpose(transposed, &transposedTwice);
+		transposeInvolution.CompareUlps(transposedTwice.vec, a.vec, 16, 0);
+
+		// transpose(A * B) = transpose(B) * transpose(A)
+		POGL_MAT4 transposedA, transposedB, expected;
+		POGLMat4Multiply(a, b, &product);
+		POGLMat4Transpose(product, &expected);
+		POGLMat4Transpose(a, &transposedA);
+		POGLMat4Transpose(b, &transposedB);
+		POGLMat4Multiply(transposedB, transposedA, &product);
+		transposeProduct.CompareRelative(product.vec, expected.vec, 16, PROPERTY_TOLERANCE);
+
+		// The cross product is perpendicular to both vectors, relative to the length of the vectors
+		const POGL_VECTOR3 cross = POGLVec3Cross(v1, v2);
+		const POGL_FLOAT lengths = POGLVec3Length(v1) * POGLVec3Length(v2);
+		const POGL_FLOAT dots[2] = {
+			POGLDot(cross, v1) / (lengths * POGLVec3Length(v1)),
+			POGLDot(cross, v2) / (lengths * POGLVec3Length(v2))
+		};
+		const POGL_FLOAT zeros[2] = { 0.0f, 0.0f };
+		crossOrthogonal.CompareRelative(dots, zeros, 2, PROPERTY_TOLERANCE);
+
+		// v1 x v2 = -(v2 x v1)
+		const POGL_VECTOR3 negatedCross = -POGLVec3Cross(v2, v1);
+		crossAntiCommutative.CompareUlps(cross.vec, negatedCross.vec, 3, 0);
+
+		POGL_VECTOR3 normalized = v1;
+		POGLVec3Normalize(&normalized);
+		const POGL_FLOAT normalizedLength = POGLVec3Length(normalized);
+		normalize.CompareRelative(&normalizedLength, &one, 1, PROPERTY_TOLERANCE);
+
+		// A rotation matrix is orthonormal and keeps the length of the vectors
+		POGL_MAT4 rotation, rotationTransposed;
+		POGLMat4Rotate(angles(generator), v2, &rotation);
+		POGLMat4Transpose(rotation, &rotationTransposed);
+		POGLMat4Multiply(rotation, rotationTransposed, &product);
+		rotate.CompareRelative(product.vec, identity.vec, 16, PROPERTY_TOLERANCE);
+		POGL_VECTOR3 rotated;
+		POGLVec3TransformVectors(rotation, &v1, 1, &rotated);
+		const POGL_FLOAT lengthDifference = (POGLVec3Length(rotated) - POGLVec3Length(v1)) / POGLVec3Length(v1);
+		rotate.CompareRelative(&lengthDifference, &zero, 1, PROPERTY_TOLERANCE);
+
+		// Scaling the identity matrix gives a diagonal matrix
+		POGL_MAT4 scaled;
+		POGLMat4Scale(v1, &scaled);
+		const POGL_FLOAT diagonal[4] = { scaled.m[0][0], scaled.m[1][1], scaled.m[2][2], scaled.m[3][3] };
+		const POGL_FLOAT expectedDiagonal[4] = { v1.x, v1.y, v1.z, 1.0f };
+		scale.CompareUlps(diagonal, expectedDiagonal, 4, 0);
+
+		// Translating the identity matrix moves points by the supplied vector
+		POGL_MAT4 translated;
+		POGLMat4Translate(v1, &translated);
+		POGL_VECTOR3 moved;
+		POGLVec3TransformPoints(translated, &v2, 1, &moved);
+		const POGL_VECTOR3 expectedMoved(v2.x + v1.x, v2.y + v1.y, v2.z + v1.z);
+		translate.CompareUlps(moved.vec, expectedMoved.vec, 3, 0);
+	}
+
+	std::cout << "Properties (" << INSTRUCTION_SET_NAMES[instructionSet] << "):" << std::endl;
+	bool ok = true;
+	ok &= inverse.Print("inverse(M) * M = I");
+	ok &= transposeInvolution.Print("transpose(transpose(M)) = M");
+	ok &= transposeProduct.Print("transpose(A * B) = transpose(B) * transpose(A)");
+	ok &= crossOrthogonal.Print("(v1 x v2) . v1 = (v1 x v2) . v2 = 0");
+	ok &= crossAntiCommutative.Print("v1 x v2 = -(v2 x v1)");
+	ok &= normalize.Print("|normalize(v)| = 1");
+	ok &= rotate.Print("R * transpose(R) = I");
+	ok &= scale.Print("POGLMat4Scale");
+	ok &= translate.Print("POGLMat4Translate");
+	return ok;
+}
+
+/*!
+	\brief Verify the comparison operators of the POGL vector types
+
+	\return true if all operators behave as expected
+*/
+bool VerifyOperators()
+{
+	bool ok = true;
+	ok &= POGL_VECTOR2(1.0f, 2.0f) == POGL_VECTOR2(1.0f, 2.0f);
+	ok &= POGL_VECTOR2(1.0f, 2.0f) != POGL_VECTOR2(1.0f, 3.0f);
+	ok &= !(POGL_VECTOR2(1.0f, 2.0f) == POGL_VECTOR2(1.0f, 1.0f));
+	ok &= POGL_VECTOR3(1.0f, 2.0f, 3.0f) == POGL_VECTOR3(1.0f, 2.0f, 3.0f);
+	ok &= POGL_VECTOR3(1.0f, 2.0f, 3.0f) != POGL_VECTOR3(1.0f, 3.0f, 3.0f);
+	ok &= !(POGL_VECTOR3(1.0f, 2.0f, 3.0f) == POGL_VECTOR3(1.0f, 1.0f, 3.0f));
+	ok &= POGL_VECTOR3(1.0f, 2.0f, 3.0f) != POGL_VECTOR3(1.0f, 2.0f, 3.5f);
+	ok &= POGL_VECTOR4(1.0f, 2.0f, 3.0f, 4.0f) == POGL_VECTOR4(1.0f, 2.0f, 3.0f, 4.0f);
+	ok &= POGL_VECTOR4(1.0f, 2.0f, 3.0f, 4.0f) != POGL_VECTOR4(1.0f, 3.0f, 3.0f, 4.0f);
+	ok &= !(POGL_VECTOR4(1.0f, 2.0f, 3.0f, 4.0f) == POGL_VECTOR4(1.0f, 1.0f, 3.0f, 4.0f));
+	ok &= POGL_SIZE(640, 480) == POGL_SIZE(640, 480);
+	ok &= !(POGL_SIZE(640, 480) == POGL_SIZE(640, 400));
+	ok &= POGL_SIZE(640, 480) != POGL_SIZE(320, 480);
+	ok &= !(POGL_SIZE(640, 480) != POGL_SIZE(640, 480));
+
+	std::cout << "Comparison operators: " << (ok ? "OK" : "FAILED") << std::endl;
+	return ok;
+}
+
+int main()
+{
+	const POGLMathInstructionSet::Enum selected = POGLMathGetInstructionSet();
+	std::cout << "Selected instruction set: " << INSTRUCTION_SET_NAMES[selected] << std::endl;
+
+	bool ok = true;
+	for (POGL_UINT32 i = POGLMathInstructionSet::SCALAR + 1; i < POGLMathInstructionSet::COUNT; ++i) {
+		const POGLMathInstructionSet::Enum instructionSet = (POGLMathInstructionSet::Enum)i;
+		if (!POGLMathIsInstructionSetSupported(instructionSet)) {
+			std::cout << INSTRUCTION_SET_NAMES[i] << ": not supported" << std::endl;
+			continue;
+		}
+		ok &= Verify(instructionSet);
+	}
+
+	for (POGL_UINT32 i = POGLMathInstructionSet::SCALAR; i < POGLMathInstructionSet::COUNT; ++i) {
+		const POGLMathInstructionSet::Enum instructionSet = (POGLMathInstructionSet::Enum)i;
+		if (POGLMathIsInstructionSetSupported(instructionSet))
+			ok &= VerifyProperties(instructionSet);
+	}
+
+	// The threaded batch functions must give the same results as the single-threaded ones
+	POGLMathSetBatchThreads(4, 1000);
+	std::cout << "Batch functions on 4 threads:" << std::endl;
+	ok &= VerifyBatch(selected);
+	POGLMathSetBatchThreads(1, 0);
+
+	POGLMathSetInstructionSet(selected);
+	ok &= VerifyInline();
+	ok &= VerifyOperators();
+
+	std::cout << (ok ? "All math functions are correct" : "One or more math functions are incorrect") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -84,6 +84,8 @@ class POGLAPI IPOGLTexture;
 class POGLAPI IPOGLTexture1D;
 class POGLAPI IPOGLTexture2D;
 class POGLAPI IPOGLTexture3D;
+class POGLAPI IPOGLTexture2DArray;
+class POGLAPI IPOGLTextureCube;
 class POGLAPI IPOGLFramebuffer;
 
 class POGLAPI IPOGLShader;
@@ -144,6 +146,8 @@ struct POGLAPI POGLVendor
 struct POGLAPI POGLTextureFormat
 {
 	enum Enum {
+		/* Color and depth data is supplied with one byte per channel, including the float and depth formats. Use a
+		   POGLSourceFormat when creating or updating 2D textures to supply float data */
 		R = 0,
 		R16F,
 		R32F,
@@ -166,6 +170,16 @@ struct POGLAPI POGLTextureFormat
 		DEPTH24_STENCIL8,
 		DEPTH32F_STENCIL8,
 
+		/* Block compressed formats. The texture data is stored as 4x4 pixel blocks of 8 or 16 bytes each */
+		BC1_RGB,
+		BC1_RGBA,
+		BC3_RGBA,
+		BC4_R,
+		BC5_RG,
+		BC7_RGBA,
+		ETC2_RGB8,
+		ETC2_RGBA8,
+
 		/* Number of enums available */
 		COUNT
 	};
@@ -181,6 +195,48 @@ struct POGLAPI POGLPixelFormat
 	};
 };
 
+/*!
+	\brief The layout of pixel data supplied by the application
+*/
+struct POGLAPI POGLSourceFormat
+{
+	enum Enum {
+		/* One unsigned byte per channel */
+		R8 = 0,
+		RGB8,
+		RGBA8,
+		BGR8,
+		BGRA8,
+
+		/* One 32 bit float per channel */
+		R32F,
+		RGB32F,
+		RGBA32F,
+
+		/* Number of enums available */
+		COUNT
+	};
+};
+
+/*!
+	\brief Operations applied to the pixels while they are converted
+*/
+struct POGLAPI POGLConvertFlags
+{
+	enum Enum {
+		NONE = 0,
+
+		/* Decode sRGB encoded color channels into linear values. Alpha is never decoded */
+		SRGB_TO_LINEAR = BIT(0),
+
+		/* Encode linear color channels as sRGB. Alpha is never encoded */
+		LINEAR_TO_SRGB = BIT(1),
+
+		/* Multiply the color channels with alpha. This is done in linear space when combined with one of the sRGB flags */
+		PREMULTIPLY_ALPHA = BIT(2)
+	};
+};
+
 struct POGLAPI POGLClearType
 {
 	enum Enum {
@@ -255,6 +311,10 @@ struct POGLAPI POGLBufferUsage
 		/* Buffers that we stream data continously from the CPU */
 		STREAM,
 
+		/* Streaming buffer split into multiple regions. Each time the buffer is mapped after it's been drawn, the next region is used. 
+			The data is expected to be completely rewritten every time that happens. */
+		STREAM_RING,
+
 		/* Number of enums available */
 		COUNT
 	};
@@ -328,6 +388,30 @@ struct POGLAPI POGLMagFilter
 	static const Enum DEFAULT = LINEAR;
 };
 
+/* Allocate the full mipmap chain when creating a texture */
+static const POGL_UINT32 POGL_ALL_MIP_LEVELS = 0;
+
+/* Attach all layers of a texture to a framebuffer */
+static const POGL_UINT32 POGL_ALL_LAYERS = 0xFFFFFFFF;
+
+/*!
+	\brief The faces of a cube texture. The value is used as the layer index of the face
+*/
+struct POGLAPI POGLCubeFace
+{
+	enum Enum {
+		POSITIVE_X = 0,
+		NEGATIVE_X,
+		POSITIVE_Y,
+		NEGATIVE_Y,
+		POSITIVE_Z,
+		NEGATIVE_Z,
+
+		/* Number of enums available */
+		COUNT
+	};
+};
+
 /*!
 	\brief
 */
@@ -498,6 +582,38 @@ struct POGLAPI POGLResourceMapType
 	};
 };
 
+/*!
+	\brief How data written to a mapped buffer is uploaded to the graphics card
+*/
+struct POGLAPI POGLBufferUpdateStrategy
+{
+	enum Enum {
+		/* Choose the strategy based on how large, and how frequent, the updates to the buffer are. Might choose ORPHAN, so
+			only use it for buffers where every mapped range is rewritten completely */
+		ADAPTIVE = 0,
+
+		/* Map the buffer and let the driver synchronize it with the graphics card */
+		MAP,
+
+		/* Orphan the buffer storage, i.e. glBufferData(NULL), before mapping it. The content of the mapped range is undefined
+			until it's rewritten */
+		ORPHAN,
+
+		/* Write to client memory and upload it using glBufferSubData when the buffer is unmapped */
+		SUB_DATA,
+
+		/* Map the buffer without any synchronization. The buffer is guarded by fences instead */
+		UNSYNCHRONIZED,
+
+		/* The buffer is mapped persistently when it's created. Cannot be changed to or from */
+		PERSISTENT,
+
+		COUNT
+	};
+
+	static const Enum DEFAULT = MAP;
+};
+
 /*!
 	\brief Resource type enum
 */
@@ -509,6 +625,8 @@ struct POGLAPI POGLResourceType
 		TEXTURE1D,
 		TEXTURE2D,
 		TEXTURE3D,
+		TEXTURE2DARRAY,
+		TEXTURECUBE,
 		SHADER,
 		PROGRAM
 	};
@@ -579,12 +697,12 @@ struct POGLAPI POGL_VECTOR2
 	POGL_VECTOR2(const POGL_FLOAT _x, const POGL_FLOAT _y) : x(_x), y(_y) {}
 	POGL_VECTOR2(const POGL_VECTOR2& rhs) : x(rhs.x), y(rhs.y) {}
 
-	POGL_VECTOR2& operator=(const POGL_VECTOR2& rhs);
+	POGL_VECTOR2& operator=(const POGL_VECTOR2& rhs) { x = rhs.x; y = rhs.y; return *this; }
 	bool operator==(const POGL_VECTOR2& rhs) const;
 	bool operator!=(const POGL_VECTOR2& rhs) const;
-	POGL_VECTOR2 operator-() const;
-	POGL_FLOAT operator[](POGL_UINT32 idx) const;
-	POGL_FLOAT& operator[](POGL_UINT32 idx);
+	POGL_VECTOR2 operator-() const { return POGL_VECTOR2(-x, -y); }
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return vec[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return vec[idx]; }
 };
 
 typedef struct POGLAPI POGL_VECTOR3
@@ -607,12 +725,12 @@ typedef struct POGLAPI POGL_VECTOR3
 	POGL_VECTOR3(const POGL_FLOAT _x, const POGL_FLOAT _y, const POGL_FLOAT _z) : x(_x), y(_y), z(_z) {}
 	POGL_VECTOR3(const POGL_VECTOR3& rhs) : x(rhs.x), y(rhs.y), z(rhs.z) {}
 
-	POGL_VECTOR3& operator=(const POGL_VECTOR3& rhs);
+	POGL_VECTOR3& operator=(const POGL_VECTOR3& rhs) { x = rhs.x; y = rhs.y; z = rhs.z; return *this; }
 	bool operator==(const POGL_VECTOR3& rhs) const;
 	bool operator!=(const POGL_VECTOR3& rhs) const;
-	POGL_VECTOR3 operator-() const;
-	POGL_FLOAT operator[](POGL_UINT32 idx) const;
-	POGL_FLOAT& operator[](POGL_UINT32 idx);
+	POGL_VECTOR3 operator-() const { return POGL_VECTOR3(-x, -y, -z); }
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return vec[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return vec[idx]; }
 } POGL_COLOR3;
 
 typedef struct POGLAPI POGL_VECTOR4
@@ -637,12 +755,12 @@ typedef struct POGLAPI POGL_VECTOR4
 	POGL_VECTOR4(const POGL_FLOAT _x, const POGL_FLOAT _y, const POGL_FLOAT _z, const POGL_FLOAT _w) : x(_x), y(_y), z(_z), w(_w) {}
 	POGL_VECTOR4(const POGL_VECTOR4& rhs) : x(rhs.x), y(rhs.y), z(rhs.z), w(rhs.w) {}
 
-	POGL_VECTOR4& operator=(const POGL_VECTOR4& rhs);
+	POGL_VECTOR4& operator=(const POGL_VECTOR4& rhs) { x = rhs.x; y = rhs.y; z = rhs.z; w = rhs.w; return *this; }
 	bool operator==(const POGL_VECTOR4& rhs) const;
 	bool operator!=(const POGL_VECTOR4& rhs) const;
-	POGL_VECTOR4 operator-() const;
-	POGL_FLOAT operator[](POGL_UINT32 idx) const;
-	POGL_FLOAT& operator[](POGL_UINT32 idx);
+	POGL_VECTOR4 operator-() const { return POGL_VECTOR4(-x, -y, -z, -w); }
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return vec[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return vec[idx]; }
 } POGL_COLOR4;
 
 struct POGLAPI POGL_RECT
@@ -714,8 +832,8 @@ struct POGLAPI POGL_MAT4
 		_14(rhs._14), _24(rhs._24), _34(rhs._34), _44(rhs._44)
 	{}
 
-	POGL_FLOAT operator[](POGL_UINT32 idx) const;
-	POGL_FLOAT& operator[](POGL_UINT32 idx);
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return vec[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return vec[idx]; }
 };
 
 /*!
@@ -739,6 +857,79 @@ struct POGLAPI POGL_DEVICE_INFO
 	POGL_UINT8 flags;
 };
 
+/*!
+	\brief Runtime statistics collected by the device
+*/
+struct POGLAPI POGL_DEVICE_STATISTICS
+{
+	/* Number of frames ended by the device */
+	POGL_UINT32 frameCount;
+
+	/* Number of times the CPU had to wait for the GPU to finish using a buffer */
+	POGL_UINT32 bufferStallCount;
+
+	/* Total time, in milliseconds, the CPU has been waiting for the GPU to finish using a buffer */
+	POGL_DOUBLE bufferStallTime;
+};
+
+/*!
+	\brief Memory used by one type of resource
+*/
+struct POGLAPI POGL_RESOURCE_MEMORY_USAGE
+{
+	/* Number of resources with their data in graphics card memory */
+	POGL_UINT32 residentCount;
+
+	/* Graphics card memory, in bytes, used by the resident resources */
+	POGL_UINT64 residentMemory;
+
+	/* Number of resources evicted to system memory */
+	POGL_UINT32 evictedCount;
+
+	/* System memory, in bytes, holding the data of the evicted resources */
+	POGL_UINT64 evictedMemory;
+};
+
+/*!
+	\brief Memory used by the textures and buffers created by a device
+
+	The memory of a texture is calculated from its format and the size of all its mip levels. The driver might use more memory
+	than that, for example for padding.
+*/
+struct POGLAPI POGL_MEMORY_USAGE
+{
+	POGL_RESOURCE_MEMORY_USAGE textures;
+	POGL_RESOURCE_MEMORY_USAGE vertexBuffers;
+	POGL_RESOURCE_MEMORY_USAGE indexBuffers;
+
+	/* Graphics card memory, in bytes, used by all resident resources */
+	POGL_UINT64 residentMemory;
+
+	/* The memory budget in bytes. 0 if the memory usage is unlimited */
+	POGL_UINT64 budget;
+
+	/* Number of times a resource has been evicted to system memory */
+	POGL_UINT32 evictionCount;
+
+	/* Number of times an evicted resource has been uploaded to graphics card memory again */
+	POGL_UINT32 restoreCount;
+};
+
+/*!
+	\brief Thresholds used by buffers with the POGLBufferUpdateStrategy::ADAPTIVE strategy
+*/
+struct POGLAPI POGL_BUFFER_UPDATE_THRESHOLDS
+{
+	/* Updates smaller than, or equal to, this size (in bytes) are uploaded using glBufferSubData */
+	POGL_UINT32 subDataMaxSize;
+
+	/* Updates covering at least this part of the buffer (0.0 - 1.0) orphans the buffer storage */
+	POGL_FLOAT orphanMinRatio;
+
+	/* The average number of updates per frame before the buffer is mapped unsynchronized and guarded by fences */
+	POGL_FLOAT unsynchronizedMinFrequency;
+};
+
 /*!
 	\brief
 */
@@ -776,6 +967,56 @@ struct POGLAPI POGL_VERTEX_LAYOUT
 	POGL_UINT32 vertexSize;
 };
 
+/*!
+	\brief Describes a vertex buffer created using IPOGLRenderContext::CreateVertexBuffers
+*/
+struct POGLAPI POGL_VERTEX_BUFFER_DESC
+{
+	/* The vertex data. Can be nullptr */
+	const void* memory;
+
+	/* The size, in bytes, of the vertex data */
+	POGL_UINT32 memorySize;
+
+	/* How the vertex data is laid out */
+	const POGL_VERTEX_LAYOUT* layout;
+
+	/* How the vertices are drawn */
+	POGLPrimitiveType::Enum primitiveType;
+};
+
+/*!
+	\brief Describes a texture attached to a framebuffer created using IPOGLRenderContext::CreateFramebuffer
+*/
+struct POGLAPI POGL_FRAMEBUFFER_ATTACHMENT
+{
+	/* The texture */
+	IPOGLTexture* texture;
+
+	/* The mip level we render into */
+	POGL_UINT32 mipLevel;
+
+	/* The array layer, cube face or depth slice we render into. Use POGL_ALL_LAYERS to attach the entire texture */
+	POGL_UINT32 layer;
+
+	POGL_FRAMEBUFFER_ATTACHMENT() : texture(nullptr), mipLevel(0), layer(POGL_ALL_LAYERS) {}
+	POGL_FRAMEBUFFER_ATTACHMENT(IPOGLTexture* _texture, POGL_UINT32 _mipLevel, POGL_UINT32 _layer) : texture(_texture), mipLevel(_mipLevel), layer(_layer) {}
+};
+
+/*!
+	\brief Describes an index buffer created using IPOGLRenderContext::CreateIndexBuffers
+*/
+struct POGLAPI POGL_INDEX_BUFFER_DESC
+{
+	/* The index data. Can be nullptr */
+	const void* memory;
+
+	/* The size, in bytes, of the index data */
+	POGL_UINT32 memorySize;
+
+	/* The index type */
+	POGLVertexType::Enum type;
+};
 
 /*!
 	\brief Vertex containing a position
@@ -926,6 +1167,85 @@ public:
 		\brief Retrieves the vendor for the current computer
 	*/
 	virtual POGLVendor::Enum GetVendor() const = 0;
+
+	/*!
+		\brief Retrieves runtime statistics, such as how long the CPU has been stalled waiting for buffers used by the GPU
+
+		\param statistics
+				The structure to be filled with the statistics
+	*/
+	virtual void GetStatistics(POGL_DEVICE_STATISTICS* statistics) const = 0;
+
+	/*!
+		\brief Set the thresholds used by buffers with the POGLBufferUpdateStrategy::ADAPTIVE update strategy
+
+		Use this if you've calibrated the thresholds for the current driver. This method is not thread-safe and should be called before
+		any buffers are updated.
+
+		\param thresholds
+	*/
+	virtual void SetBufferUpdateThresholds(const POGL_BUFFER_UPDATE_THRESHOLDS* thresholds) = 0;
+
+	/*!
+		\brief Retrieves the thresholds used by buffers with the POGLBufferUpdateStrategy::ADAPTIVE update strategy
+	*/
+	virtual const POGL_BUFFER_UPDATE_THRESHOLDS* GetBufferUpdateThresholds() const = 0;
+
+	/*!
+		\brief Set how much graphics card memory the textures and buffers are allowed to use
+
+		When a frame ends and the resources use more memory than the budget, the least recently bound resources are evicted to system
+		memory until the usage is within the budget. Resources bound during the frame that just ended or bound to the render state,
+		framebuffer attachments and buffers that are persistently mapped or share memory with other buffers are never evicted.
+		An evicted resource is uploaded to the graphics card again the next time it's bound.
+
+		\param budget
+				The budget in bytes. Use 0, which is the default, for unlimited memory usage
+	*/
+	virtual void SetMemoryBudget(POGL_UINT64 budget) = 0;
+
+	/*!
+		\brief Retrieves the memory budget in bytes. 0 if the memory usage is unlimited
+	*/
+	virtual POGL_UINT64 GetMemoryBudget() const = 0;
+
+	/*!
+		\brief Fill the supplied structure with how much memory the textures and buffers use. This method is thread-safe
+
+		\param usage
+	*/
+	virtual void GetMemoryUsage(POGL_MEMORY_USAGE* usage) const = 0;
+
+	/*!
+		\brief Set the directory where linked program binaries are cached between runs
+
+		Programs created while the cache is enabled are loaded from the cache if they've been created before, with the same shader
+		source code and graphics driver, instead of being compiled and linked. Shaders are then compiled when a program using them
+		isn't found in the cache, which means that shader compilation errors are reported when the program is created. The cache
+		is ignored if the driver doesn't support GL_ARB_get_program_binary. This method is not thread-safe and should be called before
+		any shaders are created.
+
+		\param directory
+				An existing directory. Use nullptr, which is the default, to disable the cache
+	*/
+	virtual void SetProgramCacheDirectory(const POGL_CHAR* directory) = 0;
+
+	/*!
+		\brief Retrieves the directory where linked program binaries are cached. nullptr if the cache is disabled
+	*/
+	virtual const POGL_CHAR* GetProgramCacheDirectory() const = 0;
+
+	/*!
+		\brief Retrieves the ID of the uniform with the supplied name
+
+		The same ID is returned for the same name in all programs and render states, so resolve the names once, for example at
+		startup, and use IPOGLRenderState::FindUniformByID when rendering. This method is thread-safe.
+
+		\param name
+				The name of the uniform
+		\return A non-zero ID
+	*/
+	virtual POGL_UINT32 GetUniformID(const POGL_CHAR* name) = 0;
 };
 
 /*!
@@ -947,7 +1267,7 @@ public:
 		\param type
 				The shader type
 		\throws POGLResourceException
-				Exception thrown if the shader source code is not found or is invalid
+				Exception thrown if the shader source code is not found. Compile errors are reported when a program using the shader is created
 		\return A shader resource
 	*/
 	virtual IPOGLShader* CreateShaderFromFile(const POGL_CHAR* path, POGLShaderType::Enum type) = 0;
@@ -962,7 +1282,7 @@ public:
 		\param type
 				The shader type
 		\throws POGLResourceException
-				Exception thrown if the shader source code is invalid
+				Exception thrown if the memory is empty. Compile errors are reported when a program using the shader is created
 		\return A shader resource
 	*/
 	virtual IPOGLShader* CreateShaderFromMemory(const POGL_CHAR* memory, POGL_UINT32 size, POGLShaderType::Enum type) = 0;
@@ -985,9 +1305,34 @@ public:
 	virtual IPOGLProgram* CreateProgramFromShaders(IPOGLShader** shaders, POGL_UINT32 count) = 0;
 
 	/*!
-		\brief Creates a 3D texture
+		\brief Creates a GPU program based on the supplied shaders without waiting for it to be compiled and linked
+
+		The driver compiles and links the program in the background if it supports GL_KHR_parallel_shader_compile. Create all
+		programs up front and poll them with IPOGLProgram::IsReady to keep the render thread busy while they're being built. Compile
+		and link errors are thrown from IPOGLProgram::IsReady, IPOGLProgram::Wait or when the program is applied.
+
+		\param shaders
+				The shaders we want to link when creating the program
+		\param count
+				The number of shaders we want to link
+		\return A GPU program that you can use when render geometry onto the screen
 	*/
-	virtual IPOGLTexture1D* CreateTexture1D() = 0;
+	virtual IPOGLProgram* CreateProgramFromShadersAsync(IPOGLShader** shaders, POGL_UINT32 count) = 0;
+
+	/*!
+		\brief Creates a 1D texture with immutable storage
+
+		\param width
+				Texture width of the base level
+		\param format
+				Texture format. Compressed formats are not supported
+		\param mipLevels
+				The number of mip levels. Use POGL_ALL_MIP_LEVELS to allocate the full mipmap chain
+		\param bytes
+				Bytes containing the base level texture data. Can be nullptr
+		\return
+	*/
+	virtual IPOGLTexture1D* CreateTexture1D(POGL_UINT32 width, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes) = 0;
 
 	/*!
 		\brief Creates a 2D texture
@@ -1003,9 +1348,97 @@ public:
 	virtual IPOGLTexture2D* CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, const void* bytes) = 0;
 
 	/*!
-		\brief Creates a 3D texture
+		\brief Creates a 2D texture with immutable storage for a mipmap chain
+
+		The texture cannot be resized. Use UpdateTexture2DMipLevel or GenerateMipmaps to fill in the smaller mip levels.
+		Sampler uniforms use POGLMinFilter::DEFAULT, which only samples the base level, so set a mipmap min filter with
+		IPOGLUniform::SetMinFilter to sample the smaller mip levels.
+
+		\param size
+				Texture geometry size (width and height) of the base level
+		\param format
+				Texture format
+		\param mipLevels
+				The number of mip levels. Use POGL_ALL_MIP_LEVELS to allocate the full mipmap chain
+		\param bytes
+				Bytes containing the base level texture data. Can be nullptr
+		\return
 	*/
-	virtual IPOGLTexture3D* CreateTexture3D() = 0;
+	virtual IPOGLTexture2D* CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes) = 0;
+
+	/*!
+		\brief Creates a 2D texture with immutable storage from pixel data in a different layout than the texture format
+
+		The pixels are converted while they are copied into the memory the graphics card uploads them from.
+
+		\param size
+				Texture geometry size (width and height) of the base level
+		\param format
+				Texture format. Depth and compressed formats are not supported
+		\param mipLevels
+				The number of mip levels. Use POGL_ALL_MIP_LEVELS to allocate the full mipmap chain
+		\param srcFormat
+				The layout of the supplied pixels
+		\param bytes
+				The base level pixels. Can be nullptr
+		\param convertFlags
+				A combination of POGLConvertFlags
+		\return
+	*/
+	virtual IPOGLTexture2D* CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, POGLSourceFormat::Enum srcFormat,
+		const void* bytes, POGL_UINT32 convertFlags) = 0;
+
+	/*!
+		\brief Creates a 3D texture with immutable storage
+
+		\param size
+				Texture geometry size (width and height) of the base level
+		\param depth
+				Texture depth of the base level
+		\param format
+				Texture format. Compressed formats are not supported
+		\param mipLevels
+				The number of mip levels. Use POGL_ALL_MIP_LEVELS to allocate the full mipmap chain
+		\param bytes
+				Bytes containing the base level texture data, one depth slice after another. Can be nullptr
+		\return
+	*/
+	virtual IPOGLTexture3D* CreateTexture3D(const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes) = 0;
+
+	/*!
+		\brief Creates a 2D array texture with immutable storage
+
+		All layers are bound, and sampled in a shader, using one texture unit. Use this to put many textures of the same size
+		and format behind a single binding.
+
+		\param size
+				Texture geometry size (width and height) of the base level of each layer
+		\param layers
+				The number of layers
+		\param format
+				Texture format
+		\param mipLevels
+				The number of mip levels. Use POGL_ALL_MIP_LEVELS to allocate the full mipmap chain
+		\param bytes
+				Bytes containing the base level texture data, one layer after another. Can be nullptr
+		\return
+	*/
+	virtual IPOGLTexture2DArray* CreateTexture2DArray(const POGL_SIZE& size, POGL_UINT32 layers, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes) = 0;
+
+	/*!
+		\brief Creates a cube texture with immutable storage
+
+		\param size
+				The width and height of each face of the base level
+		\param format
+				Texture format
+		\param mipLevels
+				The number of mip levels. Use POGL_ALL_MIP_LEVELS to allocate the full mipmap chain
+		\param bytes
+				Bytes containing the base level texture data, one face after another in POGLCubeFace order. Can be nullptr
+		\return
+	*/
+	virtual IPOGLTextureCube* CreateTextureCube(POGL_UINT32 size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes) = 0;
 
 	/*!
 		\brief Resize the supplied texture
@@ -1017,6 +1450,83 @@ public:
 	*/
 	virtual void ResizeTexture2D(IPOGLTexture2D* texture, const POGL_SIZE& size) = 0;
 
+	/*!
+		\brief Upload new data for one of the mip levels in the supplied texture
+
+		\param texture
+				The texture we want to update
+		\param mipLevel
+				The mip level. The size of the level is max(1, width >> mipLevel) x max(1, height >> mipLevel)
+		\param bytes
+				Bytes containing the texture data for the entire mip level
+	*/
+	virtual void UpdateTexture2DMipLevel(IPOGLTexture2D* texture, POGL_UINT32 mipLevel, const void* bytes) = 0;
+
+	/*!
+		\brief Update a part of the supplied texture
+
+		The data is streamed to the graphics card through a ring of pixel unpack buffers. The call does not wait for the
+		graphics card to finish using the texture, which makes it suitable for video frames, glyph caches and lightmaps.
+
+		The rectangle of a compressed texture must start on a 4x4 block and end on a block or at the edge of the mip level.
+
+		\param texture
+				The texture we want to update
+		\param rect
+				The part of the mip level we want to update
+		\param mipLevel
+				The mip level
+		\param bytes
+				Tightly packed bytes containing the texture data for the rectangle
+	*/
+	virtual void UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, const void* bytes) = 0;
+
+	/*!
+		\brief Update a part of the supplied texture from pixel data in a different layout than the texture format
+
+		The pixels are converted straight into the ring of pixel unpack buffers, without any intermediate copy.
+
+		\param texture
+				The texture we want to update. Depth and compressed formats are not supported
+		\param rect
+				The part of the mip level we want to update
+		\param mipLevel
+				The mip level
+		\param srcFormat
+				The layout of the supplied pixels
+		\param bytes
+				Tightly packed pixels covering the rectangle
+		\param convertFlags
+				A combination of POGLConvertFlags
+	*/
+	virtual void UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, POGLSourceFormat::Enum srcFormat,
+		const void* bytes, POGL_UINT32 convertFlags) = 0;
+
+	/*!
+		\brief Upload new data for one layer of a mip level in the supplied texture
+
+		The layer is an array layer for 2D array textures, a POGLCubeFace for cube textures and a depth slice for 3D textures.
+		1D and 2D textures only have layer 0, which is the entire mip level.
+
+		\param texture
+				The texture we want to update
+		\param layer
+				The layer
+		\param mipLevel
+				The mip level
+		\param bytes
+				Bytes containing the texture data for the entire layer
+	*/
+	virtual void UpdateTextureLayer(IPOGLTexture* texture, POGL_UINT32 layer, POGL_UINT32 mipLevel, const void* bytes) = 0;
+
+	/*!
+		\brief Generate all mip levels from the base level of the supplied texture on the graphics card
+
+		\param texture
+				The texture we want to generate mipmaps for
+	*/
+	virtual void GenerateMipmaps(IPOGLTexture* texture) = 0;
+
 	/*!
 		\brief Creates a framebuffer that renders to the supplied textures
 
@@ -1049,6 +1559,21 @@ public:
 	*/
 	virtual IPOGLFramebuffer* CreateFramebuffer(IPOGLTexture** textures, POGL_UINT32 count, IPOGLTexture* depthStencilTexture) = 0;
 
+	/*!
+		\brief Creates a framebuffer rendering into specific mip levels and layers of the supplied textures
+
+		Use this to render into one layer of a 2D array texture, one face of a cube texture or one slice of a 3D texture.
+
+		\param attachments
+				The color attachments
+		\param count
+				The number of color attachments
+		\param depthStencil
+				The depth- and/or stencil attachment. Can be nullptr
+		\return
+	*/
+	virtual IPOGLFramebuffer* CreateFramebuffer(const POGL_FRAMEBUFFER_ATTACHMENT* attachments, POGL_UINT32 count, const POGL_FRAMEBUFFER_ATTACHMENT* depthStencil) = 0;
+
 	/*!
 		\brief Creates a vertex buffer based on the supplied parameters
 
@@ -1104,6 +1629,40 @@ public:
 	*/
 	virtual IPOGLIndexBuffer* CreateIndexBuffer(const void* memory, POGL_UINT32 memorySize, POGLVertexType::Enum type, POGLBufferUsage::Enum bufferUsage) = 0;
 
+	/*!
+		\brief Creates multiple vertex buffers at once
+
+		The vertex buffers share one, or a few, internal buffers and all the vertex data is uploaded to the graphics card 
+		through a single staging buffer. Use this when loading a large amount of geometry at once, for example when loading a level.
+
+		\param descs
+				An array describing each vertex buffer
+		\param count
+				The number of vertex buffers
+		\param bufferUsage
+				The buffer usage for all vertex buffers. POGLBufferUsage::STREAM_RING is not allowed
+		\param _out_vertexBuffers
+				An array, with at least count elements, where the created vertex buffers are put into
+	*/
+	virtual void CreateVertexBuffers(const POGL_VERTEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLVertexBuffer** _out_vertexBuffers) = 0;
+
+	/*!
+		\brief Creates multiple index buffers at once
+
+		The index buffers share one, or a few, internal buffers and all the index data is uploaded to the graphics card 
+		through a single staging buffer.
+
+		\param descs
+				An array describing each index buffer
+		\param count
+				The number of index buffers
+		\param bufferUsage
+				The buffer usage for all index buffers. POGLBufferUsage::STREAM_RING is not allowed
+		\param _out_indexBuffers
+				An array, with at least count elements, where the created index buffers are put into
+	*/
+	virtual void CreateIndexBuffers(const POGL_INDEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLIndexBuffer** _out_indexBuffers) = 0;
+
 	/*!
 		\brief Clones the supplied resource and returns a new resource based of it
 
@@ -1324,6 +1883,32 @@ public:
 class POGLAPI IPOGLProgram : public IPOGLResource
 {
 public:
+	/*!
+		\brief Check to see if the program has been compiled and linked
+
+		This method only avoids blocking if the driver supports GL_KHR_parallel_shader_compile or
+		GL_ARB_parallel_shader_compile. Without it, this method waits for the program to be compiled and linked, just like
+		IPOGLProgram::Wait.
+
+		Programs created with IPOGLRenderContext::CreateProgramFromShaders on the immediate render context are always ready.
+		Must be called from the thread that owns the immediate render context.
+
+		\throws POGLResourceException
+				If a shader could not be compiled or the program could not be linked
+	*/
+	virtual bool IsReady() = 0;
+
+	/*!
+		\brief Wait for the program to be compiled and linked
+
+		Must be called from the thread that owns the immediate render context. Programs created by a deferred render context
+		must have been executed first.
+
+		\throws POGLResourceException
+				If a shader could not be compiled or the program could not be linked
+	*/
+	virtual void Wait() = 0;
+
 	/*!
 		\brief Locate the uniform with the given name
 	*/
@@ -1470,6 +2055,21 @@ public:
 	*/
 	virtual IPOGLUniform* FindUniformByName(const POGL_CHAR* name) = 0;
 
+	/*!
+		\brief Locate the uniform with the given ID
+
+		This is an array lookup, so prefer it over FindUniformByName for uniforms that are set every frame.
+		{@code
+			const POGL_UINT32 modelMatrixID = device->GetUniformID(POGL_TOCHAR("ModelMatrix"));
+			...
+			state->FindUniformByID(modelMatrixID)->SetMatrix(modelMatrix);
+		}
+
+		\param uniformID
+				An ID returned by IPOGLDevice::GetUniformID
+	*/
+	virtual IPOGLUniform* FindUniformByID(POGL_UINT32 uniformID) = 0;
+
 	/*!
 		\brief Set the framebuffer used when render to this frame
 	*/
@@ -1612,6 +2212,11 @@ public:
 		\brief Retrieves the texture color format for this texture
 	*/
 	virtual POGLTextureFormat::Enum GetTextureFormat() const = 0;
+
+	/*!
+		\brief Retrieves the number of mip levels in this texture
+	*/
+	virtual POGL_UINT32 GetMipLevels() const = 0;
 };
 
 /*!
@@ -1644,6 +2249,9 @@ public:
 class POGLAPI IPOGLTexture3D : public IPOGLTexture
 {
 public:
+	/*!
+		\brief Retrieves the depth of this texture in pixels
+	*/
 	virtual POGL_UINT32 GetDepth() const = 0;
 
 	/*!
@@ -1652,6 +2260,35 @@ public:
 	virtual const POGL_SIZE& GetSize() const = 0;
 };
 
+/*!
+	\brief An array of 2D textures with the same size and format
+*/
+class POGLAPI IPOGLTexture2DArray : public IPOGLTexture
+{
+public:
+	/*!
+		\brief Retrieves the size (width and height) of each layer in pixels
+	*/
+	virtual const POGL_SIZE& GetSize() const = 0;
+
+	/*!
+		\brief Retrieves the number of layers in this texture
+	*/
+	virtual POGL_UINT32 GetLayers() const = 0;
+};
+
+/*!
+	\brief A texture consisting of six square faces
+*/
+class POGLAPI IPOGLTextureCube : public IPOGLTexture
+{
+public:
+	/*!
+		\brief Retrieves the width and height of each face in pixels
+	*/
+	virtual POGL_UINT32 GetSize() const = 0;
+};
+
 /*!
 	\brief
 */
@@ -1696,6 +2333,22 @@ public:
 		\brief Retrieves the memory size of this vertex buffer
 	*/
 	virtual POGL_UINT32 GetMemorySize() const = 0;
+
+	/*!
+		\brief Set how data written to this buffer is uploaded to the graphics card
+
+		Buffers created with POGLBufferUsage::STREAM_RING, or buffers that are persistently mapped, ignores this value.
+
+		\param strategy
+	*/
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy) = 0;
+
+	/*!
+		\brief Retrieves the update strategy currently used by this buffer.
+
+		If the POGLBufferUpdateStrategy::ADAPTIVE strategy is set then the strategy that has been selected for this buffer is returned
+	*/
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const = 0;
 };
 
 /*!
@@ -1708,6 +2361,22 @@ public:
 		\brief Retrieves the number of elements found in this buffer
 	*/
 	virtual POGL_UINT32 GetCount() const = 0;
+
+	/*!
+		\brief Set how data written to this buffer is uploaded to the graphics card
+
+		Buffers created with POGLBufferUsage::STREAM_RING, or buffers that are persistently mapped, ignores this value.
+
+		\param strategy
+	*/
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy) = 0;
+
+	/*!
+		\brief Retrieves the update strategy currently used by this buffer.
+
+		If the POGLBufferUpdateStrategy::ADAPTIVE strategy is set then the strategy that has been selected for this buffer is returned
+	*/
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const = 0;
 };
 
 /*!
@@ -1718,6 +2387,73 @@ public:
 */
 extern POGLAPI IPOGLDevice* POGLCreateDevice(const POGL_DEVICE_INFO* info);
 
+//
+// Files
+//
+
+/*!
+	\brief Maps a file into the address space of the process in read-only mode
+
+	The file is unmapped when the instance is destroyed, which means that the memory must not be used after that.
+*/
+class POGLAPI POGLMappedFile
+{
+public:
+	/*!
+		\throws POGLResourceException
+				If the file could not be opened or mapped
+	*/
+	POGLMappedFile(const POGL_CHAR* fileName);
+	~POGLMappedFile();
+
+	/*!
+		\brief Retrieves a pointer to the beginning of the file. nullptr if the file is empty
+	*/
+	inline const POGL_BYTE* GetBytes() const {
+		return mBytes;
+	}
+
+	/*!
+		\brief Retrieves the size of the file in bytes
+	*/
+	inline POGL_UINT32 GetSize() const {
+		return mSize;
+	}
+
+private:
+	POGLMappedFile(const POGLMappedFile&);
+	POGLMappedFile& operator=(const POGLMappedFile&);
+
+	const POGL_BYTE* mBytes;
+	POGL_UINT32 mSize;
+};
+
+//
+// Pixels
+//
+
+/*!
+	\brief Convert pixels from the supplied source layout into the layout a texture format is stored in
+
+	R16F and RGBA16F are written as 16 bit half floats, R32F and RGBA32F as 32 bit floats and the other formats with one byte
+	per channel. Channels missing in the source are set to 0, except for alpha which is set to 1. Float values are clamped to
+	[0, 1] when converted to bytes.
+
+	\param src
+			The source pixels
+	\param srcFormat
+	\param dst
+			Memory where the converted pixels are written
+	\param dstFormat
+			Texture format. Depth and compressed formats are not supported
+	\param numPixels
+			The number of pixels to convert
+	\param convertFlags
+			A combination of POGLConvertFlags
+*/
+extern POGLAPI void POGLConvertPixels(const void* src, POGLSourceFormat::Enum srcFormat, void* dst, POGLTextureFormat::Enum dstFormat,
+	POGL_UINT32 numPixels, POGL_UINT32 convertFlags);
+
 //
 // Exceptions
 //
@@ -40,9 +40,38 @@ public:
 	*/
 	virtual void Unmap() = 0;
 
+	/*!
+		\brief Retrieves the offset, in bytes, to the memory region that draw calls should read from.
+
+		Only buffers split into multiple regions, or buffers sharing memory with other buffers, returns anything other than 0
+	*/
+	virtual POGL_UINT32 GetRegionOffset() const = 0;
+
+	/*!
+		\brief Set how data written to this buffer is uploaded to the graphics card
+	*/
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy) = 0;
+
+	/*!
+		\brief Retrieves the strategy used when uploading data to the graphics card
+	*/
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const = 0;
+
 	virtual void Lock() = 0;
 
 	virtual void Lock(POGL_UINT32 offset, POGL_UINT32 length) = 0;
 
 	virtual void Unlock() = 0;
+
+	/*!
+		\brief Copy the buffer data to system memory and release the graphics card memory. The buffer ID stays valid
+
+		\return false if the buffer cannot be evicted
+	*/
+	virtual bool Evict() = 0;
+
+	/*!
+		\brief Upload the data copied to system memory by Evict back into graphics card memory
+	*/
+	virtual void Restore() = 0;
 };
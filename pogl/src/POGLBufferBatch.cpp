@@ -0,0 +1,89 @@
+#include "MemCheck.h"
+#include "POGLBufferBatch.h"
+#include "POGLEnum.h"
+#include "providers/POGLSharedBufferResource.h"
+
+POGLBufferBatch::POGLBufferBatch(GLenum target, POGLBufferUsage::Enum bufferUsage)
+: mTarget(target), mBufferUsage(bufferUsage)
+{
+}
+
+POGLBufferBatch::~POGLBufferBatch()
+{
+	const POGL_UINT32 numBuffers = (POGL_UINT32)mBuffers.size();
+	for (POGL_UINT32 i = 0; i < numBuffers; ++i) {
+		mBuffers[i]->Release();
+	}
+	mBuffers.clear();
+}
+
+IPOGLBufferResource* POGLBufferBatch::Allocate(POGL_UINT32 memorySize, POGL_UINT32 alignment)
+{
+	// Start on a new buffer if the current one becomes too large
+	if (mBuffers.empty() || (mBuffers.back()->GetMemorySize() > 0 && mBuffers.back()->GetMemorySize() + alignment + memorySize > MAX_BUFFER_SIZE)) {
+		mBuffers.push_back(new POGLSharedBuffer());
+	}
+
+	POGLSharedBuffer* buffer = mBuffers.back();
+	Allocation allocation;
+	allocation.buffer = (POGL_UINT32)mBuffers.size() - 1;
+	allocation.offset = buffer->Reserve(memorySize, alignment);
+	allocation.memorySize = memorySize;
+	mAllocations.push_back(allocation);
+	return new POGLSharedBufferResource(buffer, allocation.offset, memorySize, mTarget);
+}
+
+void POGLBufferBatch::PostConstruct(const void* const* memory)
+{
+	const POGL_UINT32 numBuffers = (POGL_UINT32)mBuffers.size();
+	if (numBuffers == 0)
+		return;
+
+	//
+	// Generate all buffer names, including the staging buffer, at once. The staging buffer contains all
+	// shared buffers laid out after each other
+	//
+
+	std::vector<GLuint> bufferIDs(numBuffers + 1);
+	std::vector<POGL_UINT32> stagingOffsets(numBuffers);
+	glGenBuffers(numBuffers + 1, &bufferIDs[0]);
+
+	POGL_UINT32 stagingSize = 0;
+	for (POGL_UINT32 i = 0; i < numBuffers; ++i) {
+		stagingOffsets[i] = stagingSize;
+		stagingSize += mBuffers[i]->GetMemorySize();
+	}
+
+	const GLuint stagingBufferID = bufferIDs[numBuffers];
+	glBindBuffer(GL_COPY_READ_BUFFER, stagingBufferID);
+	glBufferData(GL_COPY_READ_BUFFER, stagingSize, nullptr, GL_STREAM_DRAW);
+	POGL_BYTE* staging = (POGL_BYTE*)glMapBufferRange(GL_COPY_READ_BUFFER, 0, stagingSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (staging == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "Could not map the staging buffer. Reason: 0x%x", glGetError());
+
+	const POGL_UINT32 numAllocations = (POGL_UINT32)mAllocations.size();
+	for (POGL_UINT32 i = 0; i < numAllocations; ++i) {
+		if (memory[i] == nullptr)
+			continue;
+		const Allocation& allocation = mAllocations[i];
+		memcpy(staging + stagingOffsets[allocation.buffer] + allocation.offset, memory[i], allocation.memorySize);
+	}
+	glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+	//
+	// Copy the staging memory into the shared buffers
+	//
+
+	const GLenum usage = POGLEnum::Convert(mBufferUsage);
+	for (POGL_UINT32 i = 0; i < numBuffers; ++i) {
+		const POGL_UINT32 memorySize = mBuffers[i]->GetMemorySize();
+		glBindBuffer(GL_COPY_WRITE_BUFFER, bufferIDs[i]);
+		glBufferData(GL_COPY_WRITE_BUFFER, memorySize, nullptr, usage);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, stagingOffsets[i], 0, memorySize);
+		mBuffers[i]->PostConstruct(bufferIDs[i]);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glDeleteBuffers(1, &stagingBufferID);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "config.h"
+#include "IPOGLBufferResource.h"
+#include <vector>
+
+class POGLSharedBuffer;
+
+/*!
+	\brief Allocates multiple buffer resources from one, or a few, shared OpenGL buffers
+
+	All buffer names are generated with one glGenBuffers call and the data is uploaded to the graphics card through a single staging buffer
+*/
+class POGLBufferBatch
+{
+	struct Allocation {
+		POGL_UINT32 buffer;
+		POGL_UINT32 offset;
+		POGL_UINT32 memorySize;
+	};
+
+public:
+	/* The maximum size of a shared OpenGL buffer */
+	static const POGL_UINT32 MAX_BUFFER_SIZE = 32 * 1024 * 1024;
+
+	POGLBufferBatch(GLenum target, POGLBufferUsage::Enum bufferUsage);
+	~POGLBufferBatch();
+
+	/*!
+		\brief Allocate a new buffer resource
+
+		\param memorySize
+				The size of the buffer resource
+		\param alignment
+				The offset of the resource in the shared buffer is a multiple of this value
+		\return A buffer resource. The caller is responsible for releasing it
+	*/
+	IPOGLBufferResource* Allocate(POGL_UINT32 memorySize, POGL_UINT32 alignment);
+
+	/*!
+		\brief Create the shared OpenGL buffers and upload the supplied data
+
+		\param memory
+				The data for each allocated resource, in the same order as they are allocated. Elements can be nullptr
+	*/
+	void PostConstruct(const void* const* memory);
+
+	/*!
+		\brief Retrieves the number of allocated resources
+	*/
+	inline POGL_UINT32 GetCount() const {
+		return (POGL_UINT32)mAllocations.size();
+	}
+
+private:
+	GLenum mTarget;
+	POGLBufferUsage::Enum mBufferUsage;
+	std::vector<POGLSharedBuffer*> mBuffers;
+	std::vector<Allocation> mAllocations;
+};
@@ -0,0 +1,589 @@
+#include "MemCheck.h"
+#include "POGLConvertPixels.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+	struct POGLChannelType
+	{
+		enum Enum {
+			BYTE = 0,
+			HALF_FLOAT,
+			FLOAT
+		};
+	};
+
+	/*!
+		\brief How the pixels of a format are laid out in memory
+	*/
+	struct POGLPixelLayout
+	{
+		POGL_UINT32 channels;
+		POGLChannelType::Enum type;
+
+		// The red and blue channels are swapped
+		bool bgr;
+
+		POGL_UINT32 GetBytesPerPixel() const {
+			static const POGL_UINT32 CHANNEL_SIZES[] = { 1, 2, 4 };
+			return channels * CHANNEL_SIZES[type];
+		}
+
+		bool operator==(const POGLPixelLayout& rhs) const {
+			return channels == rhs.channels && type == rhs.type && bgr == rhs.bgr;
+		}
+	};
+
+	// Number of pixels converted at a time when the conversion goes through floating point values
+	static const POGL_UINT32 BLOCK_SIZE = 64;
+
+	POGLPixelLayout POGLGetSourceLayout(POGLSourceFormat::Enum format)
+	{
+		static const POGLPixelLayout LAYOUTS[POGLSourceFormat::COUNT] = {
+			{ 1, POGLChannelType::BYTE, false },
+			{ 3, POGLChannelType::BYTE, false },
+			{ 4, POGLChannelType::BYTE, false },
+			{ 3, POGLChannelType::BYTE, true },
+			{ 4, POGLChannelType::BYTE, true },
+			{ 1, POGLChannelType::FLOAT, false },
+			{ 3, POGLChannelType::FLOAT, false },
+			{ 4, POGLChannelType::FLOAT, false }
+		};
+
+		if ((POGL_UINT32)format >= POGLSourceFormat::COUNT)
+			THROW_EXCEPTION(POGLResourceException, "Unknown source format: %d", format);
+		return LAYOUTS[format];
+	}
+
+	/*!
+		\brief Retrieves the layout of the converted pixels uploaded to textures with the supplied format. This is the layout
+			described by POGLEnum::ConvertToNativeTextureTypeEnum
+	*/
+	POGLPixelLayout POGLGetTextureLayout(POGLTextureFormat::Enum format)
+	{
+		POGLPixelLayout layout = { 4, POGLChannelType::BYTE, false };
+		switch (format) {
+		case POGLTextureFormat::R:
+			layout.channels = 1;
+			break;
+		case POGLTextureFormat::R16F:
+			layout.channels = 1;
+			layout.type = POGLChannelType::HALF_FLOAT;
+			break;
+		case POGLTextureFormat::R32F:
+			layout.channels = 1;
+			layout.type = POGLChannelType::FLOAT;
+			break;
+		case POGLTextureFormat::RGB:
+		case POGLTextureFormat::RGB8:
+		case POGLTextureFormat::RGB12:
+		case POGLTextureFormat::RGB16:
+			layout.channels = 3;
+			break;
+		case POGLTextureFormat::RGBA:
+		case POGLTextureFormat::RGBA8:
+		case POGLTextureFormat::RGBA12:
+		case POGLTextureFormat::RGBA16:
+		case POGLTextureFormat::RGB10_A2:
+			break;
+		case POGLTextureFormat::RGBA16F:
+			layout.type = POGLChannelType::HALF_FLOAT;
+			break;
+		case POGLTextureFormat::RGBA32F:
+			layout.type = POGLChannelType::FLOAT;
+			break;
+		case POGLTextureFormat::BGR:
+			layout.channels = 3;
+			layout.bgr = true;
+			break;
+		case POGLTextureFormat::BGRA:
+			layout.bgr = true;
+			break;
+		default:
+			THROW_EXCEPTION(POGLResourceException, "Pixels cannot be converted into the texture format: %d", format);
+		}
+		return layout;
+	}
+
+	inline POGL_FLOAT POGLSRGBToLinear(POGL_FLOAT c)
+	{
+		return c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+	}
+
+	inline POGL_FLOAT POGLLinearToSRGB(POGL_FLOAT c)
+	{
+		return c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+	}
+
+	/*!
+		\brief Lookup tables for converting 8 bit channels
+	*/
+	struct POGLChannelTables
+	{
+		// Byte to a float in the range [0, 1]
+		POGL_FLOAT toFloat[256];
+
+		// sRGB encoded byte to a linear float
+		POGL_FLOAT srgbToLinear[256];
+
+		// sRGB encoded byte to a linear byte
+		POGL_BYTE srgbToLinear8[256];
+
+		// Linear byte to a sRGB encoded byte
+		POGL_BYTE linearToSRGB8[256];
+
+		POGLChannelTables() {
+			for (POGL_UINT32 i = 0; i < 256; ++i) {
+				toFloat[i] = i / 255.0f;
+				srgbToLinear[i] = POGLSRGBToLinear(toFloat[i]);
+				srgbToLinear8[i] = (POGL_BYTE)(srgbToLinear[i] * 255.0f + 0.5f);
+				linearToSRGB8[i] = (POGL_BYTE)(POGLLinearToSRGB(toFloat[i]) * 255.0f + 0.5f);
+			}
+		}
+	};
+
+	const POGLChannelTables& POGLGetChannelTables()
+	{
+		static const POGLChannelTables tables;
+		return tables;
+	}
+
+	inline POGL_UINT32 POGLFloatBits(POGL_FLOAT f)
+	{
+		POGL_UINT32 u;
+		memcpy(&u, &f, sizeof(u));
+		return u;
+	}
+
+	inline POGL_FLOAT POGLBitsFloat(POGL_UINT32 u)
+	{
+		POGL_FLOAT f;
+		memcpy(&f, &u, sizeof(f));
+		return f;
+	}
+
+	/*!
+		\brief Convert a float into a half float, rounding to nearest even. Values too large for a half float become infinity
+	*/
+	POGL_UINT16 POGLFloatToHalf(POGL_FLOAT value)
+	{
+		static const POGL_UINT32 F32_INFINITY = 255 << 23;
+		static const POGL_UINT32 F16_MAX = (127 + 16) << 23;
+		static const POGL_UINT32 MIN_NORMAL = (127 - 14) << 23;
+		static const POGL_UINT32 SUBNORMAL_MAGIC = ((127 - 15) + (23 - 10) + 1) << 23;
+
+		POGL_UINT32 u = POGLFloatBits(value);
+		const POGL_UINT32 sign = u & 0x80000000U;
+		u ^= sign;
+
+		POGL_UINT32 result;
+		if (u >= F16_MAX) {
+			// NaN stays NaN and everything else becomes infinity
+			result = u > F32_INFINITY ? 0x7E00 : 0x7C00;
+		}
+		else if (u < MIN_NORMAL) {
+			// The float addition aligns and rounds the mantissa of the subnormal half float
+			result = POGLFloatBits(POGLBitsFloat(u) + POGLBitsFloat(SUBNORMAL_MAGIC)) - SUBNORMAL_MAGIC;
+		}
+		else {
+			const POGL_UINT32 mantissaOdd = (u >> 13) & 1;
+			u += ((POGL_UINT32)(15 - 127) << 23) + 0xFFF;
+			u += mantissaOdd;
+			result = u >> 13;
+		}
+		return (POGL_UINT16)(result | (sign >> 16));
+	}
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+	/*!
+		\brief Swap the first and third channel of four 32 bit pixels
+	*/
+	inline __m128i POGLSwizzle32(__m128i pixels)
+	{
+		const __m128i mask = _mm_set1_epi32(0xFF00FF00);
+		const __m128i rb = _mm_andnot_si128(mask, pixels);
+		return _mm_or_si128(_mm_and_si128(pixels, mask), _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16)));
+	}
+
+	/*!
+		\brief Convert four floats into half floats. The result is stored in the low 16 bits of each 32 bit value,
+			sign extended so that it can be packed using _mm_packs_epi32
+	*/
+	inline __m128i POGLFloatToHalf4(__m128 value)
+	{
+		const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+		const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+		const __m128 sign = _mm_and_ps(_mm_castsi128_ps(_mm_set1_epi32(0x80000000)), value);
+		const __m128 absValue = _mm_xor_ps(value, sign);
+		const __m128i absBits = _mm_castps_si128(absValue);
+
+		// Infinity or NaN
+		const __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absValue, absValue));
+		const __m128i special = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+		const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absBits);
+
+		// Subnormal
+		const __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absBits);
+		const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absValue, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+		// Normal, rounded to nearest even
+		const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);
+		const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), mantissaOdd), 13);
+
+		const __m128i regular = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		const __m128i result = _mm_or_si128(_mm_and_si128(isRegular, regular), _mm_andnot_si128(isRegular, special));
+		const __m128i half = _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+		return _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+	}
+
+	/*!
+		\brief Multiply the color channels of four 32 bit RGBA pixels with their alpha channel
+	*/
+	inline __m128i POGLPremultiply32(__m128i pixels)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i bias = _mm_set1_epi16(128);
+		const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+
+		__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+		__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+		const __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		const __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+		// (c * a + 128 + ((c * a + 128) >> 8)) >> 8 is c * a / 255 rounded to nearest
+		lo = _mm_add_epi16(_mm_mullo_epi16(lo, alphaLo), bias);
+		hi = _mm_add_epi16(_mm_mullo_epi16(hi, alphaHi), bias);
+		lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+		const __m128i result = _mm_packus_epi16(lo, hi);
+		return _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(pixels, alphaMask));
+	}
+#endif
+
+	inline POGL_BYTE POGLPremultiply(POGL_UINT32 c, POGL_UINT32 a)
+	{
+		const POGL_UINT32 t = c * a + 128;
+		return (POGL_BYTE)((t + (t >> 8)) >> 8);
+	}
+
+	inline POGL_BYTE POGLFloatToByte(POGL_FLOAT value)
+	{
+		return (POGL_BYTE)((std::min)((std::max)(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+	}
+
+	/*!
+		\brief Convert between two byte layouts without going through floating point values
+	*/
+	void POGLConvertBytes(const POGL_BYTE* src, const POGLPixelLayout& srcLayout, POGL_BYTE* dst, const POGLPixelLayout& dstLayout,
+		POGL_UINT32 numPixels, POGL_UINT32 flags)
+	{
+		const POGLChannelTables& tables = POGLGetChannelTables();
+		const bool premultiply = (flags & POGLConvertFlags::PREMULTIPLY_ALPHA) != 0;
+		const POGL_BYTE* decode = (flags & POGLConvertFlags::SRGB_TO_LINEAR) ? tables.srgbToLinear8 : nullptr;
+		const POGL_BYTE* encode = (flags & POGLConvertFlags::LINEAR_TO_SRGB) ? tables.linearToSRGB8 : nullptr;
+		POGL_UINT32 i = 0;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+		const bool swizzle = srcLayout.bgr != dstLayout.bgr;
+		if (srcLayout.channels == 4 && dstLayout.channels == 4 && decode == nullptr && encode == nullptr) {
+			for (; i + 4 <= numPixels; i += 4) {
+				__m128i pixels = _mm_loadu_si128((const __m128i*)(src + i * 4));
+				if (swizzle)
+					pixels = POGLSwizzle32(pixels);
+				if (premultiply)
+					pixels = POGLPremultiply32(pixels);
+				_mm_storeu_si128((__m128i*)(dst + i * 4), pixels);
+			}
+		}
+#endif
+
+		const POGL_UINT32 srcRed = srcLayout.bgr ? 2 : 0;
+		const POGL_UINT32 dstRed = dstLayout.bgr ? 2 : 0;
+		for (; i < numPixels; ++i) {
+			const POGL_BYTE* s = src + i * srcLayout.channels;
+			POGL_BYTE* d = dst + i * dstLayout.channels;
+
+			POGL_BYTE rgba[4] = { s[0], 0, 0, 255 };
+			if (srcLayout.channels >= 3) {
+				rgba[0] = s[srcRed];
+				rgba[1] = s[1];
+				rgba[2] = s[2 - srcRed];
+				if (srcLayout.channels == 4)
+					rgba[3] = s[3];
+			}
+
+			if (decode != nullptr) {
+				for (POGL_UINT32 c = 0; c < 3; ++c)
+					rgba[c] = decode[rgba[c]];
+			}
+
+			if (premultiply) {
+				for (POGL_UINT32 c = 0; c < 3; ++c)
+					rgba[c] = POGLPremultiply(rgba[c], rgba[3]);
+			}
+
+			if (encode != nullptr) {
+				for (POGL_UINT32 c = 0; c < 3; ++c)
+					rgba[c] = encode[rgba[c]];
+			}
+
+			d[0] = rgba[0];
+			if (dstLayout.channels >= 3) {
+				d[dstRed] = rgba[0];
+				d[1] = rgba[1];
+				d[2 - dstRed] = rgba[2];
+				if (dstLayout.channels == 4)
+					d[3] = rgba[3];
+			}
+		}
+	}
+
+	/*!
+		\brief Read pixels into floating point RGBA values, decoding sRGB if requested
+	*/
+	void POGLReadPixels(const POGL_BYTE* src, const POGLPixelLayout& layout, POGL_UINT32 count, POGL_FLOAT* rgba, POGL_UINT32 flags)
+	{
+		const bool decode = (flags & POGLConvertFlags::SRGB_TO_LINEAR) != 0;
+		const POGL_UINT32 red = layout.bgr ? 2 : 0;
+		const POGL_UINT32 channels = layout.channels;
+		POGL_UINT32 i = 0;
+
+		if (layout.type == POGLChannelType::BYTE) {
+			const POGLChannelTables& tables = POGLGetChannelTables();
+			const POGL_FLOAT* colorTable = decode ? tables.srgbToLinear : tables.toFloat;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+			if (channels == 4 && !decode) {
+				const __m128i zero = _mm_setzero_si128();
+				const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+				for (; i < count; ++i) {
+					const __m128i pixel = _mm_cvtsi32_si128(*(const int*)(src + i * 4));
+					__m128 value = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(pixel, zero), zero)), scale);
+					if (layout.bgr)
+						value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+					_mm_storeu_ps(rgba + i * 4, value);
+				}
+				return;
+			}
+#endif
+
+			for (; i < count; ++i) {
+				const POGL_BYTE* s = src + i * channels;
+				POGL_FLOAT* d = rgba + i * 4;
+				d[0] = colorTable[s[0]];
+				d[1] = d[2] = 0.0f;
+				d[3] = 1.0f;
+				if (channels >= 3) {
+					d[0] = colorTable[s[red]];
+					d[1] = colorTable[s[1]];
+					d[2] = colorTable[s[2 - red]];
+					if (channels == 4)
+						d[3] = tables.toFloat[s[3]];
+				}
+			}
+			return;
+		}
+
+		const POGL_FLOAT* values = (const POGL_FLOAT*)src;
+		if (channels == 4 && !layout.bgr)
+			memcpy(rgba, values, count * 4 * sizeof(POGL_FLOAT));
+		else {
+			for (; i < count; ++i) {
+				const POGL_FLOAT* s = values + i * channels;
+				POGL_FLOAT* d = rgba + i * 4;
+				d[0] = s[0];
+				d[1] = d[2] = 0.0f;
+				d[3] = 1.0f;
+				if (channels >= 3) {
+					d[0] = s[red];
+					d[1] = s[1];
+					d[2] = s[2 - red];
+					if (channels == 4)
+						d[3] = s[3];
+				}
+			}
+		}
+
+		if (decode) {
+			for (i = 0; i < count * 4; ++i) {
+				if ((i & 3) != 3)
+					rgba[i] = POGLSRGBToLinear(rgba[i]);
+			}
+		}
+	}
+
+	void POGLPremultiplyPixels(POGL_FLOAT* rgba, POGL_UINT32 count)
+	{
+		POGL_UINT32 i = 0;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+		const __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+		for (; i < count; ++i) {
+			const __m128 value = _mm_loadu_ps(rgba + i * 4);
+			const __m128 alpha = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+			const __m128 color = _mm_mul_ps(value, alpha);
+			_mm_storeu_ps(rgba + i * 4, _mm_or_ps(_mm_andnot_ps(alphaMask, color), _mm_and_ps(alphaMask, value)));
+		}
+#endif
+
+		for (; i < count; ++i) {
+			POGL_FLOAT* d = rgba + i * 4;
+			d[0] *= d[3];
+			d[1] *= d[3];
+			d[2] *= d[3];
+		}
+	}
+
+	void POGLEncodePixels(POGL_FLOAT* rgba, POGL_UINT32 count)
+	{
+		for (POGL_UINT32 i = 0; i < count * 4; ++i) {
+			if ((i & 3) != 3)
+				rgba[i] = POGLLinearToSRGB((std::min)((std::max)(rgba[i], 0.0f), 1.0f));
+		}
+	}
+
+	/*!
+		\brief Write floating point RGBA values into the destination layout
+	*/
+	void POGLWritePixels(const POGL_FLOAT* rgba, POGL_UINT32 count, const POGLPixelLayout& layout, POGL_BYTE* dst)
+	{
+		const POGL_UINT32 channels = layout.channels;
+		const POGL_UINT32 red = layout.bgr ? 2 : 0;
+		POGL_UINT32 i = 0;
+
+		switch (layout.type) {
+		case POGLChannelType::BYTE:
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+			if (channels == 4) {
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 one = _mm_set1_ps(1.0f);
+				const __m128 scale = _mm_set1_ps(255.0f);
+				const __m128 half = _mm_set1_ps(0.5f);
+				for (; i + 4 <= count; i += 4) {
+					__m128i values[4];
+					for (POGL_UINT32 p = 0; p < 4; ++p) {
+						__m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(rgba + (i + p) * 4), zero), one);
+						if (layout.bgr)
+							value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+						values[p] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half));
+					}
+					const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+					_mm_storeu_si128((__m128i*)(dst + i * 4), packed);
+				}
+			}
+#endif
+			for (; i < count; ++i) {
+				const POGL_FLOAT* s = rgba + i * 4;
+				POGL_BYTE* d = dst + i * channels;
+				d[0] = POGLFloatToByte(s[0]);
+				if (channels >= 3) {
+					d[red] = POGLFloatToByte(s[0]);
+					d[1] = POGLFloatToByte(s[1]);
+					d[2 - red] = POGLFloatToByte(s[2]);
+					if (channels == 4)
+						d[3] = POGLFloatToByte(s[3]);
+				}
+			}
+			break;
+
+		case POGLChannelType::HALF_FLOAT: {
+			POGL_UINT16* d = (POGL_UINT16*)dst;
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+			if (channels == 4) {
+				for (; i + 2 <= count; i += 2) {
+					const __m128i a = POGLFloatToHalf4(_mm_loadu_ps(rgba + i * 4));
+					const __m128i b = POGLFloatToHalf4(_mm_loadu_ps(rgba + i * 4 + 4));
+					_mm_storeu_si128((__m128i*)(d + i * 4), _mm_packs_epi32(a, b));
+				}
+			}
+			else if (channels == 1) {
+				for (; i + 8 <= count; i += 8) {
+					const POGL_FLOAT* s = rgba + i * 4;
+					const __m128i a = POGLFloatToHalf4(_mm_setr_ps(s[0], s[4], s[8], s[12]));
+					const __m128i b = POGLFloatToHalf4(_mm_setr_ps(s[16], s[20], s[24], s[28]));
+					_mm_storeu_si128((__m128i*)(d + i), _mm_packs_epi32(a, b));
+				}
+			}
+#endif
+			for (; i < count; ++i) {
+				for (POGL_UINT32 c = 0; c < channels; ++c)
+					d[i * channels + c] = POGLFloatToHalf(rgba[i * 4 + c]);
+			}
+			break;
+		}
+
+		case POGLChannelType::FLOAT: {
+			POGL_FLOAT* d = (POGL_FLOAT*)dst;
+			if (channels == 4) {
+				memcpy(d, rgba, count * 4 * sizeof(POGL_FLOAT));
+				break;
+			}
+			for (; i < count; ++i) {
+				for (POGL_UINT32 c = 0; c < channels; ++c)
+					d[i * channels + c] = rgba[i * 4 + c];
+			}
+			break;
+		}
+		}
+	}
+}
+
+void POGLCheckPixelConversion(POGLSourceFormat::Enum srcFormat, POGLTextureFormat::Enum dstFormat, POGL_UINT32 convertFlags)
+{
+	if ((convertFlags & POGLConvertFlags::SRGB_TO_LINEAR) && (convertFlags & POGLConvertFlags::LINEAR_TO_SRGB))
+		THROW_EXCEPTION(POGLResourceException, "You cannot both decode and encode sRGB in the same conversion");
+
+	POGLGetSourceLayout(srcFormat);
+	POGLGetTextureLayout(dstFormat);
+}
+
+POGL_UINT32 POGLSourceFormatToSize(POGLSourceFormat::Enum format, const POGL_SIZE& size)
+{
+	return size.width * size.height * POGLGetSourceLayout(format).GetBytesPerPixel();
+}
+
+void POGLConvertPixels(const void* src, POGLSourceFormat::Enum srcFormat, void* dst, POGLTextureFormat::Enum dstFormat,
+	POGL_UINT32 numPixels, POGL_UINT32 convertFlags)
+{
+	if (src == nullptr || dst == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+	POGLCheckPixelConversion(srcFormat, dstFormat, convertFlags);
+
+	const POGLPixelLayout srcLayout = POGLGetSourceLayout(srcFormat);
+	const POGLPixelLayout dstLayout = POGLGetTextureLayout(dstFormat);
+	const POGL_BYTE* srcBytes = (const POGL_BYTE*)src;
+	POGL_BYTE* dstBytes = (POGL_BYTE*)dst;
+
+	if (srcLayout == dstLayout && convertFlags == POGLConvertFlags::NONE) {
+		memcpy(dstBytes, srcBytes, numPixels * srcLayout.GetBytesPerPixel());
+		return;
+	}
+
+	if (srcLayout.type == POGLChannelType::BYTE && dstLayout.type == POGLChannelType::BYTE) {
+		POGLConvertBytes(srcBytes, srcLayout, dstBytes, dstLayout, numPixels, convertFlags);
+		return;
+	}
+
+	//
+	// Everything else is converted through floating point RGBA values, one block of pixels at a time
+	//
+
+	const POGL_UINT32 srcBytesPerPixel = srcLayout.GetBytesPerPixel();
+	const POGL_UINT32 dstBytesPerPixel = dstLayout.GetBytesPerPixel();
+	POGL_FLOAT rgba[BLOCK_SIZE * 4];
+	for (POGL_UINT32 offset = 0; offset < numPixels; offset += BLOCK_SIZE) {
+		const POGL_UINT32 count = (std::min)(BLOCK_SIZE, numPixels - offset);
+		POGLReadPixels(srcBytes + offset * srcBytesPerPixel, srcLayout, count, rgba, convertFlags);
+		if (convertFlags & POGLConvertFlags::PREMULTIPLY_ALPHA)
+			POGLPremultiplyPixels(rgba, count);
+		if (convertFlags & POGLConvertFlags::LINEAR_TO_SRGB)
+			POGLEncodePixels(rgba, count);
+		POGLWritePixels(rgba, count, dstLayout, dstBytes + offset * dstBytesPerPixel);
+	}
+}
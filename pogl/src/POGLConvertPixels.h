@@ -0,0 +1,16 @@
+#pragma once
+#include "config.h"
+#include <gl/pogl.h>
+
+/*!
+	\brief Throws an exception if pixels cannot be converted from the supplied source format into the texture format
+
+	Converted pixels are stored using the type returned by POGLEnum::ConvertToNativeTextureTypeEnum and have the size returned by
+	POGLEnum::TextureFormatToNativeSize.
+*/
+extern void POGLCheckPixelConversion(POGLSourceFormat::Enum srcFormat, POGLTextureFormat::Enum dstFormat, POGL_UINT32 convertFlags);
+
+/*!
+	\brief Calculates the size of tightly packed pixels in the supplied source format
+*/
+extern POGL_UINT32 POGLSourceFormatToSize(POGLSourceFormat::Enum format, const POGL_SIZE& size);
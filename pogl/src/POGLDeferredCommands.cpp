@@ -4,12 +4,17 @@
 #include "POGLVertexBuffer.h"
 #include "POGLIndexBuffer.h"
 #include "POGLTexture2D.h"
+#include "POGLTextureResource.h"
 #include "POGLRenderState.h"
 #include "POGLDeferredRenderContext.h"
 #include "POGLFramebuffer.h"
 #include "POGLShader.h"
 #include "POGLProgram.h"
+#include "POGLProgramCache.h"
 #include "POGLEnum.h"
+#include "POGLBufferBatch.h"
+#include "POGLPixelUnpackRing.h"
+#include "POGLResidencyManager.h"
 
 void POGLNothing_Release(POGL_HANDLE)
 {
@@ -63,14 +68,72 @@ void POGLCreateIndexBuffer_Release(POGL_HANDLE command)
 	cmd->indexBuffer->Release();
 }
 
+void POGLCreateVertexBuffers_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
+{
+	POGL_CREATEVERTEXBUFFERS_COMMAND_DATA* cmd = (POGL_CREATEVERTEXBUFFERS_COMMAND_DATA*)command;
+	const POGL_INT32* memoryOffsets = (const POGL_INT32*)context->GetMapPointer(cmd->memoryOffsetsOffset);
+	std::vector<const void*> memory(cmd->count);
+	for (POGL_UINT32 i = 0; i < cmd->count; ++i) {
+		memory[i] = memoryOffsets[i] != -1 ? context->GetMapPointer(memoryOffsets[i]) : nullptr;
+	}
+	cmd->batch->PostConstruct(&memory[0]);
+
+	std::vector<GLuint> vaoIDs(cmd->count);
+	glGenVertexArrays(cmd->count, &vaoIDs[0]);
+	for (POGL_UINT32 i = 0; i < cmd->count; ++i) {
+		cmd->vertexBuffers[i]->PostConstruct(state, vaoIDs[i]);
+	}
+
+	const GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+		THROW_EXCEPTION(POGLResourceException, "Failed to create vertex buffers. Reason: 0x%x", error);
+}
+
+void POGLCreateVertexBuffers_Release(POGL_HANDLE command)
+{
+	POGL_CREATEVERTEXBUFFERS_COMMAND_DATA* cmd = (POGL_CREATEVERTEXBUFFERS_COMMAND_DATA*)command;
+	for (POGL_UINT32 i = 0; i < cmd->count; ++i) {
+		cmd->vertexBuffers[i]->Release();
+	}
+	delete[] cmd->vertexBuffers;
+	delete cmd->batch;
+}
+
+void POGLCreateIndexBuffers_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
+{
+	POGL_CREATEINDEXBUFFERS_COMMAND_DATA* cmd = (POGL_CREATEINDEXBUFFERS_COMMAND_DATA*)command;
+	const POGL_INT32* memoryOffsets = (const POGL_INT32*)context->GetMapPointer(cmd->memoryOffsetsOffset);
+	std::vector<const void*> memory(cmd->count);
+	for (POGL_UINT32 i = 0; i < cmd->count; ++i) {
+		memory[i] = memoryOffsets[i] != -1 ? context->GetMapPointer(memoryOffsets[i]) : nullptr;
+	}
+	cmd->batch->PostConstruct(&memory[0]);
+
+	for (POGL_UINT32 i = 0; i < cmd->count; ++i) {
+		cmd->indexBuffers[i]->PostConstruct(state);
+	}
+
+	const GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+		THROW_EXCEPTION(POGLResourceException, "Failed to create index buffers. Reason: 0x%x", error);
+}
+
+void POGLCreateIndexBuffers_Release(POGL_HANDLE command)
+{
+	POGL_CREATEINDEXBUFFERS_COMMAND_DATA* cmd = (POGL_CREATEINDEXBUFFERS_COMMAND_DATA*)command;
+	for (POGL_UINT32 i = 0; i < cmd->count; ++i) {
+		cmd->indexBuffers[i]->Release();
+	}
+	delete[] cmd->indexBuffers;
+	delete cmd->batch;
+}
+
 void POGLCreateTexture2D_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_CREATETEXTURE2D_COMMAND_DATA* cmd = (POGL_CREATETEXTURE2D_COMMAND_DATA*)command;
 
 	const POGLTextureFormat::Enum format = cmd->texture->GetTextureFormat();
 	const POGL_SIZE& size = cmd->texture->GetSize();
-	const GLenum _format = POGLEnum::ConvertToTextureFormatEnum(format);
-	const GLenum _internalFormat = POGLEnum::ConvertToInternalTextureFormatEnum(format);
 	const GLenum minFilter = POGLEnum::Convert(POGLMinFilter::DEFAULT);
 	const GLenum magFilter = POGLEnum::Convert(POGLMagFilter::DEFAULT);
 	const GLenum textureWrap = POGLEnum::Convert(POGLTextureWrap::DEFAULT);
@@ -83,7 +146,8 @@ void POGLCreateTexture2D_Command(POGLDeferredRenderContext* context, POGLRenderS
 	if (cmd->dataSize > 0)
 		pointer = context->GetMapPointer(cmd->memoryOffset);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, _internalFormat, size.width, size.height, 0, _format, GL_UNSIGNED_BYTE, pointer);
+	POGLFactory::TexImage(GL_TEXTURE_2D, 0, size, 1, format, pointer);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, textureWrap);
@@ -103,10 +167,36 @@ void POGLCreateTexture2D_Release(POGL_HANDLE command)
 	cmd->texture->Release();
 }
 
+void POGLCreateTexture_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
+{
+	POGL_CREATETEXTURE_COMMAND_DATA* cmd = (POGL_CREATETEXTURE_COMMAND_DATA*)command;
+
+	POGL_HANDLE pointer = nullptr;
+	if (cmd->dataSize > 0)
+		pointer = context->GetMapPointer(cmd->memoryOffset);
+
+	POGLTextureResource* resource = cmd->resource;
+	const GLuint textureID = POGLFactory::CreateTextureStorage(resource->GetTextureTarget(), cmd->size, cmd->depth, resource->GetTextureFormat(),
+		cmd->mipLevels, pointer);
+	resource->PostConstruct(textureID);
+	state->ForceSetTextureResource(resource);
+}
+
+void POGLCreateTexture_Release(POGL_HANDLE command)
+{
+	POGL_CREATETEXTURE_COMMAND_DATA* cmd = (POGL_CREATETEXTURE_COMMAND_DATA*)command;
+	cmd->resource->Release();
+}
+
 void POGLCreateShader_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_CREATESHADER_COMMAND_DATA* cmd = (POGL_CREATESHADER_COMMAND_DATA*)command;
 	const POGL_HANDLE memory = context->GetMapPointer(cmd->memoryOffset);
+	if (POGLProgramCache::IsEnabled()) {
+		cmd->shader->PostConstruct((const POGL_CHAR*)memory, cmd->dataSize);
+		return;
+	}
+
 	const GLuint shaderID = POGLFactory::CreateShader((const POGL_CHAR*)memory, cmd->dataSize, cmd->shader->GetShaderType());
 	cmd->shader->PostConstruct(shaderID);
 }
@@ -120,9 +210,16 @@ void POGLCreateShader_Release(POGL_HANDLE command)
 void POGLCreateProgram_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_CREATEPROGRAM_COMMAND_DATA* cmd = (POGL_CREATEPROGRAM_COMMAND_DATA*)command;
+	if (cmd->async) {
+		POGL_PROGRAM_LINK link;
+		POGLProgramCache::BeginCreateProgram(cmd->shaders, cmd->shaderCount, &link);
+		cmd->program->PostConstructAsync(link, state);
+		return;
+	}
 
-	const GLuint programID = POGLFactory::CreateProgram(cmd->shaders, cmd->shaderCount);
-	cmd->program->PostConstruct(programID, state);
+	POGLProgramUniforms uniforms;
+	const GLuint programID = POGLProgramCache::CreateProgram(cmd->shaders, cmd->shaderCount, &uniforms);
+	cmd->program->PostConstruct(programID, uniforms, state);
 }
 
 void POGLCreateProgram_Release(POGL_HANDLE command)
@@ -370,15 +467,11 @@ void POGLResizeTexture2D_Command(POGLDeferredRenderContext* context, POGLRenderS
 	POGL_RESIZETEXTURE2D_COMMAND_DATA* cmd = (POGL_RESIZETEXTURE2D_COMMAND_DATA*)command;
 
 	POGLTextureResource* resource = cmd->texture->GetResourcePtr();
+	POGLResidencyManager::Touch(resource);
 	glBindTexture(GL_TEXTURE_2D, resource->GetTextureID());
 	state->ForceSetTextureResource(resource);
 
-	const POGLTextureFormat::Enum format = resource->GetTextureFormat();
-	const GLenum _format = POGLEnum::ConvertToTextureFormatEnum(format);
-	const GLenum _internalFormat = POGLEnum::ConvertToInternalTextureFormatEnum(format);
-	const POGL_SIZE& size = cmd->newSize;
-
-	glTexImage2D(GL_TEXTURE_2D, 0, _internalFormat, size.width, size.height, 0, _format, GL_UNSIGNED_BYTE, NULL);
+	POGLFactory::TexImage(GL_TEXTURE_2D, 0, cmd->newSize, 1, resource->GetTextureFormat(), nullptr);
 	CHECK_GL("Could not set new texture size");
 
 	cmd->texture->SetSize(cmd->newSize);
@@ -390,11 +483,55 @@ void POGLResizeTexture2D_Release(POGL_HANDLE command)
 	cmd->texture->Release();
 }
 
+void POGLUpdateTexture_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
+{
+	POGL_UPDATETEXTURE_COMMAND_DATA* cmd = (POGL_UPDATETEXTURE_COMMAND_DATA*)command;
+
+	POGLTextureResource* resource = cmd->resource;
+	const GLenum target = resource->GetTextureTarget();
+	POGLResidencyManager::Touch(resource);
+	glBindTexture(target, resource->GetTextureID());
+	state->ForceSetTextureResource(resource);
+
+	POGLPixelUnpackRing* ring = state->GetPixelUnpackRing();
+	if (cmd->convert)
+		ring->TexSubImage(target, cmd->mipLevel, cmd->layer, cmd->rect, resource->GetTextureFormat(), cmd->srcFormat,
+			context->GetMapPointer(cmd->memoryOffset), cmd->convertFlags);
+	else
+		ring->TexSubImage(target, cmd->mipLevel, cmd->layer, cmd->rect, resource->GetTextureFormat(),
+			context->GetMapPointer(cmd->memoryOffset), cmd->dataSize);
+}
+
+void POGLUpdateTexture_Release(POGL_HANDLE command)
+{
+	POGL_UPDATETEXTURE_COMMAND_DATA* cmd = (POGL_UPDATETEXTURE_COMMAND_DATA*)command;
+	cmd->resource->Release();
+}
+
+void POGLGenerateMipmaps_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
+{
+	POGL_GENERATEMIPMAPS_COMMAND_DATA* cmd = (POGL_GENERATEMIPMAPS_COMMAND_DATA*)command;
+
+	POGLTextureResource* resource = cmd->resource;
+	const GLenum target = resource->GetTextureTarget();
+	POGLResidencyManager::Touch(resource);
+	glBindTexture(target, resource->GetTextureID());
+	state->ForceSetTextureResource(resource);
+
+	glGenerateMipmap(target);
+	CHECK_GL("Could not generate mipmaps");
+}
+
+void POGLGenerateMipmaps_Release(POGL_HANDLE command)
+{
+	POGL_GENERATEMIPMAPS_COMMAND_DATA* cmd = (POGL_GENERATEMIPMAPS_COMMAND_DATA*)command;
+	cmd->resource->Release();
+}
+
 void POGLUniformSetInt_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_INT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_INT_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	switch (cmd->count) {
 	case 1:
 		uniform->SetInt32(cmd->values[0]);
@@ -417,8 +554,7 @@ void POGLUniformSetInt_Command(POGLDeferredRenderContext* context, POGLRenderSta
 void POGLUniformSetUInt_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_UINT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_UINT_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	switch (cmd->count) {
 	case 1:
 		uniform->SetUInt32(cmd->values[0]);
@@ -441,24 +577,21 @@ void POGLUniformSetUInt_Command(POGLDeferredRenderContext* context, POGLRenderSt
 void POGLUniformSetSize_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_SIZE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_SIZE_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->SetSize(cmd->size);
 }
 
 void POGLUniformSetRect_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_RECT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_RECT_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->SetRect(cmd->rect);
 }
 
 void POGLUniformSetFloat_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_FLOAT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_FLOAT_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	switch (cmd->count) {
 	case 1:
 		uniform->SetFloat(cmd->values[0]);
@@ -481,8 +614,7 @@ void POGLUniformSetFloat_Command(POGLDeferredRenderContext* context, POGLRenderS
 void POGLUniformSetDouble_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	switch (cmd->count) {
 	case 1:
 		uniform->SetDouble(cmd->values[0]);
@@ -505,15 +637,13 @@ void POGLUniformSetDouble_Command(POGLDeferredRenderContext* context, POGLRender
 void POGLUniformSetMat4_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_MAT4_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_MAT4_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	state->FindUniformByName(str)->SetMatrix(cmd->matrix);
+	state->FindUniformByID(cmd->uniformID)->SetMatrix(cmd->matrix);
 }
 
 void POGLUniformSetTexture_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_TEXTURE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_TEXTURE_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->SetTexture(cmd->texture);
 }
 
@@ -527,47 +657,41 @@ void POGLUniformSetTexture_Release(POGL_HANDLE command)
 void POGLUniformSetMinFilter_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_MINFILTER_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_MINFILTER_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->GetSamplerState()->SetMinFilter(cmd->minFilter);
 }
 
 void POGLUniformSetMagFilter_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_MAGFILTER_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_MAGFILTER_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->GetSamplerState()->SetMagFilter(cmd->magFilter);
 }
 
 void POGLUniformSetTextureWrapST_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->GetSamplerState()->SetTextureWrap(cmd->textureWrap[0], cmd->textureWrap[1]);
 }
 
 void POGLUniformSetTextureWrapSTR_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->GetSamplerState()->SetTextureWrap(cmd->textureWrap[0], cmd->textureWrap[1], cmd->textureWrap[2]);
 }
 
 void POGLUniformSetCompareFunc_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SETCOMPAREFUNC_COMMAND_DATA* cmd = (POGL_UNIFORM_SETCOMPAREFUNC_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->GetSamplerState()->SetCompareFunc(cmd->compareFunc);
 }
 
 void POGLUniformSetCompareMode_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command)
 {
 	POGL_UNIFORM_SETCOMPAREMODE_COMMAND_DATA* cmd = (POGL_UNIFORM_SETCOMPAREMODE_COMMAND_DATA*)command;
-	const POGL_STRING& str = *cmd->name;
-	auto uniform = state->FindUniformByName(str);
+	auto uniform = state->FindUniformByID(cmd->uniformID);
 	uniform->GetSamplerState()->SetCompareMode(cmd->compareMode);
 }
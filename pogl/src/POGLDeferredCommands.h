@@ -6,7 +6,9 @@ class POGLDeferredRenderContext;
 class POGLRenderState;
 class POGLVertexBuffer;
 class POGLIndexBuffer;
+class POGLBufferBatch;
 class POGLTexture2D;
+class POGLTextureResource;
 class POGLFramebuffer;
 class POGLShader;
 class POGLProgram;
@@ -75,6 +77,40 @@ struct POGL_CREATEINDEXBUFFER_COMMAND_DATA
 extern void POGLCreateIndexBuffer_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
 extern void POGLCreateIndexBuffer_Release(POGL_HANDLE command);
 
+struct POGL_CREATEVERTEXBUFFERS_COMMAND_DATA
+{
+	// The batch the vertex buffers are allocated from
+	POGLBufferBatch* batch;
+
+	// The vertex buffers we want to create
+	POGLVertexBuffer** vertexBuffers;
+
+	// The number of vertex buffers
+	POGL_UINT32 count;
+
+	// The offset where an array of memory offsets, one for each vertex buffer, begins. An memory offset of -1 means that the vertex buffer has no data
+	POGL_INT32 memoryOffsetsOffset;
+};
+extern void POGLCreateVertexBuffers_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
+extern void POGLCreateVertexBuffers_Release(POGL_HANDLE command);
+
+struct POGL_CREATEINDEXBUFFERS_COMMAND_DATA
+{
+	// The batch the index buffers are allocated from
+	POGLBufferBatch* batch;
+
+	// The index buffers we want to create
+	POGLIndexBuffer** indexBuffers;
+
+	// The number of index buffers
+	POGL_UINT32 count;
+
+	// The offset where an array of memory offsets, one for each index buffer, begins. An memory offset of -1 means that the index buffer has no data
+	POGL_INT32 memoryOffsetsOffset;
+};
+extern void POGLCreateIndexBuffers_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
+extern void POGLCreateIndexBuffers_Release(POGL_HANDLE command);
+
 struct POGL_CREATETEXTURE2D_COMMAND_DATA
 {
 	// The texture we want to create
@@ -89,6 +125,29 @@ struct POGL_CREATETEXTURE2D_COMMAND_DATA
 extern void POGLCreateTexture2D_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
 extern void POGLCreateTexture2D_Release(POGL_HANDLE command);
 
+struct POGL_CREATETEXTURE_COMMAND_DATA
+{
+	// The resource of the texture we want to create with immutable storage
+	POGLTextureResource* resource;
+
+	// The size of the base level
+	POGL_SIZE size;
+
+	// The depth or number of layers of the base level
+	POGL_UINT32 depth;
+
+	// The number of mip levels
+	POGL_UINT32 mipLevels;
+
+	// The offset where the data begins
+	POGL_UINT32 memoryOffset;
+
+	// The size (in bytes) of the texture buffer data
+	POGL_UINT32 dataSize;
+};
+extern void POGLCreateTexture_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
+extern void POGLCreateTexture_Release(POGL_HANDLE command);
+
 struct POGL_CREATESHADER_COMMAND_DATA
 {
 	// The shader
@@ -113,6 +172,9 @@ struct POGL_CREATEPROGRAM_COMMAND_DATA
 
 	// The number of shaders
 	POGL_UINT32 shaderCount;
+
+	// Submit the program without waiting for it to be compiled and linked
+	bool async;
 };
 extern void POGLCreateProgram_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
 extern void POGLCreateProgram_Release(POGL_HANDLE command);
@@ -307,10 +369,50 @@ struct POGL_RESIZETEXTURE2D_COMMAND_DATA
 extern void POGLResizeTexture2D_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
 extern void POGLResizeTexture2D_Release(POGL_HANDLE command);
 
+struct POGL_UPDATETEXTURE_COMMAND_DATA
+{
+	// The resource of the texture we want to update
+	POGLTextureResource* resource;
+
+	// The part of the layer we want to update
+	POGL_RECT rect;
+
+	// The array layer, cube face or depth slice we want to update
+	POGL_UINT32 layer;
+
+	// The mip level we want to update
+	POGL_UINT32 mipLevel;
+
+	// The offset where the data begins
+	POGL_UINT32 memoryOffset;
+
+	// The size (in bytes) of the texture data
+	POGL_UINT32 dataSize;
+
+	// Convert the data from the source format while it's copied into the pixel unpack ring
+	bool convert;
+
+	// The layout of the data if it's converted
+	POGLSourceFormat::Enum srcFormat;
+
+	// A combination of POGLConvertFlags
+	POGL_UINT32 convertFlags;
+};
+extern void POGLUpdateTexture_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
+extern void POGLUpdateTexture_Release(POGL_HANDLE command);
+
+struct POGL_GENERATEMIPMAPS_COMMAND_DATA
+{
+	// The resource of the texture we want to generate mipmaps for
+	POGLTextureResource* resource;
+};
+extern void POGLGenerateMipmaps_Command(POGLDeferredRenderContext* context, POGLRenderState* state, POGL_HANDLE command);
+extern void POGLGenerateMipmaps_Release(POGL_HANDLE command);
+
 struct POGL_UNIFORM_SET_INT_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 	
 	// The uniform value
 	POGL_INT32 values[4];
@@ -322,8 +424,8 @@ extern void POGLUniformSetInt_Command(POGLDeferredRenderContext* context, POGLRe
 
 struct POGL_UNIFORM_SET_UINT_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGL_UINT32 values[4];
@@ -335,8 +437,8 @@ extern void POGLUniformSetUInt_Command(POGLDeferredRenderContext* context, POGLR
 
 struct POGL_UNIFORM_SET_SIZE_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGL_SIZE size;
@@ -345,8 +447,8 @@ extern void POGLUniformSetSize_Command(POGLDeferredRenderContext* context, POGLR
 
 struct POGL_UNIFORM_SET_RECT_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGL_RECT rect;
@@ -355,8 +457,8 @@ extern void POGLUniformSetRect_Command(POGLDeferredRenderContext* context, POGLR
 
 struct POGL_UNIFORM_SET_FLOAT_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGL_FLOAT values[4];
@@ -368,8 +470,8 @@ extern void POGLUniformSetFloat_Command(POGLDeferredRenderContext* context, POGL
 
 struct POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGL_DOUBLE values[4];
@@ -381,8 +483,8 @@ extern void POGLUniformSetDouble_Command(POGLDeferredRenderContext* context, POG
 
 struct POGL_UNIFORM_SET_MAT4_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGL_MAT4 matrix;
@@ -391,8 +493,8 @@ extern void POGLUniformSetMat4_Command(POGLDeferredRenderContext* context, POGLR
 
 struct POGL_UNIFORM_SET_TEXTURE_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	IPOGLTexture* texture;
@@ -402,8 +504,8 @@ extern void POGLUniformSetTexture_Release(POGL_HANDLE command);
 
 struct POGL_UNIFORM_SET_MINFILTER_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGLMinFilter::Enum minFilter;
@@ -412,8 +514,8 @@ extern void POGLUniformSetMinFilter_Command(POGLDeferredRenderContext* context,
 
 struct POGL_UNIFORM_SET_MAGFILTER_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGLMagFilter::Enum magFilter;
@@ -422,8 +524,8 @@ extern void POGLUniformSetMagFilter_Command(POGLDeferredRenderContext* context,
 
 struct POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGLTextureWrap::Enum textureWrap[3];
@@ -433,8 +535,8 @@ extern void POGLUniformSetTextureWrapSTR_Command(POGLDeferredRenderContext* cont
 
 struct POGL_UNIFORM_SETCOMPAREFUNC_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGLCompareFunc::Enum compareFunc;
@@ -443,8 +545,8 @@ extern void POGLUniformSetCompareFunc_Command(POGLDeferredRenderContext* context
 
 struct POGL_UNIFORM_SETCOMPAREMODE_COMMAND_DATA
 {
-	// The name of the uniform
-	const POGL_STRING* name;
+	// The uniform ID
+	POGL_UINT32 uniformID;
 
 	// The uniform value
 	POGLCompareMode::Enum compareMode;
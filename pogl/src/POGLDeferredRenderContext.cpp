@@ -5,13 +5,22 @@
 #include "POGLFactory.h"
 #include "POGLRenderState.h"
 #include "POGLRenderContext.h"
+#include "POGLTexture1D.h"
 #include "POGLTexture2D.h"
+#include "POGLTexture3D.h"
+#include "POGLTexture2DArray.h"
+#include "POGLTextureCube.h"
+#include "POGLTextureUtils.h"
+#include "POGLTextureResource.h"
+#include "POGLConvertPixels.h"
 #include "POGLDeferredRenderState.h"
 #include "POGLFramebuffer.h"
 #include "POGLShader.h"
 #include "POGLProgram.h"
+#include "POGLProgramCache.h"
 #include "POGLIndexBuffer.h"
 #include "POGLDevice.h"
+#include "POGLBufferBatch.h"
 
 POGLDeferredRenderContext::POGLDeferredRenderContext(POGLDevice* device)
 : mRefCount(1), mDevice(device), mRenderState(nullptr),
@@ -88,13 +97,12 @@ IPOGLDevice* POGLDeferredRenderContext::GetDevice()
 
 IPOGLShader* POGLDeferredRenderContext::CreateShaderFromFile(const POGL_CHAR* path, POGLShaderType::Enum type)
 {
-	POGL_ISTREAM stream(path);
-	if (!stream.is_open())
-		THROW_EXCEPTION(POGLResourceException, "Shader at path: '%s' could not be found", path);
+	if (path == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid shader path");
 
-	// Read the entire file into memory
-	POGL_STRING str((std::istreambuf_iterator<POGL_CHAR>(stream)), std::istreambuf_iterator<POGL_CHAR>());
-	return CreateShaderFromMemory(str.c_str(), str.length(), type);
+	// The shader source is compiled straight from the mapped file
+	POGLMappedFile file(path);
+	return CreateShaderFromMemory((const POGL_CHAR*)file.GetBytes(), file.GetSize(), type);
 }
 
 IPOGLShader* POGLDeferredRenderContext::CreateShaderFromMemory(const POGL_CHAR* memory, POGL_UINT32 size, POGLShaderType::Enum type)
@@ -108,13 +116,23 @@ IPOGLShader* POGLDeferredRenderContext::CreateShaderFromMemory(const POGL_CHAR*
 	cmd->memoryOffset = GetMapOffset(size);
 	memcpy(GetMapPointer(cmd->memoryOffset), memory, size);
 	
-	POGLShader* shader = new POGLShader(type);
+	POGLShader* shader = new POGLShader(type, POGLProgramCache::Hash(memory, size, 0));
 	cmd->shader = shader;
 	cmd->shader->AddRef();
 	return shader;
 }
 
 IPOGLProgram* POGLDeferredRenderContext::CreateProgramFromShaders(IPOGLShader** shaders, POGL_UINT32 count)
+{
+	return AddCreateProgramCommand(shaders, count, false);
+}
+
+IPOGLProgram* POGLDeferredRenderContext::CreateProgramFromShadersAsync(IPOGLShader** shaders, POGL_UINT32 count)
+{
+	return AddCreateProgramCommand(shaders, count, true);
+}
+
+IPOGLProgram* POGLDeferredRenderContext::AddCreateProgramCommand(IPOGLShader** shaders, POGL_UINT32 count, bool async)
 {
 	if (shaders == nullptr)
 		THROW_EXCEPTION(POGLResourceException, "You must supply at least one shader to be able to create a program");
@@ -127,15 +145,48 @@ IPOGLProgram* POGLDeferredRenderContext::CreateProgramFromShaders(IPOGLShader**
 		shader->AddRef();
 	}
 	cmd->shaderCount = count;
+	cmd->async = async;
 	POGLProgram* program = new POGLProgram();
 	cmd->program = program;
 	cmd->program->AddRef();
 	return program;
 }
 
-IPOGLTexture1D* POGLDeferredRenderContext::CreateTexture1D()
+void POGLDeferredRenderContext::AddCreateTextureCommand(POGLTextureResource* resource, const POGL_SIZE& size, POGL_UINT32 depth, POGL_UINT32 mipLevels, const void* bytes)
 {
-	THROW_NOT_IMPLEMENTED_EXCEPTION();
+	POGL_CREATETEXTURE_COMMAND_DATA* cmd = (POGL_CREATETEXTURE_COMMAND_DATA*)AddCommand(&POGLCreateTexture_Command, &POGLCreateTexture_Release,
+		sizeof(POGL_CREATETEXTURE_COMMAND_DATA));
+	cmd->resource = resource;
+	cmd->resource->AddRef();
+	cmd->size = size;
+	cmd->depth = depth;
+	cmd->mipLevels = mipLevels;
+	cmd->dataSize = 0;
+	cmd->memoryOffset = 0;
+	if (bytes != nullptr) {
+		const POGL_UINT32 layers = resource->GetTextureTarget() == GL_TEXTURE_CUBE_MAP ? (POGL_UINT32)POGLCubeFace::COUNT : depth;
+		const POGL_UINT32 dataSize = POGLEnum::TextureFormatToSize(resource->GetTextureFormat(), size) * layers;
+		const POGL_UINT32 memoryOffset = GetMapOffset(dataSize);
+		memcpy(GetMapPointer(memoryOffset), bytes, dataSize);
+		cmd->dataSize = dataSize;
+		cmd->memoryOffset = memoryOffset;
+	}
+}
+
+IPOGLTexture1D* POGLDeferredRenderContext::CreateTexture1D(POGL_UINT32 width, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (width == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", width);
+
+	if (POGLEnum::IsCompressedTextureFormat(format))
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a 1D texture with a compressed format");
+
+	const POGL_SIZE size((POGL_INT32)width, 1);
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, 1);
+
+	POGLTexture1D* texture = new POGLTexture1D(width, format, mipLevels);
+	AddCreateTextureCommand(texture->GetResourcePtr(), size, 1, mipLevels, bytes);
+	return texture;
 }
 
 IPOGLTexture2D* POGLDeferredRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, const void* bytes)
@@ -164,9 +215,82 @@ IPOGLTexture2D* POGLDeferredRenderContext::CreateTexture2D(const POGL_SIZE& size
 	return texture;
 }
 
-IPOGLTexture3D* POGLDeferredRenderContext::CreateTexture3D()
+IPOGLTexture2D* POGLDeferredRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
 {
-	THROW_NOT_IMPLEMENTED_EXCEPTION();
+	if (size.width <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", size.width);
+
+	if (size.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with height: %d", size.height);
+
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, 1);
+
+	POGLTexture2D* texture = new POGLTexture2D(size, format, mipLevels, true);
+	AddCreateTextureCommand(texture->GetResourcePtr(), size, 1, mipLevels, bytes);
+	return texture;
+}
+
+IPOGLTexture2D* POGLDeferredRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, POGLSourceFormat::Enum srcFormat,
+	const void* bytes, POGL_UINT32 convertFlags)
+{
+	POGLCheckPixelConversion(srcFormat, format, convertFlags);
+
+	IPOGLTexture2D* texture = CreateTexture2D(size, format, mipLevels, nullptr);
+	if (bytes != nullptr)
+		UpdateTexture2D(texture, POGL_RECT(0, 0, size.width, size.height), 0, srcFormat, bytes, convertFlags);
+	return texture;
+}
+
+IPOGLTexture3D* POGLDeferredRenderContext::CreateTexture3D(const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (size.width <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", size.width);
+
+	if (size.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with height: %d", size.height);
+
+	if (depth == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with depth: %d", depth);
+
+	if (POGLEnum::IsCompressedTextureFormat(format))
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a 3D texture with a compressed format");
+
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, depth);
+
+	POGLTexture3D* texture = new POGLTexture3D(size, depth, format, mipLevels);
+	AddCreateTextureCommand(texture->GetResourcePtr(), size, depth, mipLevels, bytes);
+	return texture;
+}
+
+IPOGLTexture2DArray* POGLDeferredRenderContext::CreateTexture2DArray(const POGL_SIZE& size, POGL_UINT32 layers, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (size.width <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", size.width);
+
+	if (size.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with height: %d", size.height);
+
+	if (layers == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture array without any layers");
+
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, 1);
+
+	POGLTexture2DArray* texture = new POGLTexture2DArray(size, layers, format, mipLevels);
+	AddCreateTextureCommand(texture->GetResourcePtr(), size, layers, mipLevels, bytes);
+	return texture;
+}
+
+IPOGLTextureCube* POGLDeferredRenderContext::CreateTextureCube(POGL_UINT32 size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (size == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with size: %d", size);
+
+	const POGL_SIZE faceSize((POGL_INT32)size, (POGL_INT32)size);
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, faceSize, 1);
+
+	POGLTextureCube* texture = new POGLTextureCube(size, format, mipLevels);
+	AddCreateTextureCommand(texture->GetResourcePtr(), faceSize, 1, mipLevels, bytes);
+	return texture;
 }
 
 void POGLDeferredRenderContext::ResizeTexture2D(IPOGLTexture2D* texture, const POGL_SIZE& size)
@@ -180,6 +304,9 @@ void POGLDeferredRenderContext::ResizeTexture2D(IPOGLTexture2D* texture, const P
 	if (size.height <= 0)
 		THROW_EXCEPTION(POGLStateException, "You cannot resize a texture to 0 height");
 
+	if (static_cast<POGLTexture2D*>(texture)->IsImmutable())
+		THROW_EXCEPTION(POGLStateException, "You cannot resize a texture with immutable storage");
+
 	POGL_RESIZETEXTURE2D_COMMAND_DATA* cmd = (POGL_RESIZETEXTURE2D_COMMAND_DATA*)AddCommand(&POGLResizeTexture2D_Command, &POGLResizeTexture2D_Release, 
 		sizeof(POGL_RESIZETEXTURE2D_COMMAND_DATA));
 	cmd->texture = static_cast<POGLTexture2D*>(texture);
@@ -187,6 +314,124 @@ void POGLDeferredRenderContext::ResizeTexture2D(IPOGLTexture2D* texture, const P
 	cmd->newSize = size;
 }
 
+void POGLDeferredRenderContext::UpdateTexture2DMipLevel(IPOGLTexture2D* texture, POGL_UINT32 mipLevel, const void* bytes)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	const POGL_SIZE size = static_cast<POGLTexture2D*>(texture)->GetMipLevelSize(mipLevel);
+	UpdateTexture2D(texture, POGL_RECT(0, 0, size.width, size.height), mipLevel, bytes);
+}
+
+void POGLDeferredRenderContext::UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, const void* bytes)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a texture without any data");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	POGLTexture2D* impl = static_cast<POGLTexture2D*>(texture);
+	if (!impl->IsValidUpdateRect(rect, mipLevel))
+		THROW_EXCEPTION(POGLStateException, "The update rectangle is outside of mip level %d or not aligned to the compressed blocks", mipLevel);
+
+	const POGL_UINT32 dataSize = POGLEnum::TextureFormatToSize(impl->GetTextureFormat(), POGL_SIZE(rect.width, rect.height));
+
+	AddUpdateTextureCommand(impl->GetResourcePtr(), rect, 0, mipLevel, dataSize, bytes);
+}
+
+void POGLDeferredRenderContext::UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, POGLSourceFormat::Enum srcFormat,
+	const void* bytes, POGL_UINT32 convertFlags)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a texture without any data");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	POGLTexture2D* impl = static_cast<POGLTexture2D*>(texture);
+	if (!impl->IsValidUpdateRect(rect, mipLevel))
+		THROW_EXCEPTION(POGLStateException, "The update rectangle is outside of mip level %d or not aligned to the compressed blocks", mipLevel);
+
+	POGLCheckPixelConversion(srcFormat, impl->GetTextureFormat(), convertFlags);
+
+	// The source pixels are queued as they are and converted into the pixel unpack ring when the command is executed
+	const POGL_UINT32 dataSize = POGLSourceFormatToSize(srcFormat, POGL_SIZE(rect.width, rect.height));
+	POGL_UPDATETEXTURE_COMMAND_DATA* cmd = AddUpdateTextureCommand(impl->GetResourcePtr(), rect, 0, mipLevel, dataSize, bytes);
+	cmd->convert = true;
+	cmd->srcFormat = srcFormat;
+	cmd->convertFlags = convertFlags;
+}
+
+void POGLDeferredRenderContext::UpdateTextureLayer(IPOGLTexture* texture, POGL_UINT32 layer, POGL_UINT32 mipLevel, const void* bytes)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a texture without any data");
+
+	POGLTextureResource* resource = POGLTextureUtils::GetResourcePtr(texture);
+	if (resource == nullptr)
+		THROW_EXCEPTION(POGLStateException, "The supplied resource is not a texture");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	if (layer >= POGLTextureUtils::GetLayers(texture, mipLevel))
+		THROW_EXCEPTION(POGLStateException, "Mip level %d of the texture does not have layer %d", mipLevel, layer);
+
+	const POGL_SIZE size = POGLTextureUtils::GetMipLevelSize(texture, mipLevel);
+	const POGL_UINT32 dataSize = POGLEnum::TextureFormatToSize(resource->GetTextureFormat(), size);
+	AddUpdateTextureCommand(resource, POGL_RECT(0, 0, size.width, size.height), layer, mipLevel, dataSize, bytes);
+}
+
+POGL_UPDATETEXTURE_COMMAND_DATA* POGLDeferredRenderContext::AddUpdateTextureCommand(POGLTextureResource* resource, const POGL_RECT& rect, POGL_UINT32 layer, POGL_UINT32 mipLevel,
+	POGL_UINT32 dataSize, const void* bytes)
+{
+	POGL_UPDATETEXTURE_COMMAND_DATA* cmd = (POGL_UPDATETEXTURE_COMMAND_DATA*)AddCommand(&POGLUpdateTexture_Command, &POGLUpdateTexture_Release,
+		sizeof(POGL_UPDATETEXTURE_COMMAND_DATA));
+	cmd->resource = resource;
+	cmd->resource->AddRef();
+	cmd->rect = rect;
+	cmd->layer = layer;
+	cmd->mipLevel = mipLevel;
+	cmd->dataSize = dataSize;
+	cmd->memoryOffset = GetMapOffset(dataSize);
+	cmd->convert = false;
+	cmd->srcFormat = POGLSourceFormat::RGBA8;
+	cmd->convertFlags = POGLConvertFlags::NONE;
+	memcpy(GetMapPointer(cmd->memoryOffset), bytes, dataSize);
+	return cmd;
+}
+
+void POGLDeferredRenderContext::GenerateMipmaps(IPOGLTexture* texture)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot generate mipmaps for a non-existing texture");
+
+	POGLTextureResource* resource = POGLTextureUtils::GetResourcePtr(texture);
+	if (resource == nullptr)
+		THROW_EXCEPTION(POGLStateException, "The supplied resource is not a texture");
+
+	if (POGLEnum::IsCompressedTextureFormat(resource->GetTextureFormat()))
+		THROW_EXCEPTION(POGLStateException, "You cannot generate mipmaps for a compressed texture");
+
+	POGL_GENERATEMIPMAPS_COMMAND_DATA* cmd = (POGL_GENERATEMIPMAPS_COMMAND_DATA*)AddCommand(&POGLGenerateMipmaps_Command, &POGLGenerateMipmaps_Release,
+		sizeof(POGL_GENERATEMIPMAPS_COMMAND_DATA));
+	cmd->resource = resource;
+	cmd->resource->AddRef();
+}
+
 IPOGLFramebuffer* POGLDeferredRenderContext::CreateFramebuffer(IPOGLTexture** textures, POGL_UINT32 count)
 {
 	return CreateFramebuffer(textures, count, nullptr);
@@ -210,6 +455,26 @@ IPOGLFramebuffer* POGLDeferredRenderContext::CreateFramebuffer(IPOGLTexture** te
 	return framebuffer;
 }
 
+IPOGLFramebuffer* POGLDeferredRenderContext::CreateFramebuffer(const POGL_FRAMEBUFFER_ATTACHMENT* attachments, POGL_UINT32 count, const POGL_FRAMEBUFFER_ATTACHMENT* depthStencil)
+{
+	std::vector<POGL_FRAMEBUFFER_ATTACHMENT> attachmentsVector;
+	if (attachments != nullptr) {
+		for (POGL_UINT32 i = 0; i < count; ++i) {
+			if (attachments[i].texture == nullptr)
+				THROW_EXCEPTION(POGLResourceException, "You cannot attach a non-existing texture at index: %d", i);
+			attachmentsVector.push_back(attachments[i]);
+		}
+	}
+
+	POGLFramebuffer* framebuffer = new POGLFramebuffer(attachmentsVector, depthStencil != nullptr ? *depthStencil : POGL_FRAMEBUFFER_ATTACHMENT());
+
+	POGL_CREATEFRAMEBUFFER_COMMAND_DATA* cmd = (POGL_CREATEFRAMEBUFFER_COMMAND_DATA*)AddCommand(&POGLCreateFrameBuffer_Command, &POGLCreateFrameBuffer_Release,
+		sizeof(POGL_CREATEFRAMEBUFFER_COMMAND_DATA));
+	cmd->framebuffer = framebuffer;
+	cmd->framebuffer->AddRef();
+	return framebuffer;
+}
+
 IPOGLVertexBuffer* POGLDeferredRenderContext::CreateVertexBuffer(const void* memory, POGL_UINT32 memorySize, const POGL_VERTEX_LAYOUT* layout, POGLPrimitiveType::Enum primitiveType, POGLBufferUsage::Enum bufferUsage)
 {
 	if (memorySize == 0)
@@ -280,6 +545,103 @@ IPOGLIndexBuffer* POGLDeferredRenderContext::CreateIndexBuffer(const void* memor
 	return ib;
 }
 
+void POGLDeferredRenderContext::CreateVertexBuffers(const POGL_VERTEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLVertexBuffer** _out_vertexBuffers)
+{
+	assert_not_null(descs);
+	assert_not_null(_out_vertexBuffers);
+
+	if (bufferUsage == POGLBufferUsage::STREAM_RING)
+		THROW_EXCEPTION(POGLStateException, "You cannot create ring buffered vertex buffers in a batch");
+
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		if (descs[i].memorySize == 0)
+			THROW_EXCEPTION(POGLStateException, "You cannot create a non-existing vertex buffer");
+
+		if (descs[i].layout == nullptr)
+			THROW_EXCEPTION(POGLStateException, "You cannot create a vertex buffer without a layout");
+	}
+
+	if (count == 0)
+		return;
+
+	POGLBufferBatch* batch = new POGLBufferBatch(GL_ARRAY_BUFFER, bufferUsage);
+	POGLVertexBuffer** vertexBuffers = new POGLVertexBuffer*[count];
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		const POGL_VERTEX_BUFFER_DESC& desc = descs[i];
+		const POGL_UINT32 numVertices = desc.memorySize / desc.layout->vertexSize;
+		const GLenum type = POGLEnum::Convert(desc.primitiveType);
+		vertexBuffers[i] = new POGLVertexBuffer(numVertices, desc.layout, type, batch->Allocate(desc.memorySize, desc.layout->vertexSize));
+		vertexBuffers[i]->AddRef();
+		_out_vertexBuffers[i] = vertexBuffers[i];
+	}
+
+	POGL_CREATEVERTEXBUFFERS_COMMAND_DATA* cmd = (POGL_CREATEVERTEXBUFFERS_COMMAND_DATA*)AddCommand(&POGLCreateVertexBuffers_Command, &POGLCreateVertexBuffers_Release,
+		sizeof(POGL_CREATEVERTEXBUFFERS_COMMAND_DATA));
+	cmd->batch = batch;
+	cmd->vertexBuffers = vertexBuffers;
+	cmd->count = count;
+	cmd->memoryOffsetsOffset = GetMapOffset(count * sizeof(POGL_INT32));
+
+	// The map memory might be moved when more memory is requested, so the offsets array is re-fetched after each allocation
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		POGL_INT32 memoryOffset = -1;
+		if (descs[i].memory != nullptr) {
+			memoryOffset = GetMapOffset(descs[i].memorySize);
+			memcpy(GetMapPointer(memoryOffset), descs[i].memory, descs[i].memorySize);
+		}
+		((POGL_INT32*)GetMapPointer(cmd->memoryOffsetsOffset))[i] = memoryOffset;
+	}
+}
+
+void POGLDeferredRenderContext::CreateIndexBuffers(const POGL_INDEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLIndexBuffer** _out_indexBuffers)
+{
+	assert_not_null(descs);
+	assert_not_null(_out_indexBuffers);
+
+	if (bufferUsage == POGLBufferUsage::STREAM_RING)
+		THROW_EXCEPTION(POGLStateException, "You cannot create ring buffered index buffers in a batch");
+
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		if (descs[i].memorySize == 0)
+			THROW_EXCEPTION(POGLStateException, "You cannot create a non-existing index buffer");
+
+		if (descs[i].type == POGLVertexType::FLOAT || descs[i].type == POGLVertexType::DOUBLE)
+			THROW_EXCEPTION(POGLStateException, "You are not allowed to create an index buffer of a decimal type");
+	}
+
+	if (count == 0)
+		return;
+
+	POGLBufferBatch* batch = new POGLBufferBatch(GL_ELEMENT_ARRAY_BUFFER, bufferUsage);
+	POGLIndexBuffer** indexBuffers = new POGLIndexBuffer*[count];
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		const POGL_INDEX_BUFFER_DESC& desc = descs[i];
+		const POGL_UINT32 typeSize = POGLEnum::VertexTypeSize(desc.type);
+		const POGL_UINT32 numIndices = desc.memorySize / typeSize;
+		const GLenum indiceType = POGLEnum::Convert(desc.type);
+		indexBuffers[i] = new POGLIndexBuffer(typeSize, numIndices, indiceType, batch->Allocate(desc.memorySize, typeSize));
+		indexBuffers[i]->AddRef();
+		_out_indexBuffers[i] = indexBuffers[i];
+	}
+
+	POGL_CREATEINDEXBUFFERS_COMMAND_DATA* cmd = (POGL_CREATEINDEXBUFFERS_COMMAND_DATA*)AddCommand(&POGLCreateIndexBuffers_Command, &POGLCreateIndexBuffers_Release,
+		sizeof(POGL_CREATEINDEXBUFFERS_COMMAND_DATA));
+	cmd->batch = batch;
+	cmd->indexBuffers = indexBuffers;
+	cmd->count = count;
+	cmd->memoryOffsetsOffset = GetMapOffset(count * sizeof(POGL_INT32));
+
+	// The map memory might be moved when more memory is requested, so the offsets array is re-fetched after each allocation
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		POGL_INT32 memoryOffset = -1;
+		if (descs[i].memory != nullptr) {
+			memoryOffset = GetMapOffset(descs[i].memorySize);
+			memcpy(GetMapPointer(memoryOffset), descs[i].memory, descs[i].memorySize);
+		}
+		((POGL_INT32*)GetMapPointer(cmd->memoryOffsetsOffset))[i] = memoryOffset;
+	}
+}
+
 IPOGLResource* POGLDeferredRenderContext::CloneResource(IPOGLResource* resource)
 {
 	THROW_NOT_IMPLEMENTED_EXCEPTION();
@@ -55,17 +55,32 @@ public:
 	virtual IPOGLShader* CreateShaderFromFile(const POGL_CHAR* path, POGLShaderType::Enum type);
 	virtual IPOGLShader* CreateShaderFromMemory(const POGL_CHAR* memory, POGL_UINT32 size, POGLShaderType::Enum type);
 	virtual IPOGLProgram* CreateProgramFromShaders(IPOGLShader** shaders, POGL_UINT32 count);
-	virtual IPOGLTexture1D* CreateTexture1D();
+	virtual IPOGLProgram* CreateProgramFromShadersAsync(IPOGLShader** shaders, POGL_UINT32 count);
+	virtual IPOGLTexture1D* CreateTexture1D(POGL_UINT32 width, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes);
 	virtual IPOGLTexture2D* CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, const void* bytes);
-	virtual IPOGLTexture3D* CreateTexture3D();
+	virtual IPOGLTexture2D* CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes);
+	virtual IPOGLTexture2D* CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, POGLSourceFormat::Enum srcFormat,
+		const void* bytes, POGL_UINT32 convertFlags);
+	virtual IPOGLTexture3D* CreateTexture3D(const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes);
+	virtual IPOGLTexture2DArray* CreateTexture2DArray(const POGL_SIZE& size, POGL_UINT32 layers, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes);
+	virtual IPOGLTextureCube* CreateTextureCube(POGL_UINT32 size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes);
 	virtual void ResizeTexture2D(IPOGLTexture2D* texture, const POGL_SIZE& size);
+	virtual void UpdateTexture2DMipLevel(IPOGLTexture2D* texture, POGL_UINT32 mipLevel, const void* bytes);
+	virtual void UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, const void* bytes);
+	virtual void UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, POGLSourceFormat::Enum srcFormat,
+		const void* bytes, POGL_UINT32 convertFlags);
+	virtual void UpdateTextureLayer(IPOGLTexture* texture, POGL_UINT32 layer, POGL_UINT32 mipLevel, const void* bytes);
+	virtual void GenerateMipmaps(IPOGLTexture* texture);
 	virtual IPOGLFramebuffer* CreateFramebuffer(IPOGLTexture** textures, POGL_UINT32 count);
 	virtual IPOGLFramebuffer* CreateFramebuffer(IPOGLTexture** textures, POGL_UINT32 count, IPOGLTexture* depthTexture);
+	virtual IPOGLFramebuffer* CreateFramebuffer(const POGL_FRAMEBUFFER_ATTACHMENT* attachments, POGL_UINT32 count, const POGL_FRAMEBUFFER_ATTACHMENT* depthStencil);
 	virtual IPOGLVertexBuffer* CreateVertexBuffer(const void* memory, POGL_UINT32 memorySize, const POGL_VERTEX_LAYOUT* layout, POGLPrimitiveType::Enum primitiveType, POGLBufferUsage::Enum bufferUsage);
 	virtual IPOGLVertexBuffer* CreateVertexBuffer(const POGL_POSITION_VERTEX* memory, POGL_UINT32 memorySize, POGLPrimitiveType::Enum primitiveType, POGLBufferUsage::Enum bufferUsage);
 	virtual IPOGLVertexBuffer* CreateVertexBuffer(const POGL_POSITION_COLOR_VERTEX* memory, POGL_UINT32 memorySize, POGLPrimitiveType::Enum primitiveType, POGLBufferUsage::Enum bufferUsage);
 	virtual IPOGLVertexBuffer* CreateVertexBuffer(const POGL_POSITION_TEXCOORD_VERTEX* memory, POGL_UINT32 memorySize, POGLPrimitiveType::Enum primitiveType, POGLBufferUsage::Enum bufferUsage);
 	virtual IPOGLIndexBuffer* CreateIndexBuffer(const void* memory, POGL_UINT32 memorySize, POGLVertexType::Enum type, POGLBufferUsage::Enum bufferUsage);
+	virtual void CreateVertexBuffers(const POGL_VERTEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLVertexBuffer** _out_vertexBuffers);
+	virtual void CreateIndexBuffers(const POGL_INDEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLIndexBuffer** _out_indexBuffers);
 	virtual IPOGLResource* CloneResource(IPOGLResource* resource);
 	virtual void CopyResource(IPOGLResource* source, IPOGLResource* destination);
 	virtual void CopyResource(IPOGLResource* source, IPOGLResource* destination, POGL_UINT32 sourceOffset, POGL_UINT32 destinationOffset, POGL_UINT32 size);
@@ -81,6 +96,25 @@ public:
 	virtual void ExecuteCommands(IPOGLRenderContext* context, bool clearCommands);
 	virtual void Flush();
 
+private:
+	/*!
+		\brief Queue the creation of a program. Asynchronous programs are resolved when they're used or waited on
+	*/
+	IPOGLProgram* AddCreateProgramCommand(IPOGLShader** shaders, POGL_UINT32 count, bool async);
+
+	/*!
+		\brief Queue the creation of a texture with immutable storage. The bytes contain all layers of the base level
+	*/
+	void AddCreateTextureCommand(POGLTextureResource* resource, const POGL_SIZE& size, POGL_UINT32 depth, POGL_UINT32 mipLevels, const void* bytes);
+
+	/*!
+		\brief Queue an update of a part of one layer in a mip level of a texture
+
+		\return The queued command. The data is uploaded as it is unless the command is changed to convert it
+	*/
+	POGL_UPDATETEXTURE_COMMAND_DATA* AddUpdateTextureCommand(POGLTextureResource* resource, const POGL_RECT& rect, POGL_UINT32 layer, POGL_UINT32 mipLevel,
+		POGL_UINT32 dataSize, const void* bytes);
+
 protected:
 	REF_COUNTER mRefCount;
 	POGLDevice* mDevice;
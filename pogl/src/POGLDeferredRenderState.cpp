@@ -5,6 +5,7 @@
 #include "POGLVertexBuffer.h"
 #include "POGLIndexBuffer.h"
 #include "POGLProgram.h"
+#include "POGLUniformRegistry.h"
 #include "uniforms/POGLDeferredUniform.h"
 
 POGLDeferredRenderState::POGLDeferredRenderState(POGLDeferredRenderContext* context)
@@ -42,10 +43,10 @@ void POGLDeferredRenderState::Flush()
 
 void POGLDeferredRenderState::FlushProgram(POGLProgram* program)
 {
-	auto it = mUniforms.begin();
-	auto end = mUniforms.end();
-	for (; it != end; ++it) {
-		it->second->Flush();
+	const size_t numUniforms = mUniforms.size();
+	for (size_t i = 0; i < numUniforms; ++i) {
+		if (mUniforms[i] != nullptr)
+			mUniforms[i]->Flush();
 	}
 }
 
@@ -57,10 +58,9 @@ void POGLDeferredRenderState::AddRef()
 void POGLDeferredRenderState::Release()
 {
 	if (--mRefCount == 0) {
-		auto it = mUniforms.begin();
-		auto end = mUniforms.end();
-		for (; it != end; ++it) {
-			delete it->second;
+		const size_t numUniforms = mUniforms.size();
+		for (size_t i = 0; i < numUniforms; ++i) {
+			delete mUniforms[i];
 		}
 
 		delete this;
@@ -76,15 +76,22 @@ void POGLDeferredRenderState::Clear(POGL_UINT32 clearBits)
 
 IPOGLUniform* POGLDeferredRenderState::FindUniformByName(const POGL_CHAR* name)
 {
-	const POGL_STRING sname(name);
-	auto it = mUniforms.find(sname);
-	if (it == mUniforms.end()) {
-		POGLDeferredUniform* uniform = new POGLDeferredUniform(sname, mRenderContext);
-		mUniforms.insert(std::make_pair(sname, uniform));
-		return uniform;
-	}
+	return FindUniformByID(POGLUniformRegistry::GetID(POGL_STRING(name)));
+}
+
+IPOGLUniform* POGLDeferredRenderState::FindUniformByID(POGL_UINT32 uniformID)
+{
+	if (uniformID < mUniforms.size() && mUniforms[uniformID] != nullptr)
+		return mUniforms[uniformID];
+
+	if (!POGLUniformRegistry::IsValid(uniformID))
+		THROW_EXCEPTION(POGLStateException, "There is no uniform with the ID: %d", uniformID);
 
-	return it->second;
+	if (uniformID >= mUniforms.size())
+		mUniforms.resize(uniformID + 1, nullptr);
+	POGLDeferredUniform* uniform = new POGLDeferredUniform(uniformID, mRenderContext);
+	mUniforms[uniformID] = uniform;
+	return uniform;
 }
 
 void POGLDeferredRenderState::SetFramebuffer(IPOGLFramebuffer* framebuffer)
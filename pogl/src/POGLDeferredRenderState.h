@@ -2,13 +2,14 @@
 #include "config.h"
 #include "POGLDeferredStateValue.h"
 #include <memory>
+#include <vector>
 
 class POGLDeferredRenderContext;
 class POGLDeferredUniform;
 class POGLProgram;
 class POGLDeferredRenderState : public IPOGLRenderState
 {
-	typedef std::hash_map<POGL_STRING, POGLDeferredUniform*> Uniforms;
+	typedef std::vector<POGLDeferredUniform*> Uniforms;
 
 public:
 	POGLDeferredRenderState(POGLDeferredRenderContext* context);
@@ -33,6 +34,7 @@ public:
 public:
 	virtual void Clear(POGL_UINT32 clearBits);
 	virtual IPOGLUniform* FindUniformByName(const POGL_CHAR* name);
+	virtual IPOGLUniform* FindUniformByID(POGL_UINT32 uniformID);
 	virtual void SetFramebuffer(IPOGLFramebuffer* framebuffer);
 	virtual void SetVertexBuffer(IPOGLVertexBuffer* vertexBuffer);
 	virtual void SetIndexBuffer(IPOGLIndexBuffer* indexBuffer);
@@ -74,5 +76,6 @@ private:
 	POGLDeferredStateValue<POGLCullFace::Enum> mCullFace;
 	POGLDeferredStateValue<POGL_RECT> mViewport;
 
+	// The uniforms indexed by their uniform ID. IDs not used with this state are nullptr
 	Uniforms mUniforms;
 };
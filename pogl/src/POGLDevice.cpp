@@ -1,5 +1,10 @@
 ﻿#include "MemCheck.h"
 #include "POGLDevice.h"
+#include "providers/POGLBufferResourceLock.h"
+#include "providers/POGLDefaultBufferResource.h"
+#include "POGLResidencyManager.h"
+#include "POGLProgramCache.h"
+#include "POGLUniformRegistry.h"
 
 POGLDevice::POGLDevice(const POGL_DEVICE_INFO* info)
 {
@@ -39,134 +44,106 @@ POGLVendor::Enum POGLDevice::GetVendor() const
 	return POGLVendor::UNKNOWN;
 }
 
-//
-// Other
-//
-
-POGL_SIZE& POGL_SIZE::operator = (const POGL_SIZE& rhs)
+void POGLDevice::GetStatistics(POGL_DEVICE_STATISTICS* statistics) const
 {
-	width = rhs.width;
-	height = rhs.height;
-	return *this;
+	assert_not_null(statistics);
+	POGLBufferResourceLock::GetStatistics(statistics);
 }
 
-bool POGL_SIZE::operator==(const POGL_SIZE& rhs) const
+void POGLDevice::SetBufferUpdateThresholds(const POGL_BUFFER_UPDATE_THRESHOLDS* thresholds)
 {
-	return width == rhs.width;
+	assert_not_null(thresholds);
+	POGLDefaultBufferResource::SetThresholds(thresholds);
 }
 
-bool POGL_SIZE::operator!=(const POGL_SIZE& rhs) const
+const POGL_BUFFER_UPDATE_THRESHOLDS* POGLDevice::GetBufferUpdateThresholds() const
 {
-	return height != rhs.height;
+	return POGLDefaultBufferResource::GetThresholds();
 }
 
-POGL_VECTOR2& POGL_VECTOR2::operator=(const POGL_VECTOR2& rhs)
+void POGLDevice::SetMemoryBudget(POGL_UINT64 budget)
 {
-	x = rhs.x;
-	y = rhs.y;
-	return *this;
+	POGLResidencyManager::SetBudget(budget);
 }
 
-bool POGL_VECTOR2::operator==(const POGL_VECTOR2& rhs) const
+POGL_UINT64 POGLDevice::GetMemoryBudget() const
 {
-	return FLT_EQ(x, rhs.x) && FLT_EQ(y, rhs.x);
+	return POGLResidencyManager::GetBudget();
 }
 
-bool POGL_VECTOR2::operator!=(const POGL_VECTOR2& rhs) const
+void POGLDevice::GetMemoryUsage(POGL_MEMORY_USAGE* usage) const
 {
-	return FLT_NEQ(x, rhs.x) || FLT_NEQ(y, rhs.x);
+	assert_not_null(usage);
+	POGLResidencyManager::GetMemoryUsage(usage);
 }
 
-POGL_VECTOR2 POGL_VECTOR2::operator-() const
+void POGLDevice::SetProgramCacheDirectory(const POGL_CHAR* directory)
 {
-	return POGL_VECTOR2(-x, -y);
+	POGLProgramCache::SetDirectory(directory);
 }
 
-POGL_FLOAT POGL_VECTOR2::operator[](POGL_UINT32 idx) const
+const POGL_CHAR* POGLDevice::GetProgramCacheDirectory() const
 {
-	return vec[idx];
+	return POGLProgramCache::GetDirectory();
 }
 
-POGL_FLOAT& POGL_VECTOR2::operator[](POGL_UINT32 idx)
+POGL_UINT32 POGLDevice::GetUniformID(const POGL_CHAR* name)
 {
-	return vec[idx];
+	if (name == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You must supply the name of a uniform");
+
+	return POGLUniformRegistry::GetID(POGL_STRING(name));
 }
 
-POGL_VECTOR3& POGL_VECTOR3::operator = (const POGL_VECTOR3& rhs)
+//
+// Other
+//
+
+POGL_SIZE& POGL_SIZE::operator = (const POGL_SIZE& rhs)
 {
-	x = rhs.x;
-	y = rhs.y;
-	z = rhs.z;
+	width = rhs.width;
+	height = rhs.height;
 	return *this;
 }
 
-bool POGL_VECTOR3::operator==(const POGL_VECTOR3& rhs) const
+bool POGL_SIZE::operator==(const POGL_SIZE& rhs) const
 {
-	return FLT_EQ(x, rhs.x) && FLT_EQ(y, rhs.x) && FLT_EQ(z, rhs.z);
+	return width == rhs.width && height == rhs.height;
 }
 
-bool POGL_VECTOR3::operator!=(const POGL_VECTOR3& rhs) const
+bool POGL_SIZE::operator!=(const POGL_SIZE& rhs) const
 {
-	return FLT_NEQ(x, rhs.x) || FLT_NEQ(y, rhs.x) || FLT_NEQ(z, rhs.z);
+	return width != rhs.width || height != rhs.height;
 }
 
-POGL_VECTOR3 POGL_VECTOR3::operator-() const
+bool POGL_VECTOR2::operator==(const POGL_VECTOR2& rhs) const
 {
-	return POGL_VECTOR3(-x, -y, -z);
+	return FLT_EQ(x, rhs.x) && FLT_EQ(y, rhs.y);
 }
 
-POGL_FLOAT POGL_VECTOR3::operator[](POGL_UINT32 idx) const
+bool POGL_VECTOR2::operator!=(const POGL_VECTOR2& rhs) const
 {
-	return vec[idx];
+	return FLT_NEQ(x, rhs.x) || FLT_NEQ(y, rhs.y);
 }
 
-POGL_FLOAT& POGL_VECTOR3::operator[](POGL_UINT32 idx)
+bool POGL_VECTOR3::operator==(const POGL_VECTOR3& rhs) const
 {
-	return vec[idx];
+	return FLT_EQ(x, rhs.x) && FLT_EQ(y, rhs.y) && FLT_EQ(z, rhs.z);
 }
 
-POGL_VECTOR4& POGL_VECTOR4::operator = (const POGL_VECTOR4& rhs)
+bool POGL_VECTOR3::operator!=(const POGL_VECTOR3& rhs) const
 {
-	x = rhs.x;
-	y = rhs.y;
-	z = rhs.z;
-	w = rhs.w;
-	return *this;
+	return FLT_NEQ(x, rhs.x) || FLT_NEQ(y, rhs.y) || FLT_NEQ(z, rhs.z);
 }
 
 bool POGL_VECTOR4::operator==(const POGL_VECTOR4& rhs) const
 {
-	return FLT_EQ(x, rhs.x) && FLT_EQ(y, rhs.x) && FLT_EQ(z, rhs.z) && FLT_EQ(w, rhs.w);
+	return FLT_EQ(x, rhs.x) && FLT_EQ(y, rhs.y) && FLT_EQ(z, rhs.z) && FLT_EQ(w, rhs.w);
 }
 
 bool POGL_VECTOR4::operator!=(const POGL_VECTOR4& rhs) const
 {
-	return FLT_NEQ(x, rhs.x) || FLT_NEQ(y, rhs.x) || FLT_NEQ(z, rhs.z) || FLT_NEQ(w, rhs.w);
-}
-
-POGL_VECTOR4 POGL_VECTOR4::operator-() const
-{
-	return POGL_VECTOR4(-x, -y, -z, -w);
-}
-
-POGL_FLOAT POGL_VECTOR4::operator[](POGL_UINT32 idx) const
-{
-	return vec[idx];
-}
-
-POGL_FLOAT& POGL_VECTOR4::operator[](POGL_UINT32 idx)
-{
-	return vec[idx];
-}
-
-POGL_FLOAT POGL_MAT4::operator[](POGL_UINT32 idx) const
-{
-	return vec[idx];
-}
-
-POGL_FLOAT& POGL_MAT4::operator[](POGL_UINT32 idx)
-{
-	return vec[idx];
+	return FLT_NEQ(x, rhs.x) || FLT_NEQ(y, rhs.y) || FLT_NEQ(z, rhs.z) || FLT_NEQ(w, rhs.w);
 }
 
 POGL_RECT& POGL_RECT::operator = (const POGL_RECT& rhs)
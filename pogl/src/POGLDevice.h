@@ -19,6 +19,15 @@ public:
 public:
 	virtual const POGL_DEVICE_INFO* GetDeviceInfo() const;
 	virtual POGLVendor::Enum GetVendor() const;
+	virtual void GetStatistics(POGL_DEVICE_STATISTICS* statistics) const;
+	virtual void SetBufferUpdateThresholds(const POGL_BUFFER_UPDATE_THRESHOLDS* thresholds);
+	virtual const POGL_BUFFER_UPDATE_THRESHOLDS* GetBufferUpdateThresholds() const;
+	virtual void SetMemoryBudget(POGL_UINT64 budget);
+	virtual POGL_UINT64 GetMemoryBudget() const;
+	virtual void GetMemoryUsage(POGL_MEMORY_USAGE* usage) const;
+	virtual void SetProgramCacheDirectory(const POGL_CHAR* directory);
+	virtual const POGL_CHAR* GetProgramCacheDirectory() const;
+	virtual POGL_UINT32 GetUniformID(const POGL_CHAR* name);
 
 protected:
 	POGL_DEVICE_INFO mDeviceInfo;
@@ -80,6 +80,7 @@ GLenum POGLEnum::Convert(POGLBufferUsage::Enum e)
 	static GLenum values[POGLBufferUsage::COUNT] = {
 		GL_STATIC_DRAW,
 		GL_DYNAMIC_DRAW,
+		GL_STREAM_DRAW,
 		GL_STREAM_DRAW
 	};
 
@@ -297,6 +298,22 @@ GLenum POGLEnum::ConvertToTextureFormatEnum(POGLTextureFormat::Enum format)
 	case POGLTextureFormat::BGRA:
 		_format = GL_BGRA;
 		break;
+	case POGLTextureFormat::BC1_RGB:
+	case POGLTextureFormat::ETC2_RGB8:
+		_format = GL_RGB;
+		break;
+	case POGLTextureFormat::BC1_RGBA:
+	case POGLTextureFormat::BC3_RGBA:
+	case POGLTextureFormat::BC7_RGBA:
+	case POGLTextureFormat::ETC2_RGBA8:
+		_format = GL_RGBA;
+		break;
+	case POGLTextureFormat::BC4_R:
+		_format = GL_RED;
+		break;
+	case POGLTextureFormat::BC5_RG:
+		_format = GL_RG;
+		break;
 	}
 	return _format;
 }
@@ -365,10 +382,97 @@ GLenum POGLEnum::ConvertToInternalTextureFormatEnum(POGLTextureFormat::Enum form
 	case POGLTextureFormat::BGRA:
 		_internalFormat = GL_RGBA;
 		break;
+	case POGLTextureFormat::BC1_RGB:
+		_internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		break;
+	case POGLTextureFormat::BC1_RGBA:
+		_internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		break;
+	case POGLTextureFormat::BC3_RGBA:
+		_internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		break;
+	case POGLTextureFormat::BC4_R:
+		_internalFormat = GL_COMPRESSED_RED_RGTC1;
+		break;
+	case POGLTextureFormat::BC5_RG:
+		_internalFormat = GL_COMPRESSED_RG_RGTC2;
+		break;
+	case POGLTextureFormat::BC7_RGBA:
+		_internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+		break;
+	case POGLTextureFormat::ETC2_RGB8:
+		_internalFormat = GL_COMPRESSED_RGB8_ETC2;
+		break;
+	case POGLTextureFormat::ETC2_RGBA8:
+		_internalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+		break;
 	}
 	return _internalFormat;
 }
 
+GLenum POGLEnum::ConvertToTextureTypeEnum(POGLTextureFormat::Enum format)
+{
+	switch (format)
+	{
+	case POGLTextureFormat::DEPTH24_STENCIL8:
+		return GL_UNSIGNED_INT_24_8;
+	case POGLTextureFormat::DEPTH32F_STENCIL8:
+		return GL_FLOAT_32_UNSIGNED_INT_24_8_REV;
+	default:
+		return GL_UNSIGNED_BYTE;
+	}
+}
+
+GLenum POGLEnum::ConvertToNativeTextureTypeEnum(POGLTextureFormat::Enum format)
+{
+	switch (format)
+	{
+	case POGLTextureFormat::R16F:
+	case POGLTextureFormat::RGBA16F:
+		return GL_HALF_FLOAT;
+	case POGLTextureFormat::R32F:
+	case POGLTextureFormat::RGBA32F:
+	case POGLTextureFormat::DEPTH32F:
+		return GL_FLOAT;
+	case POGLTextureFormat::DEPTH24:
+		return GL_UNSIGNED_INT;
+	default:
+		return ConvertToTextureTypeEnum(format);
+	}
+}
+
+GLenum POGLEnum::ConvertToSizedInternalTextureFormatEnum(POGLTextureFormat::Enum format)
+{
+	const GLenum _internalFormat = ConvertToInternalTextureFormatEnum(format);
+	switch (_internalFormat)
+	{
+	case GL_RGB:
+		return GL_RGB8;
+	case GL_RGBA:
+		return GL_RGBA8;
+	default:
+		return _internalFormat;
+	}
+}
+
+bool POGLEnum::IsCompressedTextureFormat(POGLTextureFormat::Enum format)
+{
+	switch (format)
+	{
+	case POGLTextureFormat::BC1_RGB:
+	case POGLTextureFormat::BC1_RGBA:
+	case POGLTextureFormat::BC3_RGBA:
+	case POGLTextureFormat::BC4_R:
+	case POGLTextureFormat::BC5_RG:
+	case POGLTextureFormat::BC7_RGBA:
+	case POGLTextureFormat::ETC2_RGB8:
+	case POGLTextureFormat::ETC2_RGBA8:
+		return true;
+	default:
+		return false;
+	}
+}
+
 POGL_UINT32 POGLEnum::VertexTypeSize(POGLVertexType::Enum e)
 {
 	static const POGL_UINT32 sizes[POGLVertexType::COUNT] = {
@@ -388,23 +492,84 @@ POGL_UINT32 POGLEnum::VertexTypeSize(POGLVertexType::Enum e)
 POGL_UINT32 POGLEnum::TextureFormatToSize(POGLTextureFormat::Enum e, const POGL_SIZE& size)
 {
 	POGL_UINT32 bitsPerPixel = 0;
+	POGL_UINT32 bytesPerBlock = 0;
 	switch (e)
 	{
+	case POGLTextureFormat::BC1_RGB:
+	case POGLTextureFormat::BC1_RGBA:
+	case POGLTextureFormat::BC4_R:
+	case POGLTextureFormat::ETC2_RGB8:
+		bytesPerBlock = 8;
+		break;
+	case POGLTextureFormat::BC3_RGBA:
+	case POGLTextureFormat::BC5_RG:
+	case POGLTextureFormat::BC7_RGBA:
+	case POGLTextureFormat::ETC2_RGBA8:
+		bytesPerBlock = 16;
+		break;
 	case POGLTextureFormat::RGB:
+	case POGLTextureFormat::RGB8:
+	case POGLTextureFormat::RGB12:
+	case POGLTextureFormat::RGB16:
+	case POGLTextureFormat::RGB32:
 	case POGLTextureFormat::BGR:
 		bitsPerPixel = 24;
 		break;
 	case POGLTextureFormat::RGBA:
+	case POGLTextureFormat::RGBA8:
+	case POGLTextureFormat::RGBA12:
+	case POGLTextureFormat::RGBA16:
+	case POGLTextureFormat::RGB10_A2:
 	case POGLTextureFormat::BGRA:
+	case POGLTextureFormat::RGBA16F:
+	case POGLTextureFormat::RGBA32F:
+	case POGLTextureFormat::DEPTH24_STENCIL8:
 		bitsPerPixel = 32;
 		break;
 	case POGLTextureFormat::R:
+	case POGLTextureFormat::R16F:
+	case POGLTextureFormat::R32F:
+	case POGLTextureFormat::DEPTH24:
+	case POGLTextureFormat::DEPTH32F:
 		bitsPerPixel = 8;
 		break;
+	case POGLTextureFormat::DEPTH32F_STENCIL8:
+		bitsPerPixel = 64;
+		break;
 	default:
 		THROW_EXCEPTION(POGLException, "Cannot calculate texture format size for: %d", e);
 	}
 
+	// Partial blocks at the edges are stored as whole blocks
+	if (bytesPerBlock > 0)
+		return ((size.width + 3) / 4) * ((size.height + 3) / 4) * bytesPerBlock;
+
 	const POGL_UINT32 numComponents = bitsPerPixel / 8;
 	return size.width * size.height * numComponents;
 }
+
+POGL_UINT32 POGLEnum::TextureFormatToNativeSize(POGLTextureFormat::Enum e, const POGL_SIZE& size)
+{
+	POGL_UINT32 bytesPerPixel = 0;
+	switch (e)
+	{
+	case POGLTextureFormat::R16F:
+		bytesPerPixel = 2;
+		break;
+	case POGLTextureFormat::R32F:
+	case POGLTextureFormat::DEPTH24:
+	case POGLTextureFormat::DEPTH32F:
+		bytesPerPixel = 4;
+		break;
+	case POGLTextureFormat::RGBA16F:
+		bytesPerPixel = 8;
+		break;
+	case POGLTextureFormat::RGBA32F:
+		bytesPerPixel = 16;
+		break;
+	default:
+		return TextureFormatToSize(e, size);
+	}
+
+	return size.width * size.height * bytesPerPixel;
+}
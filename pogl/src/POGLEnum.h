@@ -27,7 +27,37 @@ public:
 	static GLenum ConvertToTextureFormatEnum(POGLTextureFormat::Enum format);
 	static GLenum ConvertToInternalTextureFormatEnum(POGLTextureFormat::Enum format);
 
+	/*!
+		\brief Converts the supplied format into the type of the client side pixel data uploaded to textures using it
+
+		Client data is one unsigned byte per channel for all formats except the packed depth-stencil formats.
+	*/
+	static GLenum ConvertToTextureTypeEnum(POGLTextureFormat::Enum format);
+
+	/*!
+		\brief Converts the supplied format into the client side type that holds the texture data without losing precision
+	*/
+	static GLenum ConvertToNativeTextureTypeEnum(POGLTextureFormat::Enum format);
+
+	/*!
+		\brief Converts the supplied format into a sized internal format. Immutable texture storage does not accept unsized formats
+	*/
+	static GLenum ConvertToSizedInternalTextureFormatEnum(POGLTextureFormat::Enum format);
+
+	/*!
+		\brief Check to see if the supplied format stores the texture data as compressed 4x4 pixel blocks
+	*/
+	static bool IsCompressedTextureFormat(POGLTextureFormat::Enum format);
+
 	static POGL_UINT32 VertexTypeSize(POGLVertexType::Enum e);
 
+	/*!
+		\brief Calculates the size of client side pixel data of the type returned by ConvertToTextureTypeEnum
+	*/
 	static POGL_UINT32 TextureFormatToSize(POGLTextureFormat::Enum e, const POGL_SIZE& size);
+
+	/*!
+		\brief Calculates the size of client side pixel data of the type returned by ConvertToNativeTextureTypeEnum
+	*/
+	static POGL_UINT32 TextureFormatToNativeSize(POGLTextureFormat::Enum e, const POGL_SIZE& size);
 };
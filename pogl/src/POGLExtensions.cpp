@@ -18,6 +18,7 @@ PFNGLGENBUFFERSPROC _poglGenBuffers = nullptr;
 PFNGLDELETEBUFFERSPROC _poglDeleteBuffers = nullptr;
 PFNGLBINDBUFFERPROC _poglBindBuffer = nullptr;
 PFNGLBUFFERDATAPROC _poglBufferData = nullptr;
+PFNGLBUFFERSUBDATAPROC _poglBufferSubData = nullptr;
 PFNGLMAPBUFFERPROC _poglMapBuffer = nullptr;
 PFNGLMAPBUFFERRANGEPROC _poglMapBufferRange = nullptr;
 PFNGLUNMAPBUFFERPROC _poglUnmapBuffer = nullptr;
@@ -83,6 +84,26 @@ PFNGLCHECKFRAMEBUFFERSTATUSPROC _poglCheckFramebufferStatus = nullptr;
 PFNGLDRAWBUFFERSPROC _poglDrawBuffers = nullptr;
 PFNGLCOPYBUFFERSUBDATAPROC _poglCopyBufferSubData = nullptr;
 PFNGLGETSTRINGIPROC _poglGetStringi = nullptr;
+PFNGLBUFFERSTORAGEPROC _poglBufferStorage = nullptr;
+PFNGLDRAWELEMENTSBASEVERTEXPROC _poglDrawElementsBaseVertex = nullptr;
+PFNGLTEXSTORAGE2DPROC _poglTexStorage2D = nullptr;
+PFNGLGENERATEMIPMAPPROC _poglGenerateMipmap = nullptr;
+PFNGLCOMPRESSEDTEXIMAGE2DPROC _poglCompressedTexImage2D = nullptr;
+PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC _poglCompressedTexSubImage2D = nullptr;
+PFNGLTEXSTORAGE1DPROC _poglTexStorage1D = nullptr;
+PFNGLTEXSTORAGE3DPROC _poglTexStorage3D = nullptr;
+PFNGLTEXIMAGE3DPROC _poglTexImage3D = nullptr;
+PFNGLTEXSUBIMAGE3DPROC _poglTexSubImage3D = nullptr;
+PFNGLCOMPRESSEDTEXIMAGE3DPROC _poglCompressedTexImage3D = nullptr;
+PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC _poglCompressedTexSubImage3D = nullptr;
+PFNGLFRAMEBUFFERTEXTURE2DPROC _poglFramebufferTexture2D = nullptr;
+PFNGLFRAMEBUFFERTEXTURELAYERPROC _poglFramebufferTextureLayer = nullptr;
+PFNGLGETBUFFERSUBDATAPROC _poglGetBufferSubData = nullptr;
+PFNGLGETCOMPRESSEDTEXIMAGEPROC _poglGetCompressedTexImage = nullptr;
+PFNGLGETPROGRAMBINARYPROC _poglGetProgramBinary = nullptr;
+PFNGLPROGRAMBINARYPROC _poglProgramBinary = nullptr;
+PFNGLPROGRAMPARAMETERIPROC _poglProgramParameteri = nullptr;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC _poglMaxShaderCompilerThreadsKHR = nullptr;
 #ifdef WIN32
 PFNWGLCREATECONTEXTATTRIBSARBPROC _powglCreateContextAttribsARB = nullptr;
 #endif
@@ -93,6 +114,7 @@ bool POGLLoadExtensions()
 	POGL_SET_EXTENSION_FUNC(PFNGLDELETEBUFFERSPROC, glDeleteBuffers);
 	POGL_SET_EXTENSION_FUNC(PFNGLBINDBUFFERPROC, glBindBuffer);
 	POGL_SET_EXTENSION_FUNC(PFNGLBUFFERDATAPROC, glBufferData);
+	POGL_SET_EXTENSION_FUNC(PFNGLBUFFERSUBDATAPROC, glBufferSubData);
 	POGL_SET_EXTENSION_FUNC(PFNGLMAPBUFFERPROC, glMapBuffer);
 	POGL_SET_EXTENSION_FUNC(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange);
 	POGL_SET_EXTENSION_FUNC(PFNGLUNMAPBUFFERPROC, glUnmapBuffer);
@@ -158,6 +180,28 @@ bool POGLLoadExtensions()
 	POGL_SET_EXTENSION_FUNC(PFNGLDRAWBUFFERSPROC, glDrawBuffers);
 	POGL_SET_EXTENSION_FUNC(PFNGLCOPYBUFFERSUBDATAPROC, glCopyBufferSubData);
 	POGL_SET_EXTENSION_FUNC(PFNGLGETSTRINGIPROC, glGetStringi);
+	POGL_SET_EXTENSION_FUNC(PFNGLBUFFERSTORAGEPROC, glBufferStorage);
+	POGL_SET_EXTENSION_FUNC(PFNGLDRAWELEMENTSBASEVERTEXPROC, glDrawElementsBaseVertex);
+	POGL_SET_EXTENSION_FUNC(PFNGLTEXSTORAGE2DPROC, glTexStorage2D);
+	POGL_SET_EXTENSION_FUNC(PFNGLGENERATEMIPMAPPROC, glGenerateMipmap);
+	POGL_SET_EXTENSION_FUNC(PFNGLCOMPRESSEDTEXIMAGE2DPROC, glCompressedTexImage2D);
+	POGL_SET_EXTENSION_FUNC(PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC, glCompressedTexSubImage2D);
+	POGL_SET_EXTENSION_FUNC(PFNGLTEXSTORAGE1DPROC, glTexStorage1D);
+	POGL_SET_EXTENSION_FUNC(PFNGLTEXSTORAGE3DPROC, glTexStorage3D);
+	POGL_SET_EXTENSION_FUNC(PFNGLTEXIMAGE3DPROC, glTexImage3D);
+	POGL_SET_EXTENSION_FUNC(PFNGLTEXSUBIMAGE3DPROC, glTexSubImage3D);
+	POGL_SET_EXTENSION_FUNC(PFNGLCOMPRESSEDTEXIMAGE3DPROC, glCompressedTexImage3D);
+	POGL_SET_EXTENSION_FUNC(PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC, glCompressedTexSubImage3D);
+	POGL_SET_EXTENSION_FUNC(PFNGLFRAMEBUFFERTEXTURE2DPROC, glFramebufferTexture2D);
+	POGL_SET_EXTENSION_FUNC(PFNGLFRAMEBUFFERTEXTURELAYERPROC, glFramebufferTextureLayer);
+	POGL_SET_EXTENSION_FUNC(PFNGLGETBUFFERSUBDATAPROC, glGetBufferSubData);
+	POGL_SET_EXTENSION_FUNC(PFNGLGETCOMPRESSEDTEXIMAGEPROC, glGetCompressedTexImage);
+	POGL_SET_EXTENSION_FUNC(PFNGLGETPROGRAMBINARYPROC, glGetProgramBinary);
+	POGL_SET_EXTENSION_FUNC(PFNGLPROGRAMBINARYPROC, glProgramBinary);
+	POGL_SET_EXTENSION_FUNC(PFNGLPROGRAMPARAMETERIPROC, glProgramParameteri);
+	POGL_SET_EXTENSION_FUNC(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC, glMaxShaderCompilerThreadsKHR);
+	if (glMaxShaderCompilerThreadsKHR == nullptr)
+		glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)POGLLoadExtension("glMaxShaderCompilerThreadsARB");
 	
 #ifdef WIN32
 	POGL_SET_EXTENSION_FUNC(PFNWGLCREATECONTEXTATTRIBSARBPROC, wglCreateContextAttribsARB);
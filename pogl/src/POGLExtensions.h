@@ -21,10 +21,18 @@
 
 #include "glext.h"
 
+// GL_KHR_parallel_shader_compile is newer than the bundled glext.h
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) (GLuint count);
+#endif
+
 extern PFNGLGENBUFFERSPROC _poglGenBuffers;
 extern PFNGLDELETEBUFFERSPROC _poglDeleteBuffers;
 extern PFNGLBINDBUFFERPROC _poglBindBuffer;
 extern PFNGLBUFFERDATAPROC _poglBufferData;
+extern PFNGLBUFFERSUBDATAPROC _poglBufferSubData;
 extern PFNGLMAPBUFFERPROC _poglMapBuffer;
 extern PFNGLMAPBUFFERRANGEPROC _poglMapBufferRange;
 extern PFNGLUNMAPBUFFERPROC _poglUnmapBuffer;
@@ -90,11 +98,32 @@ extern PFNGLCHECKFRAMEBUFFERSTATUSPROC _poglCheckFramebufferStatus;
 extern PFNGLDRAWBUFFERSPROC _poglDrawBuffers;
 extern PFNGLCOPYBUFFERSUBDATAPROC _poglCopyBufferSubData;
 extern PFNGLGETSTRINGIPROC _poglGetStringi;
+extern PFNGLBUFFERSTORAGEPROC _poglBufferStorage;
+extern PFNGLDRAWELEMENTSBASEVERTEXPROC _poglDrawElementsBaseVertex;
+extern PFNGLTEXSTORAGE2DPROC _poglTexStorage2D;
+extern PFNGLGENERATEMIPMAPPROC _poglGenerateMipmap;
+extern PFNGLCOMPRESSEDTEXIMAGE2DPROC _poglCompressedTexImage2D;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC _poglCompressedTexSubImage2D;
+extern PFNGLTEXSTORAGE1DPROC _poglTexStorage1D;
+extern PFNGLTEXSTORAGE3DPROC _poglTexStorage3D;
+extern PFNGLTEXIMAGE3DPROC _poglTexImage3D;
+extern PFNGLTEXSUBIMAGE3DPROC _poglTexSubImage3D;
+extern PFNGLCOMPRESSEDTEXIMAGE3DPROC _poglCompressedTexImage3D;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC _poglCompressedTexSubImage3D;
+extern PFNGLFRAMEBUFFERTEXTURE2DPROC _poglFramebufferTexture2D;
+extern PFNGLFRAMEBUFFERTEXTURELAYERPROC _poglFramebufferTextureLayer;
+extern PFNGLGETBUFFERSUBDATAPROC _poglGetBufferSubData;
+extern PFNGLGETCOMPRESSEDTEXIMAGEPROC _poglGetCompressedTexImage;
+extern PFNGLGETPROGRAMBINARYPROC _poglGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC _poglProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC _poglProgramParameteri;
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC _poglMaxShaderCompilerThreadsKHR;
 
 #define glGenBuffers _poglGenBuffers
 #define glDeleteBuffers _poglDeleteBuffers
 #define glBindBuffer _poglBindBuffer
 #define glBufferData _poglBufferData
+#define glBufferSubData _poglBufferSubData
 #define glMapBuffer _poglMapBuffer
 #define glMapBufferRange _poglMapBufferRange
 #define glUnmapBuffer _poglUnmapBuffer
@@ -160,6 +189,26 @@ extern PFNGLGETSTRINGIPROC _poglGetStringi;
 #define glDrawBuffers _poglDrawBuffers
 #define glCopyBufferSubData _poglCopyBufferSubData
 #define glGetStringi _poglGetStringi
+#define glBufferStorage _poglBufferStorage
+#define glDrawElementsBaseVertex _poglDrawElementsBaseVertex
+#define glTexStorage2D _poglTexStorage2D
+#define glGenerateMipmap _poglGenerateMipmap
+#define glCompressedTexImage2D _poglCompressedTexImage2D
+#define glCompressedTexSubImage2D _poglCompressedTexSubImage2D
+#define glTexStorage1D _poglTexStorage1D
+#define glTexStorage3D _poglTexStorage3D
+#define glTexImage3D _poglTexImage3D
+#define glTexSubImage3D _poglTexSubImage3D
+#define glCompressedTexImage3D _poglCompressedTexImage3D
+#define glCompressedTexSubImage3D _poglCompressedTexSubImage3D
+#define glFramebufferTexture2D _poglFramebufferTexture2D
+#define glFramebufferTextureLayer _poglFramebufferTextureLayer
+#define glGetBufferSubData _poglGetBufferSubData
+#define glGetCompressedTexImage _poglGetCompressedTexImage
+#define glGetProgramBinary _poglGetProgramBinary
+#define glProgramBinary _poglProgramBinary
+#define glProgramParameteri _poglProgramParameteri
+#define glMaxShaderCompilerThreadsKHR _poglMaxShaderCompilerThreadsKHR
 
 #ifdef WIN32
 extern PFNWGLCREATECONTEXTATTRIBSARBPROC _powglCreateContextAttribsARB;
@@ -4,6 +4,7 @@
 #include "POGLTexture2D.h"
 #include "POGLTextureResource.h"
 #include "POGLShader.h"
+#include <algorithm>
 
 GLuint POGLFactory::GenSamplerID()
 {
@@ -29,21 +30,200 @@ GLuint POGLFactory::GenTextureID()
 	return id;
 }
 
+void POGLFactory::TexStorage(GLenum target, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels)
+{
+	CheckTextureFormatSupported(format);
+
+	static const bool textureStorage = POGLExtensionAvailable(POGL_TOCHAR("GL_ARB_texture_storage")) && glTexStorage2D != nullptr;
+	if (textureStorage) {
+		const GLenum _internalFormat = POGLEnum::ConvertToSizedInternalTextureFormatEnum(format);
+		switch (target) {
+		case GL_TEXTURE_1D:
+			glTexStorage1D(target, mipLevels, _internalFormat, size.width);
+			break;
+		case GL_TEXTURE_3D:
+		case GL_TEXTURE_2D_ARRAY:
+			glTexStorage3D(target, mipLevels, _internalFormat, size.width, size.height, depth);
+			break;
+		default:
+			glTexStorage2D(target, mipLevels, _internalFormat, size.width, size.height);
+			break;
+		}
+	}
+	else {
+		POGL_SIZE levelSize = size;
+		POGL_UINT32 levelDepth = depth;
+		for (POGL_UINT32 level = 0; level < mipLevels; ++level) {
+			if (target == GL_TEXTURE_CUBE_MAP) {
+				for (POGL_UINT32 face = 0; face < POGLCubeFace::COUNT; ++face)
+					TexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, levelSize, 1, format, nullptr);
+			}
+			else
+				TexImage(target, level, levelSize, levelDepth, format, nullptr);
+
+			levelSize.width = (std::max)(1, levelSize.width / 2);
+			levelSize.height = (std::max)(1, levelSize.height / 2);
+			if (target == GL_TEXTURE_3D)
+				levelDepth = (std::max)(1U, levelDepth / 2);
+		}
+	}
+
+	// Textures are incomplete unless the sampled levels are limited to the allocated ones
+	glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
+}
+
+void POGLFactory::TexImage(GLenum target, POGL_UINT32 mipLevel, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, const void* bytes)
+{
+	TexImage(target, mipLevel, size, depth, format, POGLEnum::ConvertToTextureTypeEnum(format), bytes);
+}
+
+void POGLFactory::TexImage(GLenum target, POGL_UINT32 mipLevel, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, GLenum _type, const void* bytes)
+{
+	CheckTextureFormatSupported(format);
+
+	const GLenum _internalFormat = POGLEnum::ConvertToInternalTextureFormatEnum(format);
+	const GLenum _format = POGLEnum::ConvertToTextureFormatEnum(format);
+	const bool compressed = POGLEnum::IsCompressedTextureFormat(format);
+	switch (target) {
+	case GL_TEXTURE_1D:
+		glTexImage1D(target, mipLevel, _internalFormat, size.width, 0, _format, _type, bytes);
+		break;
+	case GL_TEXTURE_3D:
+	case GL_TEXTURE_2D_ARRAY:
+		if (compressed) {
+			const POGL_UINT32 imageSize = POGLEnum::TextureFormatToSize(format, size) * depth;
+			glCompressedTexImage3D(target, mipLevel, _internalFormat, size.width, size.height, depth, 0, imageSize, bytes);
+		}
+		else
+			glTexImage3D(target, mipLevel, _internalFormat, size.width, size.height, depth, 0, _format, _type, bytes);
+		break;
+	default:
+		if (compressed) {
+			const POGL_UINT32 imageSize = POGLEnum::TextureFormatToSize(format, size);
+			glCompressedTexImage2D(target, mipLevel, _internalFormat, size.width, size.height, 0, imageSize, bytes);
+		}
+		else
+			glTexImage2D(target, mipLevel, _internalFormat, size.width, size.height, 0, _format, _type, bytes);
+		break;
+	}
+}
+
+void POGLFactory::TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, const void* bytes)
+{
+	TexSubImage(target, mipLevel, layer, rect, format, POGLEnum::ConvertToTextureTypeEnum(format), bytes);
+}
+
+void POGLFactory::TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, GLenum _type, const void* bytes)
+{
+	const GLenum _format = POGLEnum::ConvertToTextureFormatEnum(format);
+	const bool compressed = POGLEnum::IsCompressedTextureFormat(format);
+	const GLenum _internalFormat = POGLEnum::ConvertToInternalTextureFormatEnum(format);
+	const POGL_UINT32 imageSize = compressed ? POGLEnum::TextureFormatToSize(format, POGL_SIZE(rect.width, rect.height)) : 0;
+	switch (target) {
+	case GL_TEXTURE_1D:
+		glTexSubImage1D(target, mipLevel, rect.x, rect.width, _format, _type, bytes);
+		break;
+	case GL_TEXTURE_3D:
+	case GL_TEXTURE_2D_ARRAY:
+		if (compressed)
+			glCompressedTexSubImage3D(target, mipLevel, rect.x, rect.y, layer, rect.width, rect.height, 1, _internalFormat, imageSize, bytes);
+		else
+			glTexSubImage3D(target, mipLevel, rect.x, rect.y, layer, rect.width, rect.height, 1, _format, _type, bytes);
+		break;
+	default: {
+		const GLenum imageTarget = target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer : target;
+		if (compressed)
+			glCompressedTexSubImage2D(imageTarget, mipLevel, rect.x, rect.y, rect.width, rect.height, _internalFormat, imageSize, bytes);
+		else
+			glTexSubImage2D(imageTarget, mipLevel, rect.x, rect.y, rect.width, rect.height, _format, _type, bytes);
+		break;
+	}
+	}
+}
+
+GLuint POGLFactory::CreateTextureStorage(GLenum target, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	// Only textures with a mipmap chain sample the smaller mip levels when no sampler object is bound
+	const GLenum minFilter = POGLEnum::Convert(mipLevels > 1 ? POGLMinFilter::LINEAR_MIPMAP_LINEAR : POGLMinFilter::DEFAULT);
+	const GLenum magFilter = POGLEnum::Convert(POGLMagFilter::DEFAULT);
+	const GLenum textureWrap = POGLEnum::Convert(POGLTextureWrap::DEFAULT);
+
+	const GLuint textureID = GenTextureID();
+	glBindTexture(target, textureID);
+
+	TexStorage(target, size, depth, format, mipLevels);
+	if (bytes != nullptr) {
+		const POGL_UINT32 layers = target == GL_TEXTURE_CUBE_MAP ? (POGL_UINT32)POGLCubeFace::COUNT : depth;
+		const POGL_UINT32 layerSize = POGLEnum::TextureFormatToSize(format, size);
+		const POGL_BYTE* layerBytes = (const POGL_BYTE*)bytes;
+		for (POGL_UINT32 layer = 0; layer < layers; ++layer) {
+			TexSubImage(target, 0, layer, POGL_RECT(0, 0, size.width, size.height), format, layerBytes);
+			layerBytes += layerSize;
+		}
+	}
+	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
+	glTexParameteri(target, GL_TEXTURE_MAG_FILTER, magFilter);
+	glTexParameteri(target, GL_TEXTURE_WRAP_S, textureWrap);
+	glTexParameteri(target, GL_TEXTURE_WRAP_T, textureWrap);
+	glTexParameteri(target, GL_TEXTURE_WRAP_R, textureWrap);
+
+	const GLenum status = glGetError();
+	if (status != GL_NO_ERROR) {
+		glDeleteTextures(1, &textureID);
+		THROW_EXCEPTION(POGLResourceException, "Could not create texture. Reason: 0x%x", status);
+	}
+
+	return textureID;
+}
+
+void POGLFactory::CheckTextureFormatSupported(POGLTextureFormat::Enum format)
+{
+	static const bool s3tc = POGLExtensionAvailable(POGL_TOCHAR("GL_EXT_texture_compression_s3tc"));
+	static const bool bptc = POGLExtensionAvailable(POGL_TOCHAR("GL_ARB_texture_compression_bptc"));
+	static const bool etc2 = POGLExtensionAvailable(POGL_TOCHAR("GL_ARB_ES3_compatibility"));
+
+	bool supported = true;
+	switch (format) {
+	case POGLTextureFormat::BC1_RGB:
+	case POGLTextureFormat::BC1_RGBA:
+	case POGLTextureFormat::BC3_RGBA:
+		supported = s3tc;
+		break;
+	case POGLTextureFormat::BC7_RGBA:
+		supported = bptc;
+		break;
+	case POGLTextureFormat::ETC2_RGB8:
+	case POGLTextureFormat::ETC2_RGBA8:
+		supported = etc2;
+		break;
+	default:
+		break;
+	}
+
+	if (!supported)
+		THROW_EXCEPTION(POGLResourceException, "The graphics card does not support the texture format: %d", format);
+}
+
 GLuint POGLFactory::CreateShader(const POGL_CHAR* memory, POGL_UINT32 size, POGLShaderType::Enum type)
 {
 	if (size == 0 || memory == nullptr)
 		THROW_EXCEPTION(POGLResourceException, "You cannot generate a non-existing shader");
 
+	// The compile status is checked by CheckShader, so that the driver can compile multiple shaders in parallel
 	const GLuint shaderID = glCreateShader(POGLEnum::Convert(type));
 	glShaderSource(shaderID, 1, (const GLchar**)&memory, (const GLint*)&size);
 	glCompileShader(shaderID);
+	return shaderID;
+}
 
+void POGLFactory::CheckShader(GLuint shaderID, POGLShaderType::Enum type)
+{
 	GLint status = 0;
 	glGetShaderiv(shaderID, GL_COMPILE_STATUS, &status);
 	if (!status) {
 		GLchar infoLogg[2048];
 		glGetShaderInfoLog(shaderID, 2048, NULL, infoLogg);
-		glDeleteShader(shaderID);
 		switch (type) {
 		case POGLShaderType::GEOMETRY_SHADER:
 			THROW_EXCEPTION(POGLResourceException, "Could not compile geometry shader. Reason: '%s'", infoLogg);
@@ -55,39 +235,40 @@ GLuint POGLFactory::CreateShader(const POGL_CHAR* memory, POGL_UINT32 size, POGL
 			THROW_EXCEPTION(POGLResourceException, "Could not compile shader. Reason: '%s'", infoLogg);
 		}
 	}
-
-	return shaderID;
 }
 
-
-GLuint POGLFactory::CreateProgram(IPOGLShader** shaders, POGL_UINT32 count)
+GLuint POGLFactory::CreateProgram(IPOGLShader** shaders, POGL_UINT32 count, bool binaryRetrievable)
 {
 	// Attach all the shaders to the program
 	const GLuint programID = glCreateProgram();
+	if (binaryRetrievable)
+		glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 	for (POGL_UINT32 i = 0; i < count; ++i) {
 		POGLShader* shader = static_cast<POGLShader*>(shaders[i]);
 		glAttachShader(programID, shader->GetShaderID());
 
 	}
 
-	// Link program
+	// Link program. The link status is checked by CheckProgram
 	glLinkProgram(programID);
 
-	// Detach the shaders when linking is complete: http://www.opengl.org/wiki/GLSL_Object
+	// Detaching doesn't wait for the link to complete: http://www.opengl.org/wiki/GLSL_Object
 	for (POGL_UINT32 i = 0; i < count; ++i) {
 		POGLShader* shader = static_cast<POGLShader*>(shaders[i]);
 		glDetachShader(programID, shader->GetShaderID());
 	}
 
-	// Verify program
+	return programID;
+}
+
+void POGLFactory::CheckProgram(GLuint programID)
+{
 	GLint status = 0;
 	glGetProgramiv(programID, GL_LINK_STATUS, &status);
-	GLchar infoLogg[2048] = { 0 };
-	glGetProgramInfoLog(programID, sizeof(infoLogg)-1, NULL, infoLogg);
 	if (!status) {
-		glDeleteProgram(programID);
+		GLchar infoLogg[2048] = { 0 };
+		glGetProgramInfoLog(programID, sizeof(infoLogg)-1, NULL, infoLogg);
 		THROW_EXCEPTION(POGLResourceException, "Could not link the supplied shader programs. Reason: %s", infoLogg);
 	}
-
-	return programID;
-}
\ No newline at end of file
+}
@@ -15,12 +15,86 @@ public:
 	static GLuint GenTextureID();
 
 	/*!
-		\brief Creates a shader OpenGL ID based on the supplied parameters
+		\brief Allocates storage for all mip levels of the texture bound to the supplied target
+
+		Immutable storage is used if the driver supports it. Otherwise each mip level is allocated using TexImage. The depth is the
+		depth of 3D textures and the number of layers of 2D array textures. It's ignored for all other targets.
+	*/
+	static void TexStorage(GLenum target, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels);
+
+	/*!
+		\brief Allocates mutable storage for a mip level of the texture bound to the supplied target
+
+		The target can be one of the cube face targets. Compressed formats are allocated using glCompressedTexImage, in which case
+		the bytes must contain the compressed blocks. Uncompressed bytes are of the type returned by POGLEnum::ConvertToTextureTypeEnum.
+	*/
+	static void TexImage(GLenum target, POGL_UINT32 mipLevel, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, const void* bytes);
+
+	/*!
+		\brief Allocates mutable storage for a mip level of the texture bound to the supplied target using bytes of the supplied type
+	*/
+	static void TexImage(GLenum target, POGL_UINT32 mipLevel, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, GLenum type, const void* bytes);
+
+	/*!
+		\brief Updates a part of one layer in a mip level of the texture bound to the supplied target
+
+		The layer is the array layer, cube face or depth slice. The bytes are read from the buffer bound to GL_PIXEL_UNPACK_BUFFER
+		if one is bound. Uncompressed bytes are of the type returned by POGLEnum::ConvertToTextureTypeEnum.
+	*/
+	static void TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, const void* bytes);
+
+	/*!
+		\brief Updates a part of one layer in a mip level of the texture bound to the supplied target using bytes of the supplied type
+	*/
+	static void TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, GLenum type, const void* bytes);
+
+	/*!
+		\brief Generates a texture with immutable storage for the supplied target and uploads the base level
+
+		The texture is left bound to the active texture unit. The bytes contain all layers of the base level, one after another.
+
+		\return The texture ID
+	*/
+	static GLuint CreateTextureStorage(GLenum target, const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes);
+
+	/*!
+		\brief Throws an exception if the graphics card cannot sample textures with the supplied format
+	*/
+	static void CheckTextureFormatSupported(POGLTextureFormat::Enum format);
+
+	/*!
+		\brief Creates a shader OpenGL ID based on the supplied parameters and starts compiling it
+
+		The compilation might not be complete when this method returns. Use CheckShader to wait for the result.
 	*/
 	static GLuint CreateShader(const POGL_CHAR* memory, POGL_UINT32 size, POGLShaderType::Enum type);
 
 	/*!
-		\brief Creates a program ID based on the supplied shaders
+		\brief Wait for the supplied shader to be compiled
+
+		\throws POGLResourceException
+				If the shader could not be compiled
+	*/
+	static void CheckShader(GLuint shaderID, POGLShaderType::Enum type);
+
+	/*!
+		\brief Creates a program ID based on the supplied shaders and starts linking it
+
+		The link might not be complete when this method returns. Use CheckProgram to wait for the result.
+
+		\param shaders
+				Shaders created by CreateShader. They don't have to be compiled yet
+		\param count
+		\param binaryRetrievable
+				Hint the driver that the program binary will be retrieved using glGetProgramBinary
+	*/
+	static GLuint CreateProgram(IPOGLShader** shaders, POGL_UINT32 count, bool binaryRetrievable);
+
+	/*!
+		\brief Wait for the supplied program to be linked
+
+		\throws POGLResourceException
+				If the program could not be linked
 	*/
-	static GLuint CreateProgram(IPOGLShader** shaders, POGL_UINT32 count);
+	static void CheckProgram(GLuint programID);
 };
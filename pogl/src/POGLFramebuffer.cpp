@@ -1,7 +1,8 @@
 #include "MemCheck.h"
 #include "POGLFramebuffer.h"
-#include "POGLTexture2D.h"
+#include "POGLTextureUtils.h"
 #include "POGLTextureResource.h"
+#include "POGLResidencyManager.h"
 
 namespace {
 	std::atomic<POGL_UINT32> uid;
@@ -11,13 +12,24 @@ namespace {
 }
 
 POGLFramebuffer::POGLFramebuffer(std::vector<IPOGLTexture*>& textures, IPOGLTexture* depthStencilTexture)
-: mRefCount(1), mUID(0), mFramebufferID(0), mTextures(textures), mDepthStencilTexture(depthStencilTexture)
+: mRefCount(1), mUID(0), mFramebufferID(0), mDepthStencil(depthStencilTexture, 0, POGL_ALL_LAYERS)
 {
-	for (POGL_UINT32 i = 0; i < mTextures.size(); ++i) {
-		mTextures[i]->AddRef();
+	for (POGL_UINT32 i = 0; i < textures.size(); ++i) {
+		mAttachments.push_back(POGL_FRAMEBUFFER_ATTACHMENT(textures[i], 0, POGL_ALL_LAYERS));
+		textures[i]->AddRef();
 	}
-	if (mDepthStencilTexture != nullptr)
-		mDepthStencilTexture->AddRef();
+	if (mDepthStencil.texture != nullptr)
+		mDepthStencil.texture->AddRef();
+}
+
+POGLFramebuffer::POGLFramebuffer(std::vector<POGL_FRAMEBUFFER_ATTACHMENT>& attachments, const POGL_FRAMEBUFFER_ATTACHMENT& depthStencil)
+: mRefCount(1), mUID(0), mFramebufferID(0), mAttachments(attachments), mDepthStencil(depthStencil)
+{
+	for (POGL_UINT32 i = 0; i < mAttachments.size(); ++i) {
+		mAttachments[i].texture->AddRef();
+	}
+	if (mDepthStencil.texture != nullptr)
+		mDepthStencil.texture->AddRef();
 }
 
 POGLFramebuffer::~POGLFramebuffer()
@@ -37,10 +49,18 @@ void POGLFramebuffer::Release()
 			mFramebufferID = 0;
 		}
 
-		POGL_SAFE_RELEASE(mDepthStencilTexture);
-		POGL_UINT32 size = mTextures.size();
+		// The textures can be evicted again once no framebuffer renders into them
+		if (mUID != 0) {
+			if (mDepthStencil.texture != nullptr)
+				POGLTextureUtils::GetResourcePtr(mDepthStencil.texture)->RemoveFramebufferAttachment();
+			for (POGL_UINT32 i = 0; i < mAttachments.size(); ++i)
+				POGLTextureUtils::GetResourcePtr(mAttachments[i].texture)->RemoveFramebufferAttachment();
+		}
+
+		POGL_SAFE_RELEASE(mDepthStencil.texture);
+		POGL_UINT32 size = mAttachments.size();
 		for (POGL_UINT32 i = 0; i < size; ++i) {
-			POGL_SAFE_RELEASE(mTextures[i]);
+			POGL_SAFE_RELEASE(mAttachments[i].texture);
 		}
 		delete this;
 	}
@@ -48,23 +68,60 @@ void POGLFramebuffer::Release()
 
 IPOGLTexture* POGLFramebuffer::GetTexture(POGL_UINT32 idx)
 {
-	if (mTextures.size() <= idx)
+	if (mAttachments.size() <= idx)
 		THROW_EXCEPTION(POGLResourceException, "There is no texture bound at index: %d", idx);
 
-	IPOGLTexture* texture = mTextures[idx];
+	IPOGLTexture* texture = mAttachments[idx].texture;
 	texture->AddRef();
 	return texture;
 }
 
 IPOGLTexture* POGLFramebuffer::GetDepthStencilTexture()
 {
-	if (mDepthStencilTexture != nullptr) {
-		mDepthStencilTexture->AddRef();
-		return mDepthStencilTexture;
+	if (mDepthStencil.texture != nullptr) {
+		mDepthStencil.texture->AddRef();
+		return mDepthStencil.texture;
 	}
 	return nullptr;
 }
 
+void POGLFramebuffer::AttachTexture(GLenum attachmentType, const POGL_FRAMEBUFFER_ATTACHMENT& attachment)
+{
+	IPOGLTexture* texture = attachment.texture;
+	POGLTextureResource* resource = POGLTextureUtils::GetResourcePtr(texture);
+	if (resource == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You cannot attach a non-texture resource to a framebuffer");
+
+	if (attachment.mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLResourceException, "The texture does not have mip level %d", attachment.mipLevel);
+
+	// The texture might have been evicted since it was last bound
+	POGLResidencyManager::Touch(resource);
+	const GLuint textureID = resource->GetTextureID();
+	if (attachment.layer == POGL_ALL_LAYERS) {
+		// Layered rendering for array, cube and 3D textures. The geometry shader selects the layer
+		glFramebufferTexture(GL_FRAMEBUFFER, attachmentType, textureID, attachment.mipLevel);
+	}
+	else {
+		if (attachment.layer >= POGLTextureUtils::GetLayers(texture, attachment.mipLevel))
+			THROW_EXCEPTION(POGLResourceException, "Mip level %d of the texture does not have layer %d", attachment.mipLevel, attachment.layer);
+
+		switch (resource->GetTextureTarget()) {
+		case GL_TEXTURE_CUBE_MAP:
+			glFramebufferTexture2D(GL_FRAMEBUFFER, attachmentType, GL_TEXTURE_CUBE_MAP_POSITIVE_X + attachment.layer, textureID, attachment.mipLevel);
+			break;
+		case GL_TEXTURE_3D:
+		case GL_TEXTURE_2D_ARRAY:
+			glFramebufferTextureLayer(GL_FRAMEBUFFER, attachmentType, textureID, attachment.mipLevel, attachment.layer);
+			break;
+		default:
+			glFramebufferTexture(GL_FRAMEBUFFER, attachmentType, textureID, attachment.mipLevel);
+			break;
+		}
+	}
+	CHECK_GL("Could not attach framebuffer texture to frame buffer");
+}
+
 void POGLFramebuffer::PostConstruct()
 {
 	glGenFramebuffers(1, &mFramebufferID);
@@ -76,45 +133,26 @@ void POGLFramebuffer::PostConstruct()
 	glBindFramebuffer(GL_FRAMEBUFFER, mFramebufferID);
 	CHECK_GL("Could not bind framebuffer");
 
-	const POGL_UINT32 numTextures = mTextures.size();
-	for (POGL_UINT32 i = 0; i < numTextures; ++i) {
-		IPOGLTexture* texture = mTextures[i];
-		const POGLResourceType::Enum type = texture->GetType();
-		if (type == POGLResourceType::TEXTURE2D) {
-			POGLTexture2D* t2d = static_cast<POGLTexture2D*>(texture);
-			POGLTextureResource* resource = t2d->GetResourcePtr();
-			glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, resource->GetTextureID(), 0);
-			CHECK_GL("Could not attach framebuffer texture to frame buffer");
-		}
-		else {
-			THROW_NOT_IMPLEMENTED_EXCEPTION();
-		}
+	const POGL_UINT32 numAttachments = mAttachments.size();
+	for (POGL_UINT32 i = 0; i < numAttachments; ++i) {
+		AttachTexture(GL_COLOR_ATTACHMENT0 + i, mAttachments[i]);
 	}
 
-	if (mDepthStencilTexture != nullptr) {
-		const POGLResourceType::Enum type = mDepthStencilTexture->GetType();
-		if (type == POGLResourceType::TEXTURE2D) {
-			POGLTexture2D* t2d = static_cast<POGLTexture2D*>(mDepthStencilTexture);
-			POGLTextureResource* resource = t2d->GetResourcePtr();
-			GLenum attachmentType = GL_DEPTH_ATTACHMENT;
-			switch (resource->GetTextureFormat()) {
-			case POGLTextureFormat::DEPTH24:
-			case POGLTextureFormat::DEPTH32F:
-				attachmentType = GL_DEPTH_ATTACHMENT;
-				break;
-			case POGLTextureFormat::DEPTH24_STENCIL8:
-			case POGLTextureFormat::DEPTH32F_STENCIL8:
-				attachmentType = GL_DEPTH_STENCIL_ATTACHMENT;
-				break;
-			default:
-				THROW_EXCEPTION(POGLResourceException, "You cannot bind a non-depth-stencil texture as a depth buffer");
-			}
-			glFramebufferTexture(GL_FRAMEBUFFER, attachmentType, resource->GetTextureID(), 0);
-
-		}
-		else {
-			THROW_NOT_IMPLEMENTED_EXCEPTION();
+	if (mDepthStencil.texture != nullptr) {
+		GLenum attachmentType = GL_DEPTH_ATTACHMENT;
+		switch (mDepthStencil.texture->GetTextureFormat()) {
+		case POGLTextureFormat::DEPTH24:
+		case POGLTextureFormat::DEPTH32F:
+			attachmentType = GL_DEPTH_ATTACHMENT;
+			break;
+		case POGLTextureFormat::DEPTH24_STENCIL8:
+		case POGLTextureFormat::DEPTH32F_STENCIL8:
+			attachmentType = GL_DEPTH_STENCIL_ATTACHMENT;
+			break;
+		default:
+			THROW_EXCEPTION(POGLResourceException, "You cannot bind a non-depth-stencil texture as a depth buffer");
 		}
+		AttachTexture(attachmentType, mDepthStencil);
 	}
 
 	//
@@ -152,6 +190,13 @@ void POGLFramebuffer::PostConstruct()
 		break;
 	}
 
+	// Framebuffers render into the attached textures without binding them, so they must stay resident
+	for (POGL_UINT32 i = 0; i < numAttachments; ++i) {
+		POGLTextureUtils::GetResourcePtr(mAttachments[i].texture)->AddFramebufferAttachment();
+	}
+	if (mDepthStencil.texture != nullptr)
+		POGLTextureUtils::GetResourcePtr(mDepthStencil.texture)->AddFramebufferAttachment();
+
 	mUID = GenFramebufferID();
 }
 
@@ -6,6 +6,7 @@ class POGLFramebuffer : public IPOGLFramebuffer
 {
 public:
 	POGLFramebuffer(std::vector<IPOGLTexture*>& textures, IPOGLTexture* depthStencilTexture);
+	POGLFramebuffer(std::vector<POGL_FRAMEBUFFER_ATTACHMENT>& attachments, const POGL_FRAMEBUFFER_ATTACHMENT& depthStencil);
 	virtual ~POGLFramebuffer();
 
 	/*!
@@ -26,7 +27,7 @@ public:
 		\brief Retrieves the number of draw buffers 
 	*/
 	inline POGL_UINT32 GetNumDrawBuffers() {
-		return mTextures.size();
+		return mAttachments.size();
 	}
 
 	/*!
@@ -34,6 +35,12 @@ public:
 	*/
 	void PostConstruct();
 
+private:
+	/*!
+		\brief Attach the mip level and layer of the supplied attachment to the bound framebuffer
+	*/
+	void AttachTexture(GLenum attachmentType, const POGL_FRAMEBUFFER_ATTACHMENT& attachment);
+
 // IPOGLInterface
 public:
 	virtual void AddRef();
@@ -48,6 +55,6 @@ private:
 	REF_COUNTER mRefCount;
 	POGL_UID mUID;
 	GLuint mFramebufferID;
-	std::vector<IPOGLTexture*> mTextures;
-	IPOGLTexture* mDepthStencilTexture;
+	std::vector<POGL_FRAMEBUFFER_ATTACHMENT> mAttachments;
+	POGL_FRAMEBUFFER_ATTACHMENT mDepthStencil;
 };
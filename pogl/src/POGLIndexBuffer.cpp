@@ -1,6 +1,7 @@
 #include "MemCheck.h"
 #include "POGLIndexBuffer.h"
 #include "POGLRenderState.h"
+#include "POGLResidencyManager.h"
 #include "providers/POGLDefaultBufferResource.h"
 
 namespace {
@@ -11,12 +12,17 @@ namespace {
 }
 
 POGLIndexBuffer::POGLIndexBuffer(POGL_UINT32 typeSize, POGL_UINT32 numIndices, GLenum elementType, POGLBufferUsage::Enum bufferUsage, IPOGLBufferResourceProvider* provider)
-: mRefCount(1), mUID(0), mTypeSize(typeSize), mNumIndices(numIndices), mElementType(elementType), mBufferID(0), mBufferResource(nullptr)
+: POGLResidentResource(POGLResidentType::INDEX_BUFFER), mRefCount(1), mUID(0), mTypeSize(typeSize), mNumIndices(numIndices), mElementType(elementType), mBufferID(0), mBufferResource(nullptr)
 {
 	const POGL_UINT32 memorySize = typeSize * numIndices;
 	mBufferResource = provider->CreateBuffer(memorySize, GL_ELEMENT_ARRAY_BUFFER, bufferUsage);
 }
 
+POGLIndexBuffer::POGLIndexBuffer(POGL_UINT32 typeSize, POGL_UINT32 numIndices, GLenum elementType, IPOGLBufferResource* bufferResource)
+: POGLResidentResource(POGLResidentType::INDEX_BUFFER), mRefCount(1), mUID(0), mTypeSize(typeSize), mNumIndices(numIndices), mElementType(elementType), mBufferID(0), mBufferResource(bufferResource)
+{
+}
+
 POGLIndexBuffer::~POGLIndexBuffer()
 {
 }
@@ -25,6 +31,7 @@ void POGLIndexBuffer::PostConstruct(POGLRenderState* renderState)
 {
 	mBufferID = mBufferResource->PostConstruct(renderState);
 	mUID = GenIndexBufferUID();
+	POGLResidencyManager::Add(this);
 
 	// Ensure that the index buffer is bound
 	renderState->ForceSetIndexBuffer(this);
@@ -38,6 +45,7 @@ void POGLIndexBuffer::AddRef()
 void POGLIndexBuffer::Release()
 {
 	if (--mRefCount == 0) {
+		POGLResidencyManager::Remove(this);
 		if (mBufferResource != nullptr) {
 			mBufferResource->Release();
 			mBufferResource = nullptr;
@@ -56,6 +64,16 @@ POGL_UINT32 POGLIndexBuffer::GetCount() const
 	return mNumIndices;
 }
 
+void POGLIndexBuffer::SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy)
+{
+	mBufferResource->SetUpdateStrategy(strategy);
+}
+
+POGLBufferUpdateStrategy::Enum POGLIndexBuffer::GetUpdateStrategy() const
+{
+	return mBufferResource->GetUpdateStrategy();
+}
+
 void* POGLIndexBuffer::Map(POGLResourceMapType::Enum e)
 {
 	return mBufferResource->Map(e);
@@ -71,24 +89,47 @@ void POGLIndexBuffer::Unmap()
 	return mBufferResource->Unmap();
 }
 
-void POGLIndexBuffer::DrawIndexed(GLenum primitiveType)
+void POGLIndexBuffer::DrawIndexed(GLenum primitiveType, POGL_UINT32 baseVertex)
 {
 	mBufferResource->Lock();
-	glDrawElements(primitiveType, mNumIndices, mElementType, NULL);
+	DrawElements(primitiveType, mNumIndices, 0, baseVertex);
 	mBufferResource->Unlock();
 }
 
-void POGLIndexBuffer::DrawIndexed(GLenum primitiveType, POGL_UINT32 count)
+void POGLIndexBuffer::DrawIndexed(GLenum primitiveType, POGL_UINT32 baseVertex, POGL_UINT32 count)
 {
 	mBufferResource->Lock(0, count * mTypeSize);
-	glDrawElements(primitiveType, count, mElementType, NULL);
+	DrawElements(primitiveType, count, 0, baseVertex);
 	mBufferResource->Unlock();
 }
 
-void POGLIndexBuffer::DrawIndexed(GLenum primitiveType, POGL_UINT32 count, POGL_UINT32 offset)
+void POGLIndexBuffer::DrawIndexed(GLenum primitiveType, POGL_UINT32 baseVertex, POGL_UINT32 count, POGL_UINT32 offset)
 {
 	mBufferResource->Lock(offset * mTypeSize, count * mTypeSize);
-	const GLvoid* indices = (const GLvoid*)(offset * mTypeSize);
-	glDrawElements(primitiveType, count, mElementType, indices);
+	DrawElements(primitiveType, count, offset, baseVertex);
 	mBufferResource->Unlock();
 }
+
+void POGLIndexBuffer::DrawElements(GLenum primitiveType, POGL_UINT32 count, POGL_UINT32 offset, POGL_UINT32 baseVertex)
+{
+	const GLvoid* indices = (const GLvoid*)(mBufferResource->GetRegionOffset() + offset * mTypeSize);
+	if (baseVertex == 0)
+		glDrawElements(primitiveType, count, mElementType, indices);
+	else
+		glDrawElementsBaseVertex(primitiveType, count, mElementType, indices, baseVertex);
+}
+
+POGL_UINT64 POGLIndexBuffer::GetResidentMemorySize() const
+{
+	return mTypeSize * mNumIndices;
+}
+
+bool POGLIndexBuffer::Evict()
+{
+	return mBufferResource->Evict();
+}
+
+void POGLIndexBuffer::Restore()
+{
+	mBufferResource->Restore();
+}
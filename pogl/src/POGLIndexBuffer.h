@@ -1,11 +1,13 @@
 #pragma once
 #include "IPOGLBufferResourceProvider.h"
+#include "POGLResidentResource.h"
 
 class POGLRenderState;
-class POGLIndexBuffer : public IPOGLIndexBuffer
+class POGLIndexBuffer : public IPOGLIndexBuffer, public POGLResidentResource
 {
 public:
 	POGLIndexBuffer(POGL_UINT32 typeSize, POGL_UINT32 numIndices, GLenum type, POGLBufferUsage::Enum bufferUsage, IPOGLBufferResourceProvider* provider);
+	POGLIndexBuffer(POGL_UINT32 typeSize, POGL_UINT32 numIndices, GLenum type, IPOGLBufferResource* bufferResource);
 	~POGLIndexBuffer();
 
 	/*!
@@ -35,9 +37,16 @@ public:
 	void* Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e);
 	void Unmap();
 
-	void DrawIndexed(GLenum primitiveType);
-	void DrawIndexed(GLenum primitiveType, POGL_UINT32 count);
-	void DrawIndexed(GLenum primitiveType, POGL_UINT32 count, POGL_UINT32 offset);
+	/*!
+		\brief Draw the indices in this buffer
+
+		\param primitiveType
+		\param baseVertex
+				A constant added to each index. Used when the vertex buffer is split into multiple regions
+	*/
+	void DrawIndexed(GLenum primitiveType, POGL_UINT32 baseVertex);
+	void DrawIndexed(GLenum primitiveType, POGL_UINT32 baseVertex, POGL_UINT32 count);
+	void DrawIndexed(GLenum primitiveType, POGL_UINT32 baseVertex, POGL_UINT32 count, POGL_UINT32 offset);
 
 // IPOGLInterface
 public:
@@ -51,6 +60,17 @@ public:
 // IPOGLIndexBuffer
 public:
 	virtual POGL_UINT32 GetCount() const;
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy);
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const;
+
+// POGLResidentResource
+public:
+	virtual POGL_UINT64 GetResidentMemorySize() const;
+	virtual bool Evict();
+	virtual void Restore();
+
+private:
+	void DrawElements(GLenum primitiveType, POGL_UINT32 count, POGL_UINT32 offset, POGL_UINT32 baseVertex);
 
 private:
 	REF_COUNTER mRefCount;
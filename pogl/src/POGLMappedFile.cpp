@@ -0,0 +1,46 @@
+#include "MemCheck.h"
+#include "config.h"
+
+//
+// The Win32 version is in win32/Win32POGLMappedFile.cpp
+//
+
+#if !defined(WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+POGLMappedFile::POGLMappedFile(const POGL_CHAR* fileName)
+: mBytes(nullptr), mSize(0)
+{
+	const int fileDescriptor = open(fileName, O_RDONLY);
+	if (fileDescriptor == -1)
+		THROW_EXCEPTION(POGLResourceException, "File not found: %s", fileName);
+
+	struct stat st;
+	if (fstat(fileDescriptor, &st) != 0) {
+		close(fileDescriptor);
+		THROW_EXCEPTION(POGLResourceException, "Could not read file: %s", fileName);
+	}
+
+	mSize = (POGL_UINT32)st.st_size;
+	if (mSize == 0) {
+		close(fileDescriptor);
+		return;
+	}
+
+	// The mapping keeps the file open, so the file descriptor isn't needed afterwards
+	void* bytes = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (bytes == MAP_FAILED)
+		THROW_EXCEPTION(POGLResourceException, "Could not map file: %s", fileName);
+	mBytes = (const POGL_BYTE*)bytes;
+}
+
+POGLMappedFile::~POGLMappedFile()
+{
+	if (mBytes != nullptr)
+		munmap((void*)mBytes, mSize);
+}
+#endif
@@ -0,0 +1,93 @@
+#include "MemCheck.h"
+#include "POGLPixelUnpackRing.h"
+#include "POGLFactory.h"
+#include "POGLEnum.h"
+#include "POGLConvertPixels.h"
+#include <algorithm>
+
+POGLPixelUnpackRing::POGLPixelUnpackRing()
+: mBufferID(0), mMemorySize(0), mOffset(0)
+{
+}
+
+POGLPixelUnpackRing::~POGLPixelUnpackRing()
+{
+	if (mBufferID != 0) {
+		glDeleteBuffers(1, &mBufferID);
+		mBufferID = 0;
+	}
+}
+
+void POGLPixelUnpackRing::TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, const void* bytes, POGL_UINT32 size)
+{
+	POGL_UINT32 offset = 0;
+	void* dst = Map(size, &offset);
+	memcpy(dst, bytes, size);
+	Unmap(target, mipLevel, layer, rect, format, POGLEnum::ConvertToTextureTypeEnum(format), offset, size);
+}
+
+void POGLPixelUnpackRing::TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, POGLSourceFormat::Enum srcFormat,
+	const void* bytes, POGL_UINT32 convertFlags)
+{
+	// Validate before mapping, so that the ring is never left mapped
+	POGLCheckPixelConversion(srcFormat, format, convertFlags);
+
+	const POGL_UINT32 size = POGLEnum::TextureFormatToNativeSize(format, POGL_SIZE(rect.width, rect.height));
+	POGL_UINT32 offset = 0;
+	void* dst = Map(size, &offset);
+	POGLConvertPixels(bytes, srcFormat, dst, format, rect.width * rect.height, convertFlags);
+	Unmap(target, mipLevel, layer, rect, format, POGLEnum::ConvertToNativeTextureTypeEnum(format), offset, size);
+}
+
+void* POGLPixelUnpackRing::Map(POGL_UINT32 size, POGL_UINT32* _out_offset)
+{
+	if (mBufferID == 0) {
+		glGenBuffers(1, &mBufferID);
+		if (mBufferID == 0)
+			THROW_EXCEPTION(POGLResourceException, "Could not generate pixel unpack buffer ID. Reason: 0x%x", glGetError());
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, mBufferID);
+	if (size > mMemorySize)
+		Reserve(size);
+
+	// Wrap around to the beginning if the data does not fit at the end of the ring
+	POGL_UINT32 offset = ((mOffset + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+	if (offset + size > mMemorySize)
+		offset = 0;
+
+	// The GPU might still copy data from this part of the ring
+	mLock.WaitClientAndClear(offset, size);
+
+	void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (dst == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "Could not map the pixel unpack buffer. Reason: 0x%x", glGetError());
+
+	*_out_offset = offset;
+	return dst;
+}
+
+void POGLPixelUnpackRing::Unmap(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, GLenum type,
+	POGL_UINT32 offset, POGL_UINT32 size)
+{
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	POGLFactory::TexSubImage(target, mipLevel, layer, rect, format, type, OFFSET(offset));
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	CHECK_GL("Could not update the texture");
+
+	mLock.PrepareFence(offset, size);
+	mLock.AddFences();
+	mOffset = offset + size;
+}
+
+void POGLPixelUnpackRing::Reserve(POGL_UINT32 size)
+{
+	// Everything in the old buffer must be copied before it's replaced
+	mLock.WaitClientAndClear();
+
+	mMemorySize = (std::max)((std::max)(mMemorySize * 2, (POGL_UINT32)DEFAULT_SIZE), size);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, mMemorySize, nullptr, GL_STREAM_DRAW);
+	CHECK_GL("Could not allocate pixel unpack buffer memory");
+	mOffset = 0;
+}
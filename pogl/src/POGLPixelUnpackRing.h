@@ -0,0 +1,92 @@
+#pragma once
+#include "config.h"
+#include "providers/POGLBufferResourceLock.h"
+
+/*!
+	\brief Streams texture data to the graphics card through a ring of pixel unpack buffer memory
+
+	Each upload is written into the next free part of the ring and the GPU copies it into the texture. The memory is guarded by fences, so
+	the CPU only waits if it catches up with data that the GPU has not yet copied.
+*/
+class POGLPixelUnpackRing
+{
+public:
+	/* The initial size of the ring */
+	static const POGL_UINT32 DEFAULT_SIZE = 4 * 1024 * 1024;
+
+	/* Each upload starts on a multiple of this value */
+	static const POGL_UINT32 ALIGNMENT = 16;
+
+	POGLPixelUnpackRing();
+	~POGLPixelUnpackRing();
+
+	/*!
+		\brief Upload the supplied pixels into a part of the texture bound to the supplied target
+
+		\param target
+				The texture target
+		\param mipLevel
+		\param layer
+				The array layer, cube face or depth slice to update. Ignored for 1D and 2D textures
+		\param rect
+				The part of the layer to update
+		\param format
+				The texture format of the data
+		\param bytes
+				The tightly packed pixel data
+		\param size
+				The size of the pixel data in bytes
+	*/
+	void TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, const void* bytes, POGL_UINT32 size);
+
+	/*!
+		\brief Convert the supplied pixels straight into the ring and upload them into a part of the texture bound to the supplied target
+
+		\param target
+				The texture target
+		\param mipLevel
+		\param layer
+				The array layer, cube face or depth slice to update. Ignored for 1D and 2D textures
+		\param rect
+				The part of the layer to update
+		\param format
+				The texture format the pixels are converted into
+		\param srcFormat
+				The layout of the supplied pixels
+		\param bytes
+				The tightly packed pixel data
+		\param convertFlags
+				A combination of POGLConvertFlags
+	*/
+	void TexSubImage(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, POGLSourceFormat::Enum srcFormat,
+		const void* bytes, POGL_UINT32 convertFlags);
+
+private:
+	/*!
+		\brief Map the next free part of the ring, large enough for the supplied amount of bytes, and bind the ring to GL_PIXEL_UNPACK_BUFFER
+
+		\param size
+				The number of bytes to map
+		\param _out_offset
+				The offset of the mapped part of the ring
+		\return A pointer to the mapped memory
+	*/
+	void* Map(POGL_UINT32 size, POGL_UINT32* _out_offset);
+
+	/*!
+		\brief Unmap the ring and let the GPU copy the mapped part into the texture bound to the supplied target
+	*/
+	void Unmap(GLenum target, POGL_UINT32 mipLevel, POGL_UINT32 layer, const POGL_RECT& rect, POGLTextureFormat::Enum format, GLenum type,
+		POGL_UINT32 offset, POGL_UINT32 size);
+
+	/*!
+		\brief Grow the ring so that at least the supplied amount of bytes fits into it
+	*/
+	void Reserve(POGL_UINT32 size);
+
+private:
+	GLuint mBufferID;
+	POGL_UINT32 mMemorySize;
+	POGL_UINT32 mOffset;
+	POGLBufferResourceLock mLock;
+};
@@ -8,13 +8,14 @@
 #include "uniforms/POGLUniformFloat.h"
 #include "uniforms/POGLUniformDouble.h"
 #include "uniforms/POGLUniformMat4.h"
-#include "uniforms/POGLUniformSampler2D.h"
+#include "uniforms/POGLUniformSampler.h"
 #include "POGLRenderContext.h"
 #include "POGLRenderState.h"
 #include "POGLFactory.h"
 #include "POGLEnum.h"
 #include "POGLSamplerObject.h"
 #include "POGLStringUtils.h"
+#include "POGLUniformRegistry.h"
 
 namespace {
 	std::atomic<POGL_UINT32> ids;
@@ -26,7 +27,8 @@ namespace {
 static POGLUniformNotFound POGL_UNIFORM_NOT_FOUND;
 
 POGLProgram::POGLProgram()
-: mRefCount(1), mProgramID(0), mUID(0)
+: mRefCount(1), mProgramID(0), mUID(0), mSnapshotInvalid(false),
+mApplyStaticUniforms(false), mRenderState(nullptr), mPending(false)
 {
 }
 
@@ -43,6 +45,8 @@ void POGLProgram::AddRef()
 void POGLProgram::Release()
 {
 	if (--mRefCount == 0) {
+		mSnapshot.uniforms.clear();
+
 		auto globalIt = mStaticUniforms.begin();
 		auto globalEnd = mStaticUniforms.end();
 		for (; globalIt != globalEnd; ++globalIt) {
@@ -55,6 +59,11 @@ void POGLProgram::Release()
 			delete it->second;
 		}
 
+		if (mPending) {
+			POGLProgramCache::ReleaseProgram(&mLink);
+			mProgramID = 0;
+		}
+
 		if (mProgramID != 0) {
 			glDeleteProgram(mProgramID);
 			mProgramID = 0;
@@ -64,34 +73,92 @@ void POGLProgram::Release()
 	}
 }
 
-void POGLProgram::PostConstruct(GLuint programID, POGLRenderState* renderState)
+void POGLProgram::PostConstruct(GLuint programID, const POGLProgramUniforms& uniforms, POGLRenderState* renderState)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 
 	mProgramID = programID;
+	CreateUniforms(uniforms, renderState);
+}
+
+void POGLProgram::PostConstructAsync(const POGL_PROGRAM_LINK& link, POGLRenderState* renderState)
+{
+	std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+	mLink = link;
+	mProgramID = link.programID;
+	mRenderState = renderState;
+	mPending = true;
+}
+
+bool POGLProgram::IsReady()
+{
+	std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+	if (mUID != 0)
+		return true;
+
+	// Not submitted yet by the deferred render context
+	if (!mPending && mErrorMessage.empty())
+		return false;
+
+	if (mPending && !POGLProgramCache::IsProgramComplete(mLink))
+		return false;
+
+	Resolve();
+	return true;
+}
+
+void POGLProgram::Wait()
+{
+	std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+	if (mUID != 0)
+		return;
+
+	if (!mPending && mErrorMessage.empty())
+		THROW_EXCEPTION(POGLProgramException, "The program has not been submitted to the driver yet. Execute the deferred render context first");
+
+	Resolve();
+}
+
+void POGLProgram::Resolve()
+{
+	if (!mErrorMessage.empty())
+		THROW_EXCEPTION(POGLResourceException, "%s", mErrorMessage.c_str());
+
+	try {
+		POGLProgramCache::EndCreateProgram(&mLink);
+	}
+	catch (POGLException& e) {
+		// The program is released by EndCreateProgram
+		mErrorMessage = e.GetMessage();
+		mPending = false;
+		mProgramID = 0;
+		throw;
+	}
+
+	mPending = false;
+	POGLProgramUniforms uniforms;
+	uniforms.swap(mLink.uniforms);
+	CreateUniforms(uniforms, mRenderState);
+	mRenderState = nullptr;
+}
+
+void POGLProgram::CreateUniforms(const POGLProgramUniforms& uniforms, POGLRenderState* renderState)
+{
 	const POGL_UINT32 programUID = GenProgramUID();
 	
 	//
 	// Prepare uniforms
 	//
 
-	GLint numUniforms = 0;
-	glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &numUniforms);
-	GLchar nameData[256] = { 0 };
-	for (GLint uniformIndex = 0; uniformIndex < numUniforms; ++uniformIndex) {
-		GLint arraySize = 0;
-		GLenum uniformType = 0;
-		GLsizei actualLength = 0;
-
-		//
-		// http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml
-		// 
-
-		glGetActiveUniform(programID, uniformIndex, sizeof(nameData), &actualLength, &arraySize, &uniformType, nameData);
-		nameData[actualLength] = 0;
-
-		const POGL_STRING name = POGLStringUtils::ToString(nameData);
-		const GLint componentID = glGetUniformLocation(programID, nameData);
+	const POGL_UINT32 numUniforms = uniforms.size();
+	for (POGL_UINT32 uniformIndex = 0; uniformIndex < numUniforms; ++uniformIndex) {
+		const POGL_PROGRAM_UNIFORM& programUniform = uniforms[uniformIndex];
+		const GLenum uniformType = programUniform.type;
+		const GLint componentID = programUniform.location;
+		const POGL_STRING name = POGLStringUtils::ToString(programUniform.name);
 
 		// Set default properties????
 
@@ -124,10 +191,15 @@ void POGLProgram::PostConstruct(GLuint programID, POGLRenderState* renderState)
 		case GL_FLOAT_MAT4:
 			uniform = new POGLUniformMat4(programUID, renderState, componentID, uniformType);
 			break;
+		case GL_SAMPLER_1D:
 		case GL_SAMPLER_2D:
-			uniform = new POGLUniformSampler2D(programUID, renderState, componentID, renderState->NextActiveTexture(), GenSamplerObject(renderState), uniformType);
-			break;
+		case GL_SAMPLER_3D:
 		case GL_SAMPLER_CUBE:
+		case GL_SAMPLER_2D_ARRAY:
+		case GL_SAMPLER_2D_SHADOW:
+		case GL_SAMPLER_2D_ARRAY_SHADOW:
+		case GL_SAMPLER_CUBE_SHADOW:
+			uniform = new POGLUniformSampler(programUID, renderState, componentID, renderState->NextActiveTexture(), GenSamplerObject(renderState), uniformType);
 			break;
 		}
 
@@ -138,10 +210,17 @@ void POGLProgram::PostConstruct(GLuint programID, POGLRenderState* renderState)
 
 		mUniforms.insert(std::make_pair(name, uniform));
 
+		const POGL_UINT32 uniformID = POGLUniformRegistry::GetID(name);
+		if (uniformID >= mUniformsByID.size())
+			mUniformsByID.resize(uniformID + 1, nullptr);
+		mUniformsByID[uniformID] = uniform;
+
 		// Associate any uniforms already created
 		auto staticUniform = mStaticUniforms.find(name);
-		if (staticUniform != mStaticUniforms.end())
+		if (staticUniform != mStaticUniforms.end()) {
 			staticUniform->second->SetAssociatedUniform(uniform);
+			mApplyStaticUniforms = true;
+		}
 	}
 
 	mUID = programUID;
@@ -158,18 +237,42 @@ void POGLProgram::ApplyStateUniforms()
 	CHECK_GL("Could not apply uniforms");
 }
 
-void POGLProgram::ApplyStaticUniforms()
+const POGLProgramData& POGLProgram::ApplySnapshot()
 {
-	std::lock_guard<std::recursive_mutex> lock(mMutex);
+	// A program locked by another thread is most likely in the middle of a batch of changes. Use the previous snapshot
+	// instead of waiting for it
+	if (mSnapshotInvalid.load(std::memory_order_acquire) && mMutex.try_lock()) {
+		mSnapshotInvalid.store(false, std::memory_order_relaxed);
+		mSnapshot.data = mData;
+		mSnapshot.uniforms.clear();
+		mSnapshot.uniforms.reserve(mStaticUniforms.size());
+		auto it = mStaticUniforms.begin();
+		auto end = mStaticUniforms.end();
+		for (; it != end; ++it) {
+			mSnapshot.uniforms.push_back(std::make_pair(it->second, it->second->GetValue()));
+		}
+		mMutex.unlock();
+		mApplyStaticUniforms = true;
+	}
 
-	auto it = mStaticUniforms.begin();
-	auto end = mStaticUniforms.end();
-	for (; it != end; ++it) {
-		auto global = it->second;
-		global->Apply();
+	if (mApplyStaticUniforms) {
+		mApplyStaticUniforms = false;
+
+		auto it = mSnapshot.uniforms.begin();
+		auto end = mSnapshot.uniforms.end();
+		for (; it != end; ++it) {
+			it->first->Apply(it->second);
+		}
+
+		CHECK_GL("Could not apply default uniforms");
 	}
 
-	CHECK_GL("Could not apply default uniforms");
+	return mSnapshot.data;
+}
+
+void POGLProgram::InvalidateSnapshot()
+{
+	mSnapshotInvalid.store(true, std::memory_order_release);
 }
 
 POGLSamplerObject* POGLProgram::GenSamplerObject(POGLRenderState* renderState)
@@ -202,20 +305,40 @@ IPOGLUniform* POGLProgram::FindStateUniformByName(const POGL_STRING& name)
 	if (it == mUniforms.end()) {
 		return &POGL_UNIFORM_NOT_FOUND;
 	}
-	return it->second;
+	return GetStateUniform(it->second);
+}
+
+IPOGLUniform* POGLProgram::FindStateUniformByID(POGL_UINT32 uniformID)
+{
+	if (uniformID >= mUniformsByID.size())
+		return &POGL_UNIFORM_NOT_FOUND;
+	return GetStateUniform(mUniformsByID[uniformID]);
+}
+
+IPOGLUniform* POGLProgram::GetStateUniform(POGLDefaultUniform* uniform)
+{
+	if (uniform == nullptr)
+		return &POGL_UNIFORM_NOT_FOUND;
+
+	// The render state might override the static value, which must be restored the next time the program is applied
+	if (uniform->HasStaticUniform())
+		mApplyStaticUniforms = true;
+	return uniform;
 }
 
 IPOGLUniform* POGLProgram::FindUniformByName(const POGL_CHAR* name)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 
-	auto it = mStaticUniforms.find(POGL_STRING(name));
+	const POGL_STRING nameStr(name);
+	auto it = mStaticUniforms.find(nameStr);
 	if (it == mStaticUniforms.end()) {
-		auto uniform = FindStateUniformByName(name);
-		POGLDefaultUniform* defaultUniform = static_cast<POGLDefaultUniform*>(uniform);
-		POGLStaticUniform* staticUniform = new POGLStaticUniform();
-		staticUniform->SetAssociatedUniform(defaultUniform);
-		mStaticUniforms.insert(std::make_pair(POGL_STRING(name), staticUniform));
+		// Programs that are not linked yet associate the uniform when they're resolved
+		auto uniform = mUniforms.find(nameStr);
+		POGLStaticUniform* staticUniform = new POGLStaticUniform(this);
+		staticUniform->SetAssociatedUniform(uniform != mUniforms.end() ? uniform->second : nullptr);
+		mStaticUniforms.insert(std::make_pair(nameStr, staticUniform));
+		InvalidateSnapshot();
 		return staticUniform;
 	}
 	return it->second;
@@ -236,12 +359,14 @@ void POGLProgram::SetDepthTest(bool b)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.depthTest = b;
+	InvalidateSnapshot();
 }
 
 void POGLProgram::SetDepthFunc(POGLDepthFunc::Enum depthFunc)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.depthFunc = depthFunc;
+	InvalidateSnapshot();
 }
 
 POGLDepthFunc::Enum POGLProgram::GetDepthFunc()
@@ -260,6 +385,7 @@ void POGLProgram::SetDepthMask(bool b)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.depthMask = b;
+	InvalidateSnapshot();
 }
 
 POGL_UINT8 POGLProgram::GetColorMask()
@@ -272,6 +398,7 @@ void POGLProgram::SetColorMask(POGL_UINT8 colorMask)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.colorMask = colorMask;
+	InvalidateSnapshot();
 }
 
 bool POGLProgram::GetStencilTest()
@@ -284,6 +411,7 @@ void POGLProgram::SetStencilTest(bool b)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.stencilTest = b;
+	InvalidateSnapshot();
 }
 
 POGL_UINT32 POGLProgram::GetStencilMask()
@@ -296,6 +424,7 @@ void POGLProgram::SetStencilMask(POGL_UINT32 mask)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.stencilMask = mask;
+	InvalidateSnapshot();
 }
 
 void POGLProgram::SetBlendFunc(POGLSrcFactor::Enum sfactor, POGLDstFactor::Enum dfactor)
@@ -303,18 +432,21 @@ void POGLProgram::SetBlendFunc(POGLSrcFactor::Enum sfactor, POGLDstFactor::Enum
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.srcFactor = sfactor;
 	mData.dstFactor = dfactor;
+	InvalidateSnapshot();
 }
 
 void POGLProgram::SetBlend(bool b)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.blending = b;
+	InvalidateSnapshot();
 }
 
 void POGLProgram::SetFrontFace(POGLFrontFace::Enum e)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.frontFace = e;
+	InvalidateSnapshot();
 }
 
 POGLFrontFace::Enum POGLProgram::GetFrontFace()
@@ -327,6 +459,7 @@ void POGLProgram::SetCullFace(POGLCullFace::Enum e)
 {
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	mData.cullFace = e;
+	InvalidateSnapshot();
 }
 
 POGLCullFace::Enum POGLProgram::GetCullFace()
@@ -334,10 +467,3 @@ POGLCullFace::Enum POGLProgram::GetCullFace()
 	std::lock_guard<std::recursive_mutex> lock(mMutex);
 	return mData.cullFace;
 }
-
-void POGLProgram::CopyProgramData(POGLProgramData* _out_Data)
-{
-	assert_not_null(_out_Data);
-	std::lock_guard<std::recursive_mutex> lock(mMutex);
-	*_out_Data = mData;
-}
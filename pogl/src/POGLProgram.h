@@ -1,14 +1,26 @@
 #pragma once
 #include "POGLProgramData.h"
+#include "POGLProgramCache.h"
+#include "uniforms/POGLStaticUniform.h"
 #include <mutex>
 #include <memory>
+#include <vector>
 
 struct POGLUniformProperty;
 class POGLDefaultUniform;
 class POGLRenderContext;
 class POGLRenderState;
 class POGLSamplerObject;
-class POGLStaticUniform;
+
+/*!
+	\brief A copy of the program data and static uniform values, used by the thread owning the render context
+*/
+struct POGLProgramSnapshot
+{
+	POGLProgramData data;
+	std::vector<std::pair<POGLStaticUniform*, POGL_STATIC_UNIFORM_VALUE>> uniforms;
+};
+
 class POGLProgram : public IPOGLProgram
 {
 	typedef std::hash_map<POGL_STRING, POGLDefaultUniform*> Uniforms;
@@ -25,10 +37,32 @@ public:
 
 		\param programID
 				The OpenGL program ID
+		\param uniforms
+				The active uniforms in the program
 		\param renderState
 				The render state
 	*/
-	void PostConstruct(GLuint programID, POGLRenderState* renderState);
+	void PostConstruct(GLuint programID, const POGLProgramUniforms& uniforms, POGLRenderState* renderState);
+
+	/*!
+		\brief Method called after the program has been submitted to the driver, but before it's been compiled and linked
+
+		The uniforms are created, and the unique ID assigned, when the program is resolved. This method is only allowed to
+		be invoked from the main thread.
+
+		\param link
+				The submitted program
+		\param renderState
+				The render state
+	*/
+	void PostConstructAsync(const POGL_PROGRAM_LINK& link, POGLRenderState* renderState);
+
+	/*!
+		\brief Check to see if the program has been submitted to the driver but not resolved yet
+	*/
+	inline bool IsPending() const {
+		return mPending;
+	}
 	
 	/*!
 		\brief Retrieves a unique ID for this effect
@@ -49,23 +83,37 @@ public:
 	}
 	
 	/*!
-		\brief Copy the effect data to the supplied instance
+		\brief Apply all default uniform properties
+	*/
+	void ApplyStateUniforms();
+
+	/*!
+		\brief Refresh the snapshot if the program has changed and apply its static uniform values
 
-		\param _out_Data
-				The target instance we want to set the program data to
+		This method never blocks. The snapshot is only refreshed if the program has changed since it was last refreshed and
+		if the program isn't locked by another thread at the time, otherwise the previous snapshot is used until the next
+		time this method is invoked. The static uniforms are only applied if the snapshot has been refreshed, or if a
+		uniform set by a static uniform has been retrieved from the render state, since the last time this method was
+		invoked. This method is only allowed to be invoked from the thread owning the render context.
+
+		\return The program data in the snapshot
 	*/
-	void CopyProgramData(POGLProgramData* _out_Data);
+	const POGLProgramData& ApplySnapshot();
 
 	/*!
-		\brief Apply all default uniform properties
+		\brief Mark the snapshot as out of date. The mutex must be held
+
+		The snapshot is refreshed the next time the program is applied, so a batch of changes only results in one copy.
 	*/
-	void ApplyStateUniforms();
+	void InvalidateSnapshot();
 
 	/*!
-		\brief Apply the global uniform properties
+		\brief Retrieves the mutex protecting the program data and static uniform values
 	*/
-	void ApplyStaticUniforms();
-	
+	inline std::recursive_mutex& GetMutex() {
+		return mMutex;
+	}
+
 	/*!
 		\brief Generate a sampler object based on the supplied property
 
@@ -93,8 +141,21 @@ public:
 	*/
 	IPOGLUniform* FindStateUniformByName(const POGL_STRING& name);
 
+	/*!
+		\brief Retrieves a uniform based on the given uniform ID
+
+		This method doesn't lock the program, since the uniforms are only created on the thread owning the render context
+
+		\param uniformID
+				An ID returned by POGLUniformRegistry::GetID
+		\return A valid uniform object
+	*/
+	IPOGLUniform* FindStateUniformByID(POGL_UINT32 uniformID);
+
 // IPOGLProgram
 public:
+	virtual bool IsReady();
+	virtual void Wait();
 	virtual IPOGLUniform* FindUniformByName(const POGL_CHAR* name);
 	virtual bool GetDepthTest();
 	virtual void SetDepthTest(bool b);
@@ -124,6 +185,29 @@ public:
 public:
 	virtual POGLResourceType::Enum GetType() const;
 
+private:
+	/*!
+		\brief Create the uniforms and assign the unique ID
+	*/
+	void CreateUniforms(const POGLProgramUniforms& uniforms, POGLRenderState* renderState);
+
+	/*!
+		\brief Wait for the submitted program to be compiled and linked and create the uniforms
+
+		\throws POGLResourceException
+				If a shader could not be compiled or the program could not be linked
+	*/
+	void Resolve();
+
+	/*!
+		\brief Mark the static uniforms to be applied again if the supplied uniform is set by a static uniform
+
+		\param uniform
+				The uniform returned to the render state. Might be nullptr
+		\return A valid uniform object
+	*/
+	IPOGLUniform* GetStateUniform(POGLDefaultUniform* uniform);
+
 private:
 	REF_COUNTER mRefCount;
 	GLuint mProgramID;
@@ -133,4 +217,22 @@ private:
 
 	Uniforms mUniforms;
 	StaticUniforms mStaticUniforms;
+
+	// Set by InvalidateSnapshot and cleared when the snapshot is refreshed. Both happen while the mutex is held
+	std::atomic<bool> mSnapshotInvalid;
+
+	// The snapshot applied by the render context. Only accessed from the thread owning the render context
+	POGLProgramSnapshot mSnapshot;
+	bool mApplyStaticUniforms;
+
+	// The uniforms indexed by their uniform ID. IDs of uniforms not in this program are nullptr
+	std::vector<POGLDefaultUniform*> mUniformsByID;
+
+	// The submitted program until it's resolved
+	POGL_PROGRAM_LINK mLink;
+	POGLRenderState* mRenderState;
+	bool mPending;
+
+	// Kept so that every attempt to use a program which failed to compile or link throws
+	POGL_STRING mErrorMessage;
 };
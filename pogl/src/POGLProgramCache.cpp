@@ -0,0 +1,372 @@
+#include "MemCheck.h"
+#include "POGLProgramCache.h"
+#include "POGLFactory.h"
+#include "POGLShader.h"
+#include "POGLEnum.h"
+#include <memory>
+
+namespace {
+	POGL_STRING directory;
+	bool enabled = false;
+
+	// 64-bit FNV-1a
+	const POGL_UINT64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+	const POGL_UINT64 FNV_PRIME = 1099511628211ULL;
+
+	// Identifies the file layout. Increase if the layout changes
+	const POGL_UINT32 CACHE_FILE_MAGIC = 0x43474f50; // "POGC"
+	const POGL_UINT32 CACHE_FILE_VERSION = 1;
+
+	struct POGL_PROGRAM_CACHE_HEADER
+	{
+		POGL_UINT32 magic;
+		POGL_UINT32 version;
+		POGL_UINT64 key;
+		POGL_UINT32 binaryFormat;
+		POGL_UINT32 binarySize;
+		POGL_UINT32 uniformCount;
+		POGL_UINT32 uniformsSize;
+	};
+
+	// Each uniform is stored as this header followed by the name, without a null terminator
+	struct POGL_PROGRAM_CACHE_UNIFORM
+	{
+		POGL_UINT32 type;
+		POGL_INT32 location;
+		POGL_UINT32 nameLength;
+	};
+
+	struct FileCloser
+	{
+		void operator()(FILE* file) const {
+			fclose(file);
+		}
+	};
+	typedef std::unique_ptr<FILE, FileCloser> FilePtr;
+}
+
+void POGLProgramCache::SetDirectory(const POGL_CHAR* dir)
+{
+	if (dir == nullptr) {
+		directory.clear();
+		enabled = false;
+		return;
+	}
+
+	directory = dir;
+	enabled = !directory.empty();
+}
+
+const POGL_CHAR* POGLProgramCache::GetDirectory()
+{
+	return enabled ? directory.c_str() : nullptr;
+}
+
+bool POGLProgramCache::IsEnabled()
+{
+	return enabled;
+}
+
+POGL_UINT64 POGLProgramCache::Hash(const void* memory, POGL_UINT32 size, POGL_UINT64 hash)
+{
+	// The offset basis is folded in and out, so that hashing a and then b gives the same result as hashing a and b at once
+	POGL_UINT64 h = hash ^ FNV_OFFSET_BASIS;
+	const POGL_BYTE* bytes = (const POGL_BYTE*)memory;
+	for (POGL_UINT32 i = 0; i < size; ++i) {
+		h ^= bytes[i];
+		h *= FNV_PRIME;
+	}
+	return h ^ FNV_OFFSET_BASIS;
+}
+
+GLuint POGLProgramCache::CreateProgram(IPOGLShader** shaders, POGL_UINT32 count, POGLProgramUniforms* _out_Uniforms)
+{
+	assert_not_null(_out_Uniforms);
+
+	POGL_PROGRAM_LINK link;
+	BeginCreateProgram(shaders, count, &link);
+	EndCreateProgram(&link);
+	_out_Uniforms->swap(link.uniforms);
+	return link.programID;
+}
+
+void POGLProgramCache::BeginCreateProgram(IPOGLShader** shaders, POGL_UINT32 count, POGL_PROGRAM_LINK* _out_Link)
+{
+	assert_not_null(_out_Link);
+
+	const bool useCache = enabled && IsSupported();
+	if (useCache) {
+		_out_Link->key = GenerateKey(shaders, count);
+		_out_Link->programID = Load(GetFilePath(_out_Link->key), _out_Link->key, &_out_Link->uniforms);
+		if (_out_Link->programID != 0) {
+			_out_Link->loaded = true;
+			return;
+		}
+	}
+
+	// Shaders created while the cache is enabled are compiled on demand
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		POGLShader* shader = static_cast<POGLShader*>(shaders[i]);
+		shader->Compile();
+		shader->AddRef();
+		_out_Link->shaders.push_back(shader);
+	}
+
+	_out_Link->programID = POGLFactory::CreateProgram(shaders, count, useCache);
+	_out_Link->store = useCache;
+}
+
+bool POGLProgramCache::IsProgramComplete(const POGL_PROGRAM_LINK& link)
+{
+	if (link.loaded || !IsParallelCompileSupported())
+		return true;
+
+	GLint completed = GL_FALSE;
+	glGetProgramiv(link.programID, GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+void POGLProgramCache::EndCreateProgram(POGL_PROGRAM_LINK* link)
+{
+	assert_not_null(link);
+	if (link->loaded)
+		return;
+
+	try {
+		// Report compile errors before the link error they cause
+		for (size_t i = 0; i < link->shaders.size(); ++i) {
+			link->shaders[i]->CheckCompileStatus();
+		}
+		POGLFactory::CheckProgram(link->programID);
+	}
+	catch (...) {
+		ReleaseProgram(link);
+		throw;
+	}
+	ReleaseShaders(link);
+
+	GetActiveUniforms(link->programID, &link->uniforms);
+	if (link->store)
+		Store(GetFilePath(link->key), link->key, link->programID, link->uniforms);
+	link->loaded = true;
+}
+
+void POGLProgramCache::ReleaseProgram(POGL_PROGRAM_LINK* link)
+{
+	ReleaseShaders(link);
+	if (link->programID != 0) {
+		glDeleteProgram(link->programID);
+		link->programID = 0;
+	}
+}
+
+void POGLProgramCache::GetActiveUniforms(GLuint programID, POGLProgramUniforms* _out_Uniforms)
+{
+	_out_Uniforms->clear();
+
+	GLint numUniforms = 0;
+	glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &numUniforms);
+	_out_Uniforms->reserve(numUniforms);
+
+	GLchar nameData[256] = { 0 };
+	for (GLint uniformIndex = 0; uniformIndex < numUniforms; ++uniformIndex) {
+		GLint arraySize = 0;
+		GLenum uniformType = 0;
+		GLsizei actualLength = 0;
+
+		//
+		// http://www.opengl.org/sdk/docs/man/xhtml/glGetActiveUniform.xml
+		//
+
+		glGetActiveUniform(programID, uniformIndex, sizeof(nameData), &actualLength, &arraySize, &uniformType, nameData);
+		nameData[actualLength] = 0;
+
+		POGL_PROGRAM_UNIFORM uniform;
+		uniform.name = nameData;
+		uniform.type = uniformType;
+		uniform.location = glGetUniformLocation(programID, nameData);
+		_out_Uniforms->push_back(uniform);
+	}
+}
+
+bool POGLProgramCache::IsSupported()
+{
+	static const bool supported = POGLExtensionAvailable(POGL_TOCHAR("GL_ARB_get_program_binary")) && glGetProgramBinary != nullptr &&
+		glProgramBinary != nullptr && glProgramParameteri != nullptr;
+	if (!supported)
+		return false;
+
+	// Some drivers support the extension without supporting any binary formats
+	static const GLint numFormats = []() {
+		GLint n = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &n);
+		return n;
+	}();
+	return numFormats > 0;
+}
+
+bool POGLProgramCache::IsParallelCompileSupported()
+{
+	static const bool supported = (POGLExtensionAvailable(POGL_TOCHAR("GL_KHR_parallel_shader_compile")) ||
+		POGLExtensionAvailable(POGL_TOCHAR("GL_ARB_parallel_shader_compile"))) && glMaxShaderCompilerThreadsKHR != nullptr;
+	return supported;
+}
+
+void POGLProgramCache::ReleaseShaders(POGL_PROGRAM_LINK* link)
+{
+	for (size_t i = 0; i < link->shaders.size(); ++i) {
+		link->shaders[i]->Release();
+	}
+	link->shaders.clear();
+}
+
+POGL_UINT64 POGLProgramCache::GenerateKey(IPOGLShader** shaders, POGL_UINT32 count)
+{
+	// Binaries are only valid for the driver that created them
+	static const GLenum DRIVER_STRINGS[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+	POGL_UINT64 key = Hash(&CACHE_FILE_VERSION, sizeof(CACHE_FILE_VERSION), 0);
+	for (POGL_UINT32 i = 0; i < sizeof(DRIVER_STRINGS) / sizeof(GLenum); ++i) {
+		const char* str = (const char*)glGetString(DRIVER_STRINGS[i]);
+		if (str != nullptr)
+			key = Hash(str, (POGL_UINT32)strlen(str) + 1, key);
+	}
+
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		const POGLShader* shader = static_cast<const POGLShader*>(shaders[i]);
+		const POGL_UINT32 type = (POGL_UINT32)shader->GetShaderType();
+		const POGL_UINT64 sourceHash = shader->GetSourceHash();
+		key = Hash(&type, sizeof(type), key);
+		key = Hash(&sourceHash, sizeof(sourceHash), key);
+	}
+	return key;
+}
+
+POGL_STRING POGLProgramCache::GetFilePath(POGL_UINT64 key)
+{
+	POGL_STRINGSTREAM ss;
+	ss << directory;
+	const POGL_CHAR last = directory[directory.length() - 1];
+	if (last != POGL_TOCHAR('/') && last != POGL_TOCHAR('\\'))
+		ss << POGL_TOCHAR('/');
+	ss << std::hex << key << POGL_TOCHAR(".bin");
+	return ss.str();
+}
+
+GLuint POGLProgramCache::Load(const POGL_STRING& path, POGL_UINT64 key, POGLProgramUniforms* _out_Uniforms)
+{
+	FilePtr file(open_file(path.c_str(), POGL_TOCHAR("rb")));
+	if (file == nullptr)
+		return 0;
+
+	fseek(file.get(), 0, SEEK_END);
+	const long fileSize = ftell(file.get());
+	fseek(file.get(), 0, SEEK_SET);
+
+	POGL_PROGRAM_CACHE_HEADER header;
+	if (fread(&header, sizeof(header), 1, file.get()) != 1)
+		return 0;
+
+	// Files with the same name might have been written by an older version or, very unlikely, by a program with a colliding hash
+	if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION || header.key != key || header.binarySize == 0)
+		return 0;
+
+	if ((POGL_UINT64)header.binarySize + header.uniformsSize != (POGL_UINT64)fileSize - sizeof(header))
+		return 0;
+
+	std::vector<POGL_BYTE> bytes(header.binarySize + header.uniformsSize);
+	if (fread(&bytes[0], 1, bytes.size(), file.get()) != bytes.size())
+		return 0;
+	file.reset();
+
+	//
+	// Read the uniforms
+	//
+
+	const POGL_BYTE* ptr = &bytes[header.binarySize];
+	const POGL_BYTE* end = ptr + header.uniformsSize;
+	_out_Uniforms->clear();
+	_out_Uniforms->reserve(header.uniformCount);
+	for (POGL_UINT32 i = 0; i < header.uniformCount; ++i) {
+		POGL_PROGRAM_CACHE_UNIFORM stored;
+		if ((size_t)(end - ptr) < sizeof(stored))
+			return 0;
+		memcpy(&stored, ptr, sizeof(stored));
+		ptr += sizeof(stored);
+		if ((size_t)(end - ptr) < stored.nameLength)
+			return 0;
+
+		POGL_PROGRAM_UNIFORM uniform;
+		uniform.name.assign((const char*)ptr, stored.nameLength);
+		uniform.type = stored.type;
+		uniform.location = stored.location;
+		_out_Uniforms->push_back(uniform);
+		ptr += stored.nameLength;
+	}
+
+	//
+	// Load the binary. The driver rejects binaries it can't use, for example after a driver update
+	//
+
+	const GLuint programID = glCreateProgram();
+	glProgramBinary(programID, header.binaryFormat, &bytes[0], header.binarySize);
+
+	GLint status = 0;
+	glGetProgramiv(programID, GL_LINK_STATUS, &status);
+	if (!status) {
+		glDeleteProgram(programID);
+		return 0;
+	}
+
+	return programID;
+}
+
+void POGLProgramCache::Store(const POGL_STRING& path, POGL_UINT64 key, GLuint programID, const POGLProgramUniforms& uniforms)
+{
+	GLint binarySize = 0;
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+	if (binarySize <= 0)
+		return;
+
+	std::vector<POGL_BYTE> binary(binarySize);
+	GLsizei length = 0;
+	GLenum binaryFormat = 0;
+	glGetProgramBinary(programID, binarySize, &length, &binaryFormat, &binary[0]);
+	if (length <= 0)
+		return;
+
+	//
+	// Serialize the uniforms
+	//
+
+	std::vector<POGL_BYTE> uniformBytes;
+	for (size_t i = 0; i < uniforms.size(); ++i) {
+		const POGL_PROGRAM_UNIFORM& uniform = uniforms[i];
+		POGL_PROGRAM_CACHE_UNIFORM stored;
+		stored.type = uniform.type;
+		stored.location = uniform.location;
+		stored.nameLength = (POGL_UINT32)uniform.name.length();
+
+		const POGL_BYTE* storedBytes = (const POGL_BYTE*)&stored;
+		uniformBytes.insert(uniformBytes.end(), storedBytes, storedBytes + sizeof(stored));
+		uniformBytes.insert(uniformBytes.end(), uniform.name.begin(), uniform.name.end());
+	}
+
+	POGL_PROGRAM_CACHE_HEADER header;
+	header.magic = CACHE_FILE_MAGIC;
+	header.version = CACHE_FILE_VERSION;
+	header.key = key;
+	header.binaryFormat = binaryFormat;
+	header.binarySize = (POGL_UINT32)length;
+	header.uniformCount = (POGL_UINT32)uniforms.size();
+	header.uniformsSize = (POGL_UINT32)uniformBytes.size();
+
+	FilePtr file(open_file(path.c_str(), POGL_TOCHAR("wb")));
+	if (file == nullptr)
+		return;
+
+	// A partially written file is rejected when loaded and then rewritten
+	fwrite(&header, sizeof(header), 1, file.get());
+	fwrite(&binary[0], 1, length, file.get());
+	if (!uniformBytes.empty())
+		fwrite(&uniformBytes[0], 1, uniformBytes.size(), file.get());
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include "config.h"
+#include <vector>
+
+/*!
+	\brief An active uniform in a linked program
+*/
+struct POGL_PROGRAM_UNIFORM
+{
+	std::string name;
+	GLenum type;
+	GLint location;
+};
+
+typedef std::vector<POGL_PROGRAM_UNIFORM> POGLProgramUniforms;
+
+class POGLShader;
+
+/*!
+	\brief A program that has been submitted to the driver, but whose compile and link results haven't been checked yet
+*/
+struct POGL_PROGRAM_LINK
+{
+	POGL_PROGRAM_LINK() : programID(0), loaded(false), store(false), key(0) {
+	}
+
+	/* The OpenGL program ID */
+	GLuint programID;
+
+	/* The shaders, which are referenced until the link result is checked. Empty if the program was loaded from the cache */
+	std::vector<POGLShader*> shaders;
+
+	/* The active uniforms. Filled in when the program is loaded from the cache or when the link result is checked */
+	POGLProgramUniforms uniforms;
+
+	/* true if the program was loaded from the cache */
+	bool loaded;
+
+	/* true if the program binary should be stored in the cache when the link result is checked */
+	bool store;
+
+	/* The cache key */
+	POGL_UINT64 key;
+};
+
+/*!
+	\brief Stores linked program binaries on disk so that programs don't have to be compiled and linked the next time they're created
+
+	Each program is stored in its own file in the cache directory. The file name is a hash of the graphics driver strings and the type
+	and source code of every shader in the program. The file contains the program binary together with the active uniforms of the
+	program, so that the uniforms don't have to be queried from the driver either. If the driver rejects the binary, for example after
+	a driver update, then the program is compiled and linked from the source code and the file is rewritten.
+
+	Shaders created while the cache is enabled keep a copy of their source code and are compiled the first time a program using them
+	isn't found in the cache.
+
+	Programs can also be created in two steps. BeginCreateProgram submits the work to the driver and EndCreateProgram waits for, and
+	checks, the result. The driver can then compile many programs in parallel before the first result is needed.
+*/
+class POGLProgramCache
+{
+public:
+	/*!
+		\brief Set the directory where program binaries are stored
+
+		\param directory
+				An existing directory. nullptr disables the cache
+	*/
+	static void SetDirectory(const POGL_CHAR* directory);
+
+	/*!
+		\brief Retrieves the cache directory. nullptr if the cache is disabled
+	*/
+	static const POGL_CHAR* GetDirectory();
+
+	/*!
+		\brief Check to see if the cache is enabled
+	*/
+	static bool IsEnabled();
+
+	/*!
+		\brief Hash the supplied memory
+
+		\param memory
+		\param size
+				The size of the memory in bytes
+		\param hash
+				The hash to continue from. Use 0 to start a new hash
+	*/
+	static POGL_UINT64 Hash(const void* memory, POGL_UINT32 size, POGL_UINT64 hash);
+
+	/*!
+		\brief Create a linked program from the supplied shaders. The cache is used if it's enabled and supported by the driver
+
+		\param shaders
+		\param count
+		\param _out_Uniforms
+				Filled with the active uniforms of the program
+		\throws POGLResourceException
+				If a shader could not be compiled or the program could not be linked
+		\return The OpenGL program ID
+	*/
+	static GLuint CreateProgram(IPOGLShader** shaders, POGL_UINT32 count, POGLProgramUniforms* _out_Uniforms);
+
+	/*!
+		\brief Start creating a program from the supplied shaders without waiting for the driver to compile and link it
+
+		\param shaders
+		\param count
+		\param _out_Link
+				Filled with the submitted program. Must be passed to EndCreateProgram or ReleaseProgram
+	*/
+	static void BeginCreateProgram(IPOGLShader** shaders, POGL_UINT32 count, POGL_PROGRAM_LINK* _out_Link);
+
+	/*!
+		\brief Check to see if the driver has finished compiling and linking the supplied program. This method never blocks
+
+		Always true if the driver doesn't support GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile.
+	*/
+	static bool IsProgramComplete(const POGL_PROGRAM_LINK& link);
+
+	/*!
+		\brief Wait for the supplied program to be compiled and linked, query its uniforms and store it in the cache
+
+		The shaders referenced by the link are released, even if an exception is thrown.
+
+		\throws POGLResourceException
+				If a shader could not be compiled or the program could not be linked
+	*/
+	static void EndCreateProgram(POGL_PROGRAM_LINK* link);
+
+	/*!
+		\brief Release a program that has been submitted but never checked
+	*/
+	static void ReleaseProgram(POGL_PROGRAM_LINK* link);
+
+	/*!
+		\brief Query the active uniforms of the supplied linked program
+
+		\param programID
+		\param _out_Uniforms
+	*/
+	static void GetActiveUniforms(GLuint programID, POGLProgramUniforms* _out_Uniforms);
+
+private:
+	/*!
+		\brief Check to see if the driver can retrieve and load program binaries
+	*/
+	static bool IsSupported();
+
+	/*!
+		\brief Check to see if the driver can compile and link programs in parallel
+	*/
+	static bool IsParallelCompileSupported();
+
+	/*!
+		\brief Release the shaders referenced by the supplied link
+	*/
+	static void ReleaseShaders(POGL_PROGRAM_LINK* link);
+
+	/*!
+		\brief Generate the key identifying a program built from the supplied shaders on the current driver
+	*/
+	static POGL_UINT64 GenerateKey(IPOGLShader** shaders, POGL_UINT32 count);
+
+	/*!
+		\brief Retrieves the path of the file in which the program with the supplied key is stored
+	*/
+	static POGL_STRING GetFilePath(POGL_UINT64 key);
+
+	/*!
+		\brief Load the program stored in the supplied file
+
+		\return The OpenGL program ID; 0 if the file is missing, invalid or rejected by the driver
+	*/
+	static GLuint Load(const POGL_STRING& path, POGL_UINT64 key, POGLProgramUniforms* _out_Uniforms);
+
+	/*!
+		\brief Store the supplied linked program in the supplied file. Failures are ignored, since the cache is only an optimization
+	*/
+	static void Store(const POGL_STRING& path, POGL_UINT64 key, GLuint programID, const POGLProgramUniforms& uniforms);
+};
@@ -3,14 +3,24 @@
 #include "POGLRenderState.h"
 #include "POGLDevice.h"
 #include "POGLEnum.h"
+#include "POGLConvertPixels.h"
 #include "POGLVertexBuffer.h"
 #include "POGLIndexBuffer.h"
+#include "POGLTexture1D.h"
 #include "POGLTexture2D.h"
+#include "POGLTexture3D.h"
+#include "POGLTexture2DArray.h"
+#include "POGLTextureCube.h"
+#include "POGLTextureUtils.h"
+#include "POGLTextureResource.h"
 #include "POGLShader.h"
 #include "POGLProgramData.h"
 #include "POGLFactory.h"
 #include "POGLFramebuffer.h"
 #include "POGLProgram.h"
+#include "POGLProgramCache.h"
+#include "POGLBufferBatch.h"
+#include "POGLPixelUnpackRing.h"
 #include <algorithm>
 
 POGLRenderContext::POGLRenderContext(POGLDevice* device)
@@ -35,21 +45,31 @@ IPOGLDevice* POGLRenderContext::GetDevice()
 
 IPOGLShader* POGLRenderContext::CreateShaderFromFile(const POGL_CHAR* path, POGLShaderType::Enum type)
 {
-	POGL_ISTREAM stream(path);
-	if (!stream.is_open())
-		THROW_EXCEPTION(POGLResourceException, "Shader at path: '%s' could not be found", path);
+	if (path == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid shader path");
 
-	// Read the entire file into memory
-	POGL_STRING str((std::istreambuf_iterator<POGL_CHAR>(stream)), std::istreambuf_iterator<POGL_CHAR>());
-	return CreateShaderFromMemory(str.c_str(), str.length(), type);
+	// The shader source is compiled straight from the mapped file
+	POGLMappedFile file(path);
+	return CreateShaderFromMemory((const POGL_CHAR*)file.GetBytes(), file.GetSize(), type);
 }
 
 IPOGLShader* POGLRenderContext::CreateShaderFromMemory(const POGL_CHAR* memory, POGL_UINT32 size, POGLShaderType::Enum type)
 {
-	// Generate a shader ID based on the supplied memory, size and type
+	if (size == 0 || memory == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You cannot generate a non-existing shader");
+
+	const POGL_UINT64 sourceHash = POGLProgramCache::Hash(memory, size, 0);
+	if (POGLProgramCache::IsEnabled()) {
+		// The shader is compiled if, and when, a program using it isn't found in the cache
+		POGLShader* shader = new POGLShader(type, sourceHash);
+		shader->PostConstruct(memory, size);
+		return shader;
+	}
+
+	// Generate a shader ID based on the supplied memory, size and type. The compile status is checked when the shader is linked
 	const GLuint shaderID = POGLFactory::CreateShader(memory, size, type);
 
-	POGLShader* shader = new POGLShader(type);
+	POGLShader* shader = new POGLShader(type, sourceHash);
 	shader->PostConstruct(shaderID);
 	return shader;
 }
@@ -59,16 +79,42 @@ IPOGLProgram* POGLRenderContext::CreateProgramFromShaders(IPOGLShader** shaders,
 	if (shaders == nullptr)
 		THROW_EXCEPTION(POGLResourceException, "You must supply at least one shader to be able to create a program");
 
-	// Attach all the shaders to the program
-	const GLuint programID = POGLFactory::CreateProgram(shaders, count);
+	// Load the program from the program cache, or compile and link it
+	POGLProgramUniforms uniforms;
+	const GLuint programID = POGLProgramCache::CreateProgram(shaders, count, &uniforms);
 	POGLProgram* program = new POGLProgram();
-	program->PostConstruct(programID, GetRenderState());
+	program->PostConstruct(programID, uniforms, GetRenderState());
 	return program;
 }
 
-IPOGLTexture1D* POGLRenderContext::CreateTexture1D()
+IPOGLProgram* POGLRenderContext::CreateProgramFromShadersAsync(IPOGLShader** shaders, POGL_UINT32 count)
 {
-	return nullptr;
+	if (shaders == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply at least one shader to be able to create a program");
+
+	POGL_PROGRAM_LINK link;
+	POGLProgramCache::BeginCreateProgram(shaders, count, &link);
+	POGLProgram* program = new POGLProgram();
+	program->PostConstructAsync(link, GetRenderState());
+	return program;
+}
+
+IPOGLTexture1D* POGLRenderContext::CreateTexture1D(POGL_UINT32 width, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (width == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", width);
+
+	if (POGLEnum::IsCompressedTextureFormat(format))
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a 1D texture with a compressed format");
+
+	const POGL_SIZE size((POGL_INT32)width, 1);
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, 1);
+	const GLuint textureID = POGLFactory::CreateTextureStorage(GL_TEXTURE_1D, size, 1, format, mipLevels, bytes);
+
+	POGLTexture1D* texture = new POGLTexture1D(width, format, mipLevels);
+	texture->PostConstruct(textureID);
+	mRenderState->ForceSetTextureResource(texture->GetResourcePtr());
+	return texture;
 }
 
 IPOGLTexture2D* POGLRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, const void* bytes)
@@ -79,8 +125,6 @@ IPOGLTexture2D* POGLRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTe
 	if (size.height <= 0)
 		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with height: %d", size.height);
 
-	const GLenum _format = POGLEnum::ConvertToTextureFormatEnum(format);
-	const GLenum _internalFormat = POGLEnum::ConvertToInternalTextureFormatEnum(format);
 	const GLenum minFilter = POGLEnum::Convert(POGLMinFilter::DEFAULT);
 	const GLenum magFilter = POGLEnum::Convert(POGLMagFilter::DEFAULT);
 	const GLenum textureWrap = POGLEnum::Convert(POGLTextureWrap::DEFAULT);
@@ -88,7 +132,8 @@ IPOGLTexture2D* POGLRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTe
 	const GLuint textureID = POGLFactory::GenTextureID();
 	glBindTexture(GL_TEXTURE_2D, textureID);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, _internalFormat, size.width, size.height, 0, _format, GL_UNSIGNED_BYTE, bytes);
+	POGLFactory::TexImage(GL_TEXTURE_2D, 0, size, 1, format, bytes);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, textureWrap);
@@ -105,9 +150,90 @@ IPOGLTexture2D* POGLRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTe
 	return texture;
 }
 
-IPOGLTexture3D* POGLRenderContext::CreateTexture3D()
+IPOGLTexture2D* POGLRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (size.width <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", size.width);
+
+	if (size.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with height: %d", size.height);
+
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, 1);
+	const GLuint textureID = POGLFactory::CreateTextureStorage(GL_TEXTURE_2D, size, 1, format, mipLevels, bytes);
+
+	POGLTexture2D* texture = new POGLTexture2D(size, format, mipLevels, true);
+	texture->PostConstruct(textureID);
+	mRenderState->ForceSetTextureResource((POGLTextureResource*)texture->GetResourcePtr());
+	return texture;
+}
+
+IPOGLTexture2D* POGLRenderContext::CreateTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, POGLSourceFormat::Enum srcFormat,
+	const void* bytes, POGL_UINT32 convertFlags)
+{
+	POGLCheckPixelConversion(srcFormat, format, convertFlags);
+
+	IPOGLTexture2D* texture = CreateTexture2D(size, format, mipLevels, nullptr);
+	if (bytes != nullptr)
+		UpdateTexture2D(texture, POGL_RECT(0, 0, size.width, size.height), 0, srcFormat, bytes, convertFlags);
+	return texture;
+}
+
+IPOGLTexture3D* POGLRenderContext::CreateTexture3D(const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (size.width <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", size.width);
+
+	if (size.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with height: %d", size.height);
+
+	if (depth == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with depth: %d", depth);
+
+	if (POGLEnum::IsCompressedTextureFormat(format))
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a 3D texture with a compressed format");
+
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, depth);
+	const GLuint textureID = POGLFactory::CreateTextureStorage(GL_TEXTURE_3D, size, depth, format, mipLevels, bytes);
+
+	POGLTexture3D* texture = new POGLTexture3D(size, depth, format, mipLevels);
+	texture->PostConstruct(textureID);
+	mRenderState->ForceSetTextureResource(texture->GetResourcePtr());
+	return texture;
+}
+
+IPOGLTexture2DArray* POGLRenderContext::CreateTexture2DArray(const POGL_SIZE& size, POGL_UINT32 layers, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
 {
-	return nullptr;
+	if (size.width <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with width: %d", size.width);
+
+	if (size.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with height: %d", size.height);
+
+	if (layers == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture array without any layers");
+
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, size, 1);
+	const GLuint textureID = POGLFactory::CreateTextureStorage(GL_TEXTURE_2D_ARRAY, size, layers, format, mipLevels, bytes);
+
+	POGLTexture2DArray* texture = new POGLTexture2DArray(size, layers, format, mipLevels);
+	texture->PostConstruct(textureID);
+	mRenderState->ForceSetTextureResource(texture->GetResourcePtr());
+	return texture;
+}
+
+IPOGLTextureCube* POGLRenderContext::CreateTextureCube(POGL_UINT32 size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, const void* bytes)
+{
+	if (size == 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create a texture with size: %d", size);
+
+	const POGL_SIZE faceSize((POGL_INT32)size, (POGL_INT32)size);
+	mipLevels = POGLTextureUtils::GetMipLevels(mipLevels, faceSize, 1);
+	const GLuint textureID = POGLFactory::CreateTextureStorage(GL_TEXTURE_CUBE_MAP, faceSize, 1, format, mipLevels, bytes);
+
+	POGLTextureCube* texture = new POGLTextureCube(size, format, mipLevels);
+	texture->PostConstruct(textureID);
+	mRenderState->ForceSetTextureResource(texture->GetResourcePtr());
+	return texture;
 }
 
 void POGLRenderContext::ResizeTexture2D(IPOGLTexture2D* texture, const POGL_SIZE& size)
@@ -122,18 +248,117 @@ void POGLRenderContext::ResizeTexture2D(IPOGLTexture2D* texture, const POGL_SIZE
 		THROW_EXCEPTION(POGLStateException, "You cannot resize a texture to 0 height");
 
 	POGLTexture2D* impl = static_cast<POGLTexture2D*>(texture);
+	if (impl->IsImmutable())
+		THROW_EXCEPTION(POGLStateException, "You cannot resize a texture with immutable storage");
+
 	POGLTextureResource* resource = impl->GetResourcePtr();
 	mRenderState->BindTextureResource(resource, 0);
 
-	const POGLTextureFormat::Enum format = resource->GetTextureFormat();
-	const GLenum _format = POGLEnum::ConvertToTextureFormatEnum(format);
-	const GLenum _internalFormat = POGLEnum::ConvertToInternalTextureFormatEnum(format);
-	
-	glTexImage2D(GL_TEXTURE_2D, 0, _internalFormat, size.width, size.height, 0, _format, GL_UNSIGNED_BYTE, NULL);
+	POGLFactory::TexImage(GL_TEXTURE_2D, 0, size, 1, resource->GetTextureFormat(), nullptr);
 	impl->SetSize(size);
 	CHECK_GL("Could not set new texture size");
 }
 
+void POGLRenderContext::UpdateTexture2DMipLevel(IPOGLTexture2D* texture, POGL_UINT32 mipLevel, const void* bytes)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	const POGL_SIZE size = static_cast<POGLTexture2D*>(texture)->GetMipLevelSize(mipLevel);
+	UpdateTexture2D(texture, POGL_RECT(0, 0, size.width, size.height), mipLevel, bytes);
+}
+
+void POGLRenderContext::UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, const void* bytes)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a texture without any data");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	POGLTexture2D* impl = static_cast<POGLTexture2D*>(texture);
+	if (!impl->IsValidUpdateRect(rect, mipLevel))
+		THROW_EXCEPTION(POGLStateException, "The update rectangle is outside of mip level %d or not aligned to the compressed blocks", mipLevel);
+
+	POGLTextureResource* resource = impl->GetResourcePtr();
+	mRenderState->BindTextureResource(resource, 0);
+
+	const POGLTextureFormat::Enum format = resource->GetTextureFormat();
+	const POGL_UINT32 size = POGLEnum::TextureFormatToSize(format, POGL_SIZE(rect.width, rect.height));
+	mRenderState->GetPixelUnpackRing()->TexSubImage(GL_TEXTURE_2D, mipLevel, 0, rect, format, bytes, size);
+}
+
+void POGLRenderContext::UpdateTexture2D(IPOGLTexture2D* texture, const POGL_RECT& rect, POGL_UINT32 mipLevel, POGLSourceFormat::Enum srcFormat,
+	const void* bytes, POGL_UINT32 convertFlags)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a texture without any data");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	POGLTexture2D* impl = static_cast<POGLTexture2D*>(texture);
+	if (!impl->IsValidUpdateRect(rect, mipLevel))
+		THROW_EXCEPTION(POGLStateException, "The update rectangle is outside of mip level %d or not aligned to the compressed blocks", mipLevel);
+
+	POGLTextureResource* resource = impl->GetResourcePtr();
+	mRenderState->BindTextureResource(resource, 0);
+	mRenderState->GetPixelUnpackRing()->TexSubImage(GL_TEXTURE_2D, mipLevel, 0, rect, resource->GetTextureFormat(), srcFormat, bytes, convertFlags);
+}
+
+void POGLRenderContext::UpdateTextureLayer(IPOGLTexture* texture, POGL_UINT32 layer, POGL_UINT32 mipLevel, const void* bytes)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a non-existing texture");
+
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot update a texture without any data");
+
+	POGLTextureResource* resource = POGLTextureUtils::GetResourcePtr(texture);
+	if (resource == nullptr)
+		THROW_EXCEPTION(POGLStateException, "The supplied resource is not a texture");
+
+	if (mipLevel >= texture->GetMipLevels())
+		THROW_EXCEPTION(POGLStateException, "The texture does not have mip level %d", mipLevel);
+
+	if (layer >= POGLTextureUtils::GetLayers(texture, mipLevel))
+		THROW_EXCEPTION(POGLStateException, "Mip level %d of the texture does not have layer %d", mipLevel, layer);
+
+	mRenderState->BindTextureResource(resource, 0);
+
+	const POGLTextureFormat::Enum format = resource->GetTextureFormat();
+	const POGL_SIZE size = POGLTextureUtils::GetMipLevelSize(texture, mipLevel);
+	const POGL_UINT32 dataSize = POGLEnum::TextureFormatToSize(format, size);
+	mRenderState->GetPixelUnpackRing()->TexSubImage(resource->GetTextureTarget(), mipLevel, layer, POGL_RECT(0, 0, size.width, size.height),
+		format, bytes, dataSize);
+}
+
+void POGLRenderContext::GenerateMipmaps(IPOGLTexture* texture)
+{
+	if (texture == nullptr)
+		THROW_EXCEPTION(POGLStateException, "You cannot generate mipmaps for a non-existing texture");
+
+	POGLTextureResource* resource = POGLTextureUtils::GetResourcePtr(texture);
+	if (resource == nullptr)
+		THROW_EXCEPTION(POGLStateException, "The supplied resource is not a texture");
+
+	if (POGLEnum::IsCompressedTextureFormat(resource->GetTextureFormat()))
+		THROW_EXCEPTION(POGLStateException, "You cannot generate mipmaps for a compressed texture");
+
+	mRenderState->BindTextureResource(resource, 0);
+	glGenerateMipmap(resource->GetTextureTarget());
+	CHECK_GL("Could not generate mipmaps");
+}
+
 IPOGLFramebuffer* POGLRenderContext::CreateFramebuffer(IPOGLTexture** textures, POGL_UINT32 count)
 {
 	return CreateFramebuffer(textures, count, nullptr);
@@ -162,6 +387,23 @@ IPOGLFramebuffer* POGLRenderContext::CreateFramebuffer(IPOGLTexture** textures,
 	return framebuffer;
 }
 
+IPOGLFramebuffer* POGLRenderContext::CreateFramebuffer(const POGL_FRAMEBUFFER_ATTACHMENT* attachments, POGL_UINT32 count, const POGL_FRAMEBUFFER_ATTACHMENT* depthStencil)
+{
+	std::vector<POGL_FRAMEBUFFER_ATTACHMENT> attachmentsVector;
+	if (attachments != nullptr) {
+		for (POGL_UINT32 i = 0; i < count; ++i) {
+			if (attachments[i].texture == nullptr)
+				THROW_EXCEPTION(POGLResourceException, "You cannot attach a non-existing texture at index: %d", i);
+			attachmentsVector.push_back(attachments[i]);
+		}
+	}
+
+	POGLFramebuffer* framebuffer = new POGLFramebuffer(attachmentsVector, depthStencil != nullptr ? *depthStencil : POGL_FRAMEBUFFER_ATTACHMENT());
+	framebuffer->PostConstruct();
+	mRenderState->SetFramebuffer(framebuffer);
+	return framebuffer;
+}
+
 IPOGLVertexBuffer* POGLRenderContext::CreateVertexBuffer(const void* memory, POGL_UINT32 memorySize, const POGL_VERTEX_LAYOUT* layout, POGLPrimitiveType::Enum primitiveType, POGLBufferUsage::Enum bufferUsage)
 {
 	if (memorySize == 0)
@@ -238,6 +480,101 @@ IPOGLIndexBuffer* POGLRenderContext::CreateIndexBuffer(const void* memory, POGL_
 	return ib;
 }
 
+void POGLRenderContext::CreateVertexBuffers(const POGL_VERTEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLVertexBuffer** _out_vertexBuffers)
+{
+	assert_not_null(descs);
+	assert_not_null(_out_vertexBuffers);
+
+	if (bufferUsage == POGLBufferUsage::STREAM_RING)
+		THROW_EXCEPTION(POGLStateException, "You cannot create ring buffered vertex buffers in a batch");
+
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		if (descs[i].memorySize == 0)
+			THROW_EXCEPTION(POGLStateException, "You cannot create a non-existing vertex buffer");
+
+		if (descs[i].layout == nullptr)
+			THROW_EXCEPTION(POGLStateException, "You cannot create a vertex buffer without a layout");
+	}
+
+	if (count == 0)
+		return;
+
+	//
+	// Allocate all vertex buffers from the shared buffers
+	//
+
+	POGLBufferBatch batch(GL_ARRAY_BUFFER, bufferUsage);
+	std::vector<POGLVertexBuffer*> vertexBuffers(count);
+	std::vector<const void*> memory(count);
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		const POGL_VERTEX_BUFFER_DESC& desc = descs[i];
+		const POGL_UINT32 numVertices = desc.memorySize / desc.layout->vertexSize;
+		const GLenum type = POGLEnum::Convert(desc.primitiveType);
+		vertexBuffers[i] = new POGLVertexBuffer(numVertices, desc.layout, type, batch.Allocate(desc.memorySize, desc.layout->vertexSize));
+		memory[i] = desc.memory;
+	}
+
+	//
+	// Upload the data and generate all vertex array objects at once
+	//
+
+	batch.PostConstruct(&memory[0]);
+
+	std::vector<GLuint> vaoIDs(count);
+	glGenVertexArrays(count, &vaoIDs[0]);
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		vertexBuffers[i]->PostConstruct(mRenderState, vaoIDs[i]);
+		_out_vertexBuffers[i] = vertexBuffers[i];
+	}
+
+	const GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+		THROW_EXCEPTION(POGLResourceException, "Failed to create vertex buffers. Reason: 0x%x", error);
+}
+
+void POGLRenderContext::CreateIndexBuffers(const POGL_INDEX_BUFFER_DESC* descs, POGL_UINT32 count, POGLBufferUsage::Enum bufferUsage, IPOGLIndexBuffer** _out_indexBuffers)
+{
+	assert_not_null(descs);
+	assert_not_null(_out_indexBuffers);
+
+	if (bufferUsage == POGLBufferUsage::STREAM_RING)
+		THROW_EXCEPTION(POGLStateException, "You cannot create ring buffered index buffers in a batch");
+
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		if (descs[i].memorySize == 0)
+			THROW_EXCEPTION(POGLStateException, "You cannot create a non-existing index buffer");
+
+		if (descs[i].type == POGLVertexType::FLOAT || descs[i].type == POGLVertexType::DOUBLE)
+			THROW_EXCEPTION(POGLStateException, "You are not allowed to create an index buffer of a decimal type");
+	}
+
+	if (count == 0)
+		return;
+
+	POGLBufferBatch batch(GL_ELEMENT_ARRAY_BUFFER, bufferUsage);
+	std::vector<POGLIndexBuffer*> indexBuffers(count);
+	std::vector<const void*> memory(count);
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		const POGL_INDEX_BUFFER_DESC& desc = descs[i];
+		const POGL_UINT32 typeSize = POGLEnum::VertexTypeSize(desc.type);
+		const POGL_UINT32 numIndices = desc.memorySize / typeSize;
+		const GLenum indiceType = POGLEnum::Convert(desc.type);
+		indexBuffers[i] = new POGLIndexBuffer(typeSize, numIndices, indiceType, batch.Allocate(desc.memorySize, typeSize));
+		memory[i] = desc.memory;
+	}
+
+	batch.PostConstruct(&memory[0]);
+
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		indexBuffers[i]->PostConstruct(mRenderState);
+		_out_indexBuffers[i] = indexBuffers[i];
+	}
+
+	const GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+		THROW_EXCEPTION(POGLResourceException, "Failed to create index buffers. Reason: 0x%x", error);
+}
+
 IPOGLResource* POGLRenderContext::CloneResource(IPOGLResource* resource)
 {
 	THROW_NOT_IMPLEMENTED_EXCEPTION();
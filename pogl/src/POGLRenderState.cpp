@@ -7,8 +7,10 @@
 #include "POGLEnum.h"
 #include "POGLTextureResource.h"
 #include "POGLSamplerObject.h"
+#include "POGLPixelUnpackRing.h"
 #include "POGLFramebuffer.h"
 #include "POGLProgram.h"
+#include "POGLResidencyManager.h"
 
 POGLRenderState::POGLRenderState(POGLRenderContext* context)
 : mRefCount(1), mRenderContext(context), mProgram(nullptr), mProgramUID(0), mApplyCurrentProgramState(false),
@@ -18,7 +20,8 @@ mColorMask(POGLColorMask::ALL), mStencilTest(false), mStencilMask(BIT_ALL), mSrc
 mFrontFace(POGLFrontFace::DEFAULT), mCullFace(POGLCullFace::DEFAULT),
 mViewport(0, 0, 0, 0),
 mMaxActiveTextures(0), mNextActiveTexture(0), mActiveTextureIndex(0),
-mFramebuffer(nullptr), mFramebufferUID(0)
+mFramebuffer(nullptr), mFramebufferUID(0),
+mPixelUnpackRing(nullptr)
 {
 	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, (GLint*)&mMaxActiveTextures);
 	mTextureUID = new POGL_UID[mMaxActiveTextures];
@@ -29,6 +32,13 @@ mFramebuffer(nullptr), mFramebufferUID(0)
 		mTextures[i] = nullptr;
 		mSamplerObjectUID[i] = 0;
 	}
+
+	// Texture data is tightly packed. Rows in small mip levels are not always aligned to 4 bytes
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	// Filter across the edges of cube texture faces
+	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 }
 
 POGLRenderState::~POGLRenderState()
@@ -57,6 +67,11 @@ void POGLRenderState::Release()
 		delete[] mTextureUID;
 		delete[] mSamplerObjectUID;
 
+		if (mPixelUnpackRing != nullptr) {
+			delete mPixelUnpackRing;
+			mPixelUnpackRing = nullptr;
+		}
+
 		delete this;
 	}
 }
@@ -88,6 +103,11 @@ IPOGLUniform* POGLRenderState::FindUniformByName(const POGL_CHAR* name)
 	return mProgram->FindStateUniformByName(name);
 }
 
+IPOGLUniform* POGLRenderState::FindUniformByID(POGL_UINT32 uniformID)
+{
+	return mProgram->FindStateUniformByID(uniformID);
+}
+
 void POGLRenderState::SetFramebuffer(IPOGLFramebuffer* framebuffer)
 {
 	POGLFramebuffer* fb = static_cast<POGLFramebuffer*>(framebuffer);
@@ -138,6 +158,7 @@ void POGLRenderState::SetIndexBuffer(IPOGLIndexBuffer* indexBuffer)
 
 void POGLRenderState::BindVertexBuffer(POGLVertexBuffer* buffer)
 {
+	POGLResidencyManager::Touch(buffer);
 	const POGL_UINT32 uid = buffer != nullptr ? buffer->GetUID() : 0;
 	if (mVertexBufferUID == uid) {
 		return;
@@ -158,6 +179,7 @@ void POGLRenderState::BindVertexBuffer(POGLVertexBuffer* buffer)
 
 void POGLRenderState::BindIndexBuffer(POGLIndexBuffer* buffer)
 {
+	POGLResidencyManager::Touch(buffer);
 	const POGL_UINT32 uid = buffer != nullptr ? buffer->GetUID() : 0;
 	if (mIndexBufferUID == uid) {
 		return;
@@ -414,15 +436,15 @@ void POGLRenderState::SetViewport(const POGL_RECT& viewport)
 
 void POGLRenderState::Apply(POGLProgram* program)
 {
-	// Retrieve the program data
-	POGLProgramData data;
-	program->CopyProgramData(&data);
+	// Programs created asynchronously get their unique ID when they're resolved
+	if (program->GetUID() == 0)
+		program->Wait();
 
 	// Bind the program if neccessary
 	BindProgram(program);
 
-	// Apply the global uniform values
-	program->ApplyStaticUniforms();
+	// Apply the global uniform values and retrieve the program data without locking the program
+	const POGLProgramData& data = program->ApplySnapshot();
 
 	//
 	// Update the render state with the (potentially) new properties
@@ -480,6 +502,9 @@ void POGLRenderState::BindTextureResource(POGLTextureResource* resource, POGL_UI
 			"This computer does not support %d consecutive textures. The maximum amount of texture bindable at the same time is %d", idx, mMaxActiveTextures);
 	}
 
+	// Restores the texture if it has been evicted, which gives it a new UID
+	POGLResidencyManager::Touch(resource);
+
 	// Check if the supplied texture is already bound to this context
 	const POGL_UINT32 uid = resource != nullptr ? resource->GetUID() : 0;
 	if (mTextureUID[idx] == uid)
@@ -509,6 +534,18 @@ void POGLRenderState::BindTextureResource(POGLTextureResource* resource, POGL_UI
 	CHECK_GL("Could not bind texture");
 }
 
+bool POGLRenderState::IsResourceBound(const POGLResidentResource* resource) const
+{
+	if (resource == static_cast<const POGLResidentResource*>(mVertexBuffer) || resource == static_cast<const POGLResidentResource*>(mIndexBuffer))
+		return true;
+
+	for (POGL_UINT32 i = 0; i < mMaxActiveTextures; ++i) {
+		if (resource == static_cast<const POGLResidentResource*>(mTextures[i]))
+			return true;
+	}
+	return false;
+}
+
 void POGLRenderState::ForceSetTextureResource(POGLTextureResource* texture)
 {
 	// Release the previous bound texture if it exists
@@ -566,3 +603,10 @@ POGL_UINT32 POGLRenderState::NextActiveTexture()
 		mNextActiveTexture = 0;
 	return textureIndex;
 }
+
+POGLPixelUnpackRing* POGLRenderState::GetPixelUnpackRing()
+{
+	if (mPixelUnpackRing == nullptr)
+		mPixelUnpackRing = new POGLPixelUnpackRing();
+	return mPixelUnpackRing;
+}
@@ -10,6 +10,8 @@ class POGLTextureResource;
 class POGLSamplerObject;
 class POGLFramebuffer;
 class POGLProgram;
+class POGLPixelUnpackRing;
+class POGLResidentResource;
 class POGLRenderState : public IPOGLRenderState
 {
 public:
@@ -90,11 +92,21 @@ public:
 	*/
 	void BindIndexBuffer(POGLIndexBuffer* buffer);
 
+	/*!
+		\brief Check to see if the supplied resource is bound to this render state
+	*/
+	bool IsResourceBound(const POGLResidentResource* resource) const;
+
 	/*!
 		\brief Retrieves a uniform
 	*/
 	IPOGLUniform* FindUniformByName(const POGL_STRING& name);
 
+	/*!
+		\brief Retrieves the ring of pixel unpack buffer memory used when updating textures
+	*/
+	POGLPixelUnpackRing* GetPixelUnpackRing();
+
 // IPOGLInterface
 public:
 	virtual void AddRef();
@@ -104,6 +116,7 @@ public:
 public:
 	virtual void Clear(POGL_UINT32 clearBits);
 	virtual IPOGLUniform* FindUniformByName(const POGL_CHAR* name);
+	virtual IPOGLUniform* FindUniformByID(POGL_UINT32 uniformID);
 	virtual void SetFramebuffer(IPOGLFramebuffer* framebuffer);
 	virtual void SetVertexBuffer(IPOGLVertexBuffer* vertexBuffer);
 	virtual void SetIndexBuffer(IPOGLIndexBuffer* indexBuffer);
@@ -180,4 +193,10 @@ private:
 
 	POGLFramebuffer* mFramebuffer;
 	POGL_UID mFramebufferUID;
+
+	//
+	// Texture uploads
+	//
+
+	POGLPixelUnpackRing* mPixelUnpackRing;
 };
@@ -0,0 +1,185 @@
+#include "MemCheck.h"
+#include "POGLResidencyManager.h"
+#include "POGLRenderState.h"
+#include "providers/POGLBufferResourceLock.h"
+#include <mutex>
+
+namespace {
+	// Guards the list and the usage counters, so that the usage can be queried from any thread
+	std::mutex mutex;
+
+	POGLResidentResource* mostRecent = nullptr;
+	POGLResidentResource* leastRecent = nullptr;
+
+	std::atomic<POGL_UINT64> budget;
+	POGL_UINT64 residentMemory = 0;
+	POGL_RESOURCE_MEMORY_USAGE usages[POGLResidentType::COUNT] = { 0 };
+	POGL_UINT32 evictionCount = 0;
+	POGL_UINT32 restoreCount = 0;
+}
+
+void POGLResidencyManager::Add(POGLResidentResource* resource)
+{
+	assert_not_null(resource);
+	if (resource->mTracked)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	resource->mResidentMemorySize = resource->GetResidentMemorySize();
+	resource->mLastFrame = POGLBufferResourceLock::GetFrame();
+	resource->mResident = true;
+	resource->mTracked = true;
+	LinkFirst(resource);
+
+	POGL_RESOURCE_MEMORY_USAGE& usage = usages[resource->mResidentType];
+	usage.residentCount++;
+	usage.residentMemory += resource->mResidentMemorySize;
+	residentMemory += resource->mResidentMemorySize;
+}
+
+void POGLResidencyManager::Remove(POGLResidentResource* resource)
+{
+	if (resource == nullptr || !resource->mTracked)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	POGL_RESOURCE_MEMORY_USAGE& usage = usages[resource->mResidentType];
+	if (resource->mResident) {
+		Unlink(resource);
+		usage.residentCount--;
+		usage.residentMemory -= resource->mResidentMemorySize;
+		residentMemory -= resource->mResidentMemorySize;
+	}
+	else {
+		usage.evictedCount--;
+		usage.evictedMemory -= resource->mResidentMemorySize;
+	}
+	resource->mTracked = false;
+}
+
+void POGLResidencyManager::Resize(POGLResidentResource* resource)
+{
+	if (resource == nullptr || !resource->mTracked)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	const POGL_UINT64 memorySize = resource->GetResidentMemorySize();
+	POGL_RESOURCE_MEMORY_USAGE& usage = usages[resource->mResidentType];
+	if (resource->mResident) {
+		usage.residentMemory = usage.residentMemory - resource->mResidentMemorySize + memorySize;
+		residentMemory = residentMemory - resource->mResidentMemorySize + memorySize;
+	}
+	else {
+		usage.evictedMemory = usage.evictedMemory - resource->mResidentMemorySize + memorySize;
+	}
+	resource->mResidentMemorySize = memorySize;
+}
+
+void POGLResidencyManager::Touch(POGLResidentResource* resource)
+{
+	if (resource == nullptr || !resource->mTracked)
+		return;
+
+	const POGL_UINT32 frame = POGLBufferResourceLock::GetFrame();
+	if (resource->mResident && resource->mLastFrame == frame)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (resource->mResident) {
+		Unlink(resource);
+	}
+	else {
+		resource->Restore();
+		resource->mResident = true;
+
+		POGL_RESOURCE_MEMORY_USAGE& usage = usages[resource->mResidentType];
+		usage.evictedCount--;
+		usage.evictedMemory -= resource->mResidentMemorySize;
+		usage.residentCount++;
+		usage.residentMemory += resource->mResidentMemorySize;
+		residentMemory += resource->mResidentMemorySize;
+		restoreCount++;
+	}
+	resource->mLastFrame = frame;
+	LinkFirst(resource);
+}
+
+void POGLResidencyManager::EndFrame(POGLRenderState* renderState)
+{
+	const POGL_UINT64 limit = budget.load();
+	if (limit == 0)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	const POGL_UINT32 frame = POGLBufferResourceLock::GetFrame();
+	POGLResidentResource* resource = leastRecent;
+	while (resource != nullptr && residentMemory > limit) {
+		// This, and every more recent, resource was bound during the frame that just ended
+		if (resource->mLastFrame + 1 >= frame)
+			break;
+
+		POGLResidentResource* next = resource->mMoreRecent;
+		if (!renderState->IsResourceBound(resource) && resource->Evict()) {
+			Unlink(resource);
+			resource->mResident = false;
+
+			POGL_RESOURCE_MEMORY_USAGE& usage = usages[resource->mResidentType];
+			usage.residentCount--;
+			usage.residentMemory -= resource->mResidentMemorySize;
+			usage.evictedCount++;
+			usage.evictedMemory += resource->mResidentMemorySize;
+			residentMemory -= resource->mResidentMemorySize;
+			evictionCount++;
+		}
+		resource = next;
+	}
+}
+
+void POGLResidencyManager::SetBudget(POGL_UINT64 b)
+{
+	budget = b;
+}
+
+POGL_UINT64 POGLResidencyManager::GetBudget()
+{
+	return budget.load();
+}
+
+void POGLResidencyManager::GetMemoryUsage(POGL_MEMORY_USAGE* usage)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	usage->textures = usages[POGLResidentType::TEXTURE];
+	usage->vertexBuffers = usages[POGLResidentType::VERTEX_BUFFER];
+	usage->indexBuffers = usages[POGLResidentType::INDEX_BUFFER];
+	usage->residentMemory = residentMemory;
+	usage->budget = budget.load();
+	usage->evictionCount = evictionCount;
+	usage->restoreCount = restoreCount;
+}
+
+void POGLResidencyManager::LinkFirst(POGLResidentResource* resource)
+{
+	resource->mMoreRecent = nullptr;
+	resource->mLessRecent = mostRecent;
+	if (mostRecent != nullptr)
+		mostRecent->mMoreRecent = resource;
+	else
+		leastRecent = resource;
+	mostRecent = resource;
+}
+
+void POGLResidencyManager::Unlink(POGLResidentResource* resource)
+{
+	if (resource->mMoreRecent != nullptr)
+		resource->mMoreRecent->mLessRecent = resource->mLessRecent;
+	else
+		mostRecent = resource->mLessRecent;
+
+	if (resource->mLessRecent != nullptr)
+		resource->mLessRecent->mMoreRecent = resource->mMoreRecent;
+	else
+		leastRecent = resource->mMoreRecent;
+
+	resource->mLessRecent = nullptr;
+	resource->mMoreRecent = nullptr;
+}
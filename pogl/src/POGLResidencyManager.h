@@ -0,0 +1,75 @@
+#pragma once
+#include "config.h"
+#include "POGLResidentResource.h"
+
+class POGLRenderState;
+
+/*!
+	\brief Keeps track of how much graphics card memory textures and buffers use and keeps the usage within the memory budget
+
+	Resident resources are kept in a list ordered by the frame in which they were last bound. When a frame ends and the resources use
+	more memory than the budget, the least recently used resources are evicted to system memory. Resources bound during the frame that
+	just ended are never evicted, since they are most likely used again in the next frame. Evicted resources are restored as soon as
+	they are bound again.
+
+	All methods, except GetMemoryUsage and GetBudget, must be called from the thread owning the OpenGL render context.
+*/
+class POGLResidencyManager
+{
+public:
+	/*!
+		\brief Start accounting for the memory used by the supplied resource
+	*/
+	static void Add(POGLResidentResource* resource);
+
+	/*!
+		\brief Stop accounting for the memory used by the supplied resource. This is done when the resource is released
+	*/
+	static void Remove(POGLResidentResource* resource);
+
+	/*!
+		\brief Update the memory accounted for the supplied resource after its storage has been reallocated
+	*/
+	static void Resize(POGLResidentResource* resource);
+
+	/*!
+		\brief Mark the supplied resource as used during the current frame and restore its data if it has been evicted
+
+		This is called every time a resource is bound, so resources which are already marked for the current frame return immediately.
+	*/
+	static void Touch(POGLResidentResource* resource);
+
+	/*!
+		\brief Notify that the current frame has ended. Evicts the least recently used resources if the budget is exceeded
+
+		\param renderState
+				Resources bound to this render state are not evicted
+	*/
+	static void EndFrame(POGLRenderState* renderState);
+
+	/*!
+		\brief Set the memory budget in bytes. 0 means that the usage is unlimited
+	*/
+	static void SetBudget(POGL_UINT64 budget);
+
+	/*!
+		\brief Retrieves the memory budget in bytes
+	*/
+	static POGL_UINT64 GetBudget();
+
+	/*!
+		\brief Fill the supplied structure with the current memory usage
+	*/
+	static void GetMemoryUsage(POGL_MEMORY_USAGE* usage);
+
+private:
+	/*!
+		\brief Put the supplied resource first in the list of resident resources
+	*/
+	static void LinkFirst(POGLResidentResource* resource);
+
+	/*!
+		\brief Remove the supplied resource from the list of resident resources
+	*/
+	static void Unlink(POGLResidentResource* resource);
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include "config.h"
+
+/*!
+	\brief The types of resources whose memory is accounted for by the residency manager
+*/
+struct POGLResidentType
+{
+	enum Enum {
+		TEXTURE = 0,
+		VERTEX_BUFFER,
+		INDEX_BUFFER,
+
+		/* Number of enums available */
+		COUNT
+	};
+};
+
+/*!
+	\brief Base class for resources that use graphics card memory
+
+	The resource is registered with the POGLResidencyManager when its OpenGL object is created and unregistered when it's released.
+	If the memory budget is exceeded then the resource can be asked to move its data to system memory. The data is moved back the next
+	time the resource is bound.
+*/
+class POGLResidentResource
+{
+	friend class POGLResidencyManager;
+
+public:
+	POGLResidentResource(POGLResidentType::Enum residentType)
+		: mResidentType(residentType), mResidentMemorySize(0), mLastFrame(0), mTracked(false), mResident(true),
+		mLessRecent(nullptr), mMoreRecent(nullptr) {
+	}
+
+	virtual ~POGLResidentResource() {
+	}
+
+	/*!
+		\brief Retrieves the number of bytes this resource uses in graphics card memory
+	*/
+	virtual POGL_UINT64 GetResidentMemorySize() const = 0;
+
+	/*!
+		\brief Copy the data of this resource to system memory and release the graphics card memory
+
+		\return false if the resource cannot be evicted
+	*/
+	virtual bool Evict() = 0;
+
+	/*!
+		\brief Upload the data copied to system memory by Evict back into graphics card memory
+	*/
+	virtual void Restore() = 0;
+
+	/*!
+		\brief Check to see if the data of this resource is in graphics card memory
+	*/
+	inline bool IsResident() const {
+		return mResident;
+	}
+
+private:
+	POGLResidentType::Enum mResidentType;
+
+	// The size accounted for in the memory usage
+	POGL_UINT64 mResidentMemorySize;
+
+	// The frame in which this resource was last bound
+	POGL_UINT32 mLastFrame;
+	bool mTracked;
+	bool mResident;
+
+	// Neighbours in the list of resident resources, ordered from the most recently used to the least recently used one
+	POGLResidentResource* mLessRecent;
+	POGLResidentResource* mMoreRecent;
+};
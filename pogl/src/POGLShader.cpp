@@ -1,5 +1,6 @@
 #include "MemCheck.h"
 #include "POGLShader.h"
+#include "POGLFactory.h"
 
 namespace {
 	std::atomic<POGL_UINT32> uid;
@@ -8,8 +9,8 @@ namespace {
 	}
 }
 
-POGLShader::POGLShader(POGLShaderType::Enum shaderType)
-: mRefCount(1), mUID(0), mShaderID(0), mShaderType(shaderType)
+POGLShader::POGLShader(POGLShaderType::Enum shaderType, POGL_UINT64 sourceHash)
+: mRefCount(1), mUID(0), mShaderID(0), mShaderType(shaderType), mSourceHash(sourceHash), mCompileStatusChecked(false)
 {
 }
 
@@ -23,6 +24,32 @@ void POGLShader::PostConstruct(GLuint shaderID)
 	mUID = GenShaderProgramUID();
 }
 
+void POGLShader::PostConstruct(const POGL_CHAR* memory, POGL_UINT32 size)
+{
+	const POGL_BYTE* bytes = (const POGL_BYTE*)memory;
+	mSource.assign(bytes, bytes + size);
+	mUID = GenShaderProgramUID();
+}
+
+void POGLShader::Compile()
+{
+	if (mShaderID != 0 || mSource.empty())
+		return;
+
+	mShaderID = POGLFactory::CreateShader((const POGL_CHAR*)&mSource[0], (POGL_UINT32)mSource.size(), mShaderType);
+	std::vector<POGL_BYTE>().swap(mSource);
+}
+
+void POGLShader::CheckCompileStatus()
+{
+	if (mCompileStatusChecked)
+		return;
+
+	Compile();
+	POGLFactory::CheckShader(mShaderID, mShaderType);
+	mCompileStatusChecked = true;
+}
+
 void POGLShader::AddRef()
 {
 	mRefCount++;
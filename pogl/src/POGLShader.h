@@ -1,10 +1,16 @@
 #pragma once
 #include "config.h"
+#include <vector>
 
 class POGLShader : public IPOGLShader
 {
 public:
-	POGLShader(POGLShaderType::Enum shaderType);
+	/*!
+		\param shaderType
+		\param sourceHash
+				Hash of the shader source code. Used to find programs in the program cache
+	*/
+	POGLShader(POGLShaderType::Enum shaderType, POGL_UINT64 sourceHash);
 	virtual ~POGLShader();
 
 	/*!
@@ -13,6 +19,33 @@ public:
 		\param shaderID
 	*/
 	void PostConstruct(GLuint shaderID);
+
+	/*!
+		\brief Method called instead of PostConstruct if the compilation is deferred until a program actually needs this shader
+
+		This is done when the program cache is enabled, since the shader isn't needed at all if its programs are found in the cache.
+
+		\param memory
+				The shader source code. A copy is kept until the shader is compiled
+		\param size
+	*/
+	void PostConstruct(const POGL_CHAR* memory, POGL_UINT32 size);
+
+	/*!
+		\brief Start compiling the source code kept by this shader, if the compilation was deferred
+
+		\throws POGLResourceException
+				If the shader could not be compiled
+	*/
+	void Compile();
+
+	/*!
+		\brief Wait for this shader to be compiled. The compile status is only queried the first time
+
+		\throws POGLResourceException
+				If the shader could not be compiled
+	*/
+	void CheckCompileStatus();
 	
 	/*!
 		\brief Retrieves a unique ID for this vertex buffer
@@ -34,6 +67,13 @@ public:
 	inline POGLShaderType::Enum GetShaderType() const {
 		return mShaderType;
 	}
+
+	/*!
+		\brief Retrieves the hash of this shaders source code
+	*/
+	inline POGL_UINT64 GetSourceHash() const {
+		return mSourceHash;
+	}
 	
 // IPOGLInterface
 public:
@@ -49,4 +89,9 @@ private:
 	POGL_UID mUID;
 	GLuint mShaderID;
 	POGLShaderType::Enum mShaderType;
+	POGL_UINT64 mSourceHash;
+	bool mCompileStatusChecked;
+
+	// Source code kept until a deferred compilation is done
+	std::vector<POGL_BYTE> mSource;
 };
@@ -0,0 +1,53 @@
+#include "MemCheck.h"
+#include "POGLTexture1D.h"
+
+POGLTexture1D::POGLTexture1D(POGL_UINT32 width, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels)
+: mRefCount(1), mResourcePtr(nullptr), mWidth(width), mMipLevels(mipLevels)
+{
+	mResourcePtr = new POGLTextureResource(GL_TEXTURE_1D, format, POGL_SIZE((POGL_INT32)width, 1), 1, mipLevels, true);
+}
+
+POGLTexture1D::~POGLTexture1D()
+{
+}
+
+void POGLTexture1D::PostConstruct(GLuint textureID)
+{
+	mResourcePtr->PostConstruct(textureID);
+}
+
+void POGLTexture1D::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLTexture1D::Release()
+{
+	if (--mRefCount == 0) {
+		if (mResourcePtr != nullptr) {
+			mResourcePtr->Release();
+			mResourcePtr = nullptr;
+		}
+		delete this;
+	}
+}
+
+POGLResourceType::Enum POGLTexture1D::GetType() const
+{
+	return POGLResourceType::TEXTURE1D;
+}
+
+POGLTextureFormat::Enum POGLTexture1D::GetTextureFormat() const
+{
+	return mResourcePtr->GetTextureFormat();
+}
+
+POGL_UINT32 POGLTexture1D::GetMipLevels() const
+{
+	return mMipLevels;
+}
+
+POGL_UINT32 POGLTexture1D::GetSize() const
+{
+	return mWidth;
+}
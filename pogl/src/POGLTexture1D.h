@@ -0,0 +1,49 @@
+#pragma once
+#include "config.h"
+#include <gl/pogl.h>
+#include "POGLTextureResource.h"
+
+class POGLTexture1D : public IPOGLTexture1D
+{
+public:
+	POGLTexture1D(POGL_UINT32 width, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels);
+	virtual ~POGLTexture1D();
+
+	/*!
+		\brief Retrieves the texture resource
+	*/
+	inline POGLTextureResource* GetResourcePtr() const {
+		return mResourcePtr;
+	}
+
+	/*!
+		\brief Method called when the texture is completed in it's construction
+
+		\param textureID
+	*/
+	void PostConstruct(GLuint textureID);
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+// IPOGLResource
+public:
+	virtual POGLResourceType::Enum GetType() const;
+
+// IPOGLTexture
+public:
+	virtual POGLTextureFormat::Enum GetTextureFormat() const;
+	virtual POGL_UINT32 GetMipLevels() const;
+
+// IPOGLTexture1D
+public:
+	virtual POGL_UINT32 GetSize() const;
+
+private:
+	REF_COUNTER mRefCount;
+	POGLTextureResource* mResourcePtr;
+	POGL_UINT32 mWidth;
+	POGL_UINT32 mMipLevels;
+};
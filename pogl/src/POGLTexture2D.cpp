@@ -1,5 +1,7 @@
 #include "MemCheck.h"
 #include "POGLTexture2D.h"
+#include "POGLEnum.h"
+#include <algorithm>
 namespace {
 	std::atomic<POGL_UINT32> uid;
 	POGL_UINT32 GenTextureUID() {
@@ -8,9 +10,15 @@ namespace {
 }
 
 POGLTexture2D::POGLTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format)
-: mRefCount(1), mResourcePtr(nullptr), mSize(size)
+: mRefCount(1), mResourcePtr(nullptr), mSize(size), mMipLevels(1), mImmutable(false)
 {
-	mResourcePtr = new POGLTextureResource(GL_TEXTURE_2D, format);
+	mResourcePtr = new POGLTextureResource(GL_TEXTURE_2D, format, size, 1, 1, false);
+}
+
+POGLTexture2D::POGLTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, bool immutable)
+: mRefCount(1), mResourcePtr(nullptr), mSize(size), mMipLevels(mipLevels), mImmutable(immutable)
+{
+	mResourcePtr = new POGLTextureResource(GL_TEXTURE_2D, format, size, 1, mipLevels, immutable);
 }
 
 POGLTexture2D::~POGLTexture2D()
@@ -25,6 +33,42 @@ void POGLTexture2D::PostConstruct(GLuint textureID)
 void POGLTexture2D::SetSize(const POGL_SIZE& newSize)
 {
 	mSize = newSize;
+	mResourcePtr->SetSize(newSize);
+}
+
+POGL_SIZE POGLTexture2D::GetMipLevelSize(POGL_UINT32 mipLevel) const
+{
+	return POGL_SIZE((std::max)(1, mSize.width >> mipLevel), (std::max)(1, mSize.height >> mipLevel));
+}
+
+bool POGLTexture2D::IsValidUpdateRect(const POGL_RECT& rect, POGL_UINT32 mipLevel) const
+{
+	const POGL_SIZE size = GetMipLevelSize(mipLevel);
+	if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0 ||
+		rect.x + rect.width > size.width || rect.y + rect.height > size.height)
+		return false;
+
+	if (POGLEnum::IsCompressedTextureFormat(GetTextureFormat())) {
+		if (rect.x % 4 != 0 || rect.y % 4 != 0)
+			return false;
+		if (rect.width % 4 != 0 && rect.x + rect.width != size.width)
+			return false;
+		if (rect.height % 4 != 0 && rect.y + rect.height != size.height)
+			return false;
+	}
+
+	return true;
+}
+
+POGL_UINT32 POGLTexture2D::CalculateMipLevels(const POGL_SIZE& size)
+{
+	POGL_UINT32 mipLevels = 1;
+	POGL_INT32 largest = (std::max)(size.width, size.height);
+	while (largest > 1) {
+		largest >>= 1;
+		mipLevels++;
+	}
+	return mipLevels;
 }
 
 void POGLTexture2D::AddRef()
@@ -57,3 +101,8 @@ const POGL_SIZE& POGLTexture2D::GetSize() const
 {
 	return mSize;
 }
+
+POGL_UINT32 POGLTexture2D::GetMipLevels() const
+{
+	return mMipLevels;
+}
@@ -7,6 +7,7 @@ class POGLTexture2D : public IPOGLTexture2D
 {
 public:
 	POGLTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format);
+	POGLTexture2D(const POGL_SIZE& size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, bool immutable);
 	virtual ~POGLTexture2D();
 
 	/*!
@@ -28,6 +29,30 @@ public:
 	*/
 	void SetSize(const POGL_SIZE& newSize);
 
+	/*!
+		\brief Retrieves true if the storage of this texture cannot be resized
+	*/
+	inline bool IsImmutable() const {
+		return mImmutable;
+	}
+
+	/*!
+		\brief Retrieves the size of the supplied mip level
+	*/
+	POGL_SIZE GetMipLevelSize(POGL_UINT32 mipLevel) const;
+
+	/*!
+		\brief Check to see if the supplied rectangle is a non-empty part of the supplied mip level
+
+		Rectangles in compressed textures must also start on a block and end on a block or at the edge of the mip level.
+	*/
+	bool IsValidUpdateRect(const POGL_RECT& rect, POGL_UINT32 mipLevel) const;
+
+	/*!
+		\brief Calculates the number of mip levels in a full mipmap chain for a texture of the supplied size
+	*/
+	static POGL_UINT32 CalculateMipLevels(const POGL_SIZE& size);
+
 // IPOGLInterface
 public:
 	virtual void AddRef();
@@ -44,9 +69,12 @@ public:
 // IPOGLTexture2D
 public:
 	virtual const POGL_SIZE& GetSize() const;
+	virtual POGL_UINT32 GetMipLevels() const;
 
 private:
 	REF_COUNTER mRefCount;
 	POGLTextureResource* mResourcePtr;
 	POGL_SIZE mSize;
+	POGL_UINT32 mMipLevels;
+	bool mImmutable;
 };
@@ -0,0 +1,58 @@
+#include "MemCheck.h"
+#include "POGLTexture2DArray.h"
+
+POGLTexture2DArray::POGLTexture2DArray(const POGL_SIZE& size, POGL_UINT32 layers, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels)
+: mRefCount(1), mResourcePtr(nullptr), mSize(size), mLayers(layers), mMipLevels(mipLevels)
+{
+	mResourcePtr = new POGLTextureResource(GL_TEXTURE_2D_ARRAY, format, size, layers, mipLevels, true);
+}
+
+POGLTexture2DArray::~POGLTexture2DArray()
+{
+}
+
+void POGLTexture2DArray::PostConstruct(GLuint textureID)
+{
+	mResourcePtr->PostConstruct(textureID);
+}
+
+void POGLTexture2DArray::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLTexture2DArray::Release()
+{
+	if (--mRefCount == 0) {
+		if (mResourcePtr != nullptr) {
+			mResourcePtr->Release();
+			mResourcePtr = nullptr;
+		}
+		delete this;
+	}
+}
+
+POGLResourceType::Enum POGLTexture2DArray::GetType() const
+{
+	return POGLResourceType::TEXTURE2DARRAY;
+}
+
+POGLTextureFormat::Enum POGLTexture2DArray::GetTextureFormat() const
+{
+	return mResourcePtr->GetTextureFormat();
+}
+
+POGL_UINT32 POGLTexture2DArray::GetMipLevels() const
+{
+	return mMipLevels;
+}
+
+POGL_UINT32 POGLTexture2DArray::GetLayers() const
+{
+	return mLayers;
+}
+
+const POGL_SIZE& POGLTexture2DArray::GetSize() const
+{
+	return mSize;
+}
@@ -0,0 +1,58 @@
+#include "MemCheck.h"
+#include "POGLTexture3D.h"
+
+POGLTexture3D::POGLTexture3D(const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels)
+: mRefCount(1), mResourcePtr(nullptr), mSize(size), mDepth(depth), mMipLevels(mipLevels)
+{
+	mResourcePtr = new POGLTextureResource(GL_TEXTURE_3D, format, size, depth, mipLevels, true);
+}
+
+POGLTexture3D::~POGLTexture3D()
+{
+}
+
+void POGLTexture3D::PostConstruct(GLuint textureID)
+{
+	mResourcePtr->PostConstruct(textureID);
+}
+
+void POGLTexture3D::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLTexture3D::Release()
+{
+	if (--mRefCount == 0) {
+		if (mResourcePtr != nullptr) {
+			mResourcePtr->Release();
+			mResourcePtr = nullptr;
+		}
+		delete this;
+	}
+}
+
+POGLResourceType::Enum POGLTexture3D::GetType() const
+{
+	return POGLResourceType::TEXTURE3D;
+}
+
+POGLTextureFormat::Enum POGLTexture3D::GetTextureFormat() const
+{
+	return mResourcePtr->GetTextureFormat();
+}
+
+POGL_UINT32 POGLTexture3D::GetMipLevels() const
+{
+	return mMipLevels;
+}
+
+POGL_UINT32 POGLTexture3D::GetDepth() const
+{
+	return mDepth;
+}
+
+const POGL_SIZE& POGLTexture3D::GetSize() const
+{
+	return mSize;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "config.h"
+#include <gl/pogl.h>
+#include "POGLTextureResource.h"
+
+class POGLTexture3D : public IPOGLTexture3D
+{
+public:
+	POGLTexture3D(const POGL_SIZE& size, POGL_UINT32 depth, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels);
+	virtual ~POGLTexture3D();
+
+	/*!
+		\brief Retrieves the texture resource
+	*/
+	inline POGLTextureResource* GetResourcePtr() const {
+		return mResourcePtr;
+	}
+
+	/*!
+		\brief Method called when the texture is completed in it's construction
+
+		\param textureID
+	*/
+	void PostConstruct(GLuint textureID);
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+// IPOGLResource
+public:
+	virtual POGLResourceType::Enum GetType() const;
+
+// IPOGLTexture
+public:
+	virtual POGLTextureFormat::Enum GetTextureFormat() const;
+	virtual POGL_UINT32 GetMipLevels() const;
+
+// IPOGLTexture3D
+public:
+	virtual POGL_UINT32 GetDepth() const;
+	virtual const POGL_SIZE& GetSize() const;
+
+private:
+	REF_COUNTER mRefCount;
+	POGLTextureResource* mResourcePtr;
+	POGL_SIZE mSize;
+	POGL_UINT32 mDepth;
+	POGL_UINT32 mMipLevels;
+};
@@ -0,0 +1,53 @@
+#include "MemCheck.h"
+#include "POGLTextureCube.h"
+
+POGLTextureCube::POGLTextureCube(POGL_UINT32 size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels)
+: mRefCount(1), mResourcePtr(nullptr), mSize(size), mMipLevels(mipLevels)
+{
+	mResourcePtr = new POGLTextureResource(GL_TEXTURE_CUBE_MAP, format, POGL_SIZE((POGL_INT32)size, (POGL_INT32)size), 1, mipLevels, true);
+}
+
+POGLTextureCube::~POGLTextureCube()
+{
+}
+
+void POGLTextureCube::PostConstruct(GLuint textureID)
+{
+	mResourcePtr->PostConstruct(textureID);
+}
+
+void POGLTextureCube::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLTextureCube::Release()
+{
+	if (--mRefCount == 0) {
+		if (mResourcePtr != nullptr) {
+			mResourcePtr->Release();
+			mResourcePtr = nullptr;
+		}
+		delete this;
+	}
+}
+
+POGLResourceType::Enum POGLTextureCube::GetType() const
+{
+	return POGLResourceType::TEXTURECUBE;
+}
+
+POGLTextureFormat::Enum POGLTextureCube::GetTextureFormat() const
+{
+	return mResourcePtr->GetTextureFormat();
+}
+
+POGL_UINT32 POGLTextureCube::GetMipLevels() const
+{
+	return mMipLevels;
+}
+
+POGL_UINT32 POGLTextureCube::GetSize() const
+{
+	return mSize;
+}
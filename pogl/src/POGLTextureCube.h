@@ -0,0 +1,49 @@
+#pragma once
+#include "config.h"
+#include <gl/pogl.h>
+#include "POGLTextureResource.h"
+
+class POGLTextureCube : public IPOGLTextureCube
+{
+public:
+	POGLTextureCube(POGL_UINT32 size, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels);
+	virtual ~POGLTextureCube();
+
+	/*!
+		\brief Retrieves the texture resource
+	*/
+	inline POGLTextureResource* GetResourcePtr() const {
+		return mResourcePtr;
+	}
+
+	/*!
+		\brief Method called when the texture is completed in it's construction
+
+		\param textureID
+	*/
+	void PostConstruct(GLuint textureID);
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+// IPOGLResource
+public:
+	virtual POGLResourceType::Enum GetType() const;
+
+// IPOGLTexture
+public:
+	virtual POGLTextureFormat::Enum GetTextureFormat() const;
+	virtual POGL_UINT32 GetMipLevels() const;
+
+// IPOGLTextureCube
+public:
+	virtual POGL_UINT32 GetSize() const;
+
+private:
+	REF_COUNTER mRefCount;
+	POGLTextureResource* mResourcePtr;
+	POGL_UINT32 mSize;
+	POGL_UINT32 mMipLevels;
+};
@@ -1,17 +1,50 @@
 #include "MemCheck.h"
 #include "POGLTextureResource.h"
+#include "POGLResidencyManager.h"
+#include "POGLFactory.h"
+#include "POGLEnum.h"
 
 namespace {
 	std::atomic<POGL_UINT32> uid;
 	POGL_UINT32 GenTextureUID() {
 		return ++uid;
 	}
+
+	// Texture parameters saved while the texture is evicted
+	const GLenum EVICTED_PARAMETERS[] = {
+		GL_TEXTURE_MIN_FILTER,
+		GL_TEXTURE_MAG_FILTER,
+		GL_TEXTURE_WRAP_S,
+		GL_TEXTURE_WRAP_T,
+		GL_TEXTURE_WRAP_R,
+		GL_TEXTURE_BASE_LEVEL,
+		GL_TEXTURE_MAX_LEVEL,
+		GL_TEXTURE_COMPARE_MODE,
+		GL_TEXTURE_COMPARE_FUNC
+	};
+	const POGL_UINT32 EVICTED_PARAMETER_COUNT = sizeof(EVICTED_PARAMETERS) / sizeof(GLenum);
+
+	GLenum GetTextureBindingEnum(GLenum target) {
+		switch (target) {
+		case GL_TEXTURE_1D:
+			return GL_TEXTURE_BINDING_1D;
+		case GL_TEXTURE_3D:
+			return GL_TEXTURE_BINDING_3D;
+		case GL_TEXTURE_2D_ARRAY:
+			return GL_TEXTURE_BINDING_2D_ARRAY;
+		case GL_TEXTURE_CUBE_MAP:
+			return GL_TEXTURE_BINDING_CUBE_MAP;
+		default:
+			return GL_TEXTURE_BINDING_2D;
+		}
+	}
 }
 
-POGLTextureResource::POGLTextureResource(GLenum textureTarget, POGLTextureFormat::Enum format)
-: mRefCount(1), mUID(0), mTextureID(0), mTextureTarget(textureTarget), mTextureFormat(format)
+POGLTextureResource::POGLTextureResource(GLenum textureTarget, POGLTextureFormat::Enum format, const POGL_SIZE& size, POGL_UINT32 depth, POGL_UINT32 mipLevels, bool immutable)
+: POGLResidentResource(POGLResidentType::TEXTURE), mRefCount(1), mUID(0), mTextureID(0), mTextureTarget(textureTarget), mTextureFormat(format),
+mSize(size), mDepth(depth), mMipLevels((std::max)(mipLevels, 1U)), mFramebufferAttachments(0), mImmutable(immutable), mEvictedMemory(nullptr)
 {
-
+	memset(mEvictedParameters, 0, sizeof(mEvictedParameters));
 }
 
 POGLTextureResource::~POGLTextureResource()
@@ -22,6 +55,24 @@ void POGLTextureResource::PostConstruct(GLuint textureID)
 {
 	mTextureID = textureID;
 	mUID = GenTextureUID();
+	POGLResidencyManager::Add(this);
+}
+
+void POGLTextureResource::SetSize(const POGL_SIZE& size)
+{
+	mSize = size;
+	POGLResidencyManager::Resize(this);
+}
+
+void POGLTextureResource::AddFramebufferAttachment()
+{
+	mFramebufferAttachments++;
+}
+
+void POGLTextureResource::RemoveFramebufferAttachment()
+{
+	assert_with_message(mFramebufferAttachments > 0, "Texture is not attached to a framebuffer");
+	mFramebufferAttachments--;
 }
 
 void POGLTextureResource::AddRef()
@@ -32,10 +83,156 @@ void POGLTextureResource::AddRef()
 void POGLTextureResource::Release()
 {
 	if (--mRefCount == 0) {
+		POGLResidencyManager::Remove(this);
 		if (mTextureID != 0) {
 			glDeleteTextures(1, &mTextureID);
 			mTextureID = 0;
 		}
+		if (mEvictedMemory != nullptr) {
+			free(mEvictedMemory);
+			mEvictedMemory = nullptr;
+		}
 		delete this;
 	}
 }
+
+POGL_UINT64 POGLTextureResource::GetResidentMemorySize() const
+{
+	POGL_UINT64 memorySize = 0;
+	for (POGL_UINT32 level = 0; level < mMipLevels; ++level)
+		memorySize += GetMipLevelMemorySize(level);
+	return memorySize;
+}
+
+bool POGLTextureResource::Evict()
+{
+	// Framebuffers keep rendering into their attachments without binding them
+	if (mFramebufferAttachments > 0 || mTextureID == 0)
+		return false;
+
+	const POGL_UINT64 memorySize = GetResidentMemorySize();
+	mEvictedMemory = (POGL_BYTE*)malloc((size_t)memorySize);
+	if (mEvictedMemory == nullptr)
+		return false;
+
+	const GLenum bindingEnum = GetTextureBindingEnum(mTextureTarget);
+	GLint previousTextureID = 0;
+	glGetIntegerv(bindingEnum, &previousTextureID);
+	glBindTexture(mTextureTarget, mTextureID);
+
+	for (POGL_UINT32 i = 0; i < EVICTED_PARAMETER_COUNT; ++i)
+		glGetTexParameteriv(mTextureTarget, EVICTED_PARAMETERS[i], &mEvictedParameters[i]);
+
+	const bool compressed = POGLEnum::IsCompressedTextureFormat(mTextureFormat);
+	const GLenum _format = POGLEnum::ConvertToTextureFormatEnum(mTextureFormat);
+	const GLenum _type = POGLEnum::ConvertToNativeTextureTypeEnum(mTextureFormat);
+	POGL_BYTE* ptr = mEvictedMemory;
+	for (POGL_UINT32 level = 0; level < mMipLevels; ++level) {
+		if (mTextureTarget == GL_TEXTURE_CUBE_MAP) {
+			const POGL_UINT32 faceSize = GetMipLevelMemorySize(level) / 6;
+			for (POGL_UINT32 face = 0; face < 6; ++face) {
+				if (compressed)
+					glGetCompressedTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, ptr);
+				else
+					glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, _format, _type, ptr);
+				ptr += faceSize;
+			}
+		}
+		else {
+			if (compressed)
+				glGetCompressedTexImage(mTextureTarget, level, ptr);
+			else
+				glGetTexImage(mTextureTarget, level, _format, _type, ptr);
+			ptr += GetMipLevelMemorySize(level);
+		}
+	}
+
+	glBindTexture(mTextureTarget, (GLuint)previousTextureID);
+	glDeleteTextures(1, &mTextureID);
+	mTextureID = 0;
+	return true;
+}
+
+void POGLTextureResource::Restore()
+{
+	assert_not_null(mEvictedMemory);
+
+	const GLenum bindingEnum = GetTextureBindingEnum(mTextureTarget);
+	GLint previousTextureID = 0;
+	glGetIntegerv(bindingEnum, &previousTextureID);
+
+	mTextureID = POGLFactory::GenTextureID();
+	glBindTexture(mTextureTarget, mTextureID);
+
+	const GLenum _type = POGLEnum::ConvertToNativeTextureTypeEnum(mTextureFormat);
+	const POGL_BYTE* ptr = mEvictedMemory;
+	if (mImmutable) {
+		// Recreate the immutable storage and upload each layer into it, so that the texture cannot be resized after it's restored
+		POGLFactory::TexStorage(mTextureTarget, mSize, mDepth, mTextureFormat, mMipLevels);
+		for (POGL_UINT32 level = 0; level < mMipLevels; ++level) {
+			const POGL_SIZE levelSize = GetMipLevelSize(level);
+			const POGL_RECT rect(0, 0, levelSize.width, levelSize.height);
+			const POGL_UINT32 layers = GetLayers(level);
+			const POGL_UINT32 layerSize = GetMipLevelMemorySize(level) / layers;
+			for (POGL_UINT32 layer = 0; layer < layers; ++layer) {
+				POGLFactory::TexSubImage(mTextureTarget, level, layer, rect, mTextureFormat, _type, ptr);
+				ptr += layerSize;
+			}
+		}
+	}
+	else {
+		for (POGL_UINT32 level = 0; level < mMipLevels; ++level) {
+			const POGL_SIZE levelSize = GetMipLevelSize(level);
+			if (mTextureTarget == GL_TEXTURE_CUBE_MAP) {
+				const POGL_UINT32 faceSize = GetMipLevelMemorySize(level) / 6;
+				for (POGL_UINT32 face = 0; face < 6; ++face) {
+					POGLFactory::TexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, levelSize, 1, mTextureFormat, _type, ptr);
+					ptr += faceSize;
+				}
+			}
+			else {
+				POGLFactory::TexImage(mTextureTarget, level, levelSize, GetLayers(level), mTextureFormat, _type, ptr);
+				ptr += GetMipLevelMemorySize(level);
+			}
+		}
+	}
+
+	for (POGL_UINT32 i = 0; i < EVICTED_PARAMETER_COUNT; ++i)
+		glTexParameteri(mTextureTarget, EVICTED_PARAMETERS[i], mEvictedParameters[i]);
+
+	glBindTexture(mTextureTarget, (GLuint)previousTextureID);
+	free(mEvictedMemory);
+	mEvictedMemory = nullptr;
+
+	// Anything caching the previous UID must bind the new texture ID
+	mUID = GenTextureUID();
+}
+
+POGL_SIZE POGLTextureResource::GetMipLevelSize(POGL_UINT32 mipLevel) const
+{
+	POGL_SIZE size = mSize;
+	for (POGL_UINT32 level = 0; level < mipLevel; ++level) {
+		size.width = (std::max)(1, size.width / 2);
+		size.height = (std::max)(1, size.height / 2);
+	}
+	return size;
+}
+
+POGL_UINT32 POGLTextureResource::GetLayers(POGL_UINT32 mipLevel) const
+{
+	switch (mTextureTarget) {
+	case GL_TEXTURE_3D:
+		return (std::max)(1U, mDepth >> mipLevel);
+	case GL_TEXTURE_2D_ARRAY:
+		return mDepth;
+	case GL_TEXTURE_CUBE_MAP:
+		return 6;
+	default:
+		return 1;
+	}
+}
+
+POGL_UINT32 POGLTextureResource::GetMipLevelMemorySize(POGL_UINT32 mipLevel) const
+{
+	return POGLEnum::TextureFormatToNativeSize(mTextureFormat, GetMipLevelSize(mipLevel)) * GetLayers(mipLevel);
+}
@@ -1,12 +1,24 @@
 #pragma once
 #include "config.h"
+#include "POGLResidentResource.h"
 
-class POGLTextureResource : public IPOGLInterface
+class POGLTextureResource : public IPOGLInterface, public POGLResidentResource
 {
 public:
-	POGLTextureResource(GLenum textureTarget, POGLTextureFormat::Enum format);
+	/*!
+		\param textureTarget
+		\param format
+		\param size
+				The size of the base level
+		\param depth
+				The depth of 3D textures or the number of layers of 2D array textures. 1 for all other textures
+		\param mipLevels
+		\param immutable
+				If the storage is allocated using POGLFactory::TexStorage. The storage is allocated the same way when the texture is restored
+	*/
+	POGLTextureResource(GLenum textureTarget, POGLTextureFormat::Enum format, const POGL_SIZE& size, POGL_UINT32 depth, POGL_UINT32 mipLevels, bool immutable);
 	virtual ~POGLTextureResource();
-	
+
 	/*!
 		\brief Method called when the texture is completed in it's construction
 
@@ -14,8 +26,25 @@ public:
 	*/
 	void PostConstruct(GLuint textureID);
 
+	/*!
+		\brief Set a new size for the base level after the storage has been reallocated
+	*/
+	void SetSize(const POGL_SIZE& size);
+
+	/*!
+		\brief Notify that this texture is attached to a framebuffer. Attached textures are never evicted
+	*/
+	void AddFramebufferAttachment();
+
+	/*!
+		\brief Notify that this texture is no longer attached to a framebuffer
+	*/
+	void RemoveFramebufferAttachment();
+
 	/*!
 		\brief Retrieves the unique ID for this resource.
+
+		The ID changes if the texture is restored after being evicted from graphics card memory, since it gets a new texture ID
 	*/
 	inline POGL_UINT32 GetUID() const {
 		return mUID;
@@ -46,11 +75,42 @@ public:
 public:
 	virtual void AddRef();
 	virtual void Release();
-	
+
+// POGLResidentResource
+public:
+	virtual POGL_UINT64 GetResidentMemorySize() const;
+	virtual bool Evict();
+	virtual void Restore();
+
+private:
+	/*!
+		\brief Retrieves the size of one layer in the supplied mip level
+	*/
+	POGL_SIZE GetMipLevelSize(POGL_UINT32 mipLevel) const;
+
+	/*!
+		\brief Retrieves the number of layers, faces or depth slices in the supplied mip level
+	*/
+	POGL_UINT32 GetLayers(POGL_UINT32 mipLevel) const;
+
+	/*!
+		\brief Retrieves the number of bytes used by all layers in the supplied mip level
+	*/
+	POGL_UINT32 GetMipLevelMemorySize(POGL_UINT32 mipLevel) const;
+
 private:
 	REF_COUNTER mRefCount;
 	POGL_UID mUID;
 	GLuint mTextureID;
 	GLenum mTextureTarget;
 	POGLTextureFormat::Enum mTextureFormat;
+	POGL_SIZE mSize;
+	POGL_UINT32 mDepth;
+	POGL_UINT32 mMipLevels;
+	POGL_UINT32 mFramebufferAttachments;
+	bool mImmutable;
+
+	// All mip levels and the texture parameters while the texture is evicted
+	POGL_BYTE* mEvictedMemory;
+	GLint mEvictedParameters[9];
 };
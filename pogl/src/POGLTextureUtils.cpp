@@ -0,0 +1,83 @@
+#include "MemCheck.h"
+#include "POGLTextureUtils.h"
+#include "POGLTexture1D.h"
+#include "POGLTexture2D.h"
+#include "POGLTexture3D.h"
+#include "POGLTexture2DArray.h"
+#include "POGLTextureCube.h"
+#include <algorithm>
+
+POGLTextureResource* POGLTextureUtils::GetResourcePtr(IPOGLTexture* texture)
+{
+	if (texture == nullptr)
+		return nullptr;
+
+	switch (texture->GetType()) {
+	case POGLResourceType::TEXTURE1D:
+		return static_cast<POGLTexture1D*>(texture)->GetResourcePtr();
+	case POGLResourceType::TEXTURE2D:
+		return static_cast<POGLTexture2D*>(texture)->GetResourcePtr();
+	case POGLResourceType::TEXTURE3D:
+		return static_cast<POGLTexture3D*>(texture)->GetResourcePtr();
+	case POGLResourceType::TEXTURE2DARRAY:
+		return static_cast<POGLTexture2DArray*>(texture)->GetResourcePtr();
+	case POGLResourceType::TEXTURECUBE:
+		return static_cast<POGLTextureCube*>(texture)->GetResourcePtr();
+	default:
+		return nullptr;
+	}
+}
+
+POGL_SIZE POGLTextureUtils::GetMipLevelSize(IPOGLTexture* texture, POGL_UINT32 mipLevel)
+{
+	POGL_SIZE size;
+	switch (texture->GetType()) {
+	case POGLResourceType::TEXTURE1D:
+		size = POGL_SIZE(static_cast<POGLTexture1D*>(texture)->GetSize(), 1);
+		break;
+	case POGLResourceType::TEXTURE2D:
+		size = static_cast<POGLTexture2D*>(texture)->GetSize();
+		break;
+	case POGLResourceType::TEXTURE3D:
+		size = static_cast<POGLTexture3D*>(texture)->GetSize();
+		break;
+	case POGLResourceType::TEXTURE2DARRAY:
+		size = static_cast<POGLTexture2DArray*>(texture)->GetSize();
+		break;
+	case POGLResourceType::TEXTURECUBE: {
+		const POGL_INT32 faceSize = (POGL_INT32)static_cast<POGLTextureCube*>(texture)->GetSize();
+		size = POGL_SIZE(faceSize, faceSize);
+		break;
+	}
+	default:
+		THROW_EXCEPTION(POGLStateException, "The supplied resource is not a texture");
+	}
+
+	return POGL_SIZE((std::max)(1, size.width >> mipLevel), (std::max)(1, size.height >> mipLevel));
+}
+
+POGL_UINT32 POGLTextureUtils::GetLayers(IPOGLTexture* texture, POGL_UINT32 mipLevel)
+{
+	switch (texture->GetType()) {
+	case POGLResourceType::TEXTURE3D:
+		return (std::max)(1U, static_cast<POGLTexture3D*>(texture)->GetDepth() >> mipLevel);
+	case POGLResourceType::TEXTURE2DARRAY:
+		return static_cast<POGLTexture2DArray*>(texture)->GetLayers();
+	case POGLResourceType::TEXTURECUBE:
+		return POGLCubeFace::COUNT;
+	default:
+		return 1;
+	}
+}
+
+POGL_UINT32 POGLTextureUtils::GetMipLevels(POGL_UINT32 mipLevels, const POGL_SIZE& size, POGL_UINT32 depth)
+{
+	const POGL_UINT32 maxMipLevels = POGLTexture2D::CalculateMipLevels(POGL_SIZE((std::max)(size.width, (POGL_INT32)depth), size.height));
+	if (mipLevels == POGL_ALL_MIP_LEVELS)
+		return maxMipLevels;
+
+	if (mipLevels > maxMipLevels)
+		THROW_EXCEPTION(POGLResourceException, "A texture of this size can have at most %d mip levels", maxMipLevels);
+
+	return mipLevels;
+}
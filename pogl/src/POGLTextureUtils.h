@@ -0,0 +1,41 @@
+#pragma once
+#include "config.h"
+#include <gl/pogl.h>
+
+class POGLTextureResource;
+class POGLTextureUtils
+{
+public:
+	/*!
+		\brief Retrieves the texture resource for the supplied texture, regardless of its type
+
+		\return The resource or nullptr if the supplied object is not a texture
+	*/
+	static POGLTextureResource* GetResourcePtr(IPOGLTexture* texture);
+
+	/*!
+		\brief Retrieves the width and height of one layer in the supplied mip level. The height of 1D textures is always 1
+	*/
+	static POGL_SIZE GetMipLevelSize(IPOGLTexture* texture, POGL_UINT32 mipLevel);
+
+	/*!
+		\brief Retrieves the number of layers in the supplied mip level.
+
+		The number of layers is the number of array layers for 2D array textures, the number of faces for cube textures and the depth of
+		3D textures. 1D and 2D textures have one layer.
+	*/
+	static POGL_UINT32 GetLayers(IPOGLTexture* texture, POGL_UINT32 mipLevel);
+
+	/*!
+		\brief Validates the requested number of mip levels for a texture of the supplied size
+
+		\param mipLevels
+				The requested number of mip levels or POGL_ALL_MIP_LEVELS
+		\param size
+				The size of the base level
+		\param depth
+				The depth of the base level. Only 3D textures shrink in depth for each mip level, so use 1 for all other textures
+		\return The number of mip levels to allocate
+	*/
+	static POGL_UINT32 GetMipLevels(POGL_UINT32 mipLevels, const POGL_SIZE& size, POGL_UINT32 depth);
+};
@@ -0,0 +1,26 @@
+#include "MemCheck.h"
+#include "POGLUniformRegistry.h"
+#include <mutex>
+
+namespace {
+	std::mutex mutex;
+	std::hash_map<POGL_STRING, POGL_UINT32> ids;
+}
+
+POGL_UINT32 POGLUniformRegistry::GetID(const POGL_STRING& name)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = ids.find(name);
+	if (it != ids.end())
+		return it->second;
+
+	const POGL_UINT32 uniformID = ids.size() + 1;
+	ids.insert(std::make_pair(name, uniformID));
+	return uniformID;
+}
+
+bool POGLUniformRegistry::IsValid(POGL_UINT32 uniformID)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return uniformID != 0 && uniformID <= ids.size();
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "config.h"
+
+/*!
+	\brief Interns uniform names into compact IDs that are shared by all programs
+
+	A uniform ID is an index into per-program and per-render state arrays, which means that a uniform can be found without hashing
+	or comparing strings once its name has been interned. IDs start at 1, so 0 never refers to a uniform. The IDs are valid for the
+	lifetime of the process.
+*/
+class POGLUniformRegistry
+{
+public:
+	/*!
+		\brief Retrieves the ID of the supplied uniform name, interning the name if it's the first time it's seen
+	*/
+	static POGL_UINT32 GetID(const POGL_STRING& name);
+
+	/*!
+		\brief Check to see if the supplied ID has been returned by GetID
+	*/
+	static bool IsValid(POGL_UINT32 uniformID);
+};
@@ -3,6 +3,7 @@
 #include "POGLIndexBuffer.h"
 #include "POGLFactory.h"
 #include "POGLRenderState.h"
+#include "POGLResidencyManager.h"
 #include "POGLEnum.h"
 
 namespace {
@@ -13,13 +14,18 @@ namespace {
 }
 
 POGLVertexBuffer::POGLVertexBuffer(POGL_UINT32 count, const POGL_VERTEX_LAYOUT* layout, GLenum primitiveType, POGLBufferUsage::Enum bufferUsage, IPOGLBufferResourceProvider* provider)
-: mRefCount(1), mUID(0), mBufferID(0), mCount(count), mVAOID(0), mLayout(layout), mPrimitiveType(primitiveType), mBufferResource(nullptr)
+: POGLResidentResource(POGLResidentType::VERTEX_BUFFER), mRefCount(1), mUID(0), mBufferID(0), mCount(count), mVAOID(0), mLayout(layout), mPrimitiveType(primitiveType), mBufferResource(nullptr)
 {
 	const POGL_UINT32 memorySize = count * layout->vertexSize;
 	mBufferResource = provider->CreateBuffer(memorySize, GL_ARRAY_BUFFER, bufferUsage);
 
 }
 
+POGLVertexBuffer::POGLVertexBuffer(POGL_UINT32 count, const POGL_VERTEX_LAYOUT* layout, GLenum primitiveType, IPOGLBufferResource* bufferResource)
+: POGLResidentResource(POGLResidentType::VERTEX_BUFFER), mRefCount(1), mUID(0), mBufferID(0), mCount(count), mVAOID(0), mLayout(layout), mPrimitiveType(primitiveType), mBufferResource(bufferResource)
+{
+}
+
 POGLVertexBuffer::~POGLVertexBuffer()
 {
 }
@@ -32,6 +38,7 @@ void POGLVertexBuffer::AddRef()
 void POGLVertexBuffer::Release()
 {
 	if (--mRefCount == 0) {
+		POGLResidencyManager::Remove(this);
 		if (mBufferResource != nullptr) {
 			mBufferResource->Release();
 			mBufferResource = nullptr;
@@ -64,6 +71,16 @@ POGL_UINT32 POGLVertexBuffer::GetMemorySize() const
 	return mCount * mLayout->vertexSize;
 }
 
+void POGLVertexBuffer::SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy)
+{
+	mBufferResource->SetUpdateStrategy(strategy);
+}
+
+POGLBufferUpdateStrategy::Enum POGLVertexBuffer::GetUpdateStrategy() const
+{
+	return mBufferResource->GetUpdateStrategy();
+}
+
 void* POGLVertexBuffer::Map(POGLResourceMapType::Enum e)
 {
 	return mBufferResource->Map(e);
@@ -82,54 +99,61 @@ void POGLVertexBuffer::Unmap()
 void POGLVertexBuffer::Draw()
 {
 	mBufferResource->Lock();
-	glDrawArrays(mPrimitiveType, 0, mCount);
+	glDrawArrays(mPrimitiveType, GetRegionFirst(), mCount);
 	mBufferResource->Unlock();
 }
 
 void POGLVertexBuffer::Draw(POGL_UINT32 count)
 {
 	mBufferResource->Lock(0, count * mLayout->vertexSize);
-	glDrawArrays(mPrimitiveType, 0, count);
+	glDrawArrays(mPrimitiveType, GetRegionFirst(), count);
 	mBufferResource->Unlock();
 }
 
 void POGLVertexBuffer::Draw(POGL_UINT32 count, POGL_UINT32 offset)
 {
 	mBufferResource->Lock(offset * mLayout->vertexSize, count * mLayout->vertexSize);
-	glDrawArrays(mPrimitiveType, offset, count);
+	glDrawArrays(mPrimitiveType, GetRegionFirst() + offset, count);
 	mBufferResource->Unlock();
 }
 
 void POGLVertexBuffer::DrawIndexed(POGLIndexBuffer* indexBuffer)
 {
 	mBufferResource->Lock();
-	indexBuffer->DrawIndexed(mPrimitiveType);
+	indexBuffer->DrawIndexed(mPrimitiveType, GetRegionFirst());
 	mBufferResource->Unlock();
 }
 
 void POGLVertexBuffer::DrawIndexed(POGLIndexBuffer* indexBuffer, POGL_UINT32 count)
 {
 	mBufferResource->Lock();
-	indexBuffer->DrawIndexed(mPrimitiveType, count);
+	indexBuffer->DrawIndexed(mPrimitiveType, GetRegionFirst(), count);
 	mBufferResource->Unlock();
 }
 
 void POGLVertexBuffer::DrawIndexed(POGLIndexBuffer* indexBuffer, POGL_UINT32 count, POGL_UINT32 offset)
 {
 	mBufferResource->Lock();
-	indexBuffer->DrawIndexed(mPrimitiveType, count, offset);
+	indexBuffer->DrawIndexed(mPrimitiveType, GetRegionFirst(), count, offset);
 	mBufferResource->Unlock();
 }
 
 void POGLVertexBuffer::PostConstruct(POGLRenderState* renderState)
 {
-	glGenVertexArrays(1, &mVAOID);
+	GLuint vaoID = 0;
+	glGenVertexArrays(1, &vaoID);
 	const GLenum error = glGetError();
-	if (mVAOID == 0 || error != GL_NO_ERROR)
+	if (vaoID == 0 || error != GL_NO_ERROR)
 		THROW_EXCEPTION(POGLResourceException, "Could not generate vertex array object ID. Reason: 0x%x", error);
 
+	PostConstruct(renderState, vaoID);
+}
+
+void POGLVertexBuffer::PostConstruct(POGLRenderState* renderState, GLuint vaoID)
+{
+	mVAOID = vaoID;
 	glBindVertexArray(mVAOID);
-	mBufferResource->PostConstruct(renderState);
+	mBufferID = mBufferResource->PostConstruct(renderState);
 
 	//
 	// Define how the vertex attributes are located
@@ -171,7 +195,23 @@ void POGLVertexBuffer::PostConstruct(POGLRenderState* renderState)
 	}
 
 	mUID = GenVertexBufferUID();
+	POGLResidencyManager::Add(this);
 
 	// Ensure that the vertex buffer is bound
 	renderState->ForceSetVertexBuffer(this);
 }
+
+POGL_UINT64 POGLVertexBuffer::GetResidentMemorySize() const
+{
+	return GetMemorySize();
+}
+
+bool POGLVertexBuffer::Evict()
+{
+	return mBufferResource->Evict();
+}
+
+void POGLVertexBuffer::Restore()
+{
+	mBufferResource->Restore();
+}
@@ -1,13 +1,15 @@
 #pragma once
 #include "IPOGLBufferResourceProvider.h"
+#include "POGLResidentResource.h"
 
 class POGLRenderState;
 class POGLIndexBuffer;
 class POGLBufferResource;
-class POGLVertexBuffer : public IPOGLVertexBuffer
+class POGLVertexBuffer : public IPOGLVertexBuffer, public POGLResidentResource
 {
 public:
 	POGLVertexBuffer(POGL_UINT32 count, const POGL_VERTEX_LAYOUT* layout, GLenum primitiveType, POGLBufferUsage::Enum bufferUsage, IPOGLBufferResourceProvider* provider);
+	POGLVertexBuffer(POGL_UINT32 count, const POGL_VERTEX_LAYOUT* layout, GLenum primitiveType, IPOGLBufferResource* bufferResource);
 	~POGLVertexBuffer();
 	
 	/*!
@@ -17,6 +19,14 @@ public:
 	*/
 	void PostConstruct(POGLRenderState* renderState);
 
+	/*!
+		\brief Initializes the OpenGL specific functionality for this buffer using an already generated vertex array object.
+
+		\param renderState
+		\param vaoID
+	*/
+	void PostConstruct(POGLRenderState* renderState, GLuint vaoID);
+
 	/*!
 		\brief Retrieves a unique ID for this vertex buffer
 	*/
@@ -42,6 +52,13 @@ public:
 	void DrawIndexed(POGLIndexBuffer* indexBuffer);
 	void DrawIndexed(POGLIndexBuffer* indexBuffer, POGL_UINT32 count);
 	void DrawIndexed(POGLIndexBuffer* indexBuffer, POGL_UINT32 count, POGL_UINT32 offset);
+
+	/*!
+		\brief Retrieves the index of the first vertex in the memory region the draw calls should read from
+	*/
+	inline POGL_UINT32 GetRegionFirst() const {
+		return mBufferResource->GetRegionOffset() / mLayout->vertexSize;
+	}
 	
 // IPOGLInterface
 public:
@@ -57,6 +74,14 @@ public:
 	virtual const POGL_VERTEX_LAYOUT* GetLayout() const;
 	virtual POGL_UINT32 GetCount() const;
 	virtual POGL_UINT32 GetMemorySize() const;
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy);
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const;
+
+// POGLResidentResource
+public:
+	virtual POGL_UINT64 GetResidentMemorySize() const;
+	virtual bool Evict();
+	virtual void Restore();
 
 private:
 	REF_COUNTER mRefCount;
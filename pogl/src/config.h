@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cmath>
 
 #include "POGLExtensions.h"
 
@@ -21,19 +22,19 @@ typedef std::string POGL_STRING;
 #endif
 
 #ifndef FLT_EQ
-#define FLT_EQ(val1, val2) (abs(val2 - val1) <= FLT_EPSILON)
+#define FLT_EQ(val1, val2) (fabs(val2 - val1) <= FLT_EPSILON)
 #endif
 
 #ifndef FLT_NEQ
-#define FLT_NEQ(val1, val2) (abs(val2 - val1) > FLT_EPSILON)
+#define FLT_NEQ(val1, val2) (fabs(val2 - val1) > FLT_EPSILON)
 #endif
 
 #ifndef DBL_EQ
-#define DBL_EQ(val1, val2) (abs(val2 - val1) <= DBL_EPSILON)
+#define DBL_EQ(val1, val2) (fabs(val2 - val1) <= DBL_EPSILON)
 #endif
 
 #ifndef DBL_NEQ
-#define DBL_NEQ(val1, val2) (abs(val2 - val1) > DBL_EPSILON)
+#define DBL_NEQ(val1, val2) (fabs(val2 - val1) > DBL_EPSILON)
 #endif
 
 #include <fstream>
@@ -51,6 +51,20 @@ void POGLAMDBufferResource::Unmap()
 {
 }
 
+POGL_UINT32 POGLAMDBufferResource::GetRegionOffset() const
+{
+	return 0;
+}
+
+void POGLAMDBufferResource::SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy)
+{
+}
+
+POGLBufferUpdateStrategy::Enum POGLAMDBufferResource::GetUpdateStrategy() const
+{
+	return POGLBufferUpdateStrategy::PERSISTENT;
+}
+
 void POGLAMDBufferResource::Lock()
 {
 	mLock.PrepareFence();
@@ -66,6 +80,16 @@ void POGLAMDBufferResource::Unlock()
 	mLock.AddFences();
 }
 
+bool POGLAMDBufferResource::Evict()
+{
+	// The buffer lives in pinned client memory, which is already system memory
+	return false;
+}
+
+void POGLAMDBufferResource::Restore()
+{
+}
+
 GLuint POGLAMDBufferResource::PostConstruct(POGLRenderState* renderState)
 {
 	glGenBuffers(1, &mBufferID);
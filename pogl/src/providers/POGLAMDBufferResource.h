@@ -22,9 +22,14 @@ public:
 	virtual void* Map(POGLResourceMapType::Enum e);
 	virtual void* Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e);
 	virtual void Unmap();
+	virtual POGL_UINT32 GetRegionOffset() const;
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy);
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const;
 	virtual void Lock();
 	virtual void Lock(POGL_UINT32 offset, POGL_UINT32 length);
 	virtual void Unlock();
+	virtual bool Evict();
+	virtual void Restore();
 
 // IPOGLInterface
 public:
@@ -1,23 +1,29 @@
 #include "MemCheck.h"
 #include "POGLBufferResourceLock.h"
+#include <algorithm>
+#include <chrono>
+using namespace std::chrono;
+
+namespace {
+	std::atomic<POGL_UINT32> frameCount;
+	std::atomic<POGL_UINT32> stallCount;
+	std::atomic<POGL_UINT64> stallTimeNs;
+
+	// How long we wait for a fence (in nanoseconds) before checking it again
+	const GLuint64 FENCE_WAIT_TIMEOUT = 1000000;
+}
 
 POGLBufferResourceLock::POGLBufferResourceLock()
+: mFirstFence(0), mNumFences(0), mPrepared(false), mPending(false), mPendingFrame(0)
 {
 }
 
 POGLBufferResourceLock::~POGLBufferResourceLock()
 {
-	auto end = mFences.end();
-	for (auto it = mFences.begin(); it != end; ++it) {
-		free(*it);
+	for (POGL_UINT32 i = 0; i < mNumFences; ++i) {
+		glDeleteSync(GetFence(i).lock);
 	}
-	mFences.clear();
-
-	end = mFreeFences.end();
-	for (auto it = mFreeFences.begin(); it != end; ++it) {
-		free(*it);
-	}
-	mFreeFences.clear();
+	mNumFences = 0;
 }
 
 void POGLBufferResourceLock::PrepareFence()
@@ -27,106 +33,163 @@ void POGLBufferResourceLock::PrepareFence()
 
 void POGLBufferResourceLock::PrepareFence(POGL_UINT32 offset, POGL_UINT32 length)
 {
-	auto fence = GetOrCreateFreeFence();
-	fence->min = offset;
-	fence->max = offset + length;
-	fence->lock = nullptr;
-	mFences.push_back(fence);
+	const POGL_UINT32 max = length > UINT_MAX - offset ? UINT_MAX : offset + length;
+	if (mPrepared) {
+		mPreparedRange.min = (std::min)(mPreparedRange.min, offset);
+		mPreparedRange.max = (std::max)(mPreparedRange.max, max);
+	}
+	else {
+		mPreparedRange.min = offset;
+		mPreparedRange.max = max;
+		mPrepared = true;
+	}
 }
 
 void POGLBufferResourceLock::AddFences()
 {
-	auto end = mFences.end();
-	for (auto it = mFences.begin(); it != end; ++it) {
-		auto fence = *it;
-		if (fence->lock == nullptr)
-			fence->lock = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-		CHECK_GL("Could not create memory fence");
+	if (!mPrepared)
+		return;
+	mPrepared = false;
+
+	// A new frame has started using this buffer. Guard the memory used by the previous frame(s)
+	const POGL_UINT32 frame = frameCount.load();
+	if (mPending && mPendingFrame != frame)
+		AddPendingFence();
+
+	if (mPending) {
+		mPendingRange.min = (std::min)(mPendingRange.min, mPreparedRange.min);
+		mPendingRange.max = (std::max)(mPendingRange.max, mPreparedRange.max);
+	}
+	else {
+		mPendingRange.min = mPreparedRange.min;
+		mPendingRange.max = mPreparedRange.max;
+		mPendingFrame = frame;
+		mPending = true;
 	}
 }
 
 void POGLBufferResourceLock::WaitAndClear()
 {
-	auto end = mFences.end();
-	for (auto it = mFences.begin(); it != end; ++it) {
-		auto fence = *it;
-		glWaitSync(fence->lock, 0, GL_TIMEOUT_IGNORED);
-		CHECK_GL("Could not wait for memory fence");
-		glDeleteSync(fence->lock);
-		CHECK_GL("Could not delete memory fence");
-		fence->lock = nullptr;
-		mFreeFences.push_back(fence);
-	}
-	mFences.clear();
+	WaitAndClear(0, UINT_MAX);
 }
 
 void POGLBufferResourceLock::WaitAndClear(POGL_UINT32 offset, POGL_UINT32 length)
 {
-	auto end = mFences.end();
-	for (auto it = mFences.begin(); it != end;) {
-		auto fence = *it;
-		if (IsInRange(fence, offset, length)) {
-			glWaitSync(fence->lock, 0, GL_TIMEOUT_IGNORED);
-			CHECK_GL("Could not wait for memory fence");
-			glDeleteSync(fence->lock);
-			CHECK_GL("Could not delete memory fence");
-			fence->lock = nullptr;
-			mFreeFences.push_back(fence);
-			Fences::iterator prev = it;
-			it++;
-			mFences.erase(prev);
-		}
-		else {
-			it++;
-		}
-	}
+	if (mPending && IsInRange(mPendingRange, offset, length))
+		AddPendingFence();
+
+	Retire();
+	const POGL_INT32 index = FindNewest(offset, length);
+	if (index == -1)
+		return;
+
+	// Let the GPU wait for the fence. Older fences are implicitly waited for as well
+	glWaitSync(GetFence(index).lock, 0, GL_TIMEOUT_IGNORED);
+	CHECK_GL("Could not wait for memory fence");
+	Clear(index + 1);
 }
 
 void POGLBufferResourceLock::WaitClientAndClear()
 {
-	auto end = mFences.end();
-	for (auto it = mFences.begin(); it != end; ++it) {
-		auto fence = *it;
-		glClientWaitSync(fence->lock, 0, GL_TIMEOUT_IGNORED);
-		CHECK_GL("Could not wait for memory fence");
-		glDeleteSync(fence->lock);
-		CHECK_GL("Could not delete memory fence");
-		fence->lock = nullptr;
-		mFreeFences.push_back(fence);
-	}
-	mFences.clear();
+	WaitClientAndClear(0, UINT_MAX);
 }
 
 void POGLBufferResourceLock::WaitClientAndClear(POGL_UINT32 offset, POGL_UINT32 length)
 {
-	auto end = mFences.end();
-	for (auto it = mFences.begin(); it != end;) {
-		auto fence = *it;
-		if (IsInRange(fence, offset, length)) {
-			glClientWaitSync(fence->lock, 0, GL_TIMEOUT_IGNORED);
-			CHECK_GL("Could not wait for memory fence");
-			glDeleteSync(fence->lock);
-			CHECK_GL("Could not delete memory fence");
-			fence->lock = nullptr;
-			mFreeFences.push_back(fence);
-			Fences::iterator prev = it;
-			it++;
-			mFences.erase(prev);
-		}
-		else {
-			it++;
-		}
+	if (mPending && IsInRange(mPendingRange, offset, length))
+		AddPendingFence();
+
+	Retire();
+	const POGL_INT32 index = FindNewest(offset, length);
+	if (index == -1)
+		return;
+
+	ClientWait(GetFence(index).lock);
+	Clear(index + 1);
+}
+
+void POGLBufferResourceLock::ClientWait(GLsync lock)
+{
+	GLenum result = glClientWaitSync(lock, 0, 0);
+	if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+		return;
+
+	const auto start = high_resolution_clock::now();
+	GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	do {
+		result = glClientWaitSync(lock, flags, FENCE_WAIT_TIMEOUT);
+		flags = 0;
+	} while (result == GL_TIMEOUT_EXPIRED);
+	CHECK_GL("Could not wait for memory fence");
+
+	const auto stallTime = duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+	stallCount++;
+	stallTimeNs += (POGL_UINT64)stallTime;
+}
+
+void POGLBufferResourceLock::EndFrame()
+{
+	frameCount++;
+}
+
+POGL_UINT32 POGLBufferResourceLock::GetFrame()
+{
+	return frameCount.load();
+}
+
+void POGLBufferResourceLock::GetStatistics(POGL_DEVICE_STATISTICS* statistics)
+{
+	statistics->frameCount = frameCount.load();
+	statistics->bufferStallCount = stallCount.load();
+	statistics->bufferStallTime = (POGL_DOUBLE)stallTimeNs.load() / 1000000.0;
+}
+
+void POGLBufferResourceLock::AddPendingFence()
+{
+	mPending = false;
+
+	// The ring is full. Make room by waiting for the oldest fence
+	if (mNumFences == MAX_FENCES) {
+		ClientWait(GetFence(0).lock);
+		Clear(1);
 	}
+
+	Fence& fence = GetFence(mNumFences);
+	fence.min = mPendingRange.min;
+	fence.max = mPendingRange.max;
+	fence.lock = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	CHECK_GL("Could not create memory fence");
+	mNumFences++;
 }
 
-POGLBufferResourceLock::Fence* POGLBufferResourceLock::GetOrCreateFreeFence()
+void POGLBufferResourceLock::Retire()
 {
-	if (mFreeFences.empty()) {
-		return (Fence*)malloc(sizeof(Fence));
+	POGL_UINT32 count = 0;
+	for (; count < mNumFences; ++count) {
+		const GLenum result = glClientWaitSync(GetFence(count).lock, 0, 0);
+		if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+			break;
 	}
+	Clear(count);
+}
 
-	auto it = mFreeFences.begin();
-	auto fence = *it;
-	mFreeFences.erase(it);
-	return fence;
+POGL_INT32 POGLBufferResourceLock::FindNewest(POGL_UINT32 offset, POGL_UINT32 length) const
+{
+	for (POGL_INT32 i = (POGL_INT32)mNumFences - 1; i >= 0; --i) {
+		if (IsInRange(GetFence(i), offset, length))
+			return i;
+	}
+	return -1;
+}
+
+void POGLBufferResourceLock::Clear(POGL_UINT32 count)
+{
+	for (POGL_UINT32 i = 0; i < count; ++i) {
+		Fence& fence = GetFence(i);
+		glDeleteSync(fence.lock);
+		CHECK_GL("Could not delete memory fence");
+		fence.lock = nullptr;
+	}
+	mFirstFence = (mFirstFence + count) % MAX_FENCES;
+	mNumFences -= count;
 }
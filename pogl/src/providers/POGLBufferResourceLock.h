@@ -1,6 +1,13 @@
 #pragma once
 #include "config.h"
 
+/*!
+	\brief Keeps track of which parts of a buffer the GPU might still be using
+
+	Memory ranges used by the GPU are accumulated during a frame and guarded by a single fence, which is put into the command stream
+	when the next frame starts using the buffer (or when someone has to wait for it). The fences are stored in a fixed-size ring, ordered 
+	from the oldest to the newest. Since the GPU executes commands in order, waiting for a fence also means that every older fence is signaled.
+*/
 class POGLBufferResourceLock
 {
 	struct Fence {
@@ -8,9 +15,11 @@ class POGLBufferResourceLock
 		POGL_UINT32 max;
 		GLsync lock;
 	};
-	typedef std::list<Fence*> Fences;
 
 public:
+	/* Maximum number of fences that can be active at the same time */
+	static const POGL_UINT32 MAX_FENCES = 8;
+
 	POGLBufferResourceLock();
 	virtual ~POGLBufferResourceLock();
 
@@ -25,16 +34,76 @@ public:
 	void WaitClientAndClear();
 	void WaitClientAndClear(POGL_UINT32 offset, POGL_UINT32 length);
 
-	inline bool IsInRange(Fence* fence, POGL_UINT32 offset, POGL_UINT32 length) {
+	inline bool IsInRange(const Fence& fence, POGL_UINT32 offset, POGL_UINT32 length) const {
 		const POGL_UINT32 min = offset;
 		const POGL_UINT32 max = offset + length;
-		return fence->max > min && fence->min < max;
+		return fence.max > min && fence.min < max;
 	}
 
+	/*!
+		\brief Wait for the supplied fence on the client side. 
+		
+		The fence is polled first and the time is only added to the stall statistics if the wait actually blocks.
+	*/
+	static void ClientWait(GLsync lock);
+
+	/*!
+		\brief Notify that the current frame has ended
+	*/
+	static void EndFrame();
+
+	/*!
+		\brief Retrieves the number of frames ended so far
+	*/
+	static POGL_UINT32 GetFrame();
+
+	/*!
+		\brief Fill the supplied statistics structure with the frame and stall counters
+	*/
+	static void GetStatistics(POGL_DEVICE_STATISTICS* statistics);
+
 private:
-	Fence* GetOrCreateFreeFence();
+	/*!
+		\brief Put a fence into the command stream for the pending memory range
+	*/
+	void AddPendingFence();
 
-public:
-	Fences mFences;
-	Fences mFreeFences;
+	/*!
+		\brief Remove every signaled fence, starting with the oldest one. This does not block.
+	*/
+	void Retire();
+
+	/*!
+		\brief Find the newest fence overlapping the supplied range
+
+		\return The fence position relative to the oldest fence; -1 if no fence is found
+	*/
+	POGL_INT32 FindNewest(POGL_UINT32 offset, POGL_UINT32 length) const;
+
+	/*!
+		\brief Remove the count oldest fences
+	*/
+	void Clear(POGL_UINT32 count);
+
+	inline Fence& GetFence(POGL_UINT32 index) {
+		return mFences[(mFirstFence + index) % MAX_FENCES];
+	}
+
+	inline const Fence& GetFence(POGL_UINT32 index) const {
+		return mFences[(mFirstFence + index) % MAX_FENCES];
+	}
+
+private:
+	Fence mFences[MAX_FENCES];
+	POGL_UINT32 mFirstFence;
+	POGL_UINT32 mNumFences;
+
+	// Memory range used since the last call to PrepareFence
+	bool mPrepared;
+	Fence mPreparedRange;
+
+	// Memory range used during the current frame which is not yet guarded by a fence
+	bool mPending;
+	Fence mPendingRange;
+	POGL_UINT32 mPendingFrame;
 };
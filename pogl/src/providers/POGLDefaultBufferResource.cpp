@@ -2,9 +2,22 @@
 #include "POGLDefaultBufferResource.h"
 #include "POGLEnum.h"
 
+namespace {
+	POGL_BUFFER_UPDATE_THRESHOLDS thresholds = { 4096, 0.75f, 2.0f };
+
+	// How much the latest update affects the averaged statistics
+	const POGL_FLOAT STATISTICS_WEIGHT = 0.25f;
+}
+
 POGLDefaultBufferResource::POGLDefaultBufferResource(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage)
-: mRefCount(1), mBufferID(0), mMemorySize(memorySize), mTarget(target), mBufferUsage(bufferUsage)
+: mRefCount(1), mBufferID(0), mMemorySize(memorySize), mTarget(target), mBufferUsage(bufferUsage), 
+mUpdateStrategy(POGLBufferUpdateStrategy::DEFAULT), mAdaptiveStrategy(POGLBufferUpdateStrategy::MAP), mTrackFences(bufferUsage != POGLBufferUsage::IMMUTABLE),
+mMappedStrategy(POGLBufferUpdateStrategy::MAP), mMappedOffset(0), mMappedLength(0), mClientMemory(nullptr), mEvictedMemory(nullptr),
+mHasStatistics(false), mStatisticsFrame(POGLBufferResourceLock::GetFrame()), mUpdatesThisFrame(0), mUpdateFrequency(0.0f), mUpdateSize(0.0f)
 {
+	// Immutable buffers are rarely updated and, when they are, they are most likely rewritten completely
+	if (bufferUsage == POGLBufferUsage::IMMUTABLE)
+		mAdaptiveStrategy = POGLBufferUpdateStrategy::ORPHAN;
 }
 
 POGLDefaultBufferResource::~POGLDefaultBufferResource()
@@ -23,24 +36,36 @@ void POGLDefaultBufferResource::Release()
 			glDeleteBuffers(1, &mBufferID);
 			mBufferID = 0;
 		}
+		if (mClientMemory != nullptr) {
+			free(mClientMemory);
+			mClientMemory = nullptr;
+		}
+		if (mEvictedMemory != nullptr) {
+			free(mEvictedMemory);
+			mEvictedMemory = nullptr;
+		}
 		delete this;
 	}
 }
 
-void* POGLDefaultBufferResource::Map(POGLResourceMapType::Enum e)
+void POGLDefaultBufferResource::SetThresholds(const POGL_BUFFER_UPDATE_THRESHOLDS* t)
 {
-	GLenum access = GL_WRITE_ONLY;
-	if (e == POGLResourceMapType::READ)
-		access = GL_READ_ONLY;
+	thresholds = *t;
+}
 
-	if (mBufferUsage == POGLBufferUsage::IMMUTABLE) {
-		glBufferData(mTarget, mMemorySize, 0, POGLEnum::Convert(mBufferUsage));
-		CHECK_GL("Could not initialize buffer data");
-	}
-	else {
-		mLock.PrepareFence();
+const POGL_BUFFER_UPDATE_THRESHOLDS* POGLDefaultBufferResource::GetThresholds()
+{
+	return &thresholds;
+}
+
+void* POGLDefaultBufferResource::Map(POGLResourceMapType::Enum e)
+{
+	if (e == POGLResourceMapType::READ) {
+		mMappedStrategy = POGLBufferUpdateStrategy::MAP;
+		return glMapBuffer(mTarget, GL_READ_ONLY);
 	}
-	return glMapBuffer(mTarget, access);
+
+	return Map(0, mMemorySize, e);
 }
 
 void* POGLDefaultBufferResource::Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e)
@@ -48,45 +73,175 @@ void* POGLDefaultBufferResource::Map(POGL_UINT32 offset, POGL_UINT32 length, POG
 	if (offset + length > mMemorySize)
 		THROW_EXCEPTION(POGLStateException, "You cannot map with offset: %d and length: %d when the buffer size is: %d", offset, length, mMemorySize);
 	
-	GLenum access = GL_MAP_UNSYNCHRONIZED_BIT;
-	if (e == POGLResourceMapType::READ)
-		access |= GL_MAP_READ_BIT;
-	else if (e == POGLResourceMapType::WRITE)
-		access |= GL_MAP_WRITE_BIT;
-
-	if (mBufferUsage != POGLBufferUsage::IMMUTABLE) {
-		mLock.PrepareFence(offset, length);
+	mMappedOffset = offset;
+	mMappedLength = length;
+	
+	if (e == POGLResourceMapType::READ) {
+		mMappedStrategy = POGLBufferUpdateStrategy::MAP;
+		return glMapBufferRange(mTarget, offset, length, GL_MAP_READ_BIT);
 	}
 
-	return glMapBufferRange(mTarget, offset, length, access);
+	mMappedStrategy = BeginUpdate(length);
+	switch (mMappedStrategy) {
+	case POGLBufferUpdateStrategy::ORPHAN:
+		if (offset == 0 && length == mMemorySize) {
+			glBufferData(mTarget, mMemorySize, 0, POGLEnum::Convert(mBufferUsage));
+			CHECK_GL("Could not orphan buffer data");
+			return glMapBufferRange(mTarget, 0, length, GL_MAP_WRITE_BIT);
+		}
+		return glMapBufferRange(mTarget, offset, length, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+	case POGLBufferUpdateStrategy::SUB_DATA:
+		// The client memory mirrors the whole buffer, so that the bytes in the mapped range that are not rewritten keep
+		// their values. It's only read back when the buffer starts using this strategy
+		if (mClientMemory == nullptr) {
+			mClientMemory = malloc(mMemorySize);
+			if (mClientMemory == nullptr)
+				THROW_EXCEPTION(POGLResourceException, "Could not allocate %d bytes of client memory for the buffer", mMemorySize);
+			glGetBufferSubData(mTarget, 0, mMemorySize, mClientMemory);
+			CHECK_GL("Could not read back buffer data");
+		}
+		return (POGL_BYTE*)mClientMemory + offset;
+	case POGLBufferUpdateStrategy::UNSYNCHRONIZED:
+		mLock.WaitClientAndClear(offset, length);
+		return glMapBufferRange(mTarget, offset, length, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	default:
+		return glMapBufferRange(mTarget, offset, length, GL_MAP_WRITE_BIT);
+	}
 }
 
 void POGLDefaultBufferResource::Unmap()
 {
-	glUnmapBuffer(mTarget);
-
-	if (mBufferUsage != POGLBufferUsage::IMMUTABLE) {
-		mLock.AddFences();
+	if (mMappedStrategy == POGLBufferUpdateStrategy::SUB_DATA) {
+		glBufferSubData(mTarget, mMappedOffset, mMappedLength, (POGL_BYTE*)mClientMemory + mMappedOffset);
+		CHECK_GL("Could not upload buffer data");
+	}
+	else {
+		glUnmapBuffer(mTarget);
 	}
 }
 
+POGL_UINT32 POGLDefaultBufferResource::GetRegionOffset() const
+{
+	return 0;
+}
+
+void POGLDefaultBufferResource::SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy)
+{
+	if (strategy == POGLBufferUpdateStrategy::PERSISTENT)
+		THROW_EXCEPTION(POGLStateException, "You cannot make a non-persistent buffer persistent");
+
+	mUpdateStrategy = strategy;
+
+	// The buffer might be mapped unsynchronized, so start tracking how the GPU uses it
+	if (strategy == POGLBufferUpdateStrategy::UNSYNCHRONIZED)
+		mTrackFences = true;
+}
+
+POGLBufferUpdateStrategy::Enum POGLDefaultBufferResource::GetUpdateStrategy() const
+{
+	if (mUpdateStrategy == POGLBufferUpdateStrategy::ADAPTIVE)
+		return mAdaptiveStrategy;
+	return mUpdateStrategy;
+}
+
 void POGLDefaultBufferResource::Lock()
 {
-	if (mBufferUsage != POGLBufferUsage::IMMUTABLE) {
-		mLock.WaitAndClear();
+	if (mTrackFences) {
+		mLock.PrepareFence();
 	}
 }
 
 void POGLDefaultBufferResource::Lock(POGL_UINT32 offset, POGL_UINT32 length)
 {
-	if (mBufferUsage != POGLBufferUsage::IMMUTABLE) {
-		mLock.WaitAndClear(offset, length);
+	if (mTrackFences) {
+		mLock.PrepareFence(offset, length);
 	}
 }
 
 void POGLDefaultBufferResource::Unlock()
 {
+	if (mTrackFences) {
+		mLock.AddFences();
+	}
+}
+
+bool POGLDefaultBufferResource::Evict()
+{
+	if (mBufferID == 0 || mMemorySize == 0)
+		return false;
+
+	mEvictedMemory = malloc(mMemorySize);
+	if (mEvictedMemory == nullptr)
+		return false;
+
+	// The copy target is used so that the buffer bindings in the current vertex array object are left untouched
+	glBindBuffer(GL_COPY_READ_BUFFER, mBufferID);
+	glGetBufferSubData(GL_COPY_READ_BUFFER, 0, mMemorySize, mEvictedMemory);
+	glBufferData(GL_COPY_READ_BUFFER, 0, nullptr, POGLEnum::Convert(mBufferUsage));
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	return true;
+}
+
+void POGLDefaultBufferResource::Restore()
+{
+	assert_not_null(mEvictedMemory);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, mBufferID);
+	glBufferData(GL_COPY_READ_BUFFER, mMemorySize, mEvictedMemory, POGLEnum::Convert(mBufferUsage));
+	CHECK_GL("Could not restore buffer data");
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+	free(mEvictedMemory);
+	mEvictedMemory = nullptr;
+}
+
+POGLBufferUpdateStrategy::Enum POGLDefaultBufferResource::BeginUpdate(POGL_UINT32 length)
+{
+	// Summarize the previous frame(s) the first time the buffer is updated in a new frame
+	const POGL_UINT32 frame = POGLBufferResourceLock::GetFrame();
+	const bool newFrame = frame != mStatisticsFrame;
+	if (newFrame) {
+		const POGL_FLOAT updatesPerFrame = (POGL_FLOAT)mUpdatesThisFrame / (POGL_FLOAT)(frame - mStatisticsFrame);
+		mUpdateFrequency += (updatesPerFrame - mUpdateFrequency) * STATISTICS_WEIGHT;
+		mStatisticsFrame = frame;
+		mUpdatesThisFrame = 0;
+	}
+	mUpdatesThisFrame++;
+
+	// The size is updated before the strategy is selected, so that the first update isn't treated as an empty one
+	if (mHasStatistics)
+		mUpdateSize += ((POGL_FLOAT)length - mUpdateSize) * STATISTICS_WEIGHT;
+	else
+		mUpdateSize = (POGL_FLOAT)length;
+
+	if (mUpdateStrategy == POGLBufferUpdateStrategy::ADAPTIVE && (newFrame || !mHasStatistics))
+		mAdaptiveStrategy = SelectStrategy();
+	mHasStatistics = true;
+
+	const POGLBufferUpdateStrategy::Enum strategy = GetUpdateStrategy();
+
+	// The client memory is only needed by the glBufferSubData strategy
+	if (strategy != POGLBufferUpdateStrategy::SUB_DATA && mClientMemory != nullptr) {
+		free(mClientMemory);
+		mClientMemory = nullptr;
+	}
+
+	return strategy;
+}
+
+POGLBufferUpdateStrategy::Enum POGLDefaultBufferResource::SelectStrategy() const
+{
+	if (mUpdateSize <= (POGL_FLOAT)thresholds.subDataMaxSize)
+		return POGLBufferUpdateStrategy::SUB_DATA;
+
+	if (mUpdateSize >= (POGL_FLOAT)mMemorySize * thresholds.orphanMinRatio)
+		return POGLBufferUpdateStrategy::ORPHAN;
+
+	// Frequent partial updates. Only wait for the parts of the buffer that the GPU is using
+	if (mTrackFences && mUpdateFrequency >= thresholds.unsynchronizedMinFrequency)
+		return POGLBufferUpdateStrategy::UNSYNCHRONIZED;
 
+	return POGLBufferUpdateStrategy::MAP;
 }
 
 GLuint POGLDefaultBufferResource::PostConstruct(POGLRenderState* renderState)
@@ -16,21 +16,49 @@ public:
 		return mBufferID;
 	}
 
+	/*!
+		\brief Set the thresholds used by all buffers with the adaptive update strategy
+	*/
+	static void SetThresholds(const POGL_BUFFER_UPDATE_THRESHOLDS* thresholds);
+
+	/*!
+		\brief Retrieves the thresholds used by all buffers with the adaptive update strategy
+	*/
+	static const POGL_BUFFER_UPDATE_THRESHOLDS* GetThresholds();
+
 // IPOGLBufferResource
 public:
 	virtual GLuint PostConstruct(POGLRenderState* renderState);
 	virtual void* Map(POGLResourceMapType::Enum e);
 	virtual void* Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e);
 	virtual void Unmap();
+	virtual POGL_UINT32 GetRegionOffset() const;
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy);
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const;
 	virtual void Lock();
 	virtual void Lock(POGL_UINT32 offset, POGL_UINT32 length);
 	virtual void Unlock();
+	virtual bool Evict();
+	virtual void Restore();
 
 // IPOGLInterface
 public:
 	virtual void AddRef();
 	virtual void Release();
 
+private:
+	/*!
+		\brief Update the size- and frequency statistics for this buffer and select a new strategy if the adaptive strategy is used
+
+		\return The strategy to use for this update
+	*/
+	POGLBufferUpdateStrategy::Enum BeginUpdate(POGL_UINT32 length);
+
+	/*!
+		\brief Select the cheapest strategy based on the collected statistics
+	*/
+	POGLBufferUpdateStrategy::Enum SelectStrategy() const;
+
 private:
 	REF_COUNTER mRefCount;
 	GLuint mBufferID;
@@ -38,5 +66,27 @@ private:
 	GLenum mTarget;
 	POGLBufferUsage::Enum mBufferUsage;
 
+	POGLBufferUpdateStrategy::Enum mUpdateStrategy;
+	POGLBufferUpdateStrategy::Enum mAdaptiveStrategy;
+	bool mTrackFences;
+
+	// The current mapping
+	POGLBufferUpdateStrategy::Enum mMappedStrategy;
+	POGL_UINT32 mMappedOffset;
+	POGL_UINT32 mMappedLength;
+
+	// A copy of the buffer data used by the glBufferSubData strategy
+	void* mClientMemory;
+
+	// The buffer data while the buffer is evicted
+	void* mEvictedMemory;
+
+	// Update statistics. The averages are seeded by the first update
+	bool mHasStatistics;
+	POGL_UINT32 mStatisticsFrame;
+	POGL_UINT32 mUpdatesThisFrame;
+	POGL_FLOAT mUpdateFrequency;
+	POGL_FLOAT mUpdateSize;
+
 	POGLBufferResourceLock mLock;
 };
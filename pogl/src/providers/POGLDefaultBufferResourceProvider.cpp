@@ -1,6 +1,7 @@
 #include "MemCheck.h"
 #include "POGLDefaultBufferResourceProvider.h"
 #include "POGLDefaultBufferResource.h"
+#include "POGLRingBufferResource.h"
 #include "POGLEnum.h"
 
 POGLDefaultBufferResourceProvider::POGLDefaultBufferResourceProvider()
@@ -13,5 +14,8 @@ POGLDefaultBufferResourceProvider::~POGLDefaultBufferResourceProvider()
 
 IPOGLBufferResource* POGLDefaultBufferResourceProvider::CreateBuffer(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage)
 {
+	if (bufferUsage == POGLBufferUsage::STREAM_RING)
+		return new POGLRingBufferResource(memorySize, target, bufferUsage, false);
+
 	return new POGLDefaultBufferResource(memorySize, target, bufferUsage);
 }
@@ -0,0 +1,118 @@
+#include "MemCheck.h"
+#include "POGLPersistentBufferResource.h"
+#include "../POGLEnum.h"
+
+namespace {
+	const GLbitfield PERSISTENT_MAP_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+}
+
+POGLPersistentBufferResource::POGLPersistentBufferResource(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage)
+: mRefCount(1), mBufferID(0), mMemorySize(memorySize), mTarget(target), mBufferUsage(bufferUsage), mMappedMemory(nullptr)
+{
+}
+
+POGLPersistentBufferResource::~POGLPersistentBufferResource()
+{
+}
+
+void POGLPersistentBufferResource::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLPersistentBufferResource::Release()
+{
+	if (--mRefCount == 0) {
+		if (mBufferID != 0) {
+			if (mMappedMemory != nullptr) {
+				glBindBuffer(mTarget, mBufferID);
+				glUnmapBuffer(mTarget);
+				mMappedMemory = nullptr;
+			}
+			glDeleteBuffers(1, &mBufferID);
+			mBufferID = 0;
+		}
+		delete this;
+	}
+}
+
+void* POGLPersistentBufferResource::Map(POGLResourceMapType::Enum e)
+{
+	mLock.WaitClientAndClear();
+	return mMappedMemory;
+}
+
+void* POGLPersistentBufferResource::Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e)
+{
+	if (offset + length > mMemorySize)
+		THROW_EXCEPTION(POGLStateException, "You cannot map with offset: %d and length: %d when the buffer size is: %d", offset, length, mMemorySize);
+
+	mLock.WaitClientAndClear(offset, length);
+	return mMappedMemory + offset;
+}
+
+void POGLPersistentBufferResource::Unmap()
+{
+	// The memory is coherent, so writes become visible to the GPU without an explicit flush
+}
+
+POGL_UINT32 POGLPersistentBufferResource::GetRegionOffset() const
+{
+	return 0;
+}
+
+void POGLPersistentBufferResource::SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy)
+{
+}
+
+POGLBufferUpdateStrategy::Enum POGLPersistentBufferResource::GetUpdateStrategy() const
+{
+	return POGLBufferUpdateStrategy::PERSISTENT;
+}
+
+void POGLPersistentBufferResource::Lock()
+{
+	mLock.PrepareFence();
+}
+
+void POGLPersistentBufferResource::Lock(POGL_UINT32 offset, POGL_UINT32 length)
+{
+	mLock.PrepareFence(offset, length);
+}
+
+void POGLPersistentBufferResource::Unlock()
+{
+	mLock.AddFences();
+}
+
+bool POGLPersistentBufferResource::Evict()
+{
+	// The buffer is mapped persistently, so the mapped pointer would be invalidated if the data was moved
+	return false;
+}
+
+void POGLPersistentBufferResource::Restore()
+{
+}
+
+GLuint POGLPersistentBufferResource::PostConstruct(POGLRenderState* renderState)
+{
+	glGenBuffers(1, &mBufferID);
+	const GLenum error = glGetError();
+	if (mBufferID == 0 || error != GL_NO_ERROR)
+		THROW_EXCEPTION(POGLResourceException, "Could not generate buffer ID. Reason: 0x%x", error);
+
+	// Bind the buffer
+	glBindBuffer(mTarget, mBufferID);
+	CHECK_GL("Could not bind buffer");
+
+	// Allocate immutable storage which is allowed to stay mapped while the GPU uses it
+	glBufferStorage(mTarget, mMemorySize, nullptr, PERSISTENT_MAP_FLAGS);
+	CHECK_GL("Could not initialize buffer storage");
+
+	mMappedMemory = (char*)glMapBufferRange(mTarget, 0, mMemorySize, PERSISTENT_MAP_FLAGS);
+	if (mMappedMemory == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "Could not map buffer persistently. Reason: 0x%x", glGetError());
+
+	return mBufferID;
+}
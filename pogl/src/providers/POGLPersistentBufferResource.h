@@ -0,0 +1,56 @@
+#pragma once
+#include "IPOGLBufferResource.h"
+#include "POGLBufferResourceLock.h"
+
+class POGLRenderState;
+
+/*!
+	\brief Buffer resource that keeps its memory persistently mapped (GL_ARB_buffer_storage)
+
+	The buffer storage is allocated with glBufferStorage and mapped once when the resource is constructed.
+	Mapping the buffer simply returns a pointer into that memory region after waiting for any in-flight draw calls.
+*/
+class POGLPersistentBufferResource : public IPOGLBufferResource
+{
+public:
+	POGLPersistentBufferResource(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage);
+	virtual ~POGLPersistentBufferResource();
+	
+	/*!
+		\brief Retrieves the internal OpenGL buffer ID
+	*/
+	inline GLuint GetBufferID() const {
+		return mBufferID;
+	}
+
+// IPOGLBufferResource
+public:
+	virtual GLuint PostConstruct(POGLRenderState* renderState);
+	virtual void* Map(POGLResourceMapType::Enum e);
+	virtual void* Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e);
+	virtual void Unmap();
+	virtual POGL_UINT32 GetRegionOffset() const;
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy);
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const;
+	virtual void Lock();
+	virtual void Lock(POGL_UINT32 offset, POGL_UINT32 length);
+	virtual void Unlock();
+	virtual bool Evict();
+	virtual void Restore();
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+private:
+	REF_COUNTER mRefCount;
+	GLuint mBufferID;
+	POGL_UINT32 mMemorySize;
+	GLenum mTarget;
+	POGLBufferUsage::Enum mBufferUsage;
+
+	char* mMappedMemory;
+
+	POGLBufferResourceLock mLock;
+};
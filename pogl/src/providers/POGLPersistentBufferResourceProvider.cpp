@@ -0,0 +1,26 @@
+#include "MemCheck.h"
+#include "POGLPersistentBufferResourceProvider.h"
+#include "POGLPersistentBufferResource.h"
+#include "POGLDefaultBufferResource.h"
+#include "POGLRingBufferResource.h"
+#include "POGLEnum.h"
+
+POGLPersistentBufferResourceProvider::POGLPersistentBufferResourceProvider()
+: POGLDefaultBufferResourceProvider()
+{
+}
+
+POGLPersistentBufferResourceProvider::~POGLPersistentBufferResourceProvider()
+{
+}
+
+IPOGLBufferResource* POGLPersistentBufferResourceProvider::CreateBuffer(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage)
+{
+	if (bufferUsage == POGLBufferUsage::STREAM_RING)
+		return new POGLRingBufferResource(memorySize, target, bufferUsage, true);
+
+	if (bufferUsage == POGLBufferUsage::STREAM || bufferUsage == POGLBufferUsage::DYNAMIC)
+		return new POGLPersistentBufferResource(memorySize, target, bufferUsage);
+
+	return POGLDefaultBufferResourceProvider::CreateBuffer(memorySize, target, bufferUsage);
+}
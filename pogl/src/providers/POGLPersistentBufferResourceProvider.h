@@ -0,0 +1,15 @@
+#pragma once
+#include "../IPOGLBufferResourceProvider.h"
+#include "POGLDefaultBufferResourceProvider.h"
+
+class POGLRenderState;
+class POGLPersistentBufferResourceProvider : public POGLDefaultBufferResourceProvider
+{
+public:
+	POGLPersistentBufferResourceProvider();
+	virtual ~POGLPersistentBufferResourceProvider();
+
+// IPOGLBufferResourceProvider
+public:
+	virtual IPOGLBufferResource* CreateBuffer(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage);
+};
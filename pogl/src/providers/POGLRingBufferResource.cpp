@@ -0,0 +1,174 @@
+#include "MemCheck.h"
+#include "POGLRingBufferResource.h"
+#include "../POGLEnum.h"
+#include "POGLBufferResourceLock.h"
+
+namespace {
+	const GLbitfield PERSISTENT_MAP_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+}
+
+POGLRingBufferResource::POGLRingBufferResource(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage, bool persistent)
+: mRefCount(1), mBufferID(0), mMemorySize(memorySize), mTarget(target), mBufferUsage(bufferUsage), mPersistent(persistent), 
+mMappedMemory(nullptr), mRegionIndex(0), mRegionInUse(false)
+{
+	for (POGL_UINT32 i = 0; i < REGION_COUNT; ++i)
+		mRegionFences[i] = nullptr;
+}
+
+POGLRingBufferResource::~POGLRingBufferResource()
+{
+}
+
+void POGLRingBufferResource::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLRingBufferResource::Release()
+{
+	if (--mRefCount == 0) {
+		for (POGL_UINT32 i = 0; i < REGION_COUNT; ++i) {
+			if (mRegionFences[i] != nullptr) {
+				glDeleteSync(mRegionFences[i]);
+				mRegionFences[i] = nullptr;
+			}
+		}
+		if (mBufferID != 0) {
+			if (mMappedMemory != nullptr) {
+				glBindBuffer(mTarget, mBufferID);
+				glUnmapBuffer(mTarget);
+				mMappedMemory = nullptr;
+			}
+			glDeleteBuffers(1, &mBufferID);
+			mBufferID = 0;
+		}
+		delete this;
+	}
+}
+
+void* POGLRingBufferResource::Map(POGLResourceMapType::Enum e)
+{
+	return Map(0, mMemorySize, e);
+}
+
+void* POGLRingBufferResource::Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e)
+{
+	if (offset + length > mMemorySize)
+		THROW_EXCEPTION(POGLStateException, "You cannot map with offset: %d and length: %d when the buffer size is: %d", offset, length, mMemorySize);
+
+	// Read the data in the current region once the GPU is done with it. A read cannot be unsynchronized
+	if (e == POGLResourceMapType::READ) {
+		if (mRegionInUse) {
+			GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			CHECK_GL("Could not create memory fence");
+			POGLBufferResourceLock::ClientWait(fence);
+			glDeleteSync(fence);
+		}
+
+		const POGL_UINT32 regionOffset = GetRegionOffset();
+		if (mPersistent)
+			return mMappedMemory + regionOffset + offset;
+		return glMapBufferRange(mTarget, regionOffset + offset, length, GL_MAP_READ_BIT);
+	}
+
+	// The GPU might still read from the current region, so start writing into the next one
+	if (mRegionInUse)
+		NextRegion();
+
+	const POGL_UINT32 regionOffset = GetRegionOffset();
+	if (mPersistent)
+		return mMappedMemory + regionOffset + offset;
+
+	// The region is guarded by its own fence so the driver doesn't have to synchronize anything for us
+	return glMapBufferRange(mTarget, regionOffset + offset, length, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void POGLRingBufferResource::Unmap()
+{
+	if (!mPersistent)
+		glUnmapBuffer(mTarget);
+}
+
+POGL_UINT32 POGLRingBufferResource::GetRegionOffset() const
+{
+	return mRegionIndex * mMemorySize;
+}
+
+void POGLRingBufferResource::SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy)
+{
+}
+
+POGLBufferUpdateStrategy::Enum POGLRingBufferResource::GetUpdateStrategy() const
+{
+	return mPersistent ? POGLBufferUpdateStrategy::PERSISTENT : POGLBufferUpdateStrategy::UNSYNCHRONIZED;
+}
+
+void POGLRingBufferResource::Lock()
+{
+}
+
+void POGLRingBufferResource::Lock(POGL_UINT32 offset, POGL_UINT32 length)
+{
+}
+
+void POGLRingBufferResource::Unlock()
+{
+	mRegionInUse = true;
+}
+
+bool POGLRingBufferResource::Evict()
+{
+	// The buffer is rewritten every frame and is mapped persistently when the driver supports it
+	return false;
+}
+
+void POGLRingBufferResource::Restore()
+{
+}
+
+void POGLRingBufferResource::NextRegion()
+{
+	// Guard every draw call that used the current region with one fence
+	mRegionFences[mRegionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	CHECK_GL("Could not create memory fence");
+
+	mRegionIndex = (mRegionIndex + 1) % REGION_COUNT;
+	mRegionInUse = false;
+
+	// Only block if the CPU has lapped the GPU
+	GLsync& fence = mRegionFences[mRegionIndex];
+	if (fence != nullptr) {
+		POGLBufferResourceLock::ClientWait(fence);
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
+
+GLuint POGLRingBufferResource::PostConstruct(POGLRenderState* renderState)
+{
+	glGenBuffers(1, &mBufferID);
+	const GLenum error = glGetError();
+	if (mBufferID == 0 || error != GL_NO_ERROR)
+		THROW_EXCEPTION(POGLResourceException, "Could not generate buffer ID. Reason: 0x%x", error);
+
+	// Bind the buffer
+	glBindBuffer(mTarget, mBufferID);
+	CHECK_GL("Could not bind buffer");
+
+	// Allocate memory for all regions
+	const POGL_UINT32 totalSize = mMemorySize * REGION_COUNT;
+	if (mPersistent) {
+		glBufferStorage(mTarget, totalSize, nullptr, PERSISTENT_MAP_FLAGS);
+		CHECK_GL("Could not initialize buffer storage");
+
+		mMappedMemory = (char*)glMapBufferRange(mTarget, 0, totalSize, PERSISTENT_MAP_FLAGS);
+		if (mMappedMemory == nullptr)
+			THROW_EXCEPTION(POGLResourceException, "Could not map buffer persistently. Reason: 0x%x", glGetError());
+	}
+	else {
+		glBufferData(mTarget, totalSize, 0, POGLEnum::Convert(mBufferUsage));
+		CHECK_GL("Could not initialize buffer data");
+	}
+
+	return mBufferID;
+}
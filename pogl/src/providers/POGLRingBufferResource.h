@@ -0,0 +1,69 @@
+#pragma once
+#include "IPOGLBufferResource.h"
+
+class POGLRenderState;
+
+/*!
+	\brief Buffer resource split into multiple, equally large, memory regions
+
+	The first time the buffer is mapped after a draw call has used it, the next region is selected. Each region is guarded by a fence 
+	which is put into the command stream when we move away from it. We only have to wait for the GPU if the CPU tries to write
+	into a region that the GPU hasn't finished reading yet.
+*/
+class POGLRingBufferResource : public IPOGLBufferResource
+{
+public:
+	POGLRingBufferResource(POGL_UINT32 memorySize, GLenum target, POGLBufferUsage::Enum bufferUsage, bool persistent);
+	virtual ~POGLRingBufferResource();
+	
+	/*!
+		\brief Retrieves the internal OpenGL buffer ID
+	*/
+	inline GLuint GetBufferID() const {
+		return mBufferID;
+	}
+
+// IPOGLBufferResource
+public:
+	virtual GLuint PostConstruct(POGLRenderState* renderState);
+	virtual void* Map(POGLResourceMapType::Enum e);
+	virtual void* Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e);
+	virtual void Unmap();
+	virtual POGL_UINT32 GetRegionOffset() const;
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy);
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const;
+	virtual void Lock();
+	virtual void Lock(POGL_UINT32 offset, POGL_UINT32 length);
+	virtual void Unlock();
+	virtual bool Evict();
+	virtual void Restore();
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+private:
+	/*!
+		\brief Move to the next region and wait for the GPU to finish reading from it if neccessary
+	*/
+	void NextRegion();
+
+public:
+	/* Number of regions the buffer is split into */
+	static const POGL_UINT32 REGION_COUNT = 3;
+
+private:
+	REF_COUNTER mRefCount;
+	GLuint mBufferID;
+	POGL_UINT32 mMemorySize;
+	GLenum mTarget;
+	POGLBufferUsage::Enum mBufferUsage;
+	bool mPersistent;
+
+	char* mMappedMemory;
+
+	POGL_UINT32 mRegionIndex;
+	bool mRegionInUse;
+	GLsync mRegionFences[REGION_COUNT];
+};
@@ -0,0 +1,141 @@
+#include "MemCheck.h"
+#include "POGLSharedBufferResource.h"
+
+POGLSharedBuffer::POGLSharedBuffer()
+: mRefCount(1), mBufferID(0), mMemorySize(0)
+{
+}
+
+POGLSharedBuffer::~POGLSharedBuffer()
+{
+}
+
+void POGLSharedBuffer::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLSharedBuffer::Release()
+{
+	if (--mRefCount == 0) {
+		if (mBufferID != 0) {
+			glDeleteBuffers(1, &mBufferID);
+			mBufferID = 0;
+		}
+		delete this;
+	}
+}
+
+void POGLSharedBuffer::PostConstruct(GLuint bufferID)
+{
+	mBufferID = bufferID;
+}
+
+POGL_UINT32 POGLSharedBuffer::Reserve(POGL_UINT32 memorySize, POGL_UINT32 alignment)
+{
+	const POGL_UINT32 offset = ((mMemorySize + alignment - 1) / alignment) * alignment;
+	mMemorySize = offset + memorySize;
+	return offset;
+}
+
+POGLSharedBufferResource::POGLSharedBufferResource(POGLSharedBuffer* buffer, POGL_UINT32 offset, POGL_UINT32 memorySize, GLenum target)
+: mRefCount(1), mBuffer(buffer), mOffset(offset), mMemorySize(memorySize), mTarget(target)
+{
+	mBuffer->AddRef();
+}
+
+POGLSharedBufferResource::~POGLSharedBufferResource()
+{
+}
+
+void POGLSharedBufferResource::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLSharedBufferResource::Release()
+{
+	if (--mRefCount == 0) {
+		if (mBuffer != nullptr) {
+			mBuffer->Release();
+			mBuffer = nullptr;
+		}
+		delete this;
+	}
+}
+
+void* POGLSharedBufferResource::Map(POGLResourceMapType::Enum e)
+{
+	return Map(0, mMemorySize, e);
+}
+
+void* POGLSharedBufferResource::Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e)
+{
+	if (offset + length > mMemorySize)
+		THROW_EXCEPTION(POGLStateException, "You cannot map with offset: %d and length: %d when the buffer size is: %d", offset, length, mMemorySize);
+
+	// The copy target is used so that neither the element array binding of the current vertex array object, nor the
+	// buffers cached by the render state, are changed
+	glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer->GetBufferID());
+	CHECK_GL("Could not bind buffer");
+
+	GLenum access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+	if (e == POGLResourceMapType::READ)
+		access = GL_MAP_READ_BIT;
+
+	return glMapBufferRange(GL_COPY_WRITE_BUFFER, mOffset + offset, length, access);
+}
+
+void POGLSharedBufferResource::Unmap()
+{
+	glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer->GetBufferID());
+	glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+POGL_UINT32 POGLSharedBufferResource::GetRegionOffset() const
+{
+	return mOffset;
+}
+
+void POGLSharedBufferResource::SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy)
+{
+}
+
+POGLBufferUpdateStrategy::Enum POGLSharedBufferResource::GetUpdateStrategy() const
+{
+	return POGLBufferUpdateStrategy::MAP;
+}
+
+void POGLSharedBufferResource::Lock()
+{
+}
+
+void POGLSharedBufferResource::Lock(POGL_UINT32 offset, POGL_UINT32 length)
+{
+}
+
+void POGLSharedBufferResource::Unlock()
+{
+}
+
+bool POGLSharedBufferResource::Evict()
+{
+	// The memory is owned by the shared buffer, which other buffer resources might be drawing from
+	return false;
+}
+
+void POGLSharedBufferResource::Restore()
+{
+}
+
+GLuint POGLSharedBufferResource::PostConstruct(POGLRenderState* renderState)
+{
+	const GLuint bufferID = mBuffer->GetBufferID();
+	if (bufferID == 0)
+		THROW_EXCEPTION(POGLResourceException, "The shared buffer has not been created yet");
+
+	glBindBuffer(mTarget, bufferID);
+	CHECK_GL("Could not bind buffer");
+	return bufferID;
+}
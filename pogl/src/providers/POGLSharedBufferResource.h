@@ -0,0 +1,90 @@
+#pragma once
+#include "IPOGLBufferResource.h"
+
+class POGLRenderState;
+
+/*!
+	\brief An OpenGL buffer shared by multiple buffer resources
+*/
+class POGLSharedBuffer : public IPOGLInterface
+{
+public:
+	POGLSharedBuffer();
+	virtual ~POGLSharedBuffer();
+
+	/*!
+		\brief Set the OpenGL buffer ID after it's been created
+	*/
+	void PostConstruct(GLuint bufferID);
+
+	/*!
+		\brief Reserve memory in this buffer
+
+		\param memorySize
+		\param alignment
+				The returned offset is a multiple of this value
+		\return The offset, in bytes, where the reserved memory begins
+	*/
+	POGL_UINT32 Reserve(POGL_UINT32 memorySize, POGL_UINT32 alignment);
+
+	/*!
+		\brief Retrieves the internal OpenGL buffer ID
+	*/
+	inline GLuint GetBufferID() const {
+		return mBufferID;
+	}
+
+	/*!
+		\brief Retrieves how much memory is reserved in this buffer
+	*/
+	inline POGL_UINT32 GetMemorySize() const {
+		return mMemorySize;
+	}
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+private:
+	REF_COUNTER mRefCount;
+	GLuint mBufferID;
+	POGL_UINT32 mMemorySize;
+};
+
+/*!
+	\brief Buffer resource using a part of an OpenGL buffer shared with other buffer resources
+*/
+class POGLSharedBufferResource : public IPOGLBufferResource
+{
+public:
+	POGLSharedBufferResource(POGLSharedBuffer* buffer, POGL_UINT32 offset, POGL_UINT32 memorySize, GLenum target);
+	virtual ~POGLSharedBufferResource();
+
+// IPOGLBufferResource
+public:
+	virtual GLuint PostConstruct(POGLRenderState* renderState);
+	virtual void* Map(POGLResourceMapType::Enum e);
+	virtual void* Map(POGL_UINT32 offset, POGL_UINT32 length, POGLResourceMapType::Enum e);
+	virtual void Unmap();
+	virtual POGL_UINT32 GetRegionOffset() const;
+	virtual void SetUpdateStrategy(POGLBufferUpdateStrategy::Enum strategy);
+	virtual POGLBufferUpdateStrategy::Enum GetUpdateStrategy() const;
+	virtual void Lock();
+	virtual void Lock(POGL_UINT32 offset, POGL_UINT32 length);
+	virtual void Unlock();
+	virtual bool Evict();
+	virtual void Restore();
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+private:
+	REF_COUNTER mRefCount;
+	POGLSharedBuffer* mBuffer;
+	POGL_UINT32 mOffset;
+	POGL_UINT32 mMemorySize;
+	GLenum mTarget;
+};
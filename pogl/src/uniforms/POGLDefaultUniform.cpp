@@ -4,7 +4,7 @@
 #include "POGLRenderState.h"
 
 POGLDefaultUniform::POGLDefaultUniform(POGL_UINT32 programUID, POGLRenderState* state, GLint componentID, GLenum uniformType)
-: mProgramUID(programUID), mRenderState(state), mComponentID(componentID), mUniformType(uniformType)
+: mProgramUID(programUID), mHasStaticUniform(false), mRenderState(state), mComponentID(componentID), mUniformType(uniformType)
 {
 }
 
@@ -27,6 +27,20 @@ public:
 		return mUniformType;
 	}
 
+	/*!
+		\brief Mark that a static uniform sets the value of this uniform when the program is applied
+	*/
+	inline void SetHasStaticUniform() {
+		mHasStaticUniform = true;
+	}
+
+	/*!
+		\brief Check to see if a static uniform sets the value of this uniform when the program is applied
+	*/
+	inline bool HasStaticUniform() const {
+		return mHasStaticUniform;
+	}
+
 	void SetInt32(POGL_INT32 a);
 	void SetInt32(POGL_INT32 a, POGL_INT32 b);
 	void SetInt32(POGL_INT32 a, POGL_INT32 b, POGL_INT32 c);
@@ -73,6 +87,7 @@ public:
 
 private:
 	POGL_UINT32 mProgramUID;
+	std::atomic<bool> mHasStaticUniform;
 
 protected:
 	POGLRenderState* mRenderState;
@@ -3,8 +3,8 @@
 #include "POGLDeferredRenderContext.h"
 #include "POGLDeferredCommands.h"
 
-POGLDeferredUniform::POGLDeferredUniform(const POGL_STRING& name, POGLDeferredRenderContext* context)
-: mName(name), mRenderContext(context), mAssigned(false), mTexture(nullptr)
+POGLDeferredUniform::POGLDeferredUniform(POGL_UINT32 uniformID, POGLDeferredRenderContext* context)
+: mUniformID(uniformID), mRenderContext(context), mAssigned(false), mTexture(nullptr)
 {
 	mInts[0] = mInts[1] = mInts[2] = mInts[3] = UINT_MAX;
 	mFloats[0] = mFloats[1] = mFloats[2] = mFloats[3] = FLT_MAX;
@@ -32,7 +32,7 @@ void POGLDeferredUniform::SetInt32(POGL_INT32 a)
 
 	POGL_UNIFORM_SET_INT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_INT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_INT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->count = 1;
 }
@@ -44,7 +44,7 @@ void POGLDeferredUniform::SetInt32(POGL_INT32 a, POGL_INT32 b)
 
 	POGL_UNIFORM_SET_INT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_INT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_INT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->count = 2;
@@ -57,7 +57,7 @@ void POGLDeferredUniform::SetInt32(POGL_INT32 a, POGL_INT32 b, POGL_INT32 c)
 
 	POGL_UNIFORM_SET_INT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_INT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_INT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -71,7 +71,7 @@ void POGLDeferredUniform::SetInt32(POGL_INT32 a, POGL_INT32 b, POGL_INT32 c, POG
 
 	POGL_UNIFORM_SET_INT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_INT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_INT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -85,7 +85,7 @@ void POGLDeferredUniform::SetInt32(POGL_INT32* ptr, POGL_UINT32 count)
 
 	POGL_UNIFORM_SET_INT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_INT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_INT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
 		cmd->values[i] = (POGL_INT32)ptr[i];
 
@@ -99,7 +99,7 @@ void POGLDeferredUniform::SetUInt32(POGL_UINT32 a)
 
 	POGL_UNIFORM_SET_UINT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_UINT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetUInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_UINT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->count = 1;
 }
@@ -111,7 +111,7 @@ void POGLDeferredUniform::SetUInt32(POGL_UINT32 a, POGL_UINT32 b)
 
 	POGL_UNIFORM_SET_UINT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_UINT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetUInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_UINT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->count = 2;
@@ -124,7 +124,7 @@ void POGLDeferredUniform::SetUInt32(POGL_UINT32 a, POGL_UINT32 b, POGL_UINT32 c)
 
 	POGL_UNIFORM_SET_UINT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_UINT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetUInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_UINT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -138,7 +138,7 @@ void POGLDeferredUniform::SetUInt32(POGL_UINT32 a, POGL_UINT32 b, POGL_UINT32 c,
 
 	POGL_UNIFORM_SET_UINT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_UINT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetUInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_UINT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -152,7 +152,7 @@ void POGLDeferredUniform::SetUInt32(POGL_UINT32* ptr, POGL_UINT32 count)
 
 	POGL_UNIFORM_SET_UINT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_UINT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetUInt_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_UINT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
 		cmd->values[i] = (POGL_UINT32)ptr[i];
 
@@ -166,7 +166,7 @@ void POGLDeferredUniform::SetFloat(POGL_FLOAT a)
 
 	POGL_UNIFORM_SET_FLOAT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_FLOAT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetFloat_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_FLOAT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->count = 1;
 }
@@ -178,7 +178,7 @@ void POGLDeferredUniform::SetFloat(POGL_FLOAT a, POGL_FLOAT b)
 
 	POGL_UNIFORM_SET_FLOAT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_FLOAT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetFloat_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_FLOAT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->count = 2;
@@ -191,7 +191,7 @@ void POGLDeferredUniform::SetFloat(POGL_FLOAT a, POGL_FLOAT b, POGL_FLOAT c)
 
 	POGL_UNIFORM_SET_FLOAT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_FLOAT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetFloat_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_FLOAT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -205,7 +205,7 @@ void POGLDeferredUniform::SetFloat(POGL_FLOAT a, POGL_FLOAT b, POGL_FLOAT c, POG
 
 	POGL_UNIFORM_SET_FLOAT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_FLOAT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetFloat_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_FLOAT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -219,7 +219,7 @@ void POGLDeferredUniform::SetFloat(POGL_FLOAT* ptr, POGL_UINT32 count)
 
 	POGL_UNIFORM_SET_FLOAT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_FLOAT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetFloat_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_FLOAT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
 		cmd->values[i] = ptr[i];
 
@@ -233,7 +233,7 @@ void POGLDeferredUniform::SetDouble(POGL_DOUBLE a)
 
 	POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetDouble_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->count = 1;
 }
@@ -245,7 +245,7 @@ void POGLDeferredUniform::SetDouble(POGL_DOUBLE a, POGL_DOUBLE b)
 
 	POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetDouble_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->count = 2;
@@ -258,7 +258,7 @@ void POGLDeferredUniform::SetDouble(POGL_DOUBLE a, POGL_DOUBLE b, POGL_DOUBLE c)
 
 	POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetDouble_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -272,7 +272,7 @@ void POGLDeferredUniform::SetDouble(POGL_DOUBLE a, POGL_DOUBLE b, POGL_DOUBLE c,
 
 	POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetDouble_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->values[0] = a;
 	cmd->values[1] = b;
 	cmd->values[2] = c;
@@ -286,7 +286,7 @@ void POGLDeferredUniform::SetDouble(POGL_DOUBLE* ptr, POGL_UINT32 count)
 
 	POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetFloat_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_DOUBLE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
 		cmd->values[i] = ptr[i];
 
@@ -297,7 +297,7 @@ void POGLDeferredUniform::SetMatrix(const POGL_MAT4& mat4)
 {
 	POGL_UNIFORM_SET_MAT4_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_MAT4_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetMat4_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_MAT4_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->matrix = mat4;
 }
 
@@ -320,7 +320,7 @@ void POGLDeferredUniform::SetSize(const POGL_SIZE& size)
 {
 	POGL_UNIFORM_SET_SIZE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_SIZE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetSize_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_SIZE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->size = size;
 }
 
@@ -328,7 +328,7 @@ void POGLDeferredUniform::SetRect(const POGL_RECT& rect)
 {
 	POGL_UNIFORM_SET_RECT_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_RECT_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetRect_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_RECT_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->rect = rect;
 }
 
@@ -344,7 +344,7 @@ void POGLDeferredUniform::SetTexture(IPOGLTexture* texture)
 
 	POGL_UNIFORM_SET_TEXTURE_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_TEXTURE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetTexture_Command, &POGLUniformSetTexture_Release,
 		sizeof(POGL_UNIFORM_SET_TEXTURE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->texture = texture;
 	if (texture != nullptr)
 		texture->AddRef();
@@ -354,7 +354,7 @@ void POGLDeferredUniform::SetMinFilter(POGLMinFilter::Enum minFilter)
 {
 	POGL_UNIFORM_SET_MINFILTER_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_MINFILTER_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetMinFilter_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_MINFILTER_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->minFilter = minFilter;
 }
 
@@ -362,7 +362,7 @@ void POGLDeferredUniform::SetMagFilter(POGLMagFilter::Enum magFilter)
 {
 	POGL_UNIFORM_SET_MAGFILTER_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_MAGFILTER_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetMagFilter_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_MAGFILTER_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->magFilter = magFilter;
 }
 
@@ -370,7 +370,7 @@ void POGLDeferredUniform::SetTextureWrap(POGLTextureWrap::Enum s, POGLTextureWra
 {
 	POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetTextureWrapST_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->textureWrap[0] = s;
 	cmd->textureWrap[1] = t;
 }
@@ -379,7 +379,7 @@ void POGLDeferredUniform::SetTextureWrap(POGLTextureWrap::Enum s, POGLTextureWra
 {
 	POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA* cmd = (POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetTextureWrapSTR_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SET_TEXTUREWRAP_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->textureWrap[0] = s;
 	cmd->textureWrap[1] = t;
 	cmd->textureWrap[2] = r;
@@ -389,7 +389,7 @@ void POGLDeferredUniform::SetCompareFunc(POGLCompareFunc::Enum compareFunc)
 {
 	POGL_UNIFORM_SETCOMPAREFUNC_COMMAND_DATA* cmd = (POGL_UNIFORM_SETCOMPAREFUNC_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetCompareFunc_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SETCOMPAREFUNC_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->compareFunc = compareFunc;
 }
 
@@ -397,7 +397,7 @@ void POGLDeferredUniform::SetCompareMode(POGLCompareMode::Enum compareMode)
 {
 	POGL_UNIFORM_SETCOMPAREMODE_COMMAND_DATA* cmd = (POGL_UNIFORM_SETCOMPAREMODE_COMMAND_DATA*)mRenderContext->AddCommand(&POGLUniformSetCompareMode_Command, &POGLNothing_Release,
 		sizeof(POGL_UNIFORM_SETCOMPAREMODE_COMMAND_DATA));
-	cmd->name = &mName;
+	cmd->uniformID = mUniformID;
 	cmd->compareMode = compareMode;
 }
 
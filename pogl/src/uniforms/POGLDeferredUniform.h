@@ -5,7 +5,7 @@ class POGLDeferredRenderContext;
 class POGLDeferredUniform : public IPOGLUniform, public IPOGLSamplerState
 {
 public:
-	POGLDeferredUniform(const POGL_STRING& name, POGLDeferredRenderContext* context);
+	POGLDeferredUniform(POGL_UINT32 uniformID, POGLDeferredRenderContext* context);
 	virtual ~POGLDeferredUniform();
 
 	void Flush();
@@ -71,7 +71,7 @@ private:
 	bool IsTextureEquals(IPOGLTexture* texture);
 
 private:
-	POGL_STRING mName;
+	POGL_UINT32 mUniformID;
 	POGLDeferredRenderContext* mRenderContext;
 
 	POGL_UINT32 mInts[4];
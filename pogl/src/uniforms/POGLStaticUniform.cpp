@@ -1,102 +1,171 @@
 #include "MemCheck.h"
 #include "POGLStaticUniform.h"
 #include "POGLDefaultUniform.h"
+#include "POGLProgram.h"
 
-POGLStaticUniform::POGLStaticUniform()
-: mAssociatedUniform(nullptr), mType(0), mTexture(nullptr), mMinFilter(POGLMinFilter::DEFAULT), mMagFilter(POGLMagFilter::DEFAULT),
-mCompareFunc(POGLCompareFunc::DEFAULT), mCompareMode(POGLCompareMode::DEFAULT)
+namespace {
+	/*!
+		\brief Locks the program while a static uniform is changed and marks the snapshot of the program as out of date
+	*/
+	class POGLStaticUniformUpdate
+	{
+	public:
+		POGLStaticUniformUpdate(POGLProgram* program) : mProgram(program) {
+			mProgram->GetMutex().lock();
+		}
+
+		~POGLStaticUniformUpdate() {
+			mProgram->InvalidateSnapshot();
+			mProgram->GetMutex().unlock();
+		}
+
+	private:
+		POGLProgram* mProgram;
+	};
+}
+
+POGL_STATIC_UNIFORM_VALUE::POGL_STATIC_UNIFORM_VALUE()
+: texture(nullptr), minFilter(POGLMinFilter::DEFAULT), magFilter(POGLMagFilter::DEFAULT),
+compareFunc(POGLCompareFunc::DEFAULT), compareMode(POGLCompareMode::DEFAULT)
 {
-	mFloats[0] = mFloats[1] = mFloats[2] = mFloats[3] = 0.0f;
-	mDoubles[0] = mDoubles[1] = mDoubles[2] = mDoubles[3] = 0.0;
-	mInts[0] = mInts[1] = mInts[2] = mInts[3] = 0;
-	mWraps[0] = mWraps[1] = mWraps[2] = POGLTextureWrap::DEFAULT;
+	floats[0] = floats[1] = floats[2] = floats[3] = 0.0f;
+	doubles[0] = doubles[1] = doubles[2] = doubles[3] = 0.0;
+	ints[0] = ints[1] = ints[2] = ints[3] = 0;
+	wraps[0] = wraps[1] = wraps[2] = POGLTextureWrap::DEFAULT;
 
-	memset(&mValue, 0, sizeof(mValue));
-	mValue._11 = 1.0;
-	mValue._22 = 1.0;
-	mValue._33 = 1.0;
-	mValue._44 = 1.0;
+	memset(&matrix, 0, sizeof(matrix));
+	matrix._11 = 1.0;
+	matrix._22 = 1.0;
+	matrix._33 = 1.0;
+	matrix._44 = 1.0;
 }
 
-POGLStaticUniform::~POGLStaticUniform()
+POGL_STATIC_UNIFORM_VALUE::POGL_STATIC_UNIFORM_VALUE(const POGL_STATIC_UNIFORM_VALUE& rhs)
+: texture(nullptr)
+{
+	*this = rhs;
+}
+
+POGL_STATIC_UNIFORM_VALUE::~POGL_STATIC_UNIFORM_VALUE()
 {
-	if (mTexture != nullptr) {
-		mTexture->Release();
-		mTexture = nullptr;
+	if (texture != nullptr) {
+		texture->Release();
+		texture = nullptr;
 	}
 }
 
+POGL_STATIC_UNIFORM_VALUE& POGL_STATIC_UNIFORM_VALUE::operator=(const POGL_STATIC_UNIFORM_VALUE& rhs)
+{
+	if (this == &rhs)
+		return *this;
+
+	memcpy(floats, rhs.floats, sizeof(floats));
+	memcpy(doubles, rhs.doubles, sizeof(doubles));
+	memcpy(ints, rhs.ints, sizeof(ints));
+	matrix = rhs.matrix;
+	if (rhs.texture != nullptr)
+		rhs.texture->AddRef();
+	if (texture != nullptr)
+		texture->Release();
+	texture = rhs.texture;
+	minFilter = rhs.minFilter;
+	magFilter = rhs.magFilter;
+	memcpy(wraps, rhs.wraps, sizeof(wraps));
+	compareFunc = rhs.compareFunc;
+	compareMode = rhs.compareMode;
+	return *this;
+}
+
+POGLStaticUniform::POGLStaticUniform(POGLProgram* program)
+: mProgram(program), mAssociatedUniform(nullptr)
+{
+}
+
+POGLStaticUniform::~POGLStaticUniform()
+{
+}
+
 void POGLStaticUniform::SetAssociatedUniform(POGLDefaultUniform* uniform)
 {
 	mAssociatedUniform = uniform;
-	mType = uniform->GetUniformType();
+	if (mAssociatedUniform != nullptr)
+		mAssociatedUniform->SetHasStaticUniform();
 }
 
-void POGLStaticUniform::Apply()
+void POGLStaticUniform::Apply(const POGL_STATIC_UNIFORM_VALUE& value)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	// The program has no uniform with this name, or it hasn't been linked yet
+	if (mAssociatedUniform == nullptr)
+		return;
 
-	switch (mType)
+	switch (mAssociatedUniform->GetUniformType())
 	{
 	case GL_FLOAT:
-		mAssociatedUniform->SetFloat(mFloats[0]);
+		mAssociatedUniform->SetFloat(value.floats[0]);
 		break;
 	case GL_FLOAT_VEC2:
-		mAssociatedUniform->SetFloat(mFloats[0], mFloats[1]);
+		mAssociatedUniform->SetFloat(value.floats[0], value.floats[1]);
 		break;
 	case GL_FLOAT_VEC3:
-		mAssociatedUniform->SetFloat(mFloats[0], mFloats[1], mFloats[2]);
+		mAssociatedUniform->SetFloat(value.floats[0], value.floats[1], value.floats[2]);
 		break;
 	case GL_FLOAT_VEC4:
-		mAssociatedUniform->SetFloat(mFloats[0], mFloats[1], mFloats[2], mFloats[3]);
+		mAssociatedUniform->SetFloat(value.floats[0], value.floats[1], value.floats[2], value.floats[3]);
 		break;
 	case GL_DOUBLE:
-		mAssociatedUniform->SetDouble(mDoubles[0]);
+		mAssociatedUniform->SetDouble(value.doubles[0]);
 		break;
 	case GL_DOUBLE_VEC2:
-		mAssociatedUniform->SetDouble(mDoubles[0], mDoubles[1]);
+		mAssociatedUniform->SetDouble(value.doubles[0], value.doubles[1]);
 		break;
 	case GL_DOUBLE_VEC3:
-		mAssociatedUniform->SetDouble(mDoubles[0], mDoubles[1], mDoubles[2]);
+		mAssociatedUniform->SetDouble(value.doubles[0], value.doubles[1], value.doubles[2]);
 		break;
 	case GL_DOUBLE_VEC4:
-		mAssociatedUniform->SetDouble(mDoubles[0], mDoubles[1], mDoubles[2], mDoubles[3]);
+		mAssociatedUniform->SetDouble(value.doubles[0], value.doubles[1], value.doubles[2], value.doubles[3]);
 		break;
 	case GL_INT:
-		mAssociatedUniform->SetInt32((POGL_INT32)mInts[0]);
+		mAssociatedUniform->SetInt32((POGL_INT32)value.ints[0]);
 		break;
 	case GL_INT_VEC2:
-		mAssociatedUniform->SetInt32((POGL_INT32)mInts[0], (POGL_INT32)mInts[1]);
+		mAssociatedUniform->SetInt32((POGL_INT32)value.ints[0], (POGL_INT32)value.ints[1]);
 		break;
 	case GL_INT_VEC3:
-		mAssociatedUniform->SetInt32((POGL_INT32)mInts[0], (POGL_INT32)mInts[1], (POGL_INT32)mInts[2]);
+		mAssociatedUniform->SetInt32((POGL_INT32)value.ints[0], (POGL_INT32)value.ints[1], (POGL_INT32)value.ints[2]);
 		break;
 	case GL_INT_VEC4:
-		mAssociatedUniform->SetInt32((POGL_INT32)mInts[0], (POGL_INT32)mInts[1], (POGL_INT32)mInts[2], (POGL_INT32)mInts[3]);
+		mAssociatedUniform->SetInt32((POGL_INT32)value.ints[0], (POGL_INT32)value.ints[1], (POGL_INT32)value.ints[2], (POGL_INT32)value.ints[3]);
 		break;
 	case GL_UNSIGNED_INT:
-		mAssociatedUniform->SetUInt32(mInts[0]);
+		mAssociatedUniform->SetUInt32(value.ints[0]);
 		break;
 	case GL_UNSIGNED_INT_VEC2:
-		mAssociatedUniform->SetUInt32(mInts[0], mInts[1]);
+		mAssociatedUniform->SetUInt32(value.ints[0], value.ints[1]);
 		break;
 	case GL_UNSIGNED_INT_VEC3:
-		mAssociatedUniform->SetUInt32(mInts[0], mInts[1], mInts[2]);
+		mAssociatedUniform->SetUInt32(value.ints[0], value.ints[1], value.ints[2]);
 		break;
 	case GL_UNSIGNED_INT_VEC4:
-		mAssociatedUniform->SetUInt32(mInts[0], mInts[1], mInts[2], mInts[3]);
+		mAssociatedUniform->SetUInt32(value.ints[0], value.ints[1], value.ints[2], value.ints[3]);
 		break;
 	case GL_FLOAT_MAT4:
-		mAssociatedUniform->SetMatrix(mValue);
+		mAssociatedUniform->SetMatrix(value.matrix);
 		break;
+	case GL_SAMPLER_1D:
 	case GL_SAMPLER_2D:
-		if (mTexture != nullptr) {
-			mAssociatedUniform->SetTexture(mTexture);
-			mAssociatedUniform->SetMinFilter(mMinFilter);
-			mAssociatedUniform->SetMagFilter(mMagFilter);
-			mAssociatedUniform->SetTextureWrap(mWraps[0], mWraps[1]);
-			mAssociatedUniform->SetCompareFunc(mCompareFunc);
-			mAssociatedUniform->SetCompareMode(mCompareMode);
+	case GL_SAMPLER_3D:
+	case GL_SAMPLER_CUBE:
+	case GL_SAMPLER_2D_ARRAY:
+	case GL_SAMPLER_2D_SHADOW:
+	case GL_SAMPLER_2D_ARRAY_SHADOW:
+	case GL_SAMPLER_CUBE_SHADOW:
+		if (value.texture != nullptr) {
+			mAssociatedUniform->SetTexture(value.texture);
+			mAssociatedUniform->SetMinFilter(value.minFilter);
+			mAssociatedUniform->SetMagFilter(value.magFilter);
+			mAssociatedUniform->SetTextureWrap(value.wraps[0], value.wraps[1]);
+			mAssociatedUniform->SetCompareFunc(value.compareFunc);
+			mAssociatedUniform->SetCompareMode(value.compareMode);
 		}
 		break;
 	};
@@ -104,245 +173,245 @@ void POGLStaticUniform::Apply()
 
 void POGLStaticUniform::SetInt32(POGL_INT32 a)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
+	mValue.ints[0] = a;
 }
 
 void POGLStaticUniform::SetInt32(POGL_INT32 a, POGL_INT32 b)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
-	mInts[1] = b;
+	mValue.ints[0] = a;
+	mValue.ints[1] = b;
 }
 
 void POGLStaticUniform::SetInt32(POGL_INT32 a, POGL_INT32 b, POGL_INT32 c)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
-	mInts[1] = b;
-	mInts[2] = c;
+	mValue.ints[0] = a;
+	mValue.ints[1] = b;
+	mValue.ints[2] = c;
 }
 
 void POGLStaticUniform::SetInt32(POGL_INT32 a, POGL_INT32 b, POGL_INT32 c, POGL_INT32 d)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
-	mInts[1] = b;
-	mInts[2] = c;
-	mInts[3] = d;
+	mValue.ints[0] = a;
+	mValue.ints[1] = b;
+	mValue.ints[2] = c;
+	mValue.ints[3] = d;
 
 }
 
 void POGLStaticUniform::SetInt32(POGL_INT32* ptr, POGL_UINT32 count)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
 	const POGL_UINT32 clampedCount = count > 4 ? 4 : count;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
-		mInts[i] = (POGL_UINT32)ptr[i];
+		mValue.ints[i] = (POGL_UINT32)ptr[i];
 }
 
 void POGLStaticUniform::SetUInt32(POGL_UINT32 a)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
+	mValue.ints[0] = a;
 }
 
 void POGLStaticUniform::SetUInt32(POGL_UINT32 a, POGL_UINT32 b)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
-	mInts[1] = b;
+	mValue.ints[0] = a;
+	mValue.ints[1] = b;
 }
 
 void POGLStaticUniform::SetUInt32(POGL_UINT32 a, POGL_UINT32 b, POGL_UINT32 c)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
-	mInts[1] = b;
-	mInts[2] = c;
+	mValue.ints[0] = a;
+	mValue.ints[1] = b;
+	mValue.ints[2] = c;
 }
 
 void POGLStaticUniform::SetUInt32(POGL_UINT32 a, POGL_UINT32 b, POGL_UINT32 c, POGL_UINT32 d)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = a;
-	mInts[1] = b;
-	mInts[2] = c;
-	mInts[3] = d;
+	mValue.ints[0] = a;
+	mValue.ints[1] = b;
+	mValue.ints[2] = c;
+	mValue.ints[3] = d;
 }
 
 void POGLStaticUniform::SetUInt32(POGL_UINT32* ptr, POGL_UINT32 count)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
 	const POGL_UINT32 clampedCount = count > 4 ? 4 : count;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
-		mInts[i] = ptr[i];
+		mValue.ints[i] = ptr[i];
 }
 
 void POGLStaticUniform::SetFloat(POGL_FLOAT a)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mFloats[0] = a;
+	mValue.floats[0] = a;
 }
 
 void POGLStaticUniform::SetFloat(POGL_FLOAT a, POGL_FLOAT b)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mFloats[0] = a;
-	mFloats[1] = b;
+	mValue.floats[0] = a;
+	mValue.floats[1] = b;
 }
 
 void POGLStaticUniform::SetFloat(POGL_FLOAT a, POGL_FLOAT b, POGL_FLOAT c)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mFloats[0] = a;
-	mFloats[1] = b;
-	mFloats[2] = c;
+	mValue.floats[0] = a;
+	mValue.floats[1] = b;
+	mValue.floats[2] = c;
 }
 
 void POGLStaticUniform::SetFloat(POGL_FLOAT a, POGL_FLOAT b, POGL_FLOAT c, POGL_FLOAT d)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mFloats[0] = a;
-	mFloats[1] = b;
-	mFloats[2] = c;
-	mFloats[3] = d;
+	mValue.floats[0] = a;
+	mValue.floats[1] = b;
+	mValue.floats[2] = c;
+	mValue.floats[3] = d;
 }
 
 void POGLStaticUniform::SetFloat(POGL_FLOAT* ptr, POGL_UINT32 count)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
 	const POGL_UINT32 clampedCount = count > 4 ? 4 : count;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
-		mFloats[i] = ptr[i];
+		mValue.floats[i] = ptr[i];
 }
 
 void POGLStaticUniform::SetDouble(POGL_DOUBLE a)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mDoubles[0] = a;
+	mValue.doubles[0] = a;
 }
 
 void POGLStaticUniform::SetDouble(POGL_DOUBLE a, POGL_DOUBLE b)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mDoubles[0] = a;
-	mDoubles[1] = b;
+	mValue.doubles[0] = a;
+	mValue.doubles[1] = b;
 }
 
 void POGLStaticUniform::SetDouble(POGL_DOUBLE a, POGL_DOUBLE b, POGL_DOUBLE c)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mDoubles[0] = a;
-	mDoubles[1] = b;
-	mDoubles[2] = c;
+	mValue.doubles[0] = a;
+	mValue.doubles[1] = b;
+	mValue.doubles[2] = c;
 }
 
 void POGLStaticUniform::SetDouble(POGL_DOUBLE a, POGL_DOUBLE b, POGL_DOUBLE c, POGL_DOUBLE d)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mDoubles[0] = a;
-	mDoubles[1] = b;
-	mDoubles[2] = c;
-	mDoubles[3] = d;
+	mValue.doubles[0] = a;
+	mValue.doubles[1] = b;
+	mValue.doubles[2] = c;
+	mValue.doubles[3] = d;
 }
 
 void POGLStaticUniform::SetDouble(POGL_DOUBLE* ptr, POGL_UINT32 count)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
 	const POGL_UINT32 clampedCount = count > 4 ? 4 : count;
 	for (POGL_UINT32 i = 0; i < clampedCount; ++i)
-		mDoubles[i] = ptr[i];
+		mValue.doubles[i] = ptr[i];
 }
 
 void POGLStaticUniform::SetMatrix(const POGL_MAT4& mat4)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mValue._11 = mat4._11;
-	mValue._12 = mat4._12;
-	mValue._13 = mat4._13;
-	mValue._14 = mat4._14;
+	mValue.matrix._11 = mat4._11;
+	mValue.matrix._12 = mat4._12;
+	mValue.matrix._13 = mat4._13;
+	mValue.matrix._14 = mat4._14;
 
-	mValue._21 = mat4._21;
-	mValue._22 = mat4._22;
-	mValue._23 = mat4._23;
-	mValue._24 = mat4._24;
+	mValue.matrix._21 = mat4._21;
+	mValue.matrix._22 = mat4._22;
+	mValue.matrix._23 = mat4._23;
+	mValue.matrix._24 = mat4._24;
 
-	mValue._31 = mat4._31;
-	mValue._32 = mat4._32;
-	mValue._33 = mat4._33;
-	mValue._34 = mat4._34;
+	mValue.matrix._31 = mat4._31;
+	mValue.matrix._32 = mat4._32;
+	mValue.matrix._33 = mat4._33;
+	mValue.matrix._34 = mat4._34;
 
-	mValue._41 = mat4._41;
-	mValue._42 = mat4._42;
-	mValue._43 = mat4._43;
-	mValue._44 = mat4._44;
+	mValue.matrix._41 = mat4._41;
+	mValue.matrix._42 = mat4._42;
+	mValue.matrix._43 = mat4._43;
+	mValue.matrix._44 = mat4._44;
 }
 
 void POGLStaticUniform::SetVector2(const POGL_VECTOR2& vec)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mFloats[0] = vec.x;
-	mFloats[1] = vec.y;
+	mValue.floats[0] = vec.x;
+	mValue.floats[1] = vec.y;
 }
 
 void POGLStaticUniform::SetVector3(const POGL_VECTOR3& vec)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mFloats[0] = vec.x;
-	mFloats[1] = vec.y;
-	mFloats[2] = vec.z;
+	mValue.floats[0] = vec.x;
+	mValue.floats[1] = vec.y;
+	mValue.floats[2] = vec.z;
 }
 
 void POGLStaticUniform::SetVector4(const POGL_VECTOR4& vec)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mFloats[0] = vec.x;
-	mFloats[1] = vec.y;
-	mFloats[2] = vec.z;
-	mFloats[3] = vec.w;
+	mValue.floats[0] = vec.x;
+	mValue.floats[1] = vec.y;
+	mValue.floats[2] = vec.z;
+	mValue.floats[3] = vec.w;
 }
 
 void POGLStaticUniform::SetSize(const POGL_SIZE& size)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = (POGL_UINT32)size.x;
-	mInts[1] = (POGL_UINT32)size.y;
+	mValue.ints[0] = (POGL_UINT32)size.x;
+	mValue.ints[1] = (POGL_UINT32)size.y;
 }
 
 void POGLStaticUniform::SetRect(const POGL_RECT& rect)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mInts[0] = (POGL_UINT32)rect.x;
-	mInts[1] = (POGL_UINT32)rect.y;
-	mInts[2] = (POGL_UINT32)rect.width;
-	mInts[3] = (POGL_UINT32)rect.height;
+	mValue.ints[0] = (POGL_UINT32)rect.x;
+	mValue.ints[1] = (POGL_UINT32)rect.y;
+	mValue.ints[2] = (POGL_UINT32)rect.width;
+	mValue.ints[3] = (POGL_UINT32)rect.height;
 }
 
 IPOGLSamplerState* POGLStaticUniform::GetSamplerState()
@@ -352,56 +421,56 @@ IPOGLSamplerState* POGLStaticUniform::GetSamplerState()
 
 void POGLStaticUniform::SetTexture(IPOGLTexture* texture)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	if (mTexture != nullptr)
-		mTexture->Release();
-	mTexture = texture;
-	if (mTexture != nullptr)
-		mTexture->AddRef();
+	if (mValue.texture != nullptr)
+		mValue.texture->Release();
+	mValue.texture = texture;
+	if (mValue.texture != nullptr)
+		mValue.texture->AddRef();
 }
 
 void POGLStaticUniform::SetMinFilter(POGLMinFilter::Enum minFilter)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mMinFilter = minFilter;
+	mValue.minFilter = minFilter;
 }
 
 void POGLStaticUniform::SetMagFilter(POGLMagFilter::Enum magFilter)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mMagFilter = magFilter;
+	mValue.magFilter = magFilter;
 }
 
 void POGLStaticUniform::SetTextureWrap(POGLTextureWrap::Enum s, POGLTextureWrap::Enum t)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 	
-	mWraps[0] = s;
-	mWraps[1] = t;
+	mValue.wraps[0] = s;
+	mValue.wraps[1] = t;
 }
 
 void POGLStaticUniform::SetTextureWrap(POGLTextureWrap::Enum s, POGLTextureWrap::Enum t, POGLTextureWrap::Enum r)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mWraps[0] = s;
-	mWraps[1] = t;
-	mWraps[2] = r;
+	mValue.wraps[0] = s;
+	mValue.wraps[1] = t;
+	mValue.wraps[2] = r;
 }
 
 void POGLStaticUniform::SetCompareFunc(POGLCompareFunc::Enum compareFunc)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mCompareFunc = compareFunc;
+	mValue.compareFunc = compareFunc;
 }
 
 void POGLStaticUniform::SetCompareMode(POGLCompareMode::Enum compareMode)
 {
-	std::lock_guard<std::mutex> lock(mMutex);
+	POGLStaticUniformUpdate update(mProgram);
 
-	mCompareMode = compareMode;
+	mValue.compareMode = compareMode;
 }
@@ -1,26 +1,60 @@
 #pragma once
 #include "config.h"
 
+/*!
+	\brief The values of a static uniform
+
+	Copies keep their own reference to the texture, so that a snapshot can be applied while the uniform is changed by another thread
+*/
+struct POGL_STATIC_UNIFORM_VALUE
+{
+	POGL_FLOAT floats[4];
+	POGL_DOUBLE doubles[4];
+	POGL_UINT32 ints[4];
+	POGL_MAT4 matrix;
+	IPOGLTexture* texture;
+
+	POGLMinFilter::Enum minFilter;
+	POGLMagFilter::Enum magFilter;
+	POGLTextureWrap::Enum wraps[3];
+	POGLCompareFunc::Enum compareFunc;
+	POGLCompareMode::Enum compareMode;
+
+	POGL_STATIC_UNIFORM_VALUE();
+	POGL_STATIC_UNIFORM_VALUE(const POGL_STATIC_UNIFORM_VALUE& rhs);
+	~POGL_STATIC_UNIFORM_VALUE();
+	POGL_STATIC_UNIFORM_VALUE& operator=(const POGL_STATIC_UNIFORM_VALUE& rhs);
+};
+
 class POGLDefaultUniform;
+class POGLProgram;
 class POGLStaticUniform : public IPOGLUniform, public IPOGLSamplerState
 {
 public:
-	POGLStaticUniform();
+	POGLStaticUniform(POGLProgram* program);
 	virtual ~POGLStaticUniform();
 
 	/*!
 		\brief Associate this uniform with the supplied uniform
 
 		\param uniform
+				The uniform in the linked program. nullptr if the program has no uniform with this name
 	*/
 	void SetAssociatedUniform(POGLDefaultUniform* uniform);
 
+	/*!
+		\brief Retrieves the current values. The program's mutex must be held
+	*/
+	inline const POGL_STATIC_UNIFORM_VALUE& GetValue() const {
+		return mValue;
+	}
+
 	/*!
 		\brief Apply this uniform.
 
-		This will set the associated uniform value with the ones specified in this uniform
+		This will set the associated uniform value with the supplied values, which are taken from a snapshot of the program
 	*/
-	void Apply();
+	void Apply(const POGL_STATIC_UNIFORM_VALUE& value);
 
 public:
 	void SetInt32(POGL_INT32 a);
@@ -68,20 +102,9 @@ public:
 	void SetCompareMode(POGLCompareMode::Enum compareMode);
 
 private:
+	POGLProgram* mProgram;
 	POGLDefaultUniform* mAssociatedUniform;
-	GLenum mType;
-
-	POGL_FLOAT mFloats[4];
-	POGL_DOUBLE mDoubles[4];
-	POGL_UINT32 mInts[4];
-	POGL_MAT4 mValue;
-	IPOGLTexture* mTexture;
-
-	POGLMinFilter::Enum mMinFilter;
-	POGLMagFilter::Enum mMagFilter;
-	POGLTextureWrap::Enum mWraps[3];
-	POGLCompareFunc::Enum mCompareFunc;
-	POGLCompareMode::Enum mCompareMode;
 
-	std::mutex mMutex;
+	// Changed by any thread while the program's mutex is held
+	POGL_STATIC_UNIFORM_VALUE mValue;
 };
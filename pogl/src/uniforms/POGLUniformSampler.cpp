@@ -1,11 +1,12 @@
 #include "MemCheck.h"
-#include "POGLUniformSampler2D.h"
+#include "POGLUniformSampler.h"
 #include "POGLRenderState.h"
 #include "POGLSamplerObject.h"
-#include "POGLTexture2D.h"
+#include "POGLTextureUtils.h"
+#include "POGLTextureResource.h"
 #include "POGLEnum.h"
 
-POGLUniformSampler2D::POGLUniformSampler2D(POGL_UINT32 programUID, POGLRenderState* state, GLint componentID, GLuint activeTexture, POGLSamplerObject* samplerObject, GLenum uniformType)
+POGLUniformSampler::POGLUniformSampler(POGL_UINT32 programUID, POGLRenderState* state, GLint componentID, GLuint activeTexture, POGLSamplerObject* samplerObject, GLenum uniformType)
 : POGLDefaultUniform(programUID, state, componentID, uniformType),
 mTextureResource(nullptr), mTextureUID(0), mActiveTexture(activeTexture), 
 mSamplerObject(samplerObject), mMinFilter(POGLMinFilter::DEFAULT), mMagFilter(POGLMagFilter::DEFAULT), mCompareFunc(POGLCompareFunc::DEFAULT), mCompareMode(POGLCompareMode::DEFAULT)
@@ -14,7 +15,7 @@ mSamplerObject(samplerObject), mMinFilter(POGLMinFilter::DEFAULT), mMagFilter(PO
 	mWrap[0] = mWrap[1] = POGLTextureWrap::DEFAULT;
 }
 
-POGLUniformSampler2D::~POGLUniformSampler2D()
+POGLUniformSampler::~POGLUniformSampler()
 {
 	if (mSamplerObject != nullptr) {
 		delete mSamplerObject;
@@ -27,27 +28,21 @@ POGLUniformSampler2D::~POGLUniformSampler2D()
 	}
 }
 
-void POGLUniformSampler2D::Apply()
+void POGLUniformSampler::Apply()
 {
 	mRenderState->BindTextureResource(mTextureResource, mActiveTexture);
 	mRenderState->BindSamplerObject(mSamplerObject, mActiveTexture);
 	glUniform1i(mComponentID, mActiveTexture);
 
-	CHECK_GL("Could not assign sampler2D uniform values");
+	CHECK_GL("Could not assign sampler uniform values");
 }
 
-void POGLUniformSampler2D::SetTexture(IPOGLTexture* texture)
+void POGLUniformSampler::SetTexture(IPOGLTexture* texture)
 {
-	if (texture == nullptr)
-		SetTextureResource(nullptr);
-	else {
-		auto type = texture->GetType();
-		if (type == POGLResourceType::TEXTURE2D)
-			SetTextureResource(reinterpret_cast<POGLTexture2D*>(texture)->GetResourcePtr());
-	}
+	SetTextureResource(POGLTextureUtils::GetResourcePtr(texture));
 }
 
-void POGLUniformSampler2D::SetMinFilter(POGLMinFilter::Enum minFilter)
+void POGLUniformSampler::SetMinFilter(POGLMinFilter::Enum minFilter)
 {
 	if (mMinFilter == minFilter)
 		return;
@@ -57,7 +52,7 @@ void POGLUniformSampler2D::SetMinFilter(POGLMinFilter::Enum minFilter)
 	mMinFilter = minFilter;
 }
 
-void POGLUniformSampler2D::SetMagFilter(POGLMagFilter::Enum magFilter)
+void POGLUniformSampler::SetMagFilter(POGLMagFilter::Enum magFilter)
 {
 	if (mMagFilter == magFilter)
 		return;
@@ -67,7 +62,7 @@ void POGLUniformSampler2D::SetMagFilter(POGLMagFilter::Enum magFilter)
 	mMagFilter = magFilter;
 }
 
-void POGLUniformSampler2D::SetTextureWrap(POGLTextureWrap::Enum s, POGLTextureWrap::Enum t)
+void POGLUniformSampler::SetTextureWrap(POGLTextureWrap::Enum s, POGLTextureWrap::Enum t)
 {
 	if (mWrap[0] == s && mWrap[1] == t)
 		return;
@@ -76,11 +71,14 @@ void POGLUniformSampler2D::SetTextureWrap(POGLTextureWrap::Enum s, POGLTextureWr
 	glSamplerParameteri(samplerID, GL_TEXTURE_WRAP_S, POGLEnum::Convert(s));
 	glSamplerParameteri(samplerID, GL_TEXTURE_WRAP_T, POGLEnum::Convert(t));
 
+	// 3D textures use the same wrap in depth as in height
+	glSamplerParameteri(samplerID, GL_TEXTURE_WRAP_R, POGLEnum::Convert(t));
+
 	mWrap[0] = s;
 	mWrap[1] = t;
 }
 
-void POGLUniformSampler2D::SetCompareFunc(POGLCompareFunc::Enum compareFunc)
+void POGLUniformSampler::SetCompareFunc(POGLCompareFunc::Enum compareFunc)
 {
 	if (mCompareFunc == compareFunc)
 		return;
@@ -91,7 +89,7 @@ void POGLUniformSampler2D::SetCompareFunc(POGLCompareFunc::Enum compareFunc)
 	mCompareFunc = compareFunc;
 }
 
-void POGLUniformSampler2D::SetCompareMode(POGLCompareMode::Enum compareMode)
+void POGLUniformSampler::SetCompareMode(POGLCompareMode::Enum compareMode)
 {
 	if (mCompareMode == compareMode)
 		return;
@@ -102,7 +100,7 @@ void POGLUniformSampler2D::SetCompareMode(POGLCompareMode::Enum compareMode)
 	mCompareMode = compareMode;
 }
 
-void POGLUniformSampler2D::SetTextureResource(POGLTextureResource* texture)
+void POGLUniformSampler::SetTextureResource(POGLTextureResource* texture)
 {
 	const POGL_UINT32 uid = texture != nullptr ? texture->GetUID() : 0;
 	mTextureUID = uid;
@@ -113,5 +111,5 @@ void POGLUniformSampler2D::SetTextureResource(POGLTextureResource* texture)
 		mTextureResource->AddRef();
 
 	if (IsProgramActive())
-		POGLUniformSampler2D::Apply();
+		POGLUniformSampler::Apply();
 }
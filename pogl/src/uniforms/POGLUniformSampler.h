@@ -4,11 +4,11 @@
 
 class POGLSamplerObject;
 class POGLTextureResource;
-class POGLAPI POGLUniformSampler2D : public POGLDefaultUniform
+class POGLAPI POGLUniformSampler : public POGLDefaultUniform
 {
 public:
-	POGLUniformSampler2D(POGL_UINT32 programUID, POGLRenderState* state, GLint componentID, GLuint activeTexture, POGLSamplerObject* samplerObject, GLenum uniformType);
-	~POGLUniformSampler2D();
+	POGLUniformSampler(POGL_UINT32 programUID, POGLRenderState* state, GLint componentID, GLuint activeTexture, POGLSamplerObject* samplerObject, GLenum uniformType);
+	~POGLUniformSampler();
 
 	void Apply();
 
@@ -3,6 +3,9 @@
 #include "POGLDeferredRenderContext.h"
 #include "providers/POGLDefaultBufferResourceProvider.h"
 #include "providers/POGLAMDBufferResourceProvider.h"
+#include "providers/POGLPersistentBufferResourceProvider.h"
+#include "providers/POGLBufferResourceLock.h"
+#include "POGLResidencyManager.h"
 #include <algorithm>
 
 /* Memory Leak Detection */
@@ -80,6 +83,8 @@ void Win32POGLDevice::EndFrame()
 	}
 
 	CHECK_GL("Could not swap buffers");
+	POGLBufferResourceLock::EndFrame();
+	POGLResidencyManager::EndFrame(mRenderContext->GetRenderState());
 }
 
 void Win32POGLDevice::Initialize()
@@ -162,9 +167,17 @@ void Win32POGLDevice::Initialize()
 		THROW_EXCEPTION(POGLInitializationException, "Could not load OpenGL extensions");
 	}
 
+	// Let the driver choose how many threads are used to compile shaders and link programs
+	if (glMaxShaderCompilerThreadsKHR != nullptr)
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+
 	// Prepare the resource providers
+	bool bufferStorage = POGLExtensionAvailable(POGL_TOCHAR("GL_ARB_buffer_storage")) && glBufferStorage != nullptr;
 	bool amdPinnedMemory = POGLExtensionAvailable(POGL_TOCHAR("GL_AMD_pinned_memory"));
-	if (amdPinnedMemory) {
+	if (bufferStorage) {
+		mBufferResourceProvider = new POGLPersistentBufferResourceProvider();
+	}
+	else if (amdPinnedMemory) {
 		mBufferResourceProvider = new POGLAMDBufferResourceProvider();
 	}
 	else {
@@ -0,0 +1,34 @@
+#include "MemCheck.h"
+#include "config.h"
+#include <windows.h>
+
+POGLMappedFile::POGLMappedFile(const POGL_CHAR* fileName)
+: mBytes(nullptr), mSize(0)
+{
+	HANDLE fileHandle = CreateFile(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		THROW_EXCEPTION(POGLResourceException, "File not found: %s", fileName);
+
+	mSize = (POGL_UINT32)GetFileSize(fileHandle, nullptr);
+	if (mSize == 0) {
+		CloseHandle(fileHandle);
+		return;
+	}
+
+	// The view keeps both the mapping and the file open, so the handles aren't needed afterwards
+	HANDLE mappingHandle = CreateFileMapping(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle != nullptr) {
+		mBytes = (const POGL_BYTE*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mappingHandle);
+	}
+	CloseHandle(fileHandle);
+
+	if (mBytes == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "Could not map file: %s", fileName);
+}
+
+POGLMappedFile::~POGLMappedFile()
+{
+	if (mBytes != nullptr)
+		UnmapViewOfFile(mBytes);
+}
@@ -44,6 +44,394 @@ extern POGLAPI IPOGLTexture2D* POGLXLoadBMPImageFromFile(IPOGLRenderContext* con
 */
 extern POGLAPI IPOGLTexture2D* POGLXLoadBMPImageFromMemory(IPOGLRenderContext* context, const POGL_BYTE* bytes, POGL_UINT32 size);
 
+/*!
+	\brief The size and pixel format of an image that has not been decoded yet
+*/
+struct POGLAPI POGLX_IMAGE_INFO
+{
+	/* The size of the image */
+	POGL_SIZE size;
+
+	/* The format of the pixels stored in the image. One of BGR or BGRA */
+	POGLTextureFormat::Enum format;
+};
+
+/*!
+	\brief Read the size and pixel format of the supplied TGA data
+
+	\param bytes
+	\param size
+	\param info
+			Receives the information about the image
+*/
+extern POGLAPI void POGLXGetTGAImageInfo(const POGL_BYTE* bytes, POGL_UINT32 size, POGLX_IMAGE_INFO* info);
+
+/*!
+	\brief Decode the supplied TGA data into memory
+
+	The decoded image is laid out exactly as POGLXLoadTGAImageFromMemory uploads it: the first row is the bottom row of the image
+	and each row is stored from right to left.
+
+	\param bytes
+	\param size
+	\param format
+			The format of the decoded pixels. Use the format from POGLXGetTGAImageInfo, or RGB/RGBA to swap the red and blue channels
+	\param dst
+			Memory where the image is decoded to. It must be at least width * height * bytesPerPixel bytes large
+*/
+extern POGLAPI void POGLXDecodeTGAImage(const POGL_BYTE* bytes, POGL_UINT32 size, POGLTextureFormat::Enum format, void* dst);
+
+/*!
+	\brief Read the size and pixel format of the supplied BMP data
+
+	\param bytes
+	\param size
+	\param info
+			Receives the information about the image
+*/
+extern POGLAPI void POGLXGetBMPImageInfo(const POGL_BYTE* bytes, POGL_UINT32 size, POGLX_IMAGE_INFO* info);
+
+/*!
+	\brief Decode the supplied BMP data into memory
+
+	The first row of the decoded image is the bottom row of the image. The padding at the end of each row is removed.
+
+	\param bytes
+	\param size
+	\param format
+			The format of the decoded pixels. Use the format from POGLXGetBMPImageInfo, or RGB/RGBA to swap the red and blue channels
+	\param dst
+			Memory where the image is decoded to. It must be at least width * height * bytesPerPixel bytes large
+*/
+extern POGLAPI void POGLXDecodeBMPImage(const POGL_BYTE* bytes, POGL_UINT32 size, POGLTextureFormat::Enum format, void* dst);
+
+/*!
+	\brief Load the supplied DDS file into a 2D texture and returns it
+
+	The file is memory mapped and the block compressed mip levels are uploaded directly from the mapping. Only BC1, BC3, BC4, BC5 and BC7
+	images are supported.
+
+	\param context
+	\param fileName
+	\return
+*/
+extern POGLAPI IPOGLTexture2D* POGLXLoadDDSImageFromFile(IPOGLRenderContext* context, const POGL_CHAR* fileName);
+
+/*!
+	\brief Load the supplied DDS data into a 2D texture and returns it
+
+	\param context
+	\param bytes
+	\param size
+	\return
+*/
+extern POGLAPI IPOGLTexture2D* POGLXLoadDDSImageFromMemory(IPOGLRenderContext* context, const POGL_BYTE* bytes, POGL_UINT32 size);
+
+/*!
+	\brief Load the supplied KTX file into a 2D texture and returns it
+
+	The file is memory mapped and the block compressed mip levels are uploaded directly from the mapping. Only KTX 1.1 images using
+	one of the compressed POGLTextureFormat formats are supported.
+
+	\param context
+	\param fileName
+	\return
+*/
+extern POGLAPI IPOGLTexture2D* POGLXLoadKTXImageFromFile(IPOGLRenderContext* context, const POGL_CHAR* fileName);
+
+/*!
+	\brief Load the supplied KTX data into a 2D texture and returns it
+
+	\param context
+	\param bytes
+	\param size
+	\return
+*/
+extern POGLAPI IPOGLTexture2D* POGLXLoadKTXImageFromMemory(IPOGLRenderContext* context, const POGL_BYTE* bytes, POGL_UINT32 size);
+
+/*!
+	\brief Filters used when generating mip levels on the CPU
+*/
+struct POGLAPI POGLXDownsampleFilter
+{
+	enum Enum {
+		/* Average each 2x2 block of pixels */
+		BOX = 0,
+
+		/* Kaiser windowed sinc filter. Sharper than the box filter but slower */
+		KAISER,
+
+		/* Number of enums available */
+		COUNT
+	};
+};
+
+/*!
+	\brief Downsample the supplied image to half its size
+
+	The image must have 8 bits per channel. The size of the destination image is max(1, width / 2) x max(1, height / 2)
+
+	\param src
+			The source image
+	\param srcSize
+			The size of the source image
+	\param bytesPerPixel
+			The number of bytes in each pixel
+	\param dst
+			Memory where the downsampled image is written
+	\param filter
+	\return The size of the downsampled image
+*/
+extern POGLAPI POGL_SIZE POGLXDownsampleImage(const POGL_BYTE* src, const POGL_SIZE& srcSize, POGL_UINT32 bytesPerPixel, POGL_BYTE* dst, POGLXDownsampleFilter::Enum filter);
+
+/*!
+	\brief Create a 2D texture with a full mipmap chain generated on the CPU
+
+	Use this for formats where the driver generates mipmaps slowly, or when a better filter than the driver's is needed.
+
+	\param context
+	\param size
+			The size of the base level
+	\param format
+			Texture format. Only formats with 8 bits per channel are supported
+	\param bytes
+			The base level texture data
+	\param filter
+	\return
+*/
+extern POGLAPI IPOGLTexture2D* POGLXCreateTexture2DWithMipmaps(IPOGLRenderContext* context, const POGL_SIZE& size, POGLTextureFormat::Enum format, const void* bytes, POGLXDownsampleFilter::Enum filter);
+
+/*!
+	\brief The location of an image packed into a texture atlas
+*/
+struct POGLAPI POGLX_ATLAS_ENTRY
+{
+	/* The index of the page texture containing the image */
+	POGL_UINT32 page;
+
+	/* The part of the page covered by the image, in pixels. The padding is not included */
+	POGL_RECT rect;
+
+	/* The texture coordinates of the top-left corner of the image */
+	POGL_VECTOR2 uvMin;
+
+	/* The texture coordinates of the bottom-right corner of the image */
+	POGL_VECTOR2 uvMax;
+};
+
+/*!
+	\brief Packs many small images into a few shared 2D textures, called pages
+
+	Images are packed using a skyline packer as they are inserted. A new page is created when an image does not fit into any
+	of the existing pages. Each image is surrounded by a border of padding pixels that repeats the edge pixels of the image, so
+	that filtering and smaller mip levels do not bleed neighbouring images into it.
+*/
+class POGLAPI IPOGLXTextureAtlas : public IPOGLInterface
+{
+public:
+	/*!
+		\brief Pack an image into the atlas and upload it to its page
+
+		\param size
+				The size of the image
+		\param bytes
+				Tightly packed image data in the format of the atlas
+		\return The index of the new entry
+	*/
+	virtual POGL_UINT32 Insert(const POGL_SIZE& size, const void* bytes) = 0;
+
+	/*!
+		\brief Retrieves the location of the supplied entry
+	*/
+	virtual const POGLX_ATLAS_ENTRY& GetEntry(POGL_UINT32 index) const = 0;
+
+	/*!
+		\brief Retrieves the number of entries in this atlas
+	*/
+	virtual POGL_UINT32 GetNumEntries() const = 0;
+
+	/*!
+		\brief Retrieves the number of pages in this atlas
+	*/
+	virtual POGL_UINT32 GetNumPages() const = 0;
+
+	/*!
+		\brief Retrieves the texture of the supplied page
+
+		The texture's reference counter is increased, so remember to release it when you are done with it
+	*/
+	virtual IPOGLTexture2D* GetPage(POGL_UINT32 index) = 0;
+
+	/*!
+		\brief Regenerate the mip levels of all pages that have new entries since the last call
+	*/
+	virtual void GenerateMipmaps() = 0;
+};
+
+/*!
+	\brief Create a texture atlas
+
+	\param context
+			The context used to create and update the pages. The atlas keeps a reference to it
+	\param pageSize
+			The size of each page
+	\param format
+			Texture format. Only formats with 8 bits per channel are supported
+	\param mipLevels
+			The number of mip levels in each page. Use POGL_ALL_MIP_LEVELS to allocate the full mipmap chain
+	\param padding
+			The number of pixels added around each image. Mip level n keeps images apart if the padding is at least 2^n pixels
+	\return
+*/
+extern POGLAPI IPOGLXTextureAtlas* POGLXCreateTextureAtlas(IPOGLRenderContext* context, const POGL_SIZE& pageSize, POGLTextureFormat::Enum format,
+	POGL_UINT32 mipLevels, POGL_UINT32 padding);
+
+/*!
+	\brief An image queued for loading by an IPOGLXImageLoader
+*/
+class POGLAPI IPOGLXImageRequest : public IPOGLInterface
+{
+public:
+	/*!
+		\brief Check if the image has been uploaded and can be used for rendering
+	*/
+	virtual bool IsReady() const = 0;
+
+	/*!
+		\brief Check if the image could not be read or decoded. The placeholder texture is used forever if this happens
+	*/
+	virtual bool HasFailed() const = 0;
+
+	/*!
+		\brief Retrieves the loaded texture, or the placeholder texture of the loader if the image is not ready yet
+
+		The texture's reference counter is increased, so remember to release it when you are done with it
+	*/
+	virtual IPOGLTexture2D* GetTexture() = 0;
+};
+
+/*!
+	\brief Loads images in the background using a pool of worker threads
+
+	The files are read and decoded in parallel by the worker threads. The decoded images are recorded into a deferred render context
+	owned by the loader, and they are uploaded when Update is called from the thread that owns the render context.
+	TGA, BMP, DDS and KTX images are supported. The type of the image is detected from its content.
+*/
+class POGLAPI IPOGLXImageLoader : public IPOGLInterface
+{
+public:
+	/*!
+		\brief Queue the supplied image file for loading
+
+		\param fileName
+		\return A request that can be used to check if the image is ready. Remember to release it when you are done with it
+	*/
+	virtual IPOGLXImageRequest* Load(const POGL_CHAR* fileName) = 0;
+
+	/*!
+		\brief Upload the images decoded since the last call and mark them as ready
+
+		This must be called from the thread that owns the render context, for example once every frame.
+
+		\param context
+				The context the images are uploaded in
+	*/
+	virtual void Update(IPOGLRenderContext* context) = 0;
+
+	/*!
+		\brief Retrieves the number of images that are queued, being decoded or waiting to be uploaded
+	*/
+	virtual POGL_UINT32 GetNumPending() const = 0;
+};
+
+/*!
+	\brief Create an image loader
+
+	\param context
+			The render context. The loader creates its deferred render context and placeholder texture from it
+	\param numThreads
+			The number of worker threads. Use 0 to create one thread for each hardware thread except the calling one
+	\param placeholder
+			The texture returned by requests until their images are ready. A 1x1 grey texture is used if this is nullptr
+	\return
+*/
+extern POGLAPI IPOGLXImageLoader* POGLXCreateImageLoader(IPOGLRenderContext* context, POGL_UINT32 numThreads, IPOGLTexture2D* placeholder);
+
+/*!
+	\brief Builds shader variants from registered sources and a set of preprocessor defines
+
+	Sources are registered once under a name. A source can include other registered sources with {@code #include "name"}, and each
+	source is included at most once into a variant. Variants are compiled the first time they are requested. Requesting the same
+	variant again returns the same shader, so programs built from the same variant share its shader object.
+
+	The defines are a list of {@code NAME} or {@code NAME=VALUE} entries separated by ';'. The list is normalized before it's used
+	as a key, so the order of the entries, whitespace and duplicate entries do not create new variants.
+	{@code
+		IPOGLShader* shader = library->GetShader(POGL_TOCHAR("lit.fs"), POGLShaderType::FRAGMENT, POGL_TOCHAR("SHADOWS;NUM_LIGHTS=4"));
+	}
+*/
+class POGLAPI IPOGLXShaderLibrary : public IPOGLInterface
+{
+public:
+	/*!
+		\brief Register shader source code under the supplied name. An existing source with the same name is replaced
+
+		Variants already built from the old source are kept.
+
+		\param name
+		\param memory
+				String containing the shader source code
+		\param size
+				The length of the source code
+	*/
+	virtual void AddSource(const POGL_CHAR* name, const POGL_CHAR* memory, POGL_UINT32 size) = 0;
+
+	/*!
+		\brief Register the shader source code in the supplied file under the supplied name
+
+		\param name
+		\param fileName
+		\throws POGLResourceException
+				If the file could not be read
+	*/
+	virtual void AddSourceFromFile(const POGL_CHAR* name, const POGL_CHAR* fileName) = 0;
+
+	/*!
+		\brief Retrieves a variant of the supplied source, compiling it if it hasn't been requested before
+
+		The shader's reference counter is increased, so remember to release it when you are done with it
+
+		\param name
+				The name of a registered source
+		\param type
+				The shader type
+		\param defines
+				The defines of the variant, separated by ';'. Can be nullptr
+		\throws POGLResourceException
+				If the source, or a source it includes, is not registered or if a define is given two different values
+	*/
+	virtual IPOGLShader* GetShader(const POGL_CHAR* name, POGLShaderType::Enum type, const POGL_CHAR* defines) = 0;
+
+	/*!
+		\brief Retrieves the number of variants built by this library
+	*/
+	virtual POGL_UINT32 GetNumVariants() const = 0;
+
+	/*!
+		\brief Retrieves the number of times a variant has been requested
+	*/
+	virtual POGL_UINT32 GetNumRequests() const = 0;
+};
+
+/*!
+	\brief Create a shader library
+
+	\param context
+			The context used to create the shaders. The library keeps a reference to it
+	\return
+*/
+extern POGLAPI IPOGLXShaderLibrary* POGLXCreateShaderLibrary(IPOGLRenderContext* context);
+
 /*!
 	\brief Create a IPOGLVertexBuffer instance containing the vertices needed to draw a sphere
 
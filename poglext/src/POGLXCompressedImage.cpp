@@ -0,0 +1,39 @@
+#include "POGLXCompressedImage.h"
+
+POGL_UINT32 POGLXBytesPerBlock(POGLTextureFormat::Enum format)
+{
+	switch (format) {
+	case POGLTextureFormat::BC1_RGB:
+	case POGLTextureFormat::BC1_RGBA:
+	case POGLTextureFormat::BC4_R:
+	case POGLTextureFormat::ETC2_RGB8:
+		return 8;
+	case POGLTextureFormat::BC3_RGBA:
+	case POGLTextureFormat::BC5_RG:
+	case POGLTextureFormat::BC7_RGBA:
+	case POGLTextureFormat::ETC2_RGBA8:
+		return 16;
+	default:
+		THROW_EXCEPTION(POGLResourceException, "The texture format is not a compressed format: %d", format);
+	}
+}
+
+POGL_UINT32 POGLXCompressedLevelSize(POGLTextureFormat::Enum format, const POGL_SIZE& size)
+{
+	return ((size.width + 3) / 4) * ((size.height + 3) / 4) * POGLXBytesPerBlock(format);
+}
+
+IPOGLTexture2D* POGLXCreateCompressedTexture2D(IPOGLRenderContext* context, const POGL_SIZE& size, POGLTextureFormat::Enum format,
+	POGL_UINT32 mipLevels, const POGL_BYTE* const* levels)
+{
+	IPOGLTexture2D* texture = context->CreateTexture2D(size, format, mipLevels, levels[0]);
+	try {
+		for (POGL_UINT32 level = 1; level < mipLevels; ++level)
+			context->UpdateTexture2DMipLevel(texture, level, levels[level]);
+	}
+	catch (...) {
+		texture->Release();
+		throw;
+	}
+	return texture;
+}
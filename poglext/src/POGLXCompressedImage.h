@@ -0,0 +1,31 @@
+#pragma once
+#include "config.h"
+
+/*!
+	\brief Retrieves the number of bytes in each 4x4 pixel block for the supplied compressed format
+*/
+extern POGL_UINT32 POGLXBytesPerBlock(POGLTextureFormat::Enum format);
+
+/*!
+	\brief Retrieves the number of bytes needed for a mip level of the supplied size
+*/
+extern POGL_UINT32 POGLXCompressedLevelSize(POGLTextureFormat::Enum format, const POGL_SIZE& size);
+
+/*!
+	\brief Create a texture containing the supplied mip levels
+
+	The mip levels are uploaded directly from the supplied memory
+
+	\param context
+	\param size
+			The size of the base level
+	\param format
+			The compressed texture format
+	\param mipLevels
+			The number of mip levels
+	\param levels
+			Pointers to the data for each mip level
+	\return
+*/
+extern IPOGLTexture2D* POGLXCreateCompressedTexture2D(IPOGLRenderContext* context, const POGL_SIZE& size, POGLTextureFormat::Enum format,
+	POGL_UINT32 mipLevels, const POGL_BYTE* const* levels);
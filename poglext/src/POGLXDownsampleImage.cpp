@@ -0,0 +1,229 @@
+#include "config.h"
+#include "POGLXImageUtils.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+	// Number of source pixels the Kaiser filter reads, in each direction, for every destination pixel
+	static const POGL_INT32 KAISER_TAPS = 6;
+
+	// Kaiser window shape. Larger values gives less ringing but a blurrier result
+	static const POGL_DOUBLE KAISER_ALPHA = 4.0;
+
+	/*!
+		\brief Zeroth order modified bessel function of the first kind
+	*/
+	POGL_DOUBLE BesselI0(POGL_DOUBLE x)
+	{
+		POGL_DOUBLE sum = 1.0;
+		POGL_DOUBLE term = 1.0;
+		const POGL_DOUBLE x2 = x * x / 4.0;
+		for (POGL_INT32 k = 1; k < 32; ++k) {
+			term *= x2 / (k * k);
+			sum += term;
+		}
+		return sum;
+	}
+
+	/*!
+		\brief Normalized Kaiser windowed sinc weights used when halving an image
+	*/
+	struct POGLXKaiserWeights
+	{
+		POGL_FLOAT weights[KAISER_TAPS];
+
+		POGLXKaiserWeights() {
+			// Distances between the destination pixel center and the source pixels, measured in destination pixels
+			const POGL_DOUBLE radius = KAISER_TAPS / 4.0;
+			POGL_DOUBLE sum = 0.0;
+			POGL_DOUBLE values[KAISER_TAPS];
+			for (POGL_INT32 i = 0; i < KAISER_TAPS; ++i) {
+				const POGL_DOUBLE t = ((i - KAISER_TAPS / 2) + 0.5) / 2.0;
+				const POGL_DOUBLE sinc = POGL_M_PI * t;
+				const POGL_DOUBLE u = t / radius;
+				const POGL_DOUBLE window = BesselI0(KAISER_ALPHA * sqrt(1.0 - u * u)) / BesselI0(KAISER_ALPHA);
+				values[i] = (sin(sinc) / sinc) * window;
+				sum += values[i];
+			}
+
+			for (POGL_INT32 i = 0; i < KAISER_TAPS; ++i)
+				weights[i] = (POGL_FLOAT)(values[i] / sum);
+		}
+	};
+
+	/*!
+		\brief Average each 2x2 block of pixels into one destination pixel
+	*/
+	void POGLXDownsampleBox(const POGL_BYTE* src, const POGL_SIZE& srcSize, POGL_UINT32 bytesPerPixel, POGL_BYTE* dst, const POGL_SIZE& dstSize)
+	{
+		const POGL_UINT32 srcPitch = srcSize.width * bytesPerPixel;
+		const POGL_UINT32 dstPitch = dstSize.width * bytesPerPixel;
+
+		for (POGL_INT32 y = 0; y < dstSize.height; ++y) {
+			const POGL_BYTE* row0 = src + (2 * y) * srcPitch;
+			const POGL_BYTE* row1 = src + (std::min)(2 * y + 1, srcSize.height - 1) * srcPitch;
+			POGL_BYTE* out = dst + y * dstPitch;
+			POGL_INT32 x = 0;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+			// Two destination pixels at a time from four source pixels on each row
+			if (bytesPerPixel == 4 && srcSize.width > 1) {
+				const __m128i zero = _mm_setzero_si128();
+				const __m128i two = _mm_set1_epi16(2);
+				for (; x + 2 <= dstSize.width; x += 2) {
+					const __m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+					const __m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+					const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+					const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+					const __m128i sumLo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+					const __m128i sumHi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+					const __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(sumLo, sumHi), two), 2);
+					_mm_storel_epi64((__m128i*)(out + x * 4), _mm_packus_epi16(sum, zero));
+				}
+			}
+#endif
+
+			for (; x < dstSize.width; ++x) {
+				const POGL_UINT32 x0 = (2 * x) * bytesPerPixel;
+				const POGL_UINT32 x1 = (std::min)(2 * x + 1, srcSize.width - 1) * bytesPerPixel;
+				for (POGL_UINT32 c = 0; c < bytesPerPixel; ++c) {
+					const POGL_UINT32 sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+					out[x * bytesPerPixel + c] = (POGL_BYTE)((sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	/*!
+		\brief Halve the image using a separable Kaiser windowed sinc filter. The image is filtered horizontally into a temporary
+			floating point image which is then filtered vertically.
+	*/
+	void POGLXDownsampleKaiser(const POGL_BYTE* src, const POGL_SIZE& srcSize, POGL_UINT32 bytesPerPixel, POGL_BYTE* dst, const POGL_SIZE& dstSize)
+	{
+		static const POGLXKaiserWeights kaiser;
+		const POGL_FLOAT* weights = kaiser.weights;
+		const POGL_UINT32 srcPitch = srcSize.width * bytesPerPixel;
+		const POGL_UINT32 tmpPitch = dstSize.width * bytesPerPixel;
+		std::vector<POGL_FLOAT> tmp(tmpPitch * srcSize.height);
+
+		//
+		// Horizontal pass
+		//
+
+		for (POGL_INT32 y = 0; y < srcSize.height; ++y) {
+			const POGL_BYTE* row = src + y * srcPitch;
+			POGL_FLOAT* out = &tmp[y * tmpPitch];
+			for (POGL_INT32 x = 0; x < dstSize.width; ++x) {
+				const POGL_INT32 first = 2 * x - KAISER_TAPS / 2 + 1;
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+				if (bytesPerPixel == 4) {
+					const __m128i zero = _mm_setzero_si128();
+					__m128 sum = _mm_setzero_ps();
+					for (POGL_INT32 i = 0; i < KAISER_TAPS; ++i) {
+						const POGL_INT32 sx = (std::min)((std::max)(first + i, 0), srcSize.width - 1);
+						const __m128i pixel = _mm_cvtsi32_si128(*(const int*)(row + sx * 4));
+						const __m128 value = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(pixel, zero), zero));
+						sum = _mm_add_ps(sum, _mm_mul_ps(value, _mm_set1_ps(weights[i])));
+					}
+					_mm_storeu_ps(out + x * 4, sum);
+					continue;
+				}
+#endif
+				for (POGL_UINT32 c = 0; c < bytesPerPixel; ++c) {
+					POGL_FLOAT sum = 0.0f;
+					for (POGL_INT32 i = 0; i < KAISER_TAPS; ++i) {
+						const POGL_INT32 sx = (std::min)((std::max)(first + i, 0), srcSize.width - 1);
+						sum += row[sx * bytesPerPixel + c] * weights[i];
+					}
+					out[x * bytesPerPixel + c] = sum;
+				}
+			}
+		}
+
+		//
+		// Vertical pass
+		//
+
+		const POGL_UINT32 dstPitch = dstSize.width * bytesPerPixel;
+		for (POGL_INT32 y = 0; y < dstSize.height; ++y) {
+			const POGL_INT32 first = 2 * y - KAISER_TAPS / 2 + 1;
+			POGL_BYTE* out = dst + y * dstPitch;
+			POGL_UINT32 i = 0;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+			// Four channels at a time
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + 4 <= dstPitch; i += 4) {
+				__m128 sum = _mm_setzero_ps();
+				for (POGL_INT32 t = 0; t < KAISER_TAPS; ++t) {
+					const POGL_INT32 sy = (std::min)((std::max)(first + t, 0), srcSize.height - 1);
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&tmp[sy * tmpPitch + i]), _mm_set1_ps(weights[t])));
+				}
+				// Round and clamp the same way as the scalar code below, so that the result doesn't depend on the instruction set
+				const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_add_ps(sum, _mm_set1_ps(0.5f)), _mm_setzero_ps()), _mm_set1_ps(255.0f));
+				const __m128i value = _mm_cvttps_epi32(clamped);
+				const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(value, zero), zero);
+				*(int*)(out + i) = _mm_cvtsi128_si32(packed);
+			}
+#endif
+
+			for (; i < dstPitch; ++i) {
+				POGL_FLOAT sum = 0.0f;
+				for (POGL_INT32 t = 0; t < KAISER_TAPS; ++t) {
+					const POGL_INT32 sy = (std::min)((std::max)(first + t, 0), srcSize.height - 1);
+					sum += tmp[sy * tmpPitch + i] * weights[t];
+				}
+				out[i] = (POGL_BYTE)(std::min)((std::max)(sum + 0.5f, 0.0f), 255.0f);
+			}
+		}
+	}
+}
+
+POGL_SIZE POGLXDownsampleImage(const POGL_BYTE* src, const POGL_SIZE& srcSize, POGL_UINT32 bytesPerPixel, POGL_BYTE* dst, POGLXDownsampleFilter::Enum filter)
+{
+	if (src == nullptr || dst == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+	if (srcSize.width <= 0 || srcSize.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot downsample an image with the size: %dx%d", srcSize.width, srcSize.height);
+
+	const POGL_SIZE dstSize((std::max)(1, srcSize.width / 2), (std::max)(1, srcSize.height / 2));
+	if (filter == POGLXDownsampleFilter::KAISER)
+		POGLXDownsampleKaiser(src, srcSize, bytesPerPixel, dst, dstSize);
+	else
+		POGLXDownsampleBox(src, srcSize, bytesPerPixel, dst, dstSize);
+	return dstSize;
+}
+
+IPOGLTexture2D* POGLXCreateTexture2DWithMipmaps(IPOGLRenderContext* context, const POGL_SIZE& size, POGLTextureFormat::Enum format, const void* bytes, POGLXDownsampleFilter::Enum filter)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+	const POGL_UINT32 bytesPerPixel = POGLXBytesPerPixel(format);
+	IPOGLTexture2D* texture = context->CreateTexture2D(size, format, POGL_ALL_MIP_LEVELS, bytes);
+
+	//
+	// Each mip level is generated from the previous one
+	//
+
+	const POGL_UINT32 mipLevels = texture->GetMipLevels();
+	std::vector<POGL_BYTE> levels[2];
+	levels[0].resize(((size.width / 2) + 1) * ((size.height / 2) + 1) * bytesPerPixel);
+	levels[1].resize(levels[0].size());
+
+	const POGL_BYTE* src = (const POGL_BYTE*)bytes;
+	POGL_SIZE srcSize = size;
+	for (POGL_UINT32 level = 1; level < mipLevels; ++level) {
+		POGL_BYTE* dst = &levels[level % 2][0];
+		srcSize = POGLXDownsampleImage(src, srcSize, bytesPerPixel, dst, filter);
+		context->UpdateTexture2DMipLevel(texture, level, dst);
+		src = dst;
+	}
+
+	return texture;
+}
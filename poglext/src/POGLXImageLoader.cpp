@@ -0,0 +1,197 @@
+#include "POGLXImageLoader.h"
+#include "POGLXImageRequest.h"
+#include "POGLXImageUtils.h"
+#include <cstring>
+
+POGLXImageLoader::POGLXImageLoader(IPOGLRenderContext* context, POGL_UINT32 numThreads, IPOGLTexture2D* placeholder)
+: mRefCount(1), mDeferredContext(nullptr), mPlaceholder(placeholder), mNumPending(0), mShutdown(false)
+{
+	if (mPlaceholder != nullptr) {
+		mPlaceholder->AddRef();
+	}
+	else {
+		const POGL_BYTE GREY[] = { 128, 128, 128 };
+		mPlaceholder = context->CreateTexture2D(POGL_SIZE(1, 1), POGLTextureFormat::RGB, GREY);
+	}
+
+	IPOGLDevice* device = context->GetDevice();
+	mDeferredContext = device->CreateDeferredRenderContext();
+	device->Release();
+
+	for (POGL_UINT32 i = 0; i < numThreads; ++i)
+		mThreads.push_back(std::thread(&POGLXImageLoader::WorkerThread, this));
+}
+
+POGLXImageLoader::~POGLXImageLoader()
+{
+	mQueueMutex.lock();
+	mShutdown = true;
+	mQueueMutex.unlock();
+	mQueueCondition.notify_all();
+
+	for (size_t i = 0; i < mThreads.size(); ++i)
+		mThreads[i].join();
+
+	//
+	// Images that were never uploaded are treated as failed
+	//
+
+	for (size_t i = 0; i < mQueue.size(); ++i) {
+		mQueue[i]->SetFailed();
+		mQueue[i]->Release();
+	}
+	mQueue.clear();
+
+	for (size_t i = 0; i < mRecorded.size(); ++i) {
+		mRecorded[i]->SetFailed();
+		mRecorded[i]->Release();
+	}
+	mRecorded.clear();
+
+	POGL_SAFE_RELEASE(mDeferredContext);
+	POGL_SAFE_RELEASE(mPlaceholder);
+}
+
+void POGLXImageLoader::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLXImageLoader::Release()
+{
+	if (--mRefCount == 0) {
+		delete this;
+	}
+}
+
+IPOGLXImageRequest* POGLXImageLoader::Load(const POGL_CHAR* fileName)
+{
+	if (fileName == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid filename");
+
+	// The queue keeps its own reference to the request until the image is uploaded
+	POGLXImageRequest* request = new POGLXImageRequest(fileName, mPlaceholder);
+	request->AddRef();
+	mNumPending++;
+
+	mQueueMutex.lock();
+	mQueue.push_back(request);
+	mQueueMutex.unlock();
+	mQueueCondition.notify_one();
+	return request;
+}
+
+void POGLXImageLoader::Update(IPOGLRenderContext* context)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	std::vector<POGLXImageRequest*> uploaded;
+	{
+		std::lock_guard<std::mutex> lock(mUploadMutex);
+		if (mRecorded.empty())
+			return;
+
+		mDeferredContext->Flush();
+		mDeferredContext->ExecuteCommands(context);
+		uploaded.swap(mRecorded);
+	}
+
+	for (size_t i = 0; i < uploaded.size(); ++i) {
+		uploaded[i]->SetReady();
+		Complete(uploaded[i]);
+	}
+}
+
+POGL_UINT32 POGLXImageLoader::GetNumPending() const
+{
+	return mNumPending;
+}
+
+void POGLXImageLoader::WorkerThread()
+{
+	std::vector<POGL_BYTE> pixels;
+	while (true) {
+		POGLXImageRequest* request = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mQueueMutex);
+			mQueueCondition.wait(lock, [this] { return mShutdown || !mQueue.empty(); });
+			if (mShutdown)
+				return;
+			request = mQueue.front();
+			mQueue.pop_front();
+		}
+
+		try {
+			LoadImage(request, pixels);
+		}
+		catch (...) {
+			request->SetFailed();
+			Complete(request);
+		}
+	}
+}
+
+void POGLXImageLoader::LoadImage(POGLXImageRequest* request, std::vector<POGL_BYTE>& pixels)
+{
+	POGLMappedFile file(request->GetFileName().c_str());
+	const POGL_BYTE* bytes = file.GetBytes();
+	const POGL_UINT32 size = file.GetSize();
+	if (size < 4)
+		THROW_EXCEPTION(POGLResourceException, "Invalid image file: %s", request->GetFileName().c_str());
+
+	//
+	// Block compressed images are not decoded. They are recorded straight from the mapped file
+	//
+
+	static const POGL_BYTE DDS_MAGIC[] = { 'D', 'D', 'S', ' ' };
+	static const POGL_BYTE KTX_MAGIC[] = { 0xAB, 'K', 'T', 'X' };
+	const bool dds = memcmp(bytes, DDS_MAGIC, sizeof(DDS_MAGIC)) == 0;
+	const bool ktx = memcmp(bytes, KTX_MAGIC, sizeof(KTX_MAGIC)) == 0;
+	if (dds || ktx) {
+		std::lock_guard<std::mutex> lock(mUploadMutex);
+		request->SetTexture(dds ? POGLXLoadDDSImageFromMemory(mDeferredContext, bytes, size) : POGLXLoadKTXImageFromMemory(mDeferredContext, bytes, size));
+		mRecorded.push_back(request);
+		return;
+	}
+
+	//
+	// Decode the image on this thread. Only the copy into the deferred context is serialized
+	//
+
+	const bool bmp = bytes[0] == 'B' && bytes[1] == 'M';
+	POGLX_IMAGE_INFO info;
+	if (bmp)
+		POGLXGetBMPImageInfo(bytes, size, &info);
+	else
+		POGLXGetTGAImageInfo(bytes, size, &info);
+
+	pixels.resize(info.size.width * info.size.height * POGLXBytesPerPixel(info.format));
+	if (bmp)
+		POGLXDecodeBMPImage(bytes, size, info.format, &pixels[0]);
+	else
+		POGLXDecodeTGAImage(bytes, size, info.format, &pixels[0]);
+
+	std::lock_guard<std::mutex> lock(mUploadMutex);
+	request->SetTexture(mDeferredContext->CreateTexture2D(info.size, info.format, &pixels[0]));
+	mRecorded.push_back(request);
+}
+
+void POGLXImageLoader::Complete(POGLXImageRequest* request)
+{
+	mNumPending--;
+	request->Release();
+}
+
+IPOGLXImageLoader* POGLXCreateImageLoader(IPOGLRenderContext* context, POGL_UINT32 numThreads, IPOGLTexture2D* placeholder)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	if (numThreads == 0) {
+		const POGL_UINT32 hardwareThreads = std::thread::hardware_concurrency();
+		numThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	return new POGLXImageLoader(context, numThreads, placeholder);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "config.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class POGLXImageRequest;
+class POGLXImageLoader : public IPOGLXImageLoader
+{
+public:
+	POGLXImageLoader(IPOGLRenderContext* context, POGL_UINT32 numThreads, IPOGLTexture2D* placeholder);
+	virtual ~POGLXImageLoader();
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+// IPOGLXImageLoader
+public:
+	virtual IPOGLXImageRequest* Load(const POGL_CHAR* fileName);
+	virtual void Update(IPOGLRenderContext* context);
+	virtual POGL_UINT32 GetNumPending() const;
+
+private:
+	/*!
+		\brief Load queued images until the loader is destroyed
+	*/
+	void WorkerThread();
+
+	/*!
+		\brief Read and decode the image of the supplied request and record its upload into the deferred context
+
+		\param request
+		\param pixels
+				Memory owned by the worker thread that is reused for all images it decodes
+	*/
+	void LoadImage(POGLXImageRequest* request, std::vector<POGL_BYTE>& pixels);
+
+	/*!
+		\brief Release a request that has been uploaded or has failed
+	*/
+	void Complete(POGLXImageRequest* request);
+
+private:
+	REF_COUNTER mRefCount;
+	IPOGLDeferredRenderContext* mDeferredContext;
+	IPOGLTexture2D* mPlaceholder;
+	std::vector<std::thread> mThreads;
+	std::atomic<POGL_UINT32> mNumPending;
+
+	// Requests waiting for a worker thread
+	std::mutex mQueueMutex;
+	std::condition_variable mQueueCondition;
+	std::deque<POGLXImageRequest*> mQueue;
+	bool mShutdown;
+
+	//
+	// Requests recorded into the deferred context but not executed yet. The deferred context reuses its command memory
+	// when it's flushed, which is why the commands are recorded, flushed and executed while holding the same lock.
+	//
+
+	std::mutex mUploadMutex;
+	std::vector<POGLXImageRequest*> mRecorded;
+};
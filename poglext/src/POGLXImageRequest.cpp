@@ -0,0 +1,57 @@
+#include "POGLXImageRequest.h"
+
+POGLXImageRequest::POGLXImageRequest(const POGL_CHAR* fileName, IPOGLTexture2D* placeholder)
+: mRefCount(1), mFileName(fileName), mPlaceholder(placeholder), mTexture(nullptr), mReady(false), mFailed(false)
+{
+	mPlaceholder->AddRef();
+}
+
+POGLXImageRequest::~POGLXImageRequest()
+{
+	POGL_SAFE_RELEASE(mTexture);
+	POGL_SAFE_RELEASE(mPlaceholder);
+}
+
+void POGLXImageRequest::SetTexture(IPOGLTexture2D* texture)
+{
+	mTexture = texture;
+}
+
+void POGLXImageRequest::SetReady()
+{
+	mReady = true;
+}
+
+void POGLXImageRequest::SetFailed()
+{
+	mFailed = true;
+}
+
+void POGLXImageRequest::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLXImageRequest::Release()
+{
+	if (--mRefCount == 0) {
+		delete this;
+	}
+}
+
+bool POGLXImageRequest::IsReady() const
+{
+	return mReady;
+}
+
+bool POGLXImageRequest::HasFailed() const
+{
+	return mFailed;
+}
+
+IPOGLTexture2D* POGLXImageRequest::GetTexture()
+{
+	IPOGLTexture2D* texture = mReady ? mTexture : mPlaceholder;
+	texture->AddRef();
+	return texture;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "config.h"
+
+class POGLXImageRequest : public IPOGLXImageRequest
+{
+public:
+	POGLXImageRequest(const POGL_CHAR* fileName, IPOGLTexture2D* placeholder);
+	virtual ~POGLXImageRequest();
+
+	/*!
+		\brief Retrieves the name of the file that is loaded
+	*/
+	inline const POGL_STRING& GetFileName() const {
+		return mFileName;
+	}
+
+	/*!
+		\brief Set the texture the image is uploaded into. The texture is not used until the request is ready
+
+		\param texture
+				The texture. The request takes over the callers reference
+	*/
+	void SetTexture(IPOGLTexture2D* texture);
+
+	/*!
+		\brief Mark that the commands uploading the texture have been executed
+	*/
+	void SetReady();
+
+	/*!
+		\brief Mark that the image could not be loaded
+	*/
+	void SetFailed();
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+// IPOGLXImageRequest
+public:
+	virtual bool IsReady() const;
+	virtual bool HasFailed() const;
+	virtual IPOGLTexture2D* GetTexture();
+
+private:
+	REF_COUNTER mRefCount;
+	POGL_STRING mFileName;
+	IPOGLTexture2D* mPlaceholder;
+	IPOGLTexture2D* mTexture;
+	std::atomic<bool> mReady;
+	std::atomic<bool> mFailed;
+};
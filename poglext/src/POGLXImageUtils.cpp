@@ -0,0 +1,214 @@
+#include "POGLXImageUtils.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+	/*!
+		\brief Copy one pixel, swapping the first and third channel if requested. The pixels must not overlap
+	*/
+	inline void POGLXCopyPixel(POGL_BYTE* dst, const POGL_BYTE* src, POGL_UINT32 bytesPerPixel, bool swizzle)
+	{
+		if (swizzle && bytesPerPixel >= 3) {
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			if (bytesPerPixel == 4)
+				dst[3] = src[3];
+		}
+		else {
+			for (POGL_UINT32 c = 0; c < bytesPerPixel; ++c)
+				dst[c] = src[c];
+		}
+	}
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+	/*!
+		\brief Swap the first and third channel of four 32 bit pixels
+	*/
+	inline __m128i POGLXSwizzle32(__m128i pixels)
+	{
+		const __m128i mask = _mm_set1_epi32(0xFF00FF00);
+		const __m128i rb = _mm_andnot_si128(mask, pixels);
+		return _mm_or_si128(_mm_and_si128(pixels, mask), _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16)));
+	}
+
+	/*!
+		\brief Reverse the order of four 32 bit pixels
+	*/
+	inline __m128i POGLXReverse32(__m128i pixels)
+	{
+		return _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+	}
+#endif
+}
+
+POGL_UINT32 POGLXBytesPerPixel(POGLTextureFormat::Enum format)
+{
+	switch (format) {
+	case POGLTextureFormat::R:
+		return 1;
+	case POGLTextureFormat::RGB:
+	case POGLTextureFormat::RGB8:
+	case POGLTextureFormat::BGR:
+		return 3;
+	case POGLTextureFormat::RGBA:
+	case POGLTextureFormat::RGBA8:
+	case POGLTextureFormat::BGRA:
+		return 4;
+	default:
+		THROW_EXCEPTION(POGLResourceException, "Only texture formats with 8 bits per channel are supported. Format: %d", format);
+	}
+}
+
+POGL_UINT32 POGLXSwizzleTransform(POGLTextureFormat::Enum srcFormat, POGLTextureFormat::Enum dstFormat)
+{
+	const POGL_UINT32 bytesPerPixel = POGLXBytesPerPixel(srcFormat);
+	if (bytesPerPixel != POGLXBytesPerPixel(dstFormat))
+		THROW_EXCEPTION(POGLResourceException, "Cannot convert pixels between formats with different number of channels. Formats: %d and %d", srcFormat, dstFormat);
+
+	const bool srcBGR = srcFormat == POGLTextureFormat::BGR || srcFormat == POGLTextureFormat::BGRA;
+	const bool dstBGR = dstFormat == POGLTextureFormat::BGR || dstFormat == POGLTextureFormat::BGRA;
+	if (bytesPerPixel < 3 || srcBGR == dstBGR)
+		return POGLXPixelTransform::NONE;
+	return POGLXPixelTransform::SWIZZLE;
+}
+
+void POGLXFillPixels(POGL_BYTE* dst, const POGL_BYTE* pixel, POGL_UINT32 bytesPerPixel, POGL_UINT32 count)
+{
+	const POGL_UINT32 totalBytes = count * bytesPerPixel;
+	if (totalBytes == 0)
+		return;
+
+	// Runs of black, white and grey pixels are common and can be filled one byte at a time
+	bool uniform = true;
+	for (POGL_UINT32 c = 1; c < bytesPerPixel; ++c)
+		uniform &= pixel[c] == pixel[0];
+	if (uniform) {
+		memset(dst, pixel[0], totalBytes);
+		return;
+	}
+
+	// Copy the pixel once and then keep doubling the filled part of the destination
+	memcpy(dst, pixel, bytesPerPixel);
+	POGL_UINT32 filled = bytesPerPixel;
+	while (filled < totalBytes) {
+		const POGL_UINT32 length = (std::min)(filled, totalBytes - filled);
+		memcpy(dst + filled, dst, length);
+		filled += length;
+	}
+}
+
+void POGLXCopyPixels(POGL_BYTE* dst, const POGL_BYTE* src, POGL_UINT32 width, POGL_UINT32 bytesPerPixel, POGL_UINT32 transform)
+{
+	if (transform == POGLXPixelTransform::NONE) {
+		memcpy(dst, src, width * bytesPerPixel);
+		return;
+	}
+
+	const bool mirror = (transform & POGLXPixelTransform::MIRROR) != 0;
+	const bool swizzle = (transform & POGLXPixelTransform::SWIZZLE) != 0;
+	POGL_UINT32 x = 0;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+	if (bytesPerPixel == 4) {
+		for (; x + 4 <= width; x += 4) {
+			__m128i pixels;
+			if (mirror)
+				pixels = POGLXReverse32(_mm_loadu_si128((const __m128i*)(src + (width - x - 4) * 4)));
+			else
+				pixels = _mm_loadu_si128((const __m128i*)(src + x * 4));
+			if (swizzle)
+				pixels = POGLXSwizzle32(pixels);
+			_mm_storeu_si128((__m128i*)(dst + x * 4), pixels);
+		}
+	}
+#endif
+
+	for (; x < width; ++x) {
+		const POGL_UINT32 sx = mirror ? width - x - 1 : x;
+		POGLXCopyPixel(dst + x * bytesPerPixel, src + sx * bytesPerPixel, bytesPerPixel, swizzle);
+	}
+}
+
+void POGLXTransformPixels(POGL_BYTE* row, POGL_UINT32 width, POGL_UINT32 bytesPerPixel, POGL_UINT32 transform)
+{
+	const bool mirror = (transform & POGLXPixelTransform::MIRROR) != 0;
+	const bool swizzle = (transform & POGLXPixelTransform::SWIZZLE) != 0 && bytesPerPixel >= 3;
+
+	if (!mirror) {
+		if (!swizzle)
+			return;
+
+		POGL_UINT32 x = 0;
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+		if (bytesPerPixel == 4) {
+			for (; x + 4 <= width; x += 4) {
+				__m128i* ptr = (__m128i*)(row + x * 4);
+				_mm_storeu_si128(ptr, POGLXSwizzle32(_mm_loadu_si128(ptr)));
+			}
+		}
+#endif
+		for (; x < width; ++x)
+			std::swap(row[x * bytesPerPixel], row[x * bytesPerPixel + 2]);
+		return;
+	}
+
+	//
+	// Swap pixels from both ends of the row until they meet in the middle
+	//
+
+	POGL_UINT32 left = 0;
+	POGL_UINT32 right = width;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+	if (bytesPerPixel == 4) {
+		for (; right - left >= 8; left += 4, right -= 4) {
+			__m128i* leftPtr = (__m128i*)(row + left * 4);
+			__m128i* rightPtr = (__m128i*)(row + (right - 4) * 4);
+			__m128i leftPixels = POGLXReverse32(_mm_loadu_si128(leftPtr));
+			__m128i rightPixels = POGLXReverse32(_mm_loadu_si128(rightPtr));
+			if (swizzle) {
+				leftPixels = POGLXSwizzle32(leftPixels);
+				rightPixels = POGLXSwizzle32(rightPixels);
+			}
+			_mm_storeu_si128(leftPtr, rightPixels);
+			_mm_storeu_si128(rightPtr, leftPixels);
+		}
+	}
+#endif
+
+	POGL_BYTE pixel[4];
+	for (; right - left >= 2; ++left, --right) {
+		POGL_BYTE* leftPixel = row + left * bytesPerPixel;
+		POGL_BYTE* rightPixel = row + (right - 1) * bytesPerPixel;
+		memcpy(pixel, leftPixel, bytesPerPixel);
+		POGLXCopyPixel(leftPixel, rightPixel, bytesPerPixel, swizzle);
+		POGLXCopyPixel(rightPixel, pixel, bytesPerPixel, swizzle);
+	}
+
+	// The pixel in the middle of a row with an odd width stays where it is
+	if (right - left == 1 && swizzle)
+		std::swap(row[left * bytesPerPixel], row[left * bytesPerPixel + 2]);
+}
+
+void POGLXFlipRows(POGL_BYTE* image, const POGL_SIZE& size, POGL_UINT32 bytesPerPixel)
+{
+	const POGL_UINT32 pitch = size.width * bytesPerPixel;
+	for (POGL_INT32 y = 0; y < size.height / 2; ++y) {
+		POGL_BYTE* top = image + y * pitch;
+		POGL_BYTE* bottom = image + (size.height - y - 1) * pitch;
+		POGL_UINT32 i = 0;
+
+#if defined(POGL_ENHANCED_INSTRUCTION_SET)
+		for (; i + 16 <= pitch; i += 16) {
+			const __m128i a = _mm_loadu_si128((const __m128i*)(top + i));
+			const __m128i b = _mm_loadu_si128((const __m128i*)(bottom + i));
+			_mm_storeu_si128((__m128i*)(top + i), b);
+			_mm_storeu_si128((__m128i*)(bottom + i), a);
+		}
+#endif
+
+		for (; i < pitch; ++i)
+			std::swap(top[i], bottom[i]);
+	}
+}
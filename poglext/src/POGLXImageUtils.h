@@ -0,0 +1,50 @@
+#pragma once
+#include "config.h"
+
+/*!
+	\brief Ways a row of pixels can be rearranged while it's copied
+*/
+struct POGLXPixelTransform
+{
+	enum Enum {
+		/* Copy the pixels as they are */
+		NONE = 0,
+
+		/* Reverse the order of the pixels in the row */
+		MIRROR = 1 << 0,
+
+		/* Swap the first and third channel of each pixel, i.e. BGR <-> RGB and BGRA <-> RGBA */
+		SWIZZLE = 1 << 1
+	};
+};
+
+/*!
+	\brief Retrieves the number of bytes for each pixel in the supplied format. Only formats with 8 bits per channel are supported
+*/
+extern POGL_UINT32 POGLXBytesPerPixel(POGLTextureFormat::Enum format);
+
+/*!
+	\brief Retrieves the POGLXPixelTransform flags that converts pixels in the source format into the destination format.
+		The formats must have the same number of channels and only differ in the order of the red and blue channel
+*/
+extern POGL_UINT32 POGLXSwizzleTransform(POGLTextureFormat::Enum srcFormat, POGLTextureFormat::Enum dstFormat);
+
+/*!
+	\brief Fill the destination with count copies of the supplied pixel
+*/
+extern void POGLXFillPixels(POGL_BYTE* dst, const POGL_BYTE* pixel, POGL_UINT32 bytesPerPixel, POGL_UINT32 count);
+
+/*!
+	\brief Copy a row of pixels and apply the supplied POGLXPixelTransform flags to it. The rows must not overlap
+*/
+extern void POGLXCopyPixels(POGL_BYTE* dst, const POGL_BYTE* src, POGL_UINT32 width, POGL_UINT32 bytesPerPixel, POGL_UINT32 transform);
+
+/*!
+	\brief Apply the supplied POGLXPixelTransform flags to a row of pixels in place
+*/
+extern void POGLXTransformPixels(POGL_BYTE* row, POGL_UINT32 width, POGL_UINT32 bytesPerPixel, POGL_UINT32 transform);
+
+/*!
+	\brief Reverse the order of the rows in the supplied image
+*/
+extern void POGLXFlipRows(POGL_BYTE* image, const POGL_SIZE& size, POGL_UINT32 bytesPerPixel);
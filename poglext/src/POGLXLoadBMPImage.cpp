@@ -1,25 +1,110 @@
 #include "config.h"
+#include "POGLXImageUtils.h"
 #include <memory>
 #include <algorithm>
 
+namespace {
+	static const POGL_UINT32 BMP_HEADER_SIZE = 54;
+	static const POGL_UINT32 BMP_RGB = 0;
+
+	/*!
+		\brief Information read from the header of a BMP image
+	*/
+	struct POGLX_BMP_HEADER
+	{
+		POGLX_IMAGE_INFO info;
+		POGL_UINT32 bytesPerPixel;
+		POGL_UINT32 dataOffset;
+
+		/* Number of bytes between the beginning of two rows. Rows are padded to a multiple of four bytes */
+		POGL_UINT32 pitch;
+
+		/* The rows are stored top to bottom and must be flipped */
+		bool flipRows;
+	};
+
+	inline POGL_UINT32 POGLXReadUInt32(const POGL_BYTE* bytes)
+	{
+		return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((POGL_UINT32)bytes[3] << 24);
+	}
+
+	void POGLXReadBMPHeader(const POGL_BYTE* bytes, POGL_UINT32 size, POGLX_BMP_HEADER* header)
+	{
+		if (bytes == nullptr || size == 0)
+			THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+		if (size < BMP_HEADER_SIZE)
+			THROW_EXCEPTION(POGLResourceException, "Invalid BMP file");
+
+		if (bytes[0] != 'B' || bytes[1] != 'M')
+			THROW_EXCEPTION(POGLResourceException, "Invalid BMP file");
+
+		// Get num bits per pixel
+		const POGL_UINT32 bitsPerPixel = bytes[28] | (bytes[29] << 8);
+
+		// Verify 24 or 32 bit image type
+		if (bitsPerPixel != 24 && bitsPerPixel != 32)
+			THROW_EXCEPTION(POGLResourceException, "Invalid File Format for file. 24 or 32 bit Image Required.");
+
+		if (POGLXReadUInt32(&bytes[30]) != BMP_RGB)
+			THROW_EXCEPTION(POGLResourceException, "Compressed BMP images are not supported");
+
+		// Read image size from header. A negative height means that the rows are stored top to bottom
+		const POGL_INT32 width = (POGL_INT32)POGLXReadUInt32(&bytes[0x12]);
+		const POGL_INT32 height = (POGL_INT32)POGLXReadUInt32(&bytes[0x16]);
+		if (width <= 0 || height == 0 || width > 0xFFFF || height > 0xFFFF || height < -0xFFFF)
+			THROW_EXCEPTION(POGLResourceException, "Invalid BMP image size: %dx%d", width, height);
+
+		header->info.size = POGL_SIZE(width, height < 0 ? -height : height);
+		header->info.format = bitsPerPixel == 24 ? POGLTextureFormat::BGR : POGLTextureFormat::BGRA;
+		header->bytesPerPixel = bitsPerPixel / 8;
+		header->dataOffset = POGLXReadUInt32(&bytes[10]);
+		header->pitch = (width * header->bytesPerPixel + 3) & ~3;
+		header->flipRows = height < 0;
+
+		if (header->dataOffset > size || (POGL_UINT64)header->pitch * header->info.size.height > size - header->dataOffset)
+			THROW_EXCEPTION(POGLResourceException, "Unexpected end of BMP data");
+	}
+
+	void POGLXDecodeBMPImage(const POGLX_BMP_HEADER& header, const POGL_BYTE* bytes, POGL_UINT32 transform, POGL_BYTE* dst)
+	{
+		const POGL_SIZE& imageSize = header.info.size;
+		const POGL_UINT32 dstPitch = imageSize.width * header.bytesPerPixel;
+		const POGL_BYTE* src = bytes + header.dataOffset;
+		for (POGL_INT32 y = 0; y < imageSize.height; ++y) {
+			const POGL_INT32 dy = header.flipRows ? imageSize.height - y - 1 : y;
+			POGLXCopyPixels(dst + dy * dstPitch, src + y * header.pitch, imageSize.width, header.bytesPerPixel, transform);
+		}
+	}
+}
+
+void POGLXGetBMPImageInfo(const POGL_BYTE* bytes, POGL_UINT32 size, POGLX_IMAGE_INFO* info)
+{
+	if (info == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid image info");
+
+	POGLX_BMP_HEADER header;
+	POGLXReadBMPHeader(bytes, size, &header);
+	*info = header.info;
+}
+
+void POGLXDecodeBMPImage(const POGL_BYTE* bytes, POGL_UINT32 size, POGLTextureFormat::Enum format, void* dst)
+{
+	if (dst == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid destination");
+
+	POGLX_BMP_HEADER header;
+	POGLXReadBMPHeader(bytes, size, &header);
+	POGLXDecodeBMPImage(header, bytes, POGLXSwizzleTransform(header.info.format, format), (POGL_BYTE*)dst);
+}
+
 IPOGLTexture2D* POGLXLoadBMPImageFromFile(IPOGLRenderContext* context, const POGL_CHAR* fileName)
 {
 	assert_not_null(context);
 	assert_not_null(fileName);
 
-	// Open file
-	FILE* file = open_file(fileName, POGL_TOCHAR("rb"));
-	if (file == nullptr)
-		THROW_EXCEPTION(POGLResourceException, "File not found: %s", fileName);
-
-	fseek(file, 0L, SEEK_END);
-	const POGL_UINT32 sz = ftell(file);
-	fseek(file, 0L, SEEK_SET);
-
-	std::shared_ptr<POGL_BYTE> bytes(new POGL_BYTE[sz], TPOGLDeleteArray<POGL_BYTE>());
-	fread(bytes.get(), 1, sz, file);
-	fclose(file);
-	return POGLXLoadBMPImageFromMemory(context, bytes.get(), sz);
+	POGLMappedFile file(fileName);
+	return POGLXLoadBMPImageFromMemory(context, file.GetBytes(), file.GetSize());
 }
 
 IPOGLTexture2D* POGLXLoadBMPImageFromMemory(IPOGLRenderContext* context, const POGL_BYTE* bytes, POGL_UINT32 size)
@@ -28,27 +113,16 @@ IPOGLTexture2D* POGLXLoadBMPImageFromMemory(IPOGLRenderContext* context, const P
 	assert_not_null(bytes);
 	assert_with_message(size > 0, "You cannot load a non-existing image");
 
-	if (size < 54)
-		THROW_EXCEPTION(POGLResourceException, "Invalid BMP file");
-
-	if (bytes[0] != 'B' || bytes[1] != 'M')
-		THROW_EXCEPTION(POGLResourceException, "Invalid BMP file");
-
-	// Get num bits per pixel
-	const POGL_UINT16 bitsPerPixel = bytes[28];
-
-	// Verify 24 or 32 bit image type
-	if (bitsPerPixel != 24 && bitsPerPixel != 32)
-	{
-		THROW_EXCEPTION(POGLResourceException, "Invalid File Format for file. 24 or 32 bit Image Required.");
-	}
-
-	// Data offset
-	const POGL_UINT32 offset = bytes[10] + (bytes[11] << 8);
+	POGLX_BMP_HEADER header;
+	POGLXReadBMPHeader(bytes, size, &header);
+	const POGL_SIZE& imageSize = header.info.size;
+	const POGL_UINT32 dstPitch = imageSize.width * header.bytesPerPixel;
 
-	// Read image size from header
-	const POGL_SIZE imageSize(*(POGL_INT32*)&(bytes[0x12]), *(POGL_INT32*)&(bytes[0x16]));
+	// Bottom-up images without row padding are uploaded directly from the supplied memory
+	if (!header.flipRows && header.pitch == dstPitch)
+		return context->CreateTexture2D(imageSize, header.info.format, &bytes[header.dataOffset]);
 
-	// Create a texture2D resource
-	return context->CreateTexture2D(imageSize, POGLTextureFormat::BGR, &bytes[offset]);
+	std::unique_ptr<POGL_BYTE[]> imageData(new POGL_BYTE[dstPitch * imageSize.height]);
+	POGLXDecodeBMPImage(header, bytes, POGLXPixelTransform::NONE, imageData.get());
+	return context->CreateTexture2D(imageSize, header.info.format, imageData.get());
 }
@@ -0,0 +1,181 @@
+#include "config.h"
+#include "POGLXCompressedImage.h"
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+	static const POGL_UINT32 DDS_MAGIC = 0x20534444;
+
+	// Header flags
+	static const POGL_UINT32 DDSD_MIPMAPCOUNT = 0x20000;
+
+	// Pixel format flags
+	static const POGL_UINT32 DDPF_ALPHAPIXELS = 0x1;
+	static const POGL_UINT32 DDPF_FOURCC = 0x4;
+
+	// Surface flags
+	static const POGL_UINT32 DDSCAPS2_CUBEMAP = 0x200;
+	static const POGL_UINT32 DDSCAPS2_VOLUME = 0x200000;
+
+	// DXGI formats used by the extended DX10 header
+	static const POGL_UINT32 DXGI_FORMAT_BC1_UNORM = 71;
+	static const POGL_UINT32 DXGI_FORMAT_BC3_UNORM = 77;
+	static const POGL_UINT32 DXGI_FORMAT_BC4_UNORM = 80;
+	static const POGL_UINT32 DXGI_FORMAT_BC5_UNORM = 83;
+	static const POGL_UINT32 DXGI_FORMAT_BC7_UNORM = 98;
+
+	struct POGLX_DDS_PIXELFORMAT
+	{
+		POGL_UINT32 size;
+		POGL_UINT32 flags;
+		POGL_UINT32 fourCC;
+		POGL_UINT32 rgbBitCount;
+		POGL_UINT32 rBitMask;
+		POGL_UINT32 gBitMask;
+		POGL_UINT32 bBitMask;
+		POGL_UINT32 aBitMask;
+	};
+
+	struct POGLX_DDS_HEADER
+	{
+		POGL_UINT32 size;
+		POGL_UINT32 flags;
+		POGL_UINT32 height;
+		POGL_UINT32 width;
+		POGL_UINT32 pitchOrLinearSize;
+		POGL_UINT32 depth;
+		POGL_UINT32 mipMapCount;
+		POGL_UINT32 reserved1[11];
+		POGLX_DDS_PIXELFORMAT pixelFormat;
+		POGL_UINT32 caps;
+		POGL_UINT32 caps2;
+		POGL_UINT32 caps3;
+		POGL_UINT32 caps4;
+		POGL_UINT32 reserved2;
+	};
+
+	struct POGLX_DDS_HEADER_DXT10
+	{
+		POGL_UINT32 dxgiFormat;
+		POGL_UINT32 resourceDimension;
+		POGL_UINT32 miscFlag;
+		POGL_UINT32 arraySize;
+		POGL_UINT32 miscFlags2;
+	};
+
+	inline POGL_UINT32 POGLXFourCC(char a, char b, char c, char d)
+	{
+		return (POGL_UINT32)a | ((POGL_UINT32)b << 8) | ((POGL_UINT32)c << 16) | ((POGL_UINT32)d << 24);
+	}
+
+	POGLTextureFormat::Enum POGLXConvertDXGIFormat(POGL_UINT32 dxgiFormat)
+	{
+		switch (dxgiFormat) {
+		case DXGI_FORMAT_BC1_UNORM:
+			return POGLTextureFormat::BC1_RGBA;
+		case DXGI_FORMAT_BC3_UNORM:
+			return POGLTextureFormat::BC3_RGBA;
+		case DXGI_FORMAT_BC4_UNORM:
+			return POGLTextureFormat::BC4_R;
+		case DXGI_FORMAT_BC5_UNORM:
+			return POGLTextureFormat::BC5_RG;
+		case DXGI_FORMAT_BC7_UNORM:
+			return POGLTextureFormat::BC7_RGBA;
+		default:
+			THROW_EXCEPTION(POGLResourceException, "Unsupported DDS DXGI format: %d", dxgiFormat);
+		}
+	}
+
+	POGLTextureFormat::Enum POGLXConvertFourCC(const POGLX_DDS_PIXELFORMAT& pixelFormat)
+	{
+		const POGL_UINT32 fourCC = pixelFormat.fourCC;
+		if (fourCC == POGLXFourCC('D', 'X', 'T', '1'))
+			return BIT_ISSET(pixelFormat.flags, DDPF_ALPHAPIXELS) ? POGLTextureFormat::BC1_RGBA : POGLTextureFormat::BC1_RGB;
+		if (fourCC == POGLXFourCC('D', 'X', 'T', '5'))
+			return POGLTextureFormat::BC3_RGBA;
+		if (fourCC == POGLXFourCC('A', 'T', 'I', '1') || fourCC == POGLXFourCC('B', 'C', '4', 'U'))
+			return POGLTextureFormat::BC4_R;
+		if (fourCC == POGLXFourCC('A', 'T', 'I', '2') || fourCC == POGLXFourCC('B', 'C', '5', 'U'))
+			return POGLTextureFormat::BC5_RG;
+		THROW_EXCEPTION(POGLResourceException, "Unsupported DDS pixel format: 0x%x", fourCC);
+	}
+}
+
+IPOGLTexture2D* POGLXLoadDDSImageFromFile(IPOGLRenderContext* context, const POGL_CHAR* fileName)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	if (fileName == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid filename");
+
+	POGLMappedFile file(fileName);
+	return POGLXLoadDDSImageFromMemory(context, file.GetBytes(), file.GetSize());
+}
+
+IPOGLTexture2D* POGLXLoadDDSImageFromMemory(IPOGLRenderContext* context, const POGL_BYTE* bytes, POGL_UINT32 size)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	if (bytes == nullptr || size < sizeof(POGL_UINT32) + sizeof(POGLX_DDS_HEADER))
+		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+	POGL_UINT32 magic;
+	memcpy(&magic, bytes, sizeof(magic));
+	if (magic != DDS_MAGIC)
+		THROW_EXCEPTION(POGLResourceException, "Unsupported DDS image");
+
+	POGLX_DDS_HEADER header;
+	memcpy(&header, bytes + sizeof(magic), sizeof(header));
+	if (header.size != sizeof(POGLX_DDS_HEADER) || header.pixelFormat.size != sizeof(POGLX_DDS_PIXELFORMAT))
+		THROW_EXCEPTION(POGLResourceException, "Invalid DDS header");
+
+	if (BIT_ISSET(header.caps2, DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))
+		THROW_EXCEPTION(POGLResourceException, "Only 2D DDS textures are supported");
+
+	if (!BIT_ISSET(header.pixelFormat.flags, DDPF_FOURCC))
+		THROW_EXCEPTION(POGLResourceException, "Only compressed DDS textures are supported");
+
+	POGL_UINT32 offset = sizeof(magic) + sizeof(header);
+	POGLTextureFormat::Enum format;
+	if (header.pixelFormat.fourCC == POGLXFourCC('D', 'X', '1', '0')) {
+		if (size < offset + sizeof(POGLX_DDS_HEADER_DXT10))
+			THROW_EXCEPTION(POGLResourceException, "Invalid DDS header");
+
+		POGLX_DDS_HEADER_DXT10 header10;
+		memcpy(&header10, bytes + offset, sizeof(header10));
+		if (header10.arraySize > 1)
+			THROW_EXCEPTION(POGLResourceException, "Only 2D DDS textures are supported");
+		format = POGLXConvertDXGIFormat(header10.dxgiFormat);
+		offset += sizeof(header10);
+	}
+	else
+		format = POGLXConvertFourCC(header.pixelFormat);
+
+	const POGL_SIZE imageSize((POGL_INT32)header.width, (POGL_INT32)header.height);
+	if (imageSize.width <= 0 || imageSize.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "Invalid DDS texture size: %dx%d", imageSize.width, imageSize.height);
+
+	const POGL_UINT32 mipLevels = BIT_ISSET(header.flags, DDSD_MIPMAPCOUNT) && header.mipMapCount > 0 ? header.mipMapCount : 1;
+
+	//
+	// The mip levels are stored one after another, largest first
+	//
+
+	std::vector<const POGL_BYTE*> levels(mipLevels);
+	POGL_SIZE levelSize = imageSize;
+	for (POGL_UINT32 level = 0; level < mipLevels; ++level) {
+		const POGL_UINT32 levelBytes = POGLXCompressedLevelSize(format, levelSize);
+		if (size < offset || size - offset < levelBytes)
+			THROW_EXCEPTION(POGLResourceException, "The DDS image data is truncated");
+
+		levels[level] = bytes + offset;
+		offset += levelBytes;
+		levelSize.width = (std::max)(1, levelSize.width / 2);
+		levelSize.height = (std::max)(1, levelSize.height / 2);
+	}
+
+	return POGLXCreateCompressedTexture2D(context, imageSize, format, mipLevels, &levels[0]);
+}
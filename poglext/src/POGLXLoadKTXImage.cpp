@@ -0,0 +1,135 @@
+#include "config.h"
+#include "POGLXCompressedImage.h"
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+	static const POGL_BYTE KTX_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+	static const POGL_UINT32 KTX_ENDIANNESS = 0x04030201;
+
+	// OpenGL internal formats supported by the loader
+	static const POGL_UINT32 KTX_COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;
+	static const POGL_UINT32 KTX_COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+	static const POGL_UINT32 KTX_COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+	static const POGL_UINT32 KTX_COMPRESSED_RED_RGTC1 = 0x8DBB;
+	static const POGL_UINT32 KTX_COMPRESSED_RG_RGTC2 = 0x8DBD;
+	static const POGL_UINT32 KTX_COMPRESSED_RGBA_BPTC_UNORM = 0x8E8C;
+	static const POGL_UINT32 KTX_COMPRESSED_RGB8_ETC2 = 0x9274;
+	static const POGL_UINT32 KTX_COMPRESSED_RGBA8_ETC2_EAC = 0x9278;
+
+	struct POGLX_KTX_HEADER
+	{
+		POGL_BYTE identifier[12];
+		POGL_UINT32 endianness;
+		POGL_UINT32 glType;
+		POGL_UINT32 glTypeSize;
+		POGL_UINT32 glFormat;
+		POGL_UINT32 glInternalFormat;
+		POGL_UINT32 glBaseInternalFormat;
+		POGL_UINT32 pixelWidth;
+		POGL_UINT32 pixelHeight;
+		POGL_UINT32 pixelDepth;
+		POGL_UINT32 numberOfArrayElements;
+		POGL_UINT32 numberOfFaces;
+		POGL_UINT32 numberOfMipmapLevels;
+		POGL_UINT32 bytesOfKeyValueData;
+	};
+
+	POGLTextureFormat::Enum POGLXConvertInternalFormat(POGL_UINT32 internalFormat)
+	{
+		switch (internalFormat) {
+		case KTX_COMPRESSED_RGB_S3TC_DXT1:
+			return POGLTextureFormat::BC1_RGB;
+		case KTX_COMPRESSED_RGBA_S3TC_DXT1:
+			return POGLTextureFormat::BC1_RGBA;
+		case KTX_COMPRESSED_RGBA_S3TC_DXT5:
+			return POGLTextureFormat::BC3_RGBA;
+		case KTX_COMPRESSED_RED_RGTC1:
+			return POGLTextureFormat::BC4_R;
+		case KTX_COMPRESSED_RG_RGTC2:
+			return POGLTextureFormat::BC5_RG;
+		case KTX_COMPRESSED_RGBA_BPTC_UNORM:
+			return POGLTextureFormat::BC7_RGBA;
+		case KTX_COMPRESSED_RGB8_ETC2:
+			return POGLTextureFormat::ETC2_RGB8;
+		case KTX_COMPRESSED_RGBA8_ETC2_EAC:
+			return POGLTextureFormat::ETC2_RGBA8;
+		default:
+			THROW_EXCEPTION(POGLResourceException, "Unsupported KTX internal format: 0x%x", internalFormat);
+		}
+	}
+}
+
+IPOGLTexture2D* POGLXLoadKTXImageFromFile(IPOGLRenderContext* context, const POGL_CHAR* fileName)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	if (fileName == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid filename");
+
+	POGLMappedFile file(fileName);
+	return POGLXLoadKTXImageFromMemory(context, file.GetBytes(), file.GetSize());
+}
+
+IPOGLTexture2D* POGLXLoadKTXImageFromMemory(IPOGLRenderContext* context, const POGL_BYTE* bytes, POGL_UINT32 size)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	if (bytes == nullptr || size < sizeof(POGLX_KTX_HEADER))
+		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+	POGLX_KTX_HEADER header;
+	memcpy(&header, bytes, sizeof(header));
+	if (memcmp(header.identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0)
+		THROW_EXCEPTION(POGLResourceException, "Unsupported KTX image");
+
+	if (header.endianness != KTX_ENDIANNESS)
+		THROW_EXCEPTION(POGLResourceException, "KTX images with a different endianness are not supported");
+
+	if (header.glType != 0 || header.glFormat != 0)
+		THROW_EXCEPTION(POGLResourceException, "Only compressed KTX textures are supported");
+
+	if (header.pixelDepth > 1 || header.numberOfArrayElements > 0 || header.numberOfFaces != 1)
+		THROW_EXCEPTION(POGLResourceException, "Only 2D KTX textures are supported");
+
+	const POGLTextureFormat::Enum format = POGLXConvertInternalFormat(header.glInternalFormat);
+	const POGL_SIZE imageSize((POGL_INT32)header.pixelWidth, (POGL_INT32)header.pixelHeight);
+	if (imageSize.width <= 0 || imageSize.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "Invalid KTX texture size: %dx%d", imageSize.width, imageSize.height);
+
+	// Zero mip levels means that the loader should generate them, which is not possible for compressed textures
+	const POGL_UINT32 mipLevels = (std::max)(header.numberOfMipmapLevels, 1U);
+
+	//
+	// Each mip level is prefixed with its size and padded to a multiple of four bytes
+	//
+
+	POGL_UINT32 offset = sizeof(header);
+	if (size - offset < header.bytesOfKeyValueData)
+		THROW_EXCEPTION(POGLResourceException, "The KTX image data is truncated");
+	offset += header.bytesOfKeyValueData;
+
+	std::vector<const POGL_BYTE*> levels(mipLevels);
+	POGL_SIZE levelSize = imageSize;
+	for (POGL_UINT32 level = 0; level < mipLevels; ++level) {
+		if (size < offset || size - offset < sizeof(POGL_UINT32))
+			THROW_EXCEPTION(POGLResourceException, "The KTX image data is truncated");
+
+		POGL_UINT32 imageBytes;
+		memcpy(&imageBytes, bytes + offset, sizeof(imageBytes));
+		offset += sizeof(imageBytes);
+
+		if (imageBytes != POGLXCompressedLevelSize(format, levelSize) || size - offset < imageBytes)
+			THROW_EXCEPTION(POGLResourceException, "Invalid KTX mip level: %d", level);
+
+		levels[level] = bytes + offset;
+		offset += (imageBytes + 3) & ~3U;
+		levelSize.width = (std::max)(1, levelSize.width / 2);
+		levelSize.height = (std::max)(1, levelSize.height / 2);
+	}
+
+	return POGLXCreateCompressedTexture2D(context, imageSize, format, mipLevels, &levels[0]);
+}
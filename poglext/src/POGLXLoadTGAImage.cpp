@@ -1,190 +1,156 @@
 #include "config.h"
+#include "POGLXImageUtils.h"
 #include <memory>
 #include <algorithm>
 
-#define POGL_SWAP(a, b) a ^= b ^= a ^=b
-
-void POGLSwap24(unsigned char* left, unsigned char* right)
-{
-	while (left < right) {
-		unsigned char* l_r = left++;
-		unsigned char* l_g = left++;
-		unsigned char* l_b = left++;
-
-		unsigned char* r_b = right--;
-		unsigned char* r_g = right--;
-		unsigned char* r_r = right--;
-
-		POGL_SWAP(*l_r, *r_r);
-		POGL_SWAP(*l_g, *r_g);
-		POGL_SWAP(*l_b, *r_b);
-	}
-}
-
-void POGLSwap32(unsigned char* left, unsigned char* right)
-{
-	while (left < right) {
-		unsigned char* l_r = left++;
-		unsigned char* l_g = left++;
-		unsigned char* l_b = left++;
-		unsigned char* l_a = left++;
-
-		unsigned char* r_a = right--;
-		unsigned char* r_b = right--;
-		unsigned char* r_g = right--;
-		unsigned char* r_r = right--;
-
-		POGL_SWAP(*l_r, *r_r);
-		POGL_SWAP(*l_g, *r_g);
-		POGL_SWAP(*l_b, *r_b);
-		POGL_SWAP(*l_a, *r_a);
+namespace {
+	static const POGL_UINT32 TGA_HEADER_SIZE = 18;
+	static const POGL_BYTE TGA_UNCOMPRESSED = 2;
+	static const POGL_BYTE TGA_COMPRESSED = 10;
+	static const POGL_BYTE TGA_RIGHT_TO_LEFT = 0x10;
+	static const POGL_BYTE TGA_TOP_TO_BOTTOM = 0x20;
+
+	/*!
+		\brief Information read from the header of a TGA image
+	*/
+	struct POGLX_TGA_HEADER
+	{
+		POGLX_IMAGE_INFO info;
+		POGL_UINT32 bytesPerPixel;
+		POGL_UINT32 dataOffset;
+		bool compressed;
+
+		/* POGLXPixelTransform flags applied to each row */
+		POGL_UINT32 transform;
+
+		/* The rows are stored top to bottom and must be flipped */
+		bool flipRows;
+	};
+
+	void POGLXReadTGAHeader(const POGL_BYTE* bytes, POGL_UINT32 size, POGLX_TGA_HEADER* header)
+	{
+		if (bytes == nullptr || size <= TGA_HEADER_SIZE)
+			THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+		const POGL_BYTE idLength = bytes[0];
+		const POGL_BYTE colorMapType = bytes[1];
+		const POGL_BYTE imageType = bytes[2];
+		if (colorMapType != 0 || (imageType != TGA_UNCOMPRESSED && imageType != TGA_COMPRESSED))
+			THROW_EXCEPTION(POGLResourceException, "Unsupported TGA image");
+
+		const POGL_SIZE imageSize(bytes[13] * 256 + bytes[12], bytes[15] * 256 + bytes[14]);
+		const POGL_UINT32 bpp = (POGL_UINT32)bytes[16];
+		if (imageSize.width <= 0 || imageSize.height <= 0 || (bpp != 24 && bpp != 32))
+			THROW_EXCEPTION(POGLResourceException, "Invalid TGA texture information");
+
+		if ((POGL_UINT64)imageSize.width * imageSize.height * (bpp / 8) > (POGL_UINT64)BIT_ALL)
+			THROW_EXCEPTION(POGLResourceException, "TGA image is too large: %dx%d", imageSize.width, imageSize.height);
+
+		header->info.size = imageSize;
+		header->info.format = bpp == 24 ? POGLTextureFormat::BGR : POGLTextureFormat::BGRA;
+		header->bytesPerPixel = bpp / 8;
+		header->dataOffset = TGA_HEADER_SIZE + idLength;
+		if (header->dataOffset >= size)
+			THROW_EXCEPTION(POGLResourceException, "Unexpected end of TGA data");
+		header->compressed = imageType == TGA_COMPRESSED;
+
+		//
+		// Images have always been uploaded bottom row first with each row stored from right to left. Rearrange the pixels
+		// of images stored in any other orientation to match that.
+		//
+
+		const POGL_BYTE descriptor = bytes[17];
+		header->transform = (descriptor & TGA_RIGHT_TO_LEFT) ? POGLXPixelTransform::NONE : POGLXPixelTransform::MIRROR;
+		header->flipRows = (descriptor & TGA_TOP_TO_BOTTOM) != 0;
 	}
-}
 
-IPOGLTexture2D* POGLXLoadCompressedTGAImageFromMemory(IPOGLRenderContext* context, POGL_BYTE* bytes)
-{
-	const POGL_SIZE imageSize(bytes[1] * 256 + bytes[0], bytes[3] * 256 + bytes[2]);
-	const POGL_UINT32 bpp = (POGL_UINT32)bytes[4];
-	const POGLTextureFormat::Enum textureFormat = bpp == 24 ? POGLTextureFormat::BGR : POGLTextureFormat::BGRA;
-	const POGL_BYTE* imageData = bytes + 6;
-
-	if (imageSize.width <= 0 || imageSize.height <= 0 || (bpp != 24 && bpp != 32)) {
-		THROW_EXCEPTION(POGLResourceException, "Invalid TGA texture information");
-	}
-
-	const POGL_UINT32 bytesPerPixel = bpp / 8;
-	const POGL_UINT32 imageDataSize = imageSize.width * imageSize.height * bytesPerPixel;
-	std::shared_ptr<unsigned char> _imageDataBytes(new unsigned char[imageDataSize], TPOGLDeleteArray<unsigned char>());
-	unsigned char* imageDataBytes = _imageDataBytes.get();
-	unsigned char colorBuffer[4] = { 0, 0, 0, 0 };
-
-	const POGL_UINT32 pixelCount = imageSize.width * imageSize.height;
-	POGL_UINT32 currentPixel = 0;
-	POGL_UINT32 currentByte = 0;
-	const POGL_BYTE* ptr = imageData;
-	do {
-		unsigned char chunkHeader = *ptr++;
-		if (chunkHeader < 128) {
-			chunkHeader++;
-			for (unsigned char counter = 0; counter < chunkHeader; ++counter) {
-				colorBuffer[0] = *ptr++;
-				colorBuffer[1] = *ptr++;
-				colorBuffer[2] = *ptr++;
-				if (bpp == 32)
-					colorBuffer[3] = *ptr++;
-
-				imageDataBytes[currentByte++] = colorBuffer[0];
-				imageDataBytes[currentByte++] = colorBuffer[1];
-				imageDataBytes[currentByte++] = colorBuffer[2];
-				if (bpp == 32)
-					imageDataBytes[currentByte++] = colorBuffer[3];
-				currentPixel++;
-				if (currentPixel > pixelCount)
-					THROW_EXCEPTION(POGLResourceException, "Too many pixels read");
+	/*!
+		\brief Decode the run-length encoded pixels into the destination. Runs of repeated pixels are filled and runs of
+			raw pixels are copied as a whole
+	*/
+	void POGLXDecodeTGARunLengths(const POGLX_TGA_HEADER& header, const POGL_BYTE* bytes, POGL_UINT32 size, POGL_BYTE* dst)
+	{
+		const POGL_UINT32 bytesPerPixel = header.bytesPerPixel;
+		const POGL_BYTE* ptr = bytes + header.dataOffset;
+		const POGL_BYTE* const end = bytes + size;
+		POGL_BYTE* out = dst;
+		POGL_BYTE* const outEnd = dst + header.info.size.width * header.info.size.height * bytesPerPixel;
+
+		while (out < outEnd) {
+			if (ptr >= end)
+				THROW_EXCEPTION(POGLResourceException, "Unexpected end of TGA data");
+
+			const POGL_BYTE chunkHeader = *ptr++;
+			const POGL_UINT32 count = (chunkHeader & 0x7F) + 1;
+			const POGL_UINT32 runSize = count * bytesPerPixel;
+			if (runSize > (POGL_UINT32)(outEnd - out))
+				THROW_EXCEPTION(POGLResourceException, "Too many pixels read");
+
+			if (chunkHeader & 0x80) {
+				if (bytesPerPixel > (POGL_UINT32)(end - ptr))
+					THROW_EXCEPTION(POGLResourceException, "Unexpected end of TGA data");
+				POGLXFillPixels(out, ptr, bytesPerPixel, count);
+				ptr += bytesPerPixel;
 			}
-		}
-		else {
-			chunkHeader -= 127;
-			colorBuffer[0] = *ptr++;
-			colorBuffer[1] = *ptr++;
-			colorBuffer[2] = *ptr++;
-			if (bpp == 32)
-				colorBuffer[3] = *ptr++;
-
-			for (unsigned char counter = 0; counter < chunkHeader; ++counter) {
-				imageDataBytes[currentByte++] = colorBuffer[0];
-				imageDataBytes[currentByte++] = colorBuffer[1];
-				imageDataBytes[currentByte++] = colorBuffer[2];
-				if (bpp == 32)
-					imageDataBytes[currentByte++] = colorBuffer[3];
-				currentPixel++;
-				if (currentPixel > pixelCount)
-					THROW_EXCEPTION(POGLResourceException, "Too many pixels read");
+			else {
+				if (runSize > (POGL_UINT32)(end - ptr))
+					THROW_EXCEPTION(POGLResourceException, "Unexpected end of TGA data");
+				memcpy(out, ptr, runSize);
+				ptr += runSize;
 			}
+			out += runSize;
 		}
-	} while (currentPixel < pixelCount);
-
-	const POGL_UINT32 orientation = (POGL_UINT32)bytes[5] & 0x30;
-	if (orientation == 0x20) {
-		THROW_NOT_IMPLEMENTED_EXCEPTION();
 	}
-	else if (orientation == 0) {
-		for (POGL_INT32 h = 0; h < imageSize.height; ++h) {
-			unsigned char* left = &imageDataBytes[imageSize.width * h * bytesPerPixel];
-			unsigned char* right = &imageDataBytes[imageSize.width * h * bytesPerPixel + (imageSize.height * bytesPerPixel - 1)];
-			if (bpp == 24) {
-				POGLSwap24(left, right);
-			}
-			else if (bpp == 32) {
-				POGLSwap32(left, right);
+
+	void POGLXDecodeTGAImage(const POGLX_TGA_HEADER& header, const POGL_BYTE* bytes, POGL_UINT32 size, POGL_UINT32 transform, POGL_BYTE* dst)
+	{
+		const POGL_SIZE& imageSize = header.info.size;
+		const POGL_UINT32 bytesPerPixel = header.bytesPerPixel;
+		const POGL_UINT32 pitch = imageSize.width * bytesPerPixel;
+
+		if (header.compressed) {
+			// The rows are rearranged in place after they are decoded
+			POGLXDecodeTGARunLengths(header, bytes, size, dst);
+			if (header.flipRows)
+				POGLXFlipRows(dst, imageSize, bytesPerPixel);
+			if (transform != POGLXPixelTransform::NONE) {
+				for (POGL_INT32 y = 0; y < imageSize.height; ++y)
+					POGLXTransformPixels(dst + y * pitch, imageSize.width, bytesPerPixel, transform);
 			}
+			return;
 		}
-	}
-
-	return context->CreateTexture2D(imageSize, textureFormat, imageDataBytes);
-}
 
-IPOGLTexture2D* POGLXLoadUncompressedTGAImageFromMemory(IPOGLRenderContext* context, POGL_BYTE* bytes)
-{
-	const POGL_SIZE imageSize(bytes[1] * 256 + bytes[0], bytes[3] * 256 + bytes[2]);
-	const POGL_UINT32 bpp = (POGL_UINT32)bytes[4];
-	const POGL_UINT32 bytesPerPixel = bpp / 8;
-	const POGLTextureFormat::Enum textureFormat = bpp == 24 ? POGLTextureFormat::BGR : POGLTextureFormat::BGRA;
-	POGL_BYTE* imageData = bytes + 6;
-
-	if (imageSize.width <= 0 || imageSize.height <= 0 || (bpp != 24 && bpp != 32)) {
-		THROW_EXCEPTION(POGLResourceException, "Invalid TGA texture information");
-	}
+		if (pitch * imageSize.height > size - header.dataOffset)
+			THROW_EXCEPTION(POGLResourceException, "Unexpected end of TGA data");
 
-	const POGL_UINT32 orientation = (POGL_UINT32)bytes[5] & 0x30;
-	if (orientation == 0x20) {
-		THROW_NOT_IMPLEMENTED_EXCEPTION();
-	}
-	else if (orientation == 0) {
-		for (POGL_INT32 h = 0; h < imageSize.height; ++h) {
-			unsigned char* left = &imageData[imageSize.width * h * bytesPerPixel];
-			unsigned char* right = &imageData[imageSize.width * h * bytesPerPixel + (imageSize.height * bytesPerPixel - 1)];
-			if (bpp == 24) {
-				POGLSwap24(left, right);
-			}
-			else if (bpp == 32) {
-				POGLSwap32(left, right);
-			}
+		// Uncompressed rows are rearranged while they are copied into the destination
+		const POGL_BYTE* src = bytes + header.dataOffset;
+		for (POGL_INT32 y = 0; y < imageSize.height; ++y) {
+			const POGL_INT32 dy = header.flipRows ? imageSize.height - y - 1 : y;
+			POGLXCopyPixels(dst + dy * pitch, src + y * pitch, imageSize.width, bytesPerPixel, transform);
 		}
 	}
-
-	return context->CreateTexture2D(imageSize, textureFormat, imageData);
 }
 
-IPOGLTexture2D* POGLXLoadInternalTGAImageFromMemory(IPOGLRenderContext* context, POGL_BYTE* bytes, POGL_UINT32 size)
+void POGLXGetTGAImageInfo(const POGL_BYTE* bytes, POGL_UINT32 size, POGLX_IMAGE_INFO* info)
 {
-	if (context == nullptr)
-		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
-
-	if (bytes == nullptr || size <= 18)
-		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
-
-	// Read header
-	POGL_BYTE* header = bytes;
-
-	// If the file is not compressed
-	static char UNCOMPRESSED[12] = { 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	if (info == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid image info");
 
-	// If the file is compressed
-	static char ISCOMPRESSED[12] = { 0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-
-	// Move the pointer beyond the header
-	POGL_BYTE* data = bytes + 12;
+	POGLX_TGA_HEADER header;
+	POGLXReadTGAHeader(bytes, size, &header);
+	*info = header.info;
+}
 
-	// Load compressed- or uncompressed TGA file
-	if (std::memcmp(UNCOMPRESSED, header, sizeof(UNCOMPRESSED)) == 0) {
-		return POGLXLoadUncompressedTGAImageFromMemory(context, data);
-	}
-	else if (std::memcmp(ISCOMPRESSED, header, sizeof(ISCOMPRESSED)) == 0) {
-		return POGLXLoadCompressedTGAImageFromMemory(context, data);
-	}
+void POGLXDecodeTGAImage(const POGL_BYTE* bytes, POGL_UINT32 size, POGLTextureFormat::Enum format, void* dst)
+{
+	if (dst == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid destination");
 
-	THROW_EXCEPTION(POGLResourceException, "Unsupported TGA image");
+	POGLX_TGA_HEADER header;
+	POGLXReadTGAHeader(bytes, size, &header);
+	const POGL_UINT32 transform = header.transform | POGLXSwizzleTransform(header.info.format, format);
+	POGLXDecodeTGAImage(header, bytes, size, transform, (POGL_BYTE*)dst);
 }
 
 /*!
@@ -198,19 +164,8 @@ IPOGLTexture2D* POGLXLoadTGAImageFromFile(IPOGLRenderContext* context, const POG
 	if (fileName == nullptr)
 		THROW_EXCEPTION(POGLResourceException, "You must supply a valid filename");
 
-	// Open file
-	FILE* file = open_file(fileName, POGL_TOCHAR("rb"));
-	if (file == nullptr)
-		THROW_EXCEPTION(POGLResourceException, "File not found: %s", fileName);
-
-	fseek(file, 0L, SEEK_END);
-	const POGL_UINT32 sz = ftell(file);
-	fseek(file, 0L, SEEK_SET);
-
-	std::shared_ptr<POGL_BYTE> bytes(new POGL_BYTE[sz], TPOGLDeleteArray<POGL_BYTE>());
-	fread(bytes.get(), 1, sz, file);
-	fclose(file);
-	return POGLXLoadTGAImageFromMemory(context, bytes.get(), sz);
+	POGLMappedFile file(fileName);
+	return POGLXLoadTGAImageFromMemory(context, file.GetBytes(), file.GetSize());
 }
 
 IPOGLTexture2D* POGLXLoadTGAImageFromMemory(IPOGLRenderContext* context, const POGL_BYTE* bytes, POGL_UINT32 size)
@@ -218,10 +173,19 @@ IPOGLTexture2D* POGLXLoadTGAImageFromMemory(IPOGLRenderContext* context, const P
 	if (context == nullptr)
 		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
 
-	if (bytes == nullptr || size <= 18)
-		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+	POGLX_TGA_HEADER header;
+	POGLXReadTGAHeader(bytes, size, &header);
+	const POGL_SIZE& imageSize = header.info.size;
+	const POGL_UINT32 imageDataSize = imageSize.width * imageSize.height * header.bytesPerPixel;
+
+	// Uncompressed images that are already stored the way they are uploaded are uploaded directly from the supplied memory
+	if (!header.compressed && !header.flipRows && header.transform == POGLXPixelTransform::NONE) {
+		if (imageDataSize > size - header.dataOffset)
+			THROW_EXCEPTION(POGLResourceException, "Unexpected end of TGA data");
+		return context->CreateTexture2D(imageSize, header.info.format, bytes + header.dataOffset);
+	}
 
-	std::shared_ptr<POGL_BYTE> copiedBytes(new POGL_BYTE[size], TPOGLDeleteArray<POGL_BYTE>());
-	memcpy(copiedBytes.get(), bytes, size);
-	return POGLXLoadInternalTGAImageFromMemory(context, copiedBytes.get(), size);
+	std::unique_ptr<POGL_BYTE[]> imageData(new POGL_BYTE[imageDataSize]);
+	POGLXDecodeTGAImage(header, bytes, size, header.transform, imageData.get());
+	return context->CreateTexture2D(imageSize, header.info.format, imageData.get());
 }
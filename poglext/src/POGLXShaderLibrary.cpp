@@ -0,0 +1,235 @@
+#include "POGLXShaderLibrary.h"
+#include <algorithm>
+
+namespace {
+	const POGL_CHAR* WHITESPACE = POGL_TOCHAR(" \t\r\n");
+
+	POGL_STRING Trim(const POGL_STRING& str) {
+		const size_t first = str.find_first_not_of(WHITESPACE);
+		if (first == POGL_STRING::npos)
+			return POGL_STRING();
+		const size_t last = str.find_last_not_of(WHITESPACE);
+		return str.substr(first, last - first + 1);
+	}
+
+	/*!
+		\brief Check to see if the supplied line is the supplied preprocessor directive and retrieve the rest of the line
+	*/
+	bool IsDirective(const POGL_STRING& line, const POGL_STRING& directive, POGL_STRING* _out_Arguments) {
+		const POGL_STRING trimmed = Trim(line);
+		if (trimmed.compare(0, directive.length(), directive) != 0)
+			return false;
+		if (trimmed.length() > directive.length()) {
+			const POGL_CHAR next = trimmed[directive.length()];
+			if (next != POGL_TOCHAR(' ') && next != POGL_TOCHAR('\t') && next != POGL_TOCHAR('"') && next != POGL_TOCHAR('<'))
+				return false;
+		}
+		*_out_Arguments = Trim(trimmed.substr(directive.length()));
+		return true;
+	}
+}
+
+POGLXShaderLibrary::POGLXShaderLibrary(IPOGLRenderContext* context)
+: mRefCount(1), mContext(context), mNumRequests(0)
+{
+	mContext->AddRef();
+}
+
+POGLXShaderLibrary::~POGLXShaderLibrary()
+{
+	auto it = mVariants.begin();
+	auto end = mVariants.end();
+	for (; it != end; ++it) {
+		it->second->Release();
+	}
+	POGL_SAFE_RELEASE(mContext);
+}
+
+void POGLXShaderLibrary::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLXShaderLibrary::Release()
+{
+	if (--mRefCount == 0) {
+		delete this;
+	}
+}
+
+void POGLXShaderLibrary::AddSource(const POGL_CHAR* name, const POGL_CHAR* memory, POGL_UINT32 size)
+{
+	if (name == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a name for the shader source");
+
+	if (memory == nullptr || size == 0)
+		THROW_EXCEPTION(POGLResourceException, "You must supply valid shader source code for: %s", name);
+
+	mSources[POGL_STRING(name)] = POGL_STRING(memory, size);
+
+	// The new source might be included by sources that are already expanded
+	mExpandedSources.clear();
+}
+
+void POGLXShaderLibrary::AddSourceFromFile(const POGL_CHAR* name, const POGL_CHAR* fileName)
+{
+	POGLMappedFile file(fileName);
+	const POGL_BYTE* bytes = file.GetBytes();
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "Could not read the shader source file: %s", fileName);
+
+	const POGL_STRING source(bytes, bytes + file.GetSize());
+	AddSource(name, source.c_str(), source.length());
+}
+
+IPOGLShader* POGLXShaderLibrary::GetShader(const POGL_CHAR* name, POGLShaderType::Enum type, const POGL_CHAR* defines)
+{
+	if (name == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply the name of a shader source");
+
+	mNumRequests++;
+
+	Defines parsedDefines;
+	ParseDefines(defines, &parsedDefines);
+
+	//
+	// The key is the source name, the shader type and the normalized defines
+	//
+
+	POGL_STRINGSTREAM key;
+	key << name << POGL_TOCHAR('|') << (POGL_UINT32)type << POGL_TOCHAR('|');
+	auto define = parsedDefines.begin();
+	for (; define != parsedDefines.end(); ++define) {
+		key << define->first;
+		if (!define->second.empty())
+			key << POGL_TOCHAR('=') << define->second;
+		key << POGL_TOCHAR(';');
+	}
+
+	const POGL_STRING variantKey = key.str();
+	auto it = mVariants.find(variantKey);
+	if (it != mVariants.end()) {
+		it->second->AddRef();
+		return it->second;
+	}
+
+	const POGL_STRING source = BuildVariantSource(GetExpandedSource(POGL_STRING(name)), parsedDefines);
+	IPOGLShader* shader = mContext->CreateShaderFromMemory(source.c_str(), source.length(), type);
+	mVariants.insert(std::make_pair(variantKey, shader));
+	shader->AddRef();
+	return shader;
+}
+
+POGL_UINT32 POGLXShaderLibrary::GetNumVariants() const
+{
+	return mVariants.size();
+}
+
+POGL_UINT32 POGLXShaderLibrary::GetNumRequests() const
+{
+	return mNumRequests;
+}
+
+void POGLXShaderLibrary::ParseDefines(const POGL_CHAR* defines, Defines* _out_Defines)
+{
+	if (defines == nullptr)
+		return;
+
+	POGL_STRINGSTREAM ss(defines);
+	POGL_STRING entry;
+	while (std::getline(ss, entry, POGL_TOCHAR(';'))) {
+		const size_t separator = entry.find(POGL_TOCHAR('='));
+		const POGL_STRING name = Trim(entry.substr(0, separator));
+		const POGL_STRING value = separator != POGL_STRING::npos ? Trim(entry.substr(separator + 1)) : POGL_STRING();
+		if (name.empty())
+			continue;
+
+		auto it = _out_Defines->find(name);
+		if (it == _out_Defines->end())
+			_out_Defines->insert(std::make_pair(name, value));
+		else if (it->second != value)
+			THROW_EXCEPTION(POGLResourceException, "The define %s is given two different values: '%s' and '%s'", name.c_str(), it->second.c_str(), value.c_str());
+	}
+}
+
+const POGL_STRING& POGLXShaderLibrary::GetExpandedSource(const POGL_STRING& name)
+{
+	auto it = mExpandedSources.find(name);
+	if (it != mExpandedSources.end())
+		return it->second;
+
+	std::set<POGL_STRING> included;
+	included.insert(name);
+	POGL_STRING source;
+	ExpandSource(name, &included, &source);
+	return mExpandedSources.insert(std::make_pair(name, source)).first->second;
+}
+
+void POGLXShaderLibrary::ExpandSource(const POGL_STRING& name, std::set<POGL_STRING>* included, POGL_STRING* _out_Source)
+{
+	auto it = mSources.find(name);
+	if (it == mSources.end())
+		THROW_EXCEPTION(POGLResourceException, "There is no shader source named: %s", name.c_str());
+
+	const POGL_STRING includeDirective(POGL_TOCHAR("#include"));
+	POGL_STRINGSTREAM ss(it->second);
+	POGL_STRING line;
+	while (std::getline(ss, line)) {
+		POGL_STRING arguments;
+		if (!IsDirective(line, includeDirective, &arguments)) {
+			_out_Source->append(line);
+			_out_Source->push_back(POGL_TOCHAR('\n'));
+			continue;
+		}
+
+		// #include "name" or #include <name>
+		if (arguments.length() < 2 || !((arguments.front() == POGL_TOCHAR('"') && arguments.back() == POGL_TOCHAR('"')) ||
+			(arguments.front() == POGL_TOCHAR('<') && arguments.back() == POGL_TOCHAR('>'))))
+			THROW_EXCEPTION(POGLResourceException, "Invalid include directive in the shader source %s: %s", name.c_str(), line.c_str());
+
+		const POGL_STRING includeName = arguments.substr(1, arguments.length() - 2);
+		if (included->insert(includeName).second)
+			ExpandSource(includeName, included, _out_Source);
+	}
+}
+
+POGL_STRING POGLXShaderLibrary::BuildVariantSource(const POGL_STRING& source, const Defines& defines)
+{
+	POGL_STRINGSTREAM header;
+	auto it = defines.begin();
+	for (; it != defines.end(); ++it) {
+		header << POGL_TOCHAR("#define ") << it->first;
+		if (!it->second.empty())
+			header << POGL_TOCHAR(' ') << it->second;
+		header << POGL_TOCHAR('\n');
+	}
+
+	// The #version directive must come before anything else in the shader
+	const POGL_STRING versionDirective(POGL_TOCHAR("#version"));
+	size_t lineStart = 0;
+	while (lineStart < source.length()) {
+		size_t lineEnd = source.find(POGL_TOCHAR('\n'), lineStart);
+		if (lineEnd == POGL_STRING::npos)
+			lineEnd = source.length();
+
+		POGL_STRING arguments;
+		if (IsDirective(source.substr(lineStart, lineEnd - lineStart), versionDirective, &arguments)) {
+			const size_t insertAt = (std::min)(lineEnd + 1, source.length());
+			POGL_STRING result = source.substr(0, insertAt);
+			if (lineEnd == source.length())
+				result.push_back(POGL_TOCHAR('\n'));
+			return result + header.str() + source.substr(insertAt);
+		}
+		lineStart = lineEnd + 1;
+	}
+
+	return header.str() + source;
+}
+
+IPOGLXShaderLibrary* POGLXCreateShaderLibrary(IPOGLRenderContext* context)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	return new POGLXShaderLibrary(context);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "config.h"
+#include <set>
+#include <map>
+
+class POGLXShaderLibrary : public IPOGLXShaderLibrary
+{
+	typedef std::hash_map<POGL_STRING, POGL_STRING> Sources;
+	typedef std::hash_map<POGL_STRING, IPOGLShader*> Variants;
+	typedef std::map<POGL_STRING, POGL_STRING> Defines;
+
+public:
+	POGLXShaderLibrary(IPOGLRenderContext* context);
+	virtual ~POGLXShaderLibrary();
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+// IPOGLXShaderLibrary
+public:
+	virtual void AddSource(const POGL_CHAR* name, const POGL_CHAR* memory, POGL_UINT32 size);
+	virtual void AddSourceFromFile(const POGL_CHAR* name, const POGL_CHAR* fileName);
+	virtual IPOGLShader* GetShader(const POGL_CHAR* name, POGLShaderType::Enum type, const POGL_CHAR* defines);
+	virtual POGL_UINT32 GetNumVariants() const;
+	virtual POGL_UINT32 GetNumRequests() const;
+
+private:
+	/*!
+		\brief Parse the supplied define list into a sorted set of unique defines
+
+		\throws POGLResourceException
+				If a define is given two different values
+	*/
+	static void ParseDefines(const POGL_CHAR* defines, Defines* _out_Defines);
+
+	/*!
+		\brief Retrieves the source code with all includes resolved. The result is kept until a source is added
+	*/
+	const POGL_STRING& GetExpandedSource(const POGL_STRING& name);
+
+	/*!
+		\brief Append the supplied source to the result, replacing each include directive with the included source
+
+		\param name
+		\param included
+				The sources already included into the result. Each source is included at most once
+		\param _out_Source
+	*/
+	void ExpandSource(const POGL_STRING& name, std::set<POGL_STRING>* included, POGL_STRING* _out_Source);
+
+	/*!
+		\brief Build the source code of a variant by adding the defines after the #version directive of the supplied source
+	*/
+	static POGL_STRING BuildVariantSource(const POGL_STRING& source, const Defines& defines);
+
+private:
+	REF_COUNTER mRefCount;
+	IPOGLRenderContext* mContext;
+
+	Sources mSources;
+	Sources mExpandedSources;
+	Variants mVariants;
+	POGL_UINT32 mNumRequests;
+};
@@ -0,0 +1,102 @@
+#include "POGLXSkylinePacker.h"
+#include <climits>
+#include <algorithm>
+
+POGLXSkylinePacker::POGLXSkylinePacker(const POGL_SIZE& size)
+: mSize(size)
+{
+	const POGLXSkylineNode ground = { 0, 0, size.width };
+	mSkyline.push_back(ground);
+}
+
+POGLXSkylinePacker::~POGLXSkylinePacker()
+{
+}
+
+bool POGLXSkylinePacker::Insert(const POGL_SIZE& size, POGL_RECT* _out_rect)
+{
+	POGL_INT32 bestTop = INT_MAX;
+	POGL_INT32 bestWidth = INT_MAX;
+	POGL_INT32 bestY = 0;
+	size_t bestIndex = mSkyline.size();
+
+	const size_t numNodes = mSkyline.size();
+	for (size_t i = 0; i < numNodes; ++i) {
+		POGL_INT32 y;
+		if (!Fit(i, size, &y))
+			continue;
+
+		// Prefer the lowest top edge. Use the narrowest node to break ties, which leaves wider gaps for larger rectangles
+		const POGL_INT32 top = y + size.height;
+		if (top < bestTop || (top == bestTop && mSkyline[i].width < bestWidth)) {
+			bestTop = top;
+			bestWidth = mSkyline[i].width;
+			bestY = y;
+			bestIndex = i;
+		}
+	}
+
+	if (bestIndex == mSkyline.size())
+		return false;
+
+	*_out_rect = POGL_RECT(mSkyline[bestIndex].x, bestY, size.width, size.height);
+	AddSkylineLevel(bestIndex, *_out_rect);
+	return true;
+}
+
+bool POGLXSkylinePacker::Fit(size_t index, const POGL_SIZE& size, POGL_INT32* _out_y) const
+{
+	if (mSkyline[index].x + size.width > mSize.width)
+		return false;
+
+	// The rectangle rests on the highest node below it
+	POGL_INT32 y = 0;
+	POGL_INT32 widthLeft = size.width;
+	for (size_t i = index; widthLeft > 0; ++i) {
+		y = (std::max)(y, mSkyline[i].y);
+		if (y + size.height > mSize.height)
+			return false;
+		widthLeft -= mSkyline[i].width;
+	}
+
+	*_out_y = y;
+	return true;
+}
+
+void POGLXSkylinePacker::AddSkylineLevel(size_t index, const POGL_RECT& rect)
+{
+	const POGLXSkylineNode node = { rect.x, rect.y + rect.height, rect.width };
+	mSkyline.insert(mSkyline.begin() + index, node);
+
+	//
+	// Shrink or remove the nodes now covered by the new node
+	//
+
+	for (size_t i = index + 1; i < mSkyline.size();) {
+		const POGL_INT32 previousRight = mSkyline[i - 1].x + mSkyline[i - 1].width;
+		POGLXSkylineNode& current = mSkyline[i];
+		if (current.x >= previousRight)
+			break;
+
+		const POGL_INT32 shrink = previousRight - current.x;
+		if (current.width > shrink) {
+			current.x += shrink;
+			current.width -= shrink;
+			break;
+		}
+		mSkyline.erase(mSkyline.begin() + i);
+	}
+
+	//
+	// Merge neighbouring nodes at the same height
+	//
+
+	for (size_t i = 0; i + 1 < mSkyline.size();) {
+		if (mSkyline[i].y == mSkyline[i + 1].y) {
+			mSkyline[i].width += mSkyline[i + 1].width;
+			mSkyline.erase(mSkyline.begin() + i + 1);
+		}
+		else
+			++i;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "config.h"
+#include <vector>
+
+/*!
+	\brief Packs rectangles into an area using the skyline bottom-left heuristic
+
+	The packer keeps track of the top edge, the skyline, of all rectangles packed so far. Each new rectangle is placed where its top
+	edge ends up as low as possible. Rectangles are packed as they arrive, so the packer works without knowing all rectangles up front.
+*/
+class POGLXSkylinePacker
+{
+	struct POGLXSkylineNode
+	{
+		POGL_INT32 x;
+		POGL_INT32 y;
+		POGL_INT32 width;
+	};
+
+public:
+	POGLXSkylinePacker(const POGL_SIZE& size);
+	~POGLXSkylinePacker();
+
+	/*!
+		\brief Find room for a rectangle of the supplied size
+
+		\param size
+				The size of the rectangle
+		\param _out_rect
+				The location of the rectangle
+		\return true if the rectangle fits; false otherwise
+	*/
+	bool Insert(const POGL_SIZE& size, POGL_RECT* _out_rect);
+
+private:
+	/*!
+		\brief Check to see if a rectangle of the supplied size fits with its left edge on the supplied skyline node
+
+		\param _out_y
+				The lowest position of the rectangle's bottom edge
+	*/
+	bool Fit(size_t index, const POGL_SIZE& size, POGL_INT32* _out_y) const;
+
+	/*!
+		\brief Raise the skyline over the supplied rectangle, which starts at the supplied skyline node
+	*/
+	void AddSkylineLevel(size_t index, const POGL_RECT& rect);
+
+private:
+	POGL_SIZE mSize;
+	std::vector<POGLXSkylineNode> mSkyline;
+};
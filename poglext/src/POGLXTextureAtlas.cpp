@@ -0,0 +1,153 @@
+#include "POGLXTextureAtlas.h"
+#include "POGLXImageUtils.h"
+#include <cstring>
+#include <algorithm>
+
+POGLXTextureAtlas::POGLXTextureAtlas(IPOGLRenderContext* context, const POGL_SIZE& pageSize, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, POGL_UINT32 padding)
+: mRefCount(1), mContext(context), mPageSize(pageSize), mFormat(format), mMipLevels(mipLevels), mPadding(padding), mBytesPerPixel(POGLXBytesPerPixel(format))
+{
+	mContext->AddRef();
+}
+
+POGLXTextureAtlas::~POGLXTextureAtlas()
+{
+	for (size_t i = 0; i < mPages.size(); ++i) {
+		POGL_SAFE_RELEASE(mPages[i].texture);
+	}
+	POGL_SAFE_RELEASE(mContext);
+}
+
+void POGLXTextureAtlas::AddRef()
+{
+	mRefCount++;
+}
+
+void POGLXTextureAtlas::Release()
+{
+	if (--mRefCount == 0) {
+		delete this;
+	}
+}
+
+POGL_UINT32 POGLXTextureAtlas::Insert(const POGL_SIZE& size, const void* bytes)
+{
+	if (bytes == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply valid image data");
+
+	if (size.width <= 0 || size.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot insert an image with the size: %dx%d", size.width, size.height);
+
+	const POGL_INT32 padding = (POGL_INT32)mPadding;
+	const POGL_SIZE paddedSize(size.width + 2 * padding, size.height + 2 * padding);
+	if (paddedSize.width > mPageSize.width || paddedSize.height > mPageSize.height)
+		THROW_EXCEPTION(POGLResourceException, "The image %dx%d, including padding, does not fit into a page of size %dx%d",
+			size.width, size.height, mPageSize.width, mPageSize.height);
+
+	//
+	// Try the existing pages before creating a new one
+	//
+
+	POGL_RECT rect;
+	POGL_UINT32 page = 0;
+	const POGL_UINT32 numPages = mPages.size();
+	for (; page < numPages; ++page) {
+		if (mPages[page].packer.Insert(paddedSize, &rect))
+			break;
+	}
+
+	if (page == numPages) {
+		IPOGLTexture2D* texture = mContext->CreateTexture2D(mPageSize, mFormat, mMipLevels, nullptr);
+		mPages.push_back(POGLXAtlasPage(texture, mPageSize));
+		mPages[page].packer.Insert(paddedSize, &rect);
+	}
+
+	const POGL_BYTE* image = padding > 0 ? PadImage(size, (const POGL_BYTE*)bytes) : (const POGL_BYTE*)bytes;
+	mContext->UpdateTexture2D(mPages[page].texture, rect, 0, image);
+	mPages[page].dirty = true;
+
+	POGLX_ATLAS_ENTRY entry;
+	entry.page = page;
+	entry.rect = POGL_RECT(rect.x + padding, rect.y + padding, size.width, size.height);
+	entry.uvMin = POGL_VECTOR2((POGL_FLOAT)entry.rect.x / (POGL_FLOAT)mPageSize.width, (POGL_FLOAT)entry.rect.y / (POGL_FLOAT)mPageSize.height);
+	entry.uvMax = POGL_VECTOR2((POGL_FLOAT)(entry.rect.x + entry.rect.width) / (POGL_FLOAT)mPageSize.width,
+		(POGL_FLOAT)(entry.rect.y + entry.rect.height) / (POGL_FLOAT)mPageSize.height);
+	mEntries.push_back(entry);
+	return mEntries.size() - 1;
+}
+
+const POGLX_ATLAS_ENTRY& POGLXTextureAtlas::GetEntry(POGL_UINT32 index) const
+{
+	if (index >= mEntries.size())
+		THROW_EXCEPTION(POGLResourceException, "There is no atlas entry at index: %d", index);
+
+	return mEntries[index];
+}
+
+POGL_UINT32 POGLXTextureAtlas::GetNumEntries() const
+{
+	return mEntries.size();
+}
+
+POGL_UINT32 POGLXTextureAtlas::GetNumPages() const
+{
+	return mPages.size();
+}
+
+IPOGLTexture2D* POGLXTextureAtlas::GetPage(POGL_UINT32 index)
+{
+	if (index >= mPages.size())
+		THROW_EXCEPTION(POGLResourceException, "There is no atlas page at index: %d", index);
+
+	IPOGLTexture2D* texture = mPages[index].texture;
+	texture->AddRef();
+	return texture;
+}
+
+void POGLXTextureAtlas::GenerateMipmaps()
+{
+	const POGL_UINT32 numPages = mPages.size();
+	for (POGL_UINT32 i = 0; i < numPages; ++i) {
+		POGLXAtlasPage& page = mPages[i];
+		if (page.dirty && page.texture->GetMipLevels() > 1)
+			mContext->GenerateMipmaps(page.texture);
+		page.dirty = false;
+	}
+}
+
+const POGL_BYTE* POGLXTextureAtlas::PadImage(const POGL_SIZE& size, const POGL_BYTE* bytes)
+{
+	const POGL_INT32 padding = (POGL_INT32)mPadding;
+	const POGL_UINT32 bpp = mBytesPerPixel;
+	const POGL_UINT32 srcPitch = size.width * bpp;
+	const POGL_UINT32 dstPitch = (size.width + 2 * padding) * bpp;
+	const POGL_INT32 dstHeight = size.height + 2 * padding;
+	mPaddedImage.resize(dstPitch * dstHeight);
+
+	for (POGL_INT32 y = 0; y < dstHeight; ++y) {
+		// Rows in the top and bottom padding repeat the first and last row
+		const POGL_INT32 srcY = (std::min)((std::max)(y - padding, 0), size.height - 1);
+		const POGL_BYTE* src = bytes + srcY * srcPitch;
+		POGL_BYTE* dst = &mPaddedImage[y * dstPitch];
+
+		const POGL_BYTE* lastPixel = src + srcPitch - bpp;
+		for (POGL_INT32 x = 0; x < padding; ++x) {
+			memcpy(dst + x * bpp, src, bpp);
+			memcpy(dst + (padding + size.width + x) * bpp, lastPixel, bpp);
+		}
+		memcpy(dst + padding * bpp, src, srcPitch);
+	}
+
+	return &mPaddedImage[0];
+}
+
+IPOGLXTextureAtlas* POGLXCreateTextureAtlas(IPOGLRenderContext* context, const POGL_SIZE& pageSize, POGLTextureFormat::Enum format,
+	POGL_UINT32 mipLevels, POGL_UINT32 padding)
+{
+	if (context == nullptr)
+		THROW_EXCEPTION(POGLResourceException, "You must supply a valid render context");
+
+	if (pageSize.width <= 0 || pageSize.height <= 0)
+		THROW_EXCEPTION(POGLResourceException, "You cannot create an atlas with the page size: %dx%d", pageSize.width, pageSize.height);
+
+	return new POGLXTextureAtlas(context, pageSize, format, mipLevels, padding);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "config.h"
+#include "POGLXSkylinePacker.h"
+#include <vector>
+
+class POGLXTextureAtlas : public IPOGLXTextureAtlas
+{
+	struct POGLXAtlasPage
+	{
+		IPOGLTexture2D* texture;
+		POGLXSkylinePacker packer;
+
+		// New entries have been added since the mip levels were generated
+		bool dirty;
+
+		POGLXAtlasPage(IPOGLTexture2D* _texture, const POGL_SIZE& size) : texture(_texture), packer(size), dirty(false) {}
+	};
+
+public:
+	POGLXTextureAtlas(IPOGLRenderContext* context, const POGL_SIZE& pageSize, POGLTextureFormat::Enum format, POGL_UINT32 mipLevels, POGL_UINT32 padding);
+	virtual ~POGLXTextureAtlas();
+
+// IPOGLInterface
+public:
+	virtual void AddRef();
+	virtual void Release();
+
+// IPOGLXTextureAtlas
+public:
+	virtual POGL_UINT32 Insert(const POGL_SIZE& size, const void* bytes);
+	virtual const POGLX_ATLAS_ENTRY& GetEntry(POGL_UINT32 index) const;
+	virtual POGL_UINT32 GetNumEntries() const;
+	virtual POGL_UINT32 GetNumPages() const;
+	virtual IPOGLTexture2D* GetPage(POGL_UINT32 index);
+	virtual void GenerateMipmaps();
+
+private:
+	/*!
+		\brief Copy the supplied image into the middle of the padded image and repeat its edge pixels out into the padding
+	*/
+	const POGL_BYTE* PadImage(const POGL_SIZE& size, const POGL_BYTE* bytes);
+
+private:
+	REF_COUNTER mRefCount;
+	IPOGLRenderContext* mContext;
+	POGL_SIZE mPageSize;
+	POGLTextureFormat::Enum mFormat;
+	POGL_UINT32 mMipLevels;
+	POGL_UINT32 mPadding;
+	POGL_UINT32 mBytesPerPixel;
+
+	std::vector<POGLXAtlasPage> mPages;
+	std::vector<POGLX_ATLAS_ENTRY> mEntries;
+	std::vector<POGL_BYTE> mPaddedImage;
+};
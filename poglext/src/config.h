@@ -51,6 +51,13 @@ typedef std::stringstream POGL_STRINGSTREAM;
 #define open_file fopen
 #endif
 
+/* Atomic types */
+typedef std::atomic<POGL_UINT32> REF_COUNTER;
+
+#ifndef POGL_SAFE_RELEASE
+#define POGL_SAFE_RELEASE(x) if(x != nullptr) { x->Release(); x = nullptr; }
+#endif
+
 /*!
 	\brief Custom delete struct used with std::shared_ptr to delete arrays
 
@@ -6,6 +6,52 @@
 #error "You must include pogl.h before poglmath.h"
 #endif
 
+#include "poglmathinline.h"
+
+/*!
+	\brief The instruction sets the math functions can be executed with
+*/
+struct POGLAPI POGLMathInstructionSet
+{
+	enum Enum {
+		/* Plain C++. The results of every other instruction set are verified against this one */
+		SCALAR = 0,
+		SSE2,
+		SSE41,
+		AVX,
+		NEON,
+
+		COUNT
+	};
+};
+
+/*!
+	\brief Check to see if the supplied instruction set is compiled into the library and supported by this CPU
+
+	\param instructionSet
+*/
+extern POGLAPI bool POGLMathIsInstructionSetSupported(POGLMathInstructionSet::Enum instructionSet);
+
+/*!
+	\brief Retrieves the instruction set the math functions are executed with
+
+	This is the best instruction set supported by the CPU, unless another instruction set is selected using
+	POGLMathSetInstructionSet.
+*/
+extern POGLAPI POGLMathInstructionSet::Enum POGLMathGetInstructionSet();
+
+/*!
+	\brief Select the instruction set the math functions are executed with
+
+	This is useful for comparing the instruction sets with each other. Functions that have no implementation for the
+	selected instruction set use the scalar version. This function is not allowed to be invoked while another thread
+	is using the math functions.
+
+	\param instructionSet
+	\return true if the instruction set is selected; false if it's not supported
+*/
+extern POGLAPI bool POGLMathSetInstructionSet(POGLMathInstructionSet::Enum instructionSet);
+
 /*!
 	\brief Calculate the length of the supplied vector
 
@@ -262,4 +308,186 @@ extern POGLAPI void POGLMat4Rotate(POGL_FLOAT angle, const POGL_MAT4& mat4, cons
 */
 extern POGLAPI void POGLMat4Scale(const POGL_VECTOR3& v, POGL_MAT4* _out_Mat4);
 
+/*!
+	\brief Axis-aligned bounding box
+*/
+struct POGL_AABB
+{
+	POGL_VECTOR3 min;
+	POGL_VECTOR3 max;
+};
+_STATIC_ASSERT(sizeof(POGL_AABB) == sizeof(POGL_FLOAT) * 6);
+
+/*!
+	\brief Bounding sphere
+*/
+struct POGL_SPHERE
+{
+	POGL_VECTOR3 center;
+	POGL_FLOAT radius;
+};
+_STATIC_ASSERT(sizeof(POGL_SPHERE) == sizeof(POGL_FLOAT) * 4);
+
+/*!
+	\brief The six planes of a view frustum: left, right, bottom, top, near and far
+
+	Each plane is stored as (a, b, c, d) with a normal pointing into the frustum, which means that a point is inside
+	the plane if a * x + b * y + c * z + d >= 0.
+*/
+struct POGL_FRUSTUM
+{
+	POGL_VECTOR4 planes[6];
+};
+_STATIC_ASSERT(sizeof(POGL_FRUSTUM) == sizeof(POGL_FLOAT) * 24);
+
+/*!
+	\brief Split the batch functions across multiple threads
+
+	The batch functions run on the calling thread by default. Large batches are split into chunks of at least
+	minItemsPerThread items, which are executed on up to maxThreads threads (including the calling thread).
+	This function is not allowed to be invoked while another thread is using the batch functions.
+
+	\param maxThreads
+			The maximum number of threads. 1 disables the threading
+	\param minItemsPerThread
+			The minimum number of items each thread is given
+*/
+extern POGLAPI void POGLMathSetBatchThreads(POGL_UINT32 maxThreads, POGL_UINT32 minItemsPerThread);
+
+/*!
+	\brief Multiply the supplied matrix with every matrix in the rhs array
+
+	_out_Mat4s[i] = lhs * rhs[i]
+
+	\param lhs
+	\param rhs
+	\param count
+			The number of matrices in the rhs and output arrays
+	\param _out_Mat4s
+			The output array. It's allowed to be the same array as rhs
+*/
+extern POGLAPI void POGLMat4MultiplyArray(const POGL_MAT4& lhs, const POGL_MAT4* rhs, POGL_UINT32 count, POGL_MAT4* _out_Mat4s);
+
+/*!
+	\brief Transform an array of points with the supplied matrix, including the translation
+
+	\param m
+	\param points
+	\param count
+	\param _out_Vec3s
+			The output array. It's allowed to be the same array as points
+*/
+extern POGLAPI void POGLVec3TransformPoints(const POGL_MAT4& m, const POGL_VECTOR3* points, POGL_UINT32 count, POGL_VECTOR3* _out_Vec3s);
+
+/*!
+	\brief Transform an array of direction vectors with the supplied matrix, excluding the translation
+
+	\param m
+	\param vectors
+	\param count
+	\param _out_Vec3s
+			The output array. It's allowed to be the same array as vectors
+*/
+extern POGLAPI void POGLVec3TransformVectors(const POGL_MAT4& m, const POGL_VECTOR3* vectors, POGL_UINT32 count, POGL_VECTOR3* _out_Vec3s);
+
+/*!
+	\brief Transform points stored as separate x, y and z arrays with the supplied matrix, including the translation
+
+	This layout is faster than POGLVec3TransformPoints because every SIMD lane works on its own point.
+	The output arrays are allowed to be the same arrays as the input arrays.
+*/
+extern POGLAPI void POGLVec3TransformPointsSoA(const POGL_MAT4& m, const POGL_FLOAT* xs, const POGL_FLOAT* ys, const POGL_FLOAT* zs, POGL_UINT32 count,
+	POGL_FLOAT* _out_Xs, POGL_FLOAT* _out_Ys, POGL_FLOAT* _out_Zs);
+
+/*!
+	\brief Transform direction vectors stored as separate x, y and z arrays with the supplied matrix, excluding the translation
+*/
+extern POGLAPI void POGLVec3TransformVectorsSoA(const POGL_MAT4& m, const POGL_FLOAT* xs, const POGL_FLOAT* ys, const POGL_FLOAT* zs, POGL_UINT32 count,
+	POGL_FLOAT* _out_Xs, POGL_FLOAT* _out_Ys, POGL_FLOAT* _out_Zs);
+
+/*!
+	\brief Transform an array of bounding boxes with the supplied matrix
+
+	The result is the smallest axis-aligned box that contains the transformed box. The supplied matrix is assumed to be an
+	affine transform.
+
+	\param m
+	\param aabbs
+	\param count
+	\param _out_AABBs
+			The output array. It's allowed to be the same array as aabbs
+*/
+extern POGLAPI void POGLAABBTransform(const POGL_MAT4& m, const POGL_AABB* aabbs, POGL_UINT32 count, POGL_AABB* _out_AABBs);
+
+/*!
+	\brief Extract the frustum planes from the supplied view-projection matrix
+
+	The planes are normalized. If the supplied matrix is only a projection matrix then the planes are in view space.
+
+	\param viewProjection
+	\param _out_Frustum
+*/
+extern POGLAPI void POGLFrustumExtract(const POGL_MAT4& viewProjection, POGL_FRUSTUM* _out_Frustum);
+
+/*!
+	\brief Test an array of spheres against the supplied frustum
+
+	\param frustum
+	\param spheres
+	\param count
+	\param _out_Mask
+			A visibility bitmask with room for (count + 31) / 32 words. Bit (i % 32) in word (i / 32) is set if sphere i
+			intersects the frustum
+*/
+extern POGLAPI void POGLFrustumCullSpheres(const POGL_FRUSTUM& frustum, const POGL_SPHERE* spheres, POGL_UINT32 count, POGL_UINT32* _out_Mask);
+
+/*!
+	\brief Test an array of bounding boxes against the supplied frustum
+
+	\param frustum
+	\param aabbs
+	\param count
+	\param _out_Mask
+			A visibility bitmask with room for (count + 31) / 32 words. Bit (i % 32) in word (i / 32) is set if box i
+			intersects the frustum
+*/
+extern POGLAPI void POGLFrustumCullAABBs(const POGL_FRUSTUM& frustum, const POGL_AABB* aabbs, POGL_UINT32 count, POGL_UINT32* _out_Mask);
+
+/*!
+	\brief Convert a visibility bitmask into a compacted list of indices
+
+	\param mask
+			The bitmask written by POGLFrustumCullSpheres or POGLFrustumCullAABBs
+	\param count
+			The number of items the bitmask was written for
+	\param _out_Indices
+			An array with room for count indices. The indices are written in increasing order
+	\return The number of indices written
+*/
+extern POGLAPI POGL_UINT32 POGLVisibilityMaskToIndices(const POGL_UINT32* mask, POGL_UINT32 count, POGL_UINT32* _out_Indices);
+
+/*!
+	\brief Calculate the world matrices and the skinning palette for a joint hierarchy
+
+	The local matrix of each joint is calculated from its pose and multiplied with the world matrix of its parent. The
+	world matrix is then multiplied with the inverse bind pose, which gives the matrix that is uploaded to the vertex shader.
+	Everything is done in one pass over the joints.
+
+	\param localPoses
+			The pose of each joint relative to its parent
+	\param parents
+			The index of the parent of each joint, or a negative value for root joints. A parent must come before its
+			children in the array
+	\param inverseBindPoses
+			The inverse bind pose of each joint. If nullptr then only the world matrices are calculated
+	\param count
+			The number of joints
+	\param _out_WorldMatrices
+			The world matrix of each joint
+	\param _out_Palette
+			The skinning matrix of each joint. Not used if inverseBindPoses is nullptr
+*/
+extern POGLAPI void POGLSkinningPalette(const POGL_TRSF* localPoses, const POGL_INT32* parents, const POGL_MAT4* inverseBindPoses, POGL_UINT32 count,
+	POGL_MAT4* _out_WorldMatrices, POGL_MAT4* _out_Palette);
+
 #endif
@@ -0,0 +1,583 @@
+#pragma once
+#ifndef _POGLMATHINLINE_H_
+#define _POGLMATHINLINE_H_
+
+#ifndef _POGL_H_
+#error "You must include pogl.h before poglmathinline.h"
+#endif
+
+#include <cmath>
+
+//
+// Header-only math types. Everything in this file is inlined into the calling code, which lets the compiler keep the
+// values in registers and vectorize loops. The types have exactly the same memory layout as their POGL counterparts
+// (POGL_VECTOR2, POGL_VECTOR3, POGL_VECTOR4 and POGL_MAT4) and are implicitly convertible to and from them.
+//
+// Use the exported POGLMat4Multiply, POGLMat4Inverse and the batch functions for large amounts of data; they are
+// executed with the best instruction set supported by the CPU.
+//
+
+#ifndef POGL_CONSTEXPR
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define POGL_CONSTEXPR inline
+#else
+#define POGL_CONSTEXPR constexpr
+#endif
+#endif
+
+/*!
+	\brief Inline 2D vector
+*/
+struct POGL_VEC2F
+{
+	POGL_FLOAT x;
+	POGL_FLOAT y;
+
+	POGL_VEC2F() {}
+	POGL_CONSTEXPR POGL_VEC2F(POGL_FLOAT _x, POGL_FLOAT _y) : x(_x), y(_y) {}
+	POGL_VEC2F(const POGL_VECTOR2& v) : x(v.x), y(v.y) {}
+
+	operator POGL_VECTOR2() const { return POGL_VECTOR2(x, y); }
+
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return (&x)[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return (&x)[idx]; }
+	const POGL_FLOAT* Data() const { return &x; }
+	POGL_FLOAT* Data() { return &x; }
+
+	POGL_CONSTEXPR POGL_VEC2F operator-() const { return POGL_VEC2F(-x, -y); }
+	POGL_CONSTEXPR POGL_VEC2F operator+(const POGL_VEC2F& rhs) const { return POGL_VEC2F(x + rhs.x, y + rhs.y); }
+	POGL_CONSTEXPR POGL_VEC2F operator-(const POGL_VEC2F& rhs) const { return POGL_VEC2F(x - rhs.x, y - rhs.y); }
+	POGL_CONSTEXPR POGL_VEC2F operator*(const POGL_VEC2F& rhs) const { return POGL_VEC2F(x * rhs.x, y * rhs.y); }
+	POGL_CONSTEXPR POGL_VEC2F operator*(POGL_FLOAT rhs) const { return POGL_VEC2F(x * rhs, y * rhs); }
+	POGL_CONSTEXPR POGL_VEC2F operator/(POGL_FLOAT rhs) const { return POGL_VEC2F(x / rhs, y / rhs); }
+
+	POGL_VEC2F& operator+=(const POGL_VEC2F& rhs) { x += rhs.x; y += rhs.y; return *this; }
+	POGL_VEC2F& operator-=(const POGL_VEC2F& rhs) { x -= rhs.x; y -= rhs.y; return *this; }
+	POGL_VEC2F& operator*=(POGL_FLOAT rhs) { x *= rhs; y *= rhs; return *this; }
+
+	/* Exact comparison. Use POGLNearlyEqual to compare with a tolerance */
+	POGL_CONSTEXPR bool operator==(const POGL_VEC2F& rhs) const { return x == rhs.x && y == rhs.y; }
+	POGL_CONSTEXPR bool operator!=(const POGL_VEC2F& rhs) const { return !(*this == rhs); }
+};
+_STATIC_ASSERT(sizeof(POGL_VEC2F) == sizeof(POGL_VECTOR2));
+
+/*!
+	\brief Inline 3D vector
+*/
+struct POGL_VEC3F
+{
+	POGL_FLOAT x;
+	POGL_FLOAT y;
+	POGL_FLOAT z;
+
+	POGL_VEC3F() {}
+	POGL_CONSTEXPR POGL_VEC3F(POGL_FLOAT _x, POGL_FLOAT _y, POGL_FLOAT _z) : x(_x), y(_y), z(_z) {}
+	POGL_VEC3F(const POGL_VECTOR3& v) : x(v.x), y(v.y), z(v.z) {}
+
+	operator POGL_VECTOR3() const { return POGL_VECTOR3(x, y, z); }
+
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return (&x)[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return (&x)[idx]; }
+	const POGL_FLOAT* Data() const { return &x; }
+	POGL_FLOAT* Data() { return &x; }
+
+	POGL_CONSTEXPR POGL_VEC3F operator-() const { return POGL_VEC3F(-x, -y, -z); }
+	POGL_CONSTEXPR POGL_VEC3F operator+(const POGL_VEC3F& rhs) const { return POGL_VEC3F(x + rhs.x, y + rhs.y, z + rhs.z); }
+	POGL_CONSTEXPR POGL_VEC3F operator-(const POGL_VEC3F& rhs) const { return POGL_VEC3F(x - rhs.x, y - rhs.y, z - rhs.z); }
+	POGL_CONSTEXPR POGL_VEC3F operator*(const POGL_VEC3F& rhs) const { return POGL_VEC3F(x * rhs.x, y * rhs.y, z * rhs.z); }
+	POGL_CONSTEXPR POGL_VEC3F operator*(POGL_FLOAT rhs) const { return POGL_VEC3F(x * rhs, y * rhs, z * rhs); }
+	POGL_CONSTEXPR POGL_VEC3F operator/(POGL_FLOAT rhs) const { return POGL_VEC3F(x / rhs, y / rhs, z / rhs); }
+
+	POGL_VEC3F& operator+=(const POGL_VEC3F& rhs) { x += rhs.x; y += rhs.y; z += rhs.z; return *this; }
+	POGL_VEC3F& operator-=(const POGL_VEC3F& rhs) { x -= rhs.x; y -= rhs.y; z -= rhs.z; return *this; }
+	POGL_VEC3F& operator*=(POGL_FLOAT rhs) { x *= rhs; y *= rhs; z *= rhs; return *this; }
+
+	/* Exact comparison. Use POGLNearlyEqual to compare with a tolerance */
+	POGL_CONSTEXPR bool operator==(const POGL_VEC3F& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+	POGL_CONSTEXPR bool operator!=(const POGL_VEC3F& rhs) const { return !(*this == rhs); }
+};
+_STATIC_ASSERT(sizeof(POGL_VEC3F) == sizeof(POGL_VECTOR3));
+
+/*!
+	\brief Inline 4D vector
+*/
+struct POGL_VEC4F
+{
+	POGL_FLOAT x;
+	POGL_FLOAT y;
+	POGL_FLOAT z;
+	POGL_FLOAT w;
+
+	POGL_VEC4F() {}
+	POGL_CONSTEXPR POGL_VEC4F(POGL_FLOAT _x, POGL_FLOAT _y, POGL_FLOAT _z, POGL_FLOAT _w) : x(_x), y(_y), z(_z), w(_w) {}
+	POGL_CONSTEXPR POGL_VEC4F(const POGL_VEC3F& v, POGL_FLOAT _w) : x(v.x), y(v.y), z(v.z), w(_w) {}
+	POGL_VEC4F(const POGL_VECTOR4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+	operator POGL_VECTOR4() const { return POGL_VECTOR4(x, y, z, w); }
+
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return (&x)[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return (&x)[idx]; }
+	const POGL_FLOAT* Data() const { return &x; }
+	POGL_FLOAT* Data() { return &x; }
+
+	/* Retrieves the x, y and z components */
+	POGL_CONSTEXPR POGL_VEC3F XYZ() const { return POGL_VEC3F(x, y, z); }
+
+	POGL_CONSTEXPR POGL_VEC4F operator-() const { return POGL_VEC4F(-x, -y, -z, -w); }
+	POGL_CONSTEXPR POGL_VEC4F operator+(const POGL_VEC4F& rhs) const { return POGL_VEC4F(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w); }
+	POGL_CONSTEXPR POGL_VEC4F operator-(const POGL_VEC4F& rhs) const { return POGL_VEC4F(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w); }
+	POGL_CONSTEXPR POGL_VEC4F operator*(const POGL_VEC4F& rhs) const { return POGL_VEC4F(x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w); }
+	POGL_CONSTEXPR POGL_VEC4F operator*(POGL_FLOAT rhs) const { return POGL_VEC4F(x * rhs, y * rhs, z * rhs, w * rhs); }
+	POGL_CONSTEXPR POGL_VEC4F operator/(POGL_FLOAT rhs) const { return POGL_VEC4F(x / rhs, y / rhs, z / rhs, w / rhs); }
+
+	POGL_VEC4F& operator+=(const POGL_VEC4F& rhs) { x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w; return *this; }
+	POGL_VEC4F& operator-=(const POGL_VEC4F& rhs) { x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w; return *this; }
+	POGL_VEC4F& operator*=(POGL_FLOAT rhs) { x *= rhs; y *= rhs; z *= rhs; w *= rhs; return *this; }
+
+	/* Exact comparison. Use POGLNearlyEqual to compare with a tolerance */
+	POGL_CONSTEXPR bool operator==(const POGL_VEC4F& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w; }
+	POGL_CONSTEXPR bool operator!=(const POGL_VEC4F& rhs) const { return !(*this == rhs); }
+};
+_STATIC_ASSERT(sizeof(POGL_VEC4F) == sizeof(POGL_VECTOR4));
+
+POGL_CONSTEXPR POGL_VEC2F operator*(POGL_FLOAT lhs, const POGL_VEC2F& rhs) { return rhs * lhs; }
+POGL_CONSTEXPR POGL_VEC3F operator*(POGL_FLOAT lhs, const POGL_VEC3F& rhs) { return rhs * lhs; }
+POGL_CONSTEXPR POGL_VEC4F operator*(POGL_FLOAT lhs, const POGL_VEC4F& rhs) { return rhs * lhs; }
+
+POGL_CONSTEXPR POGL_FLOAT POGLDot(const POGL_VEC2F& v1, const POGL_VEC2F& v2) { return v1.x * v2.x + v1.y * v2.y; }
+POGL_CONSTEXPR POGL_FLOAT POGLDot(const POGL_VEC3F& v1, const POGL_VEC3F& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+POGL_CONSTEXPR POGL_FLOAT POGLDot(const POGL_VEC4F& v1, const POGL_VEC4F& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z + v1.w * v2.w; }
+
+/*!
+	\brief Calculate the cross product between the first- and second vector
+*/
+POGL_CONSTEXPR POGL_VEC3F POGLCross(const POGL_VEC3F& v1, const POGL_VEC3F& v2)
+{
+	return POGL_VEC3F(v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x);
+}
+
+template<typename T>
+POGL_CONSTEXPR POGL_FLOAT POGLSqrdLength(const T& v) { return POGLDot(v, v); }
+
+template<typename T>
+inline POGL_FLOAT POGLLength(const T& v) { return sqrtf(POGLDot(v, v)); }
+
+/*!
+	\brief Retrieves a normalized version of the supplied vector. A zero vector is returned unchanged
+*/
+template<typename T>
+inline T POGLNormalize(const T& v)
+{
+	const POGL_FLOAT length = POGLLength(v);
+	return length > 0.0f ? v * (1.0f / length) : v;
+}
+
+/*!
+	\brief Linear interpolation between the first- and second vector. t = 0 gives v1 and t = 1 gives v2
+*/
+template<typename T>
+POGL_CONSTEXPR T POGLLerp(const T& v1, const T& v2, POGL_FLOAT t) { return v1 + (v2 - v1) * t; }
+
+/*!
+	\brief Check to see if every component in the supplied vectors differ by at most the supplied tolerance
+*/
+inline bool POGLNearlyEqual(const POGL_VEC3F& v1, const POGL_VEC3F& v2, POGL_FLOAT tolerance)
+{
+	return fabsf(v1.x - v2.x) <= tolerance && fabsf(v1.y - v2.y) <= tolerance && fabsf(v1.z - v2.z) <= tolerance;
+}
+
+inline bool POGLNearlyEqual(const POGL_VEC4F& v1, const POGL_VEC4F& v2, POGL_FLOAT tolerance)
+{
+	return POGLNearlyEqual(v1.XYZ(), v2.XYZ(), tolerance) && fabsf(v1.w - v2.w) <= tolerance;
+}
+
+/*!
+	\brief Inline 4x4 matrix
+
+	The values are stored in column-major order, just like POGL_MAT4. Default constructed matrices are uninitialized;
+	use POGL_MAT4F::Identity() for an identity matrix.
+*/
+struct POGL_MAT4F
+{
+	POGL_FLOAT vec[16];
+
+	POGL_MAT4F() {}
+	POGL_CONSTEXPR POGL_MAT4F(const POGL_VEC4F& c0, const POGL_VEC4F& c1, const POGL_VEC4F& c2, const POGL_VEC4F& c3)
+		: vec{ c0.x, c0.y, c0.z, c0.w, c1.x, c1.y, c1.z, c1.w, c2.x, c2.y, c2.z, c2.w, c3.x, c3.y, c3.z, c3.w } {}
+	POGL_MAT4F(const POGL_MAT4& m) {
+		for (POGL_UINT32 i = 0; i < 16; ++i)
+			vec[i] = m.vec[i];
+	}
+
+	operator POGL_MAT4() const {
+		POGL_MAT4 m;
+		for (POGL_UINT32 i = 0; i < 16; ++i)
+			m.vec[i] = vec[i];
+		return m;
+	}
+
+	static POGL_CONSTEXPR POGL_MAT4F Identity() {
+		return POGL_MAT4F(POGL_VEC4F(1, 0, 0, 0), POGL_VEC4F(0, 1, 0, 0), POGL_VEC4F(0, 0, 1, 0), POGL_VEC4F(0, 0, 0, 1));
+	}
+
+	static POGL_CONSTEXPR POGL_MAT4F Translation(const POGL_VEC3F& v) {
+		return POGL_MAT4F(POGL_VEC4F(1, 0, 0, 0), POGL_VEC4F(0, 1, 0, 0), POGL_VEC4F(0, 0, 1, 0), POGL_VEC4F(v, 1));
+	}
+
+	static POGL_CONSTEXPR POGL_MAT4F Scale(const POGL_VEC3F& v) {
+		return POGL_MAT4F(POGL_VEC4F(v.x, 0, 0, 0), POGL_VEC4F(0, v.y, 0, 0), POGL_VEC4F(0, 0, v.z, 0), POGL_VEC4F(0, 0, 0, 1));
+	}
+
+	/* Retrieves the value at the supplied row and column */
+	POGL_FLOAT operator()(POGL_UINT32 row, POGL_UINT32 col) const { return vec[col * 4 + row]; }
+	POGL_FLOAT& operator()(POGL_UINT32 row, POGL_UINT32 col) { return vec[col * 4 + row]; }
+
+	POGL_FLOAT operator[](POGL_UINT32 idx) const { return vec[idx]; }
+	POGL_FLOAT& operator[](POGL_UINT32 idx) { return vec[idx]; }
+
+	POGL_VEC4F Column(POGL_UINT32 col) const { return POGL_VEC4F(vec[col * 4], vec[col * 4 + 1], vec[col * 4 + 2], vec[col * 4 + 3]); }
+	POGL_VEC4F Row(POGL_UINT32 row) const { return POGL_VEC4F(vec[row], vec[4 + row], vec[8 + row], vec[12 + row]); }
+
+	/*!
+		\brief Matrix multiplication
+
+		The products are summed in the same order as POGLMat4Multiply, so both give the same result
+	*/
+	POGL_MAT4F operator*(const POGL_MAT4F& rhs) const {
+		POGL_MAT4F result;
+		for (POGL_UINT32 col = 0; col < 4; ++col) {
+			const POGL_FLOAT* b = rhs.vec + col * 4;
+			for (POGL_UINT32 row = 0; row < 4; ++row)
+				result.vec[col * 4 + row] = vec[row] * b[0] + vec[4 + row] * b[1] + vec[8 + row] * b[2] + vec[12 + row] * b[3];
+		}
+		return result;
+	}
+
+	POGL_VEC4F operator*(const POGL_VEC4F& v) const {
+		return POGL_VEC4F(
+			vec[0] * v.x + vec[4] * v.y + vec[8] * v.z + vec[12] * v.w,
+			vec[1] * v.x + vec[5] * v.y + vec[9] * v.z + vec[13] * v.w,
+			vec[2] * v.x + vec[6] * v.y + vec[10] * v.z + vec[14] * v.w,
+			vec[3] * v.x + vec[7] * v.y + vec[11] * v.z + vec[15] * v.w);
+	}
+
+	POGL_MAT4F& operator*=(const POGL_MAT4F& rhs) { *this = *this * rhs; return *this; }
+};
+_STATIC_ASSERT(sizeof(POGL_MAT4F) == sizeof(POGL_MAT4));
+
+/*!
+	\brief Transform the supplied point with the supplied matrix, including the translation. The result is not divided by w
+*/
+inline POGL_VEC3F POGLTransformPoint(const POGL_MAT4F& m, const POGL_VEC3F& v)
+{
+	const POGL_FLOAT* c = m.vec;
+	return POGL_VEC3F(
+		c[0] * v.x + c[4] * v.y + c[8] * v.z + c[12],
+		c[1] * v.x + c[5] * v.y + c[9] * v.z + c[13],
+		c[2] * v.x + c[6] * v.y + c[10] * v.z + c[14]);
+}
+
+/*!
+	\brief Transform the supplied direction vector with the supplied matrix, excluding the translation
+*/
+inline POGL_VEC3F POGLTransformVector(const POGL_MAT4F& m, const POGL_VEC3F& v)
+{
+	const POGL_FLOAT* c = m.vec;
+	return POGL_VEC3F(
+		c[0] * v.x + c[4] * v.y + c[8] * v.z,
+		c[1] * v.x + c[5] * v.y + c[9] * v.z,
+		c[2] * v.x + c[6] * v.y + c[10] * v.z);
+}
+
+inline POGL_MAT4F POGLTranspose(const POGL_MAT4F& m)
+{
+	return POGL_MAT4F(m.Row(0), m.Row(1), m.Row(2), m.Row(3));
+}
+
+/*!
+	\brief Check to see if every value in the supplied matrices differ by at most the supplied tolerance
+*/
+inline bool POGLNearlyEqual(const POGL_MAT4F& m1, const POGL_MAT4F& m2, POGL_FLOAT tolerance)
+{
+	for (POGL_UINT32 i = 0; i < 16; ++i) {
+		if (!(fabsf(m1.vec[i] - m2.vec[i]) <= tolerance))
+			return false;
+	}
+	return true;
+}
+
+/*!
+	\brief Inline quaternion
+
+	The quaternion (x, y, z, w) represents a rotation of 2 * acos(w) radians around the axis (x, y, z). Rotations are
+	combined like matrices: (q1 * q2) rotates with q2 first and then with q1.
+*/
+struct POGL_QUATF
+{
+	POGL_FLOAT x;
+	POGL_FLOAT y;
+	POGL_FLOAT z;
+	POGL_FLOAT w;
+
+	POGL_QUATF() {}
+	POGL_CONSTEXPR POGL_QUATF(POGL_FLOAT _x, POGL_FLOAT _y, POGL_FLOAT _z, POGL_FLOAT _w) : x(_x), y(_y), z(_z), w(_w) {}
+	POGL_QUATF(const POGL_VECTOR4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+	operator POGL_VECTOR4() const { return POGL_VECTOR4(x, y, z, w); }
+
+	static POGL_CONSTEXPR POGL_QUATF Identity() { return POGL_QUATF(0, 0, 0, 1); }
+
+	/*!
+		\brief Create a rotation around the supplied axis. The axis must be normalized
+	*/
+	static POGL_QUATF FromAxisAngle(const POGL_VEC3F& axis, POGL_FLOAT radians) {
+		const POGL_FLOAT s = sinf(radians * 0.5f);
+		return POGL_QUATF(axis.x * s, axis.y * s, axis.z * s, cosf(radians * 0.5f));
+	}
+
+	/*!
+		\brief Create a rotation from the upper 3x3 part of the supplied matrix. The matrix must be a pure rotation
+	*/
+	static POGL_QUATF FromMatrix(const POGL_MAT4F& m) {
+		// Ken Shoemake's method: start with the largest component to avoid dividing by a small number
+		const POGL_FLOAT trace = m(0, 0) + m(1, 1) + m(2, 2);
+		if (trace > 0.0f) {
+			const POGL_FLOAT s = sqrtf(trace + 1.0f) * 2.0f;
+			return POGL_QUATF((m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s, 0.25f * s);
+		}
+		if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+			const POGL_FLOAT s = sqrtf(1.0f + m(0, 0) - m(1, 1) - m(2, 2)) * 2.0f;
+			return POGL_QUATF(0.25f * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s);
+		}
+		if (m(1, 1) > m(2, 2)) {
+			const POGL_FLOAT s = sqrtf(1.0f + m(1, 1) - m(0, 0) - m(2, 2)) * 2.0f;
+			return POGL_QUATF((m(0, 1) + m(1, 0)) / s, 0.25f * s, (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s);
+		}
+		const POGL_FLOAT s = sqrtf(1.0f + m(2, 2) - m(0, 0) - m(1, 1)) * 2.0f;
+		return POGL_QUATF((m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, 0.25f * s, (m(1, 0) - m(0, 1)) / s);
+	}
+
+	/* Retrieves the x, y and z components */
+	POGL_CONSTEXPR POGL_VEC3F XYZ() const { return POGL_VEC3F(x, y, z); }
+
+	/* The inverse rotation of a normalized quaternion */
+	POGL_CONSTEXPR POGL_QUATF Conjugate() const { return POGL_QUATF(-x, -y, -z, w); }
+
+	POGL_CONSTEXPR POGL_QUATF operator-() const { return POGL_QUATF(-x, -y, -z, -w); }
+	POGL_CONSTEXPR POGL_QUATF operator+(const POGL_QUATF& rhs) const { return POGL_QUATF(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w); }
+	POGL_CONSTEXPR POGL_QUATF operator-(const POGL_QUATF& rhs) const { return POGL_QUATF(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w); }
+	POGL_CONSTEXPR POGL_QUATF operator*(POGL_FLOAT rhs) const { return POGL_QUATF(x * rhs, y * rhs, z * rhs, w * rhs); }
+
+	POGL_CONSTEXPR POGL_QUATF operator*(const POGL_QUATF& rhs) const {
+		return POGL_QUATF(
+			w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+			w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+			w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+			w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z);
+	}
+
+	POGL_QUATF& operator*=(const POGL_QUATF& rhs) { *this = *this * rhs; return *this; }
+
+	/* Exact comparison. Note that q and -q represent the same rotation */
+	POGL_CONSTEXPR bool operator==(const POGL_QUATF& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w; }
+	POGL_CONSTEXPR bool operator!=(const POGL_QUATF& rhs) const { return !(*this == rhs); }
+};
+_STATIC_ASSERT(sizeof(POGL_QUATF) == sizeof(POGL_VECTOR4));
+
+POGL_CONSTEXPR POGL_FLOAT POGLDot(const POGL_QUATF& q1, const POGL_QUATF& q2) { return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w; }
+
+/*!
+	\brief Rotate the supplied vector with the supplied normalized quaternion
+*/
+inline POGL_VEC3F POGLRotate(const POGL_QUATF& q, const POGL_VEC3F& v)
+{
+	// v' = v + w * t + u x t, where u = (x, y, z) and t = 2 * (u x v)
+	const POGL_VEC3F u = q.XYZ();
+	const POGL_VEC3F t = POGLCross(u, v) * 2.0f;
+	return v + t * q.w + POGLCross(u, t);
+}
+
+/*!
+	\brief Normalized linear interpolation between two rotations along the shortest path
+
+	This is much faster than POGLSlerp. The angular velocity is not constant, but the error is small for the angles
+	between two animation keys.
+*/
+inline POGL_QUATF POGLNlerp(const POGL_QUATF& q1, const POGL_QUATF& q2, POGL_FLOAT t)
+{
+	const POGL_QUATF to = POGLDot(q1, q2) < 0.0f ? -q2 : q2;
+	return POGLNormalize(q1 + (to - q1) * t);
+}
+
+/*!
+	\brief Spherical linear interpolation between two rotations along the shortest path
+*/
+inline POGL_QUATF POGLSlerp(const POGL_QUATF& q1, const POGL_QUATF& q2, POGL_FLOAT t)
+{
+	POGL_FLOAT cosTheta = POGLDot(q1, q2);
+	POGL_QUATF to = q2;
+	if (cosTheta < 0.0f) {
+		cosTheta = -cosTheta;
+		to = -q2;
+	}
+
+	// The rotations are so close that sin(theta) loses its precision
+	if (cosTheta > 0.9995f)
+		return POGLNormalize(q1 + (to - q1) * t);
+
+	const POGL_FLOAT theta = acosf(cosTheta);
+	const POGL_FLOAT invSinTheta = 1.0f / sinf(theta);
+	return q1 * (sinf((1.0f - t) * theta) * invSinTheta) + to * (sinf(t * theta) * invSinTheta);
+}
+
+/*!
+	\brief Retrieves the rotation matrix for the supplied normalized quaternion
+*/
+inline POGL_MAT4F POGLToMatrix(const POGL_QUATF& q)
+{
+	const POGL_FLOAT x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+	const POGL_FLOAT xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+	const POGL_FLOAT xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+	const POGL_FLOAT wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+	return POGL_MAT4F(
+		POGL_VEC4F(1.0f - (yy + zz), xy + wz, xz - wy, 0.0f),
+		POGL_VEC4F(xy - wz, 1.0f - (xx + zz), yz + wx, 0.0f),
+		POGL_VEC4F(xz + wy, yz - wx, 1.0f - (xx + yy), 0.0f),
+		POGL_VEC4F(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+/*!
+	\brief Inline dual quaternion
+
+	A dual quaternion represents a rotation followed by a translation. Unlike matrices, dual quaternions can be blended
+	(weighted sum followed by POGLNormalize) without introducing scale or shear, which is why they are used for skinning.
+*/
+struct POGL_DUALQUATF
+{
+	POGL_QUATF real;
+	POGL_QUATF dual;
+
+	POGL_DUALQUATF() {}
+	POGL_CONSTEXPR POGL_DUALQUATF(const POGL_QUATF& _real, const POGL_QUATF& _dual) : real(_real), dual(_dual) {}
+
+	static POGL_CONSTEXPR POGL_DUALQUATF Identity() { return POGL_DUALQUATF(POGL_QUATF(0, 0, 0, 1), POGL_QUATF(0, 0, 0, 0)); }
+
+	/*!
+		\brief Create a dual quaternion that rotates with the supplied normalized quaternion and then translates
+	*/
+	static POGL_CONSTEXPR POGL_DUALQUATF FromRotationTranslation(const POGL_QUATF& rotation, const POGL_VEC3F& translation) {
+		return POGL_DUALQUATF(rotation, POGL_QUATF(translation.x * 0.5f, translation.y * 0.5f, translation.z * 0.5f, 0.0f) * rotation);
+	}
+
+	/*!
+		\brief Create a dual quaternion from the supplied matrix. The matrix must be a rotation and a translation only
+	*/
+	static POGL_DUALQUATF FromMatrix(const POGL_MAT4F& m) {
+		return FromRotationTranslation(POGL_QUATF::FromMatrix(m), m.Column(3).XYZ());
+	}
+
+	POGL_VEC3F GetTranslation() const {
+		return (dual * real.Conjugate()).XYZ() * 2.0f;
+	}
+
+	POGL_CONSTEXPR POGL_DUALQUATF operator+(const POGL_DUALQUATF& rhs) const { return POGL_DUALQUATF(real + rhs.real, dual + rhs.dual); }
+	POGL_CONSTEXPR POGL_DUALQUATF operator*(POGL_FLOAT rhs) const { return POGL_DUALQUATF(real * rhs, dual * rhs); }
+
+	/* Combine the transforms. The right-hand transform is applied first */
+	POGL_CONSTEXPR POGL_DUALQUATF operator*(const POGL_DUALQUATF& rhs) const {
+		return POGL_DUALQUATF(real * rhs.real, real * rhs.dual + dual * rhs.real);
+	}
+};
+_STATIC_ASSERT(sizeof(POGL_DUALQUATF) == sizeof(POGL_FLOAT) * 8);
+
+/*!
+	\brief Retrieves the normalized version of the supplied dual quaternion, for example after blending
+*/
+inline POGL_DUALQUATF POGLNormalize(const POGL_DUALQUATF& dq)
+{
+	const POGL_FLOAT length = sqrtf(POGLDot(dq.real, dq.real));
+	return length > 0.0f ? dq * (1.0f / length) : dq;
+}
+
+inline POGL_VEC3F POGLTransformPoint(const POGL_DUALQUATF& dq, const POGL_VEC3F& v)
+{
+	return POGLRotate(dq.real, v) + dq.GetTranslation();
+}
+
+inline POGL_MAT4F POGLToMatrix(const POGL_DUALQUATF& dq)
+{
+	POGL_MAT4F m = POGLToMatrix(dq.real);
+	const POGL_VEC3F translation = dq.GetTranslation();
+	m.vec[12] = translation.x;
+	m.vec[13] = translation.y;
+	m.vec[14] = translation.z;
+	return m;
+}
+
+/*!
+	\brief A transform split into translation, rotation and scale. The scale is applied first and the translation last
+*/
+struct POGL_TRSF
+{
+	POGL_VEC3F translation;
+	POGL_QUATF rotation;
+	POGL_VEC3F scale;
+
+	POGL_TRSF() {}
+	POGL_CONSTEXPR POGL_TRSF(const POGL_VEC3F& _translation, const POGL_QUATF& _rotation, const POGL_VEC3F& _scale)
+		: translation(_translation), rotation(_rotation), scale(_scale) {}
+
+	static POGL_CONSTEXPR POGL_TRSF Identity() { return POGL_TRSF(POGL_VEC3F(0, 0, 0), POGL_QUATF(0, 0, 0, 1), POGL_VEC3F(1, 1, 1)); }
+};
+_STATIC_ASSERT(sizeof(POGL_TRSF) == sizeof(POGL_FLOAT) * 10);
+
+/*!
+	\brief Retrieves the matrix translation * rotation * scale
+
+	This is the local joint matrix POGLSkinningPalette calculates for each pose. It's calculated directly instead of
+	creating and multiplying three matrices.
+*/
+inline POGL_MAT4F POGLCompose(const POGL_TRSF& trs)
+{
+	POGL_MAT4F m = POGLToMatrix(trs.rotation);
+	for (POGL_UINT32 row = 0; row < 3; ++row) {
+		m.vec[row] *= trs.scale.x;
+		m.vec[4 + row] *= trs.scale.y;
+		m.vec[8 + row] *= trs.scale.z;
+	}
+	m.vec[12] = trs.translation.x;
+	m.vec[13] = trs.translation.y;
+	m.vec[14] = trs.translation.z;
+	return m;
+}
+
+/*!
+	\brief Split the supplied matrix into translation, rotation and scale
+
+	A negative determinant (a mirroring transform) is returned as a negative x scale.
+
+	\return false if the matrix is not an affine transform or if it has a zero scale
+*/
+inline bool POGLDecompose(const POGL_MAT4F& m, POGL_TRSF* _out_TRS)
+{
+	if (m(3, 0) != 0.0f || m(3, 1) != 0.0f || m(3, 2) != 0.0f || m(3, 3) != 1.0f)
+		return false;
+
+	const POGL_VEC3F c0 = m.Column(0).XYZ();
+	const POGL_VEC3F c1 = m.Column(1).XYZ();
+	const POGL_VEC3F c2 = m.Column(2).XYZ();
+	POGL_VEC3F scale(POGLLength(c0), POGLLength(c1), POGLLength(c2));
+	if (scale.x == 0.0f || scale.y == 0.0f || scale.z == 0.0f)
+		return false;
+	if (POGLDot(POGLCross(c0, c1), c2) < 0.0f)
+		scale.x = -scale.x;
+
+	const POGL_MAT4F rotation(POGL_VEC4F(c0 / scale.x, 0.0f), POGL_VEC4F(c1 / scale.y, 0.0f), POGL_VEC4F(c2 / scale.z, 0.0f),
+		POGL_VEC4F(0.0f, 0.0f, 0.0f, 1.0f));
+	_out_TRS->translation = m.Column(3).XYZ();
+	_out_TRS->rotation = POGLNormalize(POGL_QUATF::FromMatrix(rotation));
+	_out_TRS->scale = scale;
+	return true;
+}
+
+#endif
@@ -0,0 +1,176 @@
+#include "POGLMathKernels.h"
+
+#if defined(POGLMATH_X86)
+#include <immintrin.h>
+
+namespace {
+	/*!
+		\brief Calculate two result columns at once. Each column in the left-hand matrix is duplicated into both halves of a register
+	*/
+	inline void Multiply(const __m256* a, const float* rhs, float* _out_Mat4) {
+		// The columns are summed in the same order as the scalar code
+		__m256 result[2];
+		for (int cols = 0; cols < 2; ++cols) {
+			const __m256 b = _mm256_loadu_ps(rhs + cols * 8);
+			__m256 sum = _mm256_mul_ps(a[0], _mm256_permute_ps(b, _MM_SHUFFLE(0, 0, 0, 0)));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(a[1], _mm256_permute_ps(b, _MM_SHUFFLE(1, 1, 1, 1))));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(a[2], _mm256_permute_ps(b, _MM_SHUFFLE(2, 2, 2, 2))));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(a[3], _mm256_permute_ps(b, _MM_SHUFFLE(3, 3, 3, 3))));
+			result[cols] = sum;
+		}
+
+		_mm256_storeu_ps(_out_Mat4, result[0]);
+		_mm256_storeu_ps(_out_Mat4 + 8, result[1]);
+	}
+
+	inline void LoadColumns(const float* lhs, __m256* _out_Columns) {
+		for (int col = 0; col < 4; ++col)
+			_out_Columns[col] = _mm256_broadcast_ps((const __m128*)(lhs + col * 4));
+	}
+
+	void Mat4Multiply(const float* lhs, const float* rhs, float* _out_Mat4)
+	{
+		__m256 a[4];
+		LoadColumns(lhs, a);
+		Multiply(a, rhs, _out_Mat4);
+	}
+
+	void Mat4MultiplyArray(const float* lhs, const float* rhs, unsigned int count, float* _out_Mat4s)
+	{
+		__m256 a[4];
+		LoadColumns(lhs, a);
+		for (unsigned int i = 0; i < count; ++i)
+			Multiply(a, rhs + i * 16, _out_Mat4s + i * 16);
+	}
+
+	void TransformSoA(const float* m, const float* xs, const float* ys, const float* zs, unsigned int count, float w,
+		float* _out_Xs, float* _out_Ys, float* _out_Zs)
+	{
+		__m256 column[3][3];
+		for (int col = 0; col < 3; ++col) {
+			for (int row = 0; row < 3; ++row)
+				column[col][row] = _mm256_set1_ps(m[col * 4 + row]);
+		}
+
+		const float translation[3] = { m[12] * w, m[13] * w, m[14] * w };
+		float* outs[3] = { _out_Xs, _out_Ys, _out_Zs };
+
+		unsigned int i = 0;
+		for (; i + 8 <= count; i += 8) {
+			const __m256 x = _mm256_loadu_ps(xs + i);
+			const __m256 y = _mm256_loadu_ps(ys + i);
+			const __m256 z = _mm256_loadu_ps(zs + i);
+			__m256 result[3];
+			for (int row = 0; row < 3; ++row) {
+				result[row] = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(column[0][row], x), _mm256_mul_ps(column[1][row], y)),
+					_mm256_mul_ps(column[2][row], z)), _mm256_set1_ps(translation[row]));
+			}
+			for (int row = 0; row < 3; ++row)
+				_mm256_storeu_ps(outs[row] + i, result[row]);
+		}
+
+		for (; i < count; ++i) {
+			const float x = xs[i];
+			const float y = ys[i];
+			const float z = zs[i];
+			_out_Xs[i] = m[0] * x + m[4] * y + m[8] * z + translation[0];
+			_out_Ys[i] = m[1] * x + m[5] * y + m[9] * z + translation[1];
+			_out_Zs[i] = m[2] * x + m[6] * y + m[10] * z + translation[2];
+		}
+	}
+
+	/*!
+		\brief The six frustum planes transposed so that each register holds one component of all planes. The last two lanes are unused
+	*/
+	struct Planes
+	{
+		__m256 x, y, z, w;
+		__m256 absX, absY, absZ;
+
+		Planes(const float* p) {
+			x = _mm256_setr_ps(p[0], p[4], p[8], p[12], p[16], p[20], 0.0f, 0.0f);
+			y = _mm256_setr_ps(p[1], p[5], p[9], p[13], p[17], p[21], 0.0f, 0.0f);
+			z = _mm256_setr_ps(p[2], p[6], p[10], p[14], p[18], p[22], 0.0f, 0.0f);
+			w = _mm256_setr_ps(p[3], p[7], p[11], p[15], p[19], p[23], 0.0f, 0.0f);
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+			absX = _mm256_andnot_ps(signMask, x);
+			absY = _mm256_andnot_ps(signMask, y);
+			absZ = _mm256_andnot_ps(signMask, z);
+		}
+
+		inline __m256 Distance(const float* center) const {
+			return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_broadcast_ss(center)), _mm256_mul_ps(y, _mm256_broadcast_ss(center + 1))),
+				_mm256_mul_ps(z, _mm256_broadcast_ss(center + 2))), w);
+		}
+	};
+
+	void CullSpheres(const float* planes, const float* spheres, unsigned int count, unsigned int* _out_Mask)
+	{
+		const Planes frustum(planes);
+		const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			const float* sphere = spheres + i * 4;
+			const __m256 negRadius = _mm256_xor_ps(_mm256_broadcast_ss(sphere + 3), signMask);
+			const int outside = _mm256_movemask_ps(_mm256_cmp_ps(frustum.Distance(sphere), negRadius, _CMP_LT_OQ)) & 0x3F;
+
+			if (outside == 0)
+				word |= 1U << (i & 31);
+			if ((i & 31) == 31 || i == count - 1) {
+				_out_Mask[i >> 5] = word;
+				word = 0;
+			}
+		}
+	}
+
+	void CullAABBs(const float* planes, const float* aabbs, unsigned int count, unsigned int* _out_Mask)
+	{
+		const Planes frustum(planes);
+		const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			const float* aabb = aabbs + i * 6;
+			float center[3], extents[3];
+			for (int axis = 0; axis < 3; ++axis) {
+				center[axis] = (aabb[axis] + aabb[axis + 3]) * 0.5f;
+				extents[axis] = (aabb[axis + 3] - aabb[axis]) * 0.5f;
+			}
+
+			const __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(frustum.absX, _mm256_broadcast_ss(extents)),
+				_mm256_mul_ps(frustum.absY, _mm256_broadcast_ss(extents + 1))), _mm256_mul_ps(frustum.absZ, _mm256_broadcast_ss(extents + 2)));
+			const int outside = _mm256_movemask_ps(_mm256_cmp_ps(frustum.Distance(center), _mm256_xor_ps(radius, signMask), _CMP_LT_OQ)) & 0x3F;
+
+			if (outside == 0)
+				word |= 1U << (i & 31);
+			if ((i & 31) == 31 || i == count - 1) {
+				_out_Mask[i >> 5] = word;
+				word = 0;
+			}
+		}
+	}
+}
+
+//
+// The other kernels don't benefit from the wider registers and use the SSE versions
+//
+
+const POGL_MATH_KERNELS POGL_MATH_KERNELS_AVX = {
+	Mat4Multiply,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	Mat4MultiplyArray,
+	nullptr,
+	TransformSoA,
+	nullptr,
+	CullSpheres,
+	CullAABBs,
+	nullptr
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include "config.h"
+#include "POGLMathKernels.h"
+#include <thread>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+	// Threading is disabled by default
+	std::atomic<POGL_UINT32> maxBatchThreads(1);
+	std::atomic<POGL_UINT32> minItemsPerBatchThread(4096);
+
+	/*!
+		\brief Execute the supplied function for the range [0, count), split into chunks that are executed on separate threads
+
+		Each chunk is a multiple of 32 items, so that no two threads write to the same visibility mask word. The first chunk
+		is executed on the calling thread.
+	*/
+	template<typename Func>
+	void ParallelFor(POGL_UINT32 count, Func func) {
+		if (count == 0)
+			return;
+
+		const POGL_UINT32 minItems = (std::max)(minItemsPerBatchThread.load(), 32U);
+		const POGL_UINT32 numThreads = (std::min)(maxBatchThreads.load(), count / minItems);
+		if (numThreads <= 1) {
+			func(0U, count);
+			return;
+		}
+
+		const POGL_UINT32 chunkSize = ((count + numThreads - 1) / numThreads + 31) & ~31U;
+		std::vector<std::thread> threads;
+		threads.reserve(numThreads - 1);
+		for (POGL_UINT32 begin = chunkSize; begin < count; begin += chunkSize) {
+			const POGL_UINT32 end = (std::min)(begin + chunkSize, count);
+			threads.push_back(std::thread(func, begin, end));
+		}
+
+		func(0U, (std::min)(chunkSize, count));
+		for (size_t i = 0; i < threads.size(); ++i)
+			threads[i].join();
+	}
+
+	inline POGL_UINT32 LowestBit(POGL_UINT32 word) {
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, word);
+		return index;
+#else
+		return __builtin_ctz(word);
+#endif
+	}
+
+	void TransformPoints(const POGL_MAT4& m, const POGL_VECTOR3* from, POGL_UINT32 count, POGL_FLOAT w, POGL_VECTOR3* _out_Vec3s) {
+		const POGL_MATH_KERNELS* kernels = POGLMathGetKernels();
+		ParallelFor(count, [=](POGL_UINT32 begin, POGL_UINT32 end) {
+			kernels->TransformAoS(m.vec, from[begin].vec, end - begin, w, _out_Vec3s[begin].vec);
+		});
+	}
+
+	void TransformPointsSoA(const POGL_MAT4& m, const POGL_FLOAT* xs, const POGL_FLOAT* ys, const POGL_FLOAT* zs, POGL_UINT32 count, POGL_FLOAT w,
+		POGL_FLOAT* _out_Xs, POGL_FLOAT* _out_Ys, POGL_FLOAT* _out_Zs) {
+		const POGL_MATH_KERNELS* kernels = POGLMathGetKernels();
+		ParallelFor(count, [=](POGL_UINT32 begin, POGL_UINT32 end) {
+			kernels->TransformSoA(m.vec, xs + begin, ys + begin, zs + begin, end - begin, w, _out_Xs + begin, _out_Ys + begin, _out_Zs + begin);
+		});
+	}
+}
+
+void POGLMathSetBatchThreads(POGL_UINT32 maxThreads, POGL_UINT32 minItemsPerThread)
+{
+	maxBatchThreads = (std::max)(maxThreads, 1U);
+	minItemsPerBatchThread = minItemsPerThread;
+}
+
+void POGLMat4MultiplyArray(const POGL_MAT4& lhs, const POGL_MAT4* rhs, POGL_UINT32 count, POGL_MAT4* _out_Mat4s)
+{
+	const POGL_MATH_KERNELS* kernels = POGLMathGetKernels();
+	const POGL_MAT4 m = lhs;
+	ParallelFor(count, [=, &m](POGL_UINT32 begin, POGL_UINT32 end) {
+		kernels->Mat4MultiplyArray(m.vec, rhs[begin].vec, end - begin, _out_Mat4s[begin].vec);
+	});
+}
+
+void POGLVec3TransformPoints(const POGL_MAT4& m, const POGL_VECTOR3* points, POGL_UINT32 count, POGL_VECTOR3* _out_Vec3s)
+{
+	TransformPoints(m, points, count, 1.0f, _out_Vec3s);
+}
+
+void POGLVec3TransformVectors(const POGL_MAT4& m, const POGL_VECTOR3* vectors, POGL_UINT32 count, POGL_VECTOR3* _out_Vec3s)
+{
+	TransformPoints(m, vectors, count, 0.0f, _out_Vec3s);
+}
+
+void POGLVec3TransformPointsSoA(const POGL_MAT4& m, const POGL_FLOAT* xs, const POGL_FLOAT* ys, const POGL_FLOAT* zs, POGL_UINT32 count,
+	POGL_FLOAT* _out_Xs, POGL_FLOAT* _out_Ys, POGL_FLOAT* _out_Zs)
+{
+	TransformPointsSoA(m, xs, ys, zs, count, 1.0f, _out_Xs, _out_Ys, _out_Zs);
+}
+
+void POGLVec3TransformVectorsSoA(const POGL_MAT4& m, const POGL_FLOAT* xs, const POGL_FLOAT* ys, const POGL_FLOAT* zs, POGL_UINT32 count,
+	POGL_FLOAT* _out_Xs, POGL_FLOAT* _out_Ys, POGL_FLOAT* _out_Zs)
+{
+	TransformPointsSoA(m, xs, ys, zs, count, 0.0f, _out_Xs, _out_Ys, _out_Zs);
+}
+
+void POGLAABBTransform(const POGL_MAT4& m, const POGL_AABB* aabbs, POGL_UINT32 count, POGL_AABB* _out_AABBs)
+{
+	const POGL_MATH_KERNELS* kernels = POGLMathGetKernels();
+	ParallelFor(count, [=, &m](POGL_UINT32 begin, POGL_UINT32 end) {
+		kernels->TransformAABBs(m.vec, aabbs[begin].min.vec, end - begin, _out_AABBs[begin].min.vec);
+	});
+}
+
+void POGLFrustumExtract(const POGL_MAT4& viewProjection, POGL_FRUSTUM* _out_Frustum)
+{
+	// Gil Gribb and Klaus Hartmann, "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix"
+	const POGL_FLOAT* m = viewProjection.vec;
+	for (POGL_UINT32 i = 0; i < 6; ++i) {
+		const POGL_UINT32 row = i / 2;
+		const POGL_FLOAT sign = (i & 1) == 0 ? 1.0f : -1.0f;
+		POGL_VECTOR4& plane = _out_Frustum->planes[i];
+		plane.x = m[3] + sign * m[row];
+		plane.y = m[7] + sign * m[4 + row];
+		plane.z = m[11] + sign * m[8 + row];
+		plane.w = m[15] + sign * m[12 + row];
+
+		const POGL_FLOAT length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		if (length > 0.0f) {
+			const POGL_FLOAT scale = 1.0f / length;
+			plane.x *= scale;
+			plane.y *= scale;
+			plane.z *= scale;
+			plane.w *= scale;
+		}
+	}
+}
+
+void POGLFrustumCullSpheres(const POGL_FRUSTUM& frustum, const POGL_SPHERE* spheres, POGL_UINT32 count, POGL_UINT32* _out_Mask)
+{
+	const POGL_MATH_KERNELS* kernels = POGLMathGetKernels();
+	ParallelFor(count, [=, &frustum](POGL_UINT32 begin, POGL_UINT32 end) {
+		kernels->CullSpheres(frustum.planes[0].vec, spheres[begin].center.vec, end - begin, _out_Mask + begin / 32);
+	});
+}
+
+void POGLFrustumCullAABBs(const POGL_FRUSTUM& frustum, const POGL_AABB* aabbs, POGL_UINT32 count, POGL_UINT32* _out_Mask)
+{
+	const POGL_MATH_KERNELS* kernels = POGLMathGetKernels();
+	ParallelFor(count, [=, &frustum](POGL_UINT32 begin, POGL_UINT32 end) {
+		kernels->CullAABBs(frustum.planes[0].vec, aabbs[begin].min.vec, end - begin, _out_Mask + begin / 32);
+	});
+}
+
+void POGLSkinningPalette(const POGL_TRSF* localPoses, const POGL_INT32* parents, const POGL_MAT4* inverseBindPoses, POGL_UINT32 count,
+	POGL_MAT4* _out_WorldMatrices, POGL_MAT4* _out_Palette)
+{
+	// The joints depend on their parents, so this can't be split across threads
+	if (count == 0)
+		return;
+
+	POGLMathGetKernels()->SkinningPalette(&localPoses[0].translation.x, parents, inverseBindPoses != nullptr ? inverseBindPoses[0].vec : nullptr,
+		count, _out_WorldMatrices[0].vec, _out_Palette != nullptr ? _out_Palette[0].vec : nullptr);
+}
+
+POGL_UINT32 POGLVisibilityMaskToIndices(const POGL_UINT32* mask, POGL_UINT32 count, POGL_UINT32* _out_Indices)
+{
+	POGL_UINT32 numVisible = 0;
+	const POGL_UINT32 numWords = (count + 31) / 32;
+	for (POGL_UINT32 i = 0; i < numWords; ++i) {
+		POGL_UINT32 word = mask[i];
+		while (word != 0) {
+			_out_Indices[numVisible++] = i * 32 + LowestBit(word);
+			word &= word - 1;
+		}
+	}
+	return numVisible;
+}
@@ -0,0 +1,158 @@
+#include "config.h"
+#include "POGLMathKernels.h"
+#include <mutex>
+
+#if defined(POGLMATH_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+	std::mutex mutex;
+	bool initialized = false;
+
+	// The kernels for each instruction set, where missing kernels are taken from the instruction set it builds on
+	POGL_MATH_KERNELS kernelsByInstructionSet[POGLMathInstructionSet::COUNT];
+	bool supported[POGLMathInstructionSet::COUNT];
+
+	std::atomic<const POGL_MATH_KERNELS*> selectedKernels(nullptr);
+	std::atomic<POGL_UINT32> selectedInstructionSet(POGLMathInstructionSet::SCALAR);
+
+#if defined(POGLMATH_X86)
+	void CPUID(POGL_UINT32 leaf, POGL_UINT32* _out_Registers) {
+#if defined(_MSC_VER)
+		int registers[4];
+		__cpuid(registers, (int)leaf);
+		for (POGL_UINT32 i = 0; i < 4; ++i)
+			_out_Registers[i] = (POGL_UINT32)registers[i];
+#else
+		__cpuid(leaf, _out_Registers[0], _out_Registers[1], _out_Registers[2], _out_Registers[3]);
+#endif
+	}
+
+	/*!
+		\brief Check to see if the operating system saves the AVX registers when switching threads
+	*/
+	bool IsAVXStateEnabled() {
+#if defined(_MSC_VER)
+		const POGL_UINT64 xcr0 = _xgetbv(0);
+#else
+		POGL_UINT32 eax, edx;
+		__asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		const POGL_UINT64 xcr0 = ((POGL_UINT64)edx << 32) | eax;
+#endif
+		return (xcr0 & 0x6) == 0x6;
+	}
+#endif
+
+	/*!
+		\brief Fill the missing kernels in the supplied instruction set with the kernels of the instruction set it builds on
+	*/
+	void Merge(const POGL_MATH_KERNELS& kernels, const POGL_MATH_KERNELS& base, POGL_MATH_KERNELS* _out_Kernels) {
+		*_out_Kernels = base;
+		if (kernels.Mat4Multiply != nullptr) _out_Kernels->Mat4Multiply = kernels.Mat4Multiply;
+		if (kernels.Mat4Transpose != nullptr) _out_Kernels->Mat4Transpose = kernels.Mat4Transpose;
+		if (kernels.Mat4Inverse != nullptr) _out_Kernels->Mat4Inverse = kernels.Mat4Inverse;
+		if (kernels.Vec3Length != nullptr) _out_Kernels->Vec3Length = kernels.Vec3Length;
+		if (kernels.Vec3SqrdLength != nullptr) _out_Kernels->Vec3SqrdLength = kernels.Vec3SqrdLength;
+		if (kernels.Vec3Normalize != nullptr) _out_Kernels->Vec3Normalize = kernels.Vec3Normalize;
+		if (kernels.Vec3Cross != nullptr) _out_Kernels->Vec3Cross = kernels.Vec3Cross;
+		if (kernels.Mat4MultiplyArray != nullptr) _out_Kernels->Mat4MultiplyArray = kernels.Mat4MultiplyArray;
+		if (kernels.TransformAoS != nullptr) _out_Kernels->TransformAoS = kernels.TransformAoS;
+		if (kernels.TransformSoA != nullptr) _out_Kernels->TransformSoA = kernels.TransformSoA;
+		if (kernels.TransformAABBs != nullptr) _out_Kernels->TransformAABBs = kernels.TransformAABBs;
+		if (kernels.CullSpheres != nullptr) _out_Kernels->CullSpheres = kernels.CullSpheres;
+		if (kernels.CullAABBs != nullptr) _out_Kernels->CullAABBs = kernels.CullAABBs;
+		if (kernels.SkinningPalette != nullptr) _out_Kernels->SkinningPalette = kernels.SkinningPalette;
+	}
+
+	/*!
+		\brief Detect the instruction sets supported by the CPU and select the best one. The mutex must be held
+	*/
+	void Initialize() {
+		if (initialized)
+			return;
+
+		kernelsByInstructionSet[POGLMathInstructionSet::SCALAR] = POGL_MATH_KERNELS_SCALAR;
+		supported[POGLMathInstructionSet::SCALAR] = true;
+
+#if defined(POGLMATH_X86)
+		POGL_UINT32 registers[4] = { 0 };
+		CPUID(0, registers);
+		const POGL_UINT32 maxLeaf = registers[0];
+		if (maxLeaf >= 1) {
+			CPUID(1, registers);
+			const POGL_UINT32 ecx = registers[2];
+			const POGL_UINT32 edx = registers[3];
+			supported[POGLMathInstructionSet::SSE2] = BIT_ISSET(edx, BIT(26));
+			supported[POGLMathInstructionSet::SSE41] = supported[POGLMathInstructionSet::SSE2] && BIT_ISSET(ecx, BIT(19));
+			supported[POGLMathInstructionSet::AVX] = supported[POGLMathInstructionSet::SSE41] && BIT_ISSET(ecx, BIT(27)) &&
+				BIT_ISSET(ecx, BIT(28)) && IsAVXStateEnabled();
+		}
+		Merge(POGL_MATH_KERNELS_SSE2, POGL_MATH_KERNELS_SCALAR, &kernelsByInstructionSet[POGLMathInstructionSet::SSE2]);
+		Merge(POGL_MATH_KERNELS_SSE41, kernelsByInstructionSet[POGLMathInstructionSet::SSE2], &kernelsByInstructionSet[POGLMathInstructionSet::SSE41]);
+		Merge(POGL_MATH_KERNELS_AVX, kernelsByInstructionSet[POGLMathInstructionSet::SSE41], &kernelsByInstructionSet[POGLMathInstructionSet::AVX]);
+#endif
+
+#if defined(POGLMATH_NEON)
+		// NEON is mandatory on the ARM targets the library is compiled with NEON for
+		supported[POGLMathInstructionSet::NEON] = true;
+		Merge(POGL_MATH_KERNELS_NEON, POGL_MATH_KERNELS_SCALAR, &kernelsByInstructionSet[POGLMathInstructionSet::NEON]);
+#endif
+
+		POGL_UINT32 best = POGLMathInstructionSet::SCALAR;
+		for (POGL_UINT32 i = 0; i < POGLMathInstructionSet::COUNT; ++i) {
+			if (supported[i])
+				best = i;
+		}
+
+		selectedInstructionSet = best;
+		selectedKernels = &kernelsByInstructionSet[best];
+		initialized = true;
+	}
+}
+
+const POGL_MATH_KERNELS* POGLMathGetKernels()
+{
+	const POGL_MATH_KERNELS* kernels = selectedKernels.load(std::memory_order_acquire);
+	if (kernels != nullptr)
+		return kernels;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	Initialize();
+	return selectedKernels.load();
+}
+
+bool POGLMathIsInstructionSetSupported(POGLMathInstructionSet::Enum instructionSet)
+{
+	if (instructionSet >= POGLMathInstructionSet::COUNT)
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	Initialize();
+	return supported[instructionSet];
+}
+
+POGLMathInstructionSet::Enum POGLMathGetInstructionSet()
+{
+	POGLMathGetKernels();
+	return (POGLMathInstructionSet::Enum)selectedInstructionSet.load();
+}
+
+bool POGLMathSetInstructionSet(POGLMathInstructionSet::Enum instructionSet)
+{
+	if (instructionSet >= POGLMathInstructionSet::COUNT)
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	Initialize();
+	if (!supported[instructionSet])
+		return false;
+
+	selectedInstructionSet = instructionSet;
+	selectedKernels = &kernelsByInstructionSet[instructionSet];
+	return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+//
+// This header is included by the instruction set specific translation units, which are compiled with their own
+// compiler flags. It must therefore never include pogl.h or any other header with inline functions: an inline function
+// compiled with, for example, AVX enabled might be the one picked by the linker and then executed on a CPU without AVX.
+// The kernels work on raw float arrays for the same reason. The layout is the same as POGL_FLOAT, POGL_VECTOR3 and POGL_MAT4.
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define POGLMATH_X86
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM) || defined(_M_ARM64)
+#define POGLMATH_NEON
+#endif
+
+/*!
+	\brief The math kernels for one instruction set
+
+	Matrices are 16 floats in column-major order and 3D vectors are 3 floats. The output is allowed to be the same memory
+	as any of the inputs. Kernels that are nullptr use the version of the instruction set it builds on:
+	AVX builds on SSE4.1, SSE4.1 on SSE2 and the rest on the scalar version.
+*/
+struct POGL_MATH_KERNELS
+{
+	void (*Mat4Multiply)(const float* lhs, const float* rhs, float* _out_Mat4);
+	void (*Mat4Transpose)(const float* from, float* _out_Mat4);
+	bool (*Mat4Inverse)(const float* from, float* _out_Mat4);
+
+	float (*Vec3Length)(const float* v);
+	float (*Vec3SqrdLength)(const float* v);
+	void (*Vec3Normalize)(float* _in_out_Vec3);
+	void (*Vec3Cross)(const float* v1, const float* v2, float* _out_Vec3);
+
+	//
+	// Batch kernels. AABBs are 6 floats (min and max) and spheres are 4 floats (center and radius). Planes are 6 * 4 floats
+	// (a, b, c, d), where a point is inside if a * x + b * y + c * z + d >= 0. Visibility masks have one bit per item and
+	// unused bits in the last word are zero
+	//
+
+	void (*Mat4MultiplyArray)(const float* lhs, const float* rhs, unsigned int count, float* _out_Mat4s);
+	void (*TransformAoS)(const float* mat4, const float* vec3s, unsigned int count, float w, float* _out_Vec3s);
+	void (*TransformSoA)(const float* mat4, const float* xs, const float* ys, const float* zs, unsigned int count, float w,
+		float* _out_Xs, float* _out_Ys, float* _out_Zs);
+	void (*TransformAABBs)(const float* mat4, const float* aabbs, unsigned int count, float* _out_AABBs);
+	void (*CullSpheres)(const float* planes, const float* spheres, unsigned int count, unsigned int* _out_Mask);
+	void (*CullAABBs)(const float* planes, const float* aabbs, unsigned int count, unsigned int* _out_Mask);
+
+	//
+	// Skinning. A pose is 10 floats: translation (3), rotation quaternion (4) and scale (3). The parent of a joint is
+	// either negative (a root joint) or a joint earlier in the array. The inverse bind poses are allowed to be nullptr
+	//
+
+	void (*SkinningPalette)(const float* poses, const int* parents, const float* inverseBindPoses, unsigned int count,
+		float* _out_Worlds, float* _out_Palette);
+};
+
+/* The reference implementation. Every other instruction set is verified against it */
+extern const POGL_MATH_KERNELS POGL_MATH_KERNELS_SCALAR;
+
+#if defined(POGLMATH_X86)
+extern const POGL_MATH_KERNELS POGL_MATH_KERNELS_SSE2;
+extern const POGL_MATH_KERNELS POGL_MATH_KERNELS_SSE41;
+extern const POGL_MATH_KERNELS POGL_MATH_KERNELS_AVX;
+#endif
+
+#if defined(POGLMATH_NEON)
+extern const POGL_MATH_KERNELS POGL_MATH_KERNELS_NEON;
+#endif
+
+/*!
+	\brief Retrieves the kernels for the instruction set selected by POGLMathSetInstructionSet, or the best instruction set
+			supported by the CPU if none is selected
+*/
+const POGL_MATH_KERNELS* POGLMathGetKernels();
@@ -0,0 +1,99 @@
+#include "POGLMathKernels.h"
+
+#if defined(POGLMATH_NEON)
+#include <arm_neon.h>
+
+namespace {
+	void Mat4Multiply(const float* lhs, const float* rhs, float* _out_Mat4)
+	{
+		const float32x4_t a0 = vld1q_f32(lhs);
+		const float32x4_t a1 = vld1q_f32(lhs + 4);
+		const float32x4_t a2 = vld1q_f32(lhs + 8);
+		const float32x4_t a3 = vld1q_f32(lhs + 12);
+
+		// The products are added separately instead of with a (fused) multiply-add, so that the results match the scalar code
+		float32x4_t result[4];
+		for (int col = 0; col < 4; ++col) {
+			const float* b = rhs + col * 4;
+			float32x4_t sum = vmulq_n_f32(a0, b[0]);
+			sum = vaddq_f32(sum, vmulq_n_f32(a1, b[1]));
+			sum = vaddq_f32(sum, vmulq_n_f32(a2, b[2]));
+			sum = vaddq_f32(sum, vmulq_n_f32(a3, b[3]));
+			result[col] = sum;
+		}
+
+		vst1q_f32(_out_Mat4, result[0]);
+		vst1q_f32(_out_Mat4 + 4, result[1]);
+		vst1q_f32(_out_Mat4 + 8, result[2]);
+		vst1q_f32(_out_Mat4 + 12, result[3]);
+	}
+
+	void Mat4Transpose(const float* from, float* _out_Mat4)
+	{
+		// A de-interleaving load puts every fourth value into the same register, which is the transpose
+		const float32x4x4_t m = vld4q_f32(from);
+		vst1q_f32(_out_Mat4, m.val[0]);
+		vst1q_f32(_out_Mat4 + 4, m.val[1]);
+		vst1q_f32(_out_Mat4 + 8, m.val[2]);
+		vst1q_f32(_out_Mat4 + 12, m.val[3]);
+	}
+
+	void Mat4MultiplyArray(const float* lhs, const float* rhs, unsigned int count, float* _out_Mat4s)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			Mat4Multiply(lhs, rhs + i * 16, _out_Mat4s + i * 16);
+	}
+
+	void TransformSoA(const float* m, const float* xs, const float* ys, const float* zs, unsigned int count, float w,
+		float* _out_Xs, float* _out_Ys, float* _out_Zs)
+	{
+		const float translation[3] = { m[12] * w, m[13] * w, m[14] * w };
+		float* outs[3] = { _out_Xs, _out_Ys, _out_Zs };
+
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			const float32x4_t x = vld1q_f32(xs + i);
+			const float32x4_t y = vld1q_f32(ys + i);
+			const float32x4_t z = vld1q_f32(zs + i);
+			for (int row = 0; row < 3; ++row) {
+				float32x4_t result = vmulq_n_f32(x, m[row]);
+				result = vaddq_f32(result, vmulq_n_f32(y, m[row + 4]));
+				result = vaddq_f32(result, vmulq_n_f32(z, m[row + 8]));
+				result = vaddq_f32(result, vdupq_n_f32(translation[row]));
+				vst1q_f32(outs[row] + i, result);
+			}
+		}
+
+		for (; i < count; ++i) {
+			const float x = xs[i];
+			const float y = ys[i];
+			const float z = zs[i];
+			_out_Xs[i] = m[0] * x + m[4] * y + m[8] * z + translation[0];
+			_out_Ys[i] = m[1] * x + m[5] * y + m[9] * z + translation[1];
+			_out_Zs[i] = m[2] * x + m[6] * y + m[10] * z + translation[2];
+		}
+	}
+}
+
+//
+// The other kernels use the scalar versions
+//
+
+const POGL_MATH_KERNELS POGL_MATH_KERNELS_NEON = {
+	Mat4Multiply,
+	Mat4Transpose,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	Mat4MultiplyArray,
+	nullptr,
+	TransformSoA,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr
+};
+
+#endif
@@ -0,0 +1,488 @@
+#include "POGLMathKernels.h"
+
+#if defined(POGLMATH_X86)
+#include <emmintrin.h>
+
+namespace {
+	inline __m128 LoadVec3(const float* v) {
+		return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)v), _mm_load_ss(v + 2));
+	}
+
+	inline void StoreVec3(float* v, __m128 value) {
+		_mm_storel_pi((__m64*)v, value);
+		_mm_store_ss(v + 2, _mm_movehl_ps(value, value));
+	}
+
+	/*!
+		\brief Calculate the cross product of the first three lanes. The fourth lane is undefined
+	*/
+	inline __m128 Cross(__m128 a, __m128 b) {
+		const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+		const __m128 b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+		return _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+	}
+
+	/*!
+		\brief Sum the first three lanes in the same order as the scalar code: (x + y) + z
+	*/
+	inline __m128 Sum3(__m128 v) {
+		const __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+		return _mm_add_ss(_mm_add_ss(v, y), z);
+	}
+
+	inline __m128 Abs(__m128 v) {
+		return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+	}
+
+	inline __m128 Broadcast(__m128 v, int lane) {
+		switch (lane) {
+		case 0: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+		case 1: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+		case 2: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+		default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+	}
+
+	float Vec3SqrdLength(const float* v)
+	{
+		const __m128 a = LoadVec3(v);
+		return _mm_cvtss_f32(Sum3(_mm_mul_ps(a, a)));
+	}
+
+	float Vec3Length(const float* v)
+	{
+		const __m128 a = LoadVec3(v);
+		return _mm_cvtss_f32(_mm_sqrt_ss(Sum3(_mm_mul_ps(a, a))));
+	}
+
+	void Vec3Normalize(float* _in_out_Vec3)
+	{
+		const __m128 a = LoadVec3(_in_out_Vec3);
+		__m128 len = _mm_sqrt_ss(Sum3(_mm_mul_ps(a, a)));
+		if (_mm_cvtss_f32(len) == 0.0f)
+			len = _mm_set_ss(1.0f);
+
+		const __m128 lengthMul = _mm_div_ss(_mm_set_ss(1.0f), len);
+		StoreVec3(_in_out_Vec3, _mm_mul_ps(a, Broadcast(lengthMul, 0)));
+	}
+
+	void Mat4Multiply(const float* lhs, const float* rhs, float* _out_Mat4)
+	{
+		const __m128 a0 = _mm_loadu_ps(lhs);
+		const __m128 a1 = _mm_loadu_ps(lhs + 4);
+		const __m128 a2 = _mm_loadu_ps(lhs + 8);
+		const __m128 a3 = _mm_loadu_ps(lhs + 12);
+
+		// Each result column is a linear combination of the columns in the left-hand matrix.
+		// The columns are summed in the same order as the scalar code
+		__m128 result[4];
+		for (int col = 0; col < 4; ++col) {
+			const __m128 b = _mm_loadu_ps(rhs + col * 4);
+			__m128 sum = _mm_mul_ps(a0, Broadcast(b, 0));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a1, Broadcast(b, 1)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a2, Broadcast(b, 2)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a3, Broadcast(b, 3)));
+			result[col] = sum;
+		}
+
+		_mm_storeu_ps(_out_Mat4, result[0]);
+		_mm_storeu_ps(_out_Mat4 + 4, result[1]);
+		_mm_storeu_ps(_out_Mat4 + 8, result[2]);
+		_mm_storeu_ps(_out_Mat4 + 12, result[3]);
+	}
+
+	void Mat4Transpose(const float* from, float* _out_Mat4)
+	{
+		__m128 c0 = _mm_loadu_ps(from);
+		__m128 c1 = _mm_loadu_ps(from + 4);
+		__m128 c2 = _mm_loadu_ps(from + 8);
+		__m128 c3 = _mm_loadu_ps(from + 12);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		_mm_storeu_ps(_out_Mat4, c0);
+		_mm_storeu_ps(_out_Mat4 + 4, c1);
+		_mm_storeu_ps(_out_Mat4 + 8, c2);
+		_mm_storeu_ps(_out_Mat4 + 12, c3);
+	}
+
+	bool Mat4Inverse(const float* from, float* _out_Mat4)
+	{
+		//
+		// The inverse is calculated with cross products of the columns, as described in "Foundations of Game Engine Development,
+		// Volume 1" by Eric Lengyel. a, b, c and d are the first three rows of each column and x, y, z and w is the fourth row.
+		// Unlike the scalar version, this doesn't pivot, so the results differ by a few ULP
+		//
+
+		const __m128 a = _mm_loadu_ps(from);
+		const __m128 b = _mm_loadu_ps(from + 4);
+		const __m128 c = _mm_loadu_ps(from + 8);
+		const __m128 d = _mm_loadu_ps(from + 12);
+		const __m128 x = Broadcast(a, 3);
+		const __m128 y = Broadcast(b, 3);
+		const __m128 z = Broadcast(c, 3);
+		const __m128 w = Broadcast(d, 3);
+
+		__m128 s = Cross(a, b);
+		__m128 t = Cross(c, d);
+		__m128 u = _mm_sub_ps(_mm_mul_ps(a, y), _mm_mul_ps(b, x));
+		__m128 v = _mm_sub_ps(_mm_mul_ps(c, w), _mm_mul_ps(d, z));
+
+		const __m128 det = Sum3(_mm_add_ps(_mm_mul_ps(s, v), _mm_mul_ps(t, u)));
+		if (_mm_cvtss_f32(det) == 0.0f)
+			return false;
+
+		const __m128 invDet = Broadcast(_mm_div_ss(_mm_set_ss(1.0f), det), 0);
+		s = _mm_mul_ps(s, invDet);
+		t = _mm_mul_ps(t, invDet);
+		u = _mm_mul_ps(u, invDet);
+		v = _mm_mul_ps(v, invDet);
+
+		// The first three columns of each row in the inverse
+		__m128 r0 = _mm_add_ps(Cross(b, v), _mm_mul_ps(t, y));
+		__m128 r1 = _mm_sub_ps(Cross(v, a), _mm_mul_ps(t, x));
+		__m128 r2 = _mm_add_ps(Cross(d, u), _mm_mul_ps(s, w));
+		__m128 r3 = _mm_sub_ps(Cross(u, c), _mm_mul_ps(s, z));
+
+		// The fourth column is: -dot(b, t), dot(a, t), -dot(d, s), dot(c, s)
+		__m128 p0 = _mm_mul_ps(b, t);
+		__m128 p1 = _mm_mul_ps(a, t);
+		__m128 p2 = _mm_mul_ps(d, s);
+		__m128 p3 = _mm_mul_ps(c, s);
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		const __m128 col3 = _mm_mul_ps(_mm_add_ps(_mm_add_ps(p0, p1), p2), _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f));
+
+		// Transpose the rows into columns. The fourth lane of each row is undefined, so the last column is replaced
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(_out_Mat4, r0);
+		_mm_storeu_ps(_out_Mat4 + 4, r1);
+		_mm_storeu_ps(_out_Mat4 + 8, r2);
+		_mm_storeu_ps(_out_Mat4 + 12, col3);
+		return true;
+	}
+
+	void Vec3Cross(const float* v1, const float* v2, float* _out_Vec3)
+	{
+		StoreVec3(_out_Vec3, Cross(LoadVec3(v1), LoadVec3(v2)));
+	}
+
+	void TransformAoS(const float* mat4, const float* vec3s, unsigned int count, float w, float* _out_Vec3s)
+	{
+		const __m128 c0 = _mm_loadu_ps(mat4);
+		const __m128 c1 = _mm_loadu_ps(mat4 + 4);
+		const __m128 c2 = _mm_loadu_ps(mat4 + 8);
+		const __m128 c3 = _mm_mul_ps(_mm_loadu_ps(mat4 + 12), _mm_set1_ps(w));
+
+		for (unsigned int i = 0; i < count; ++i) {
+			const __m128 v = LoadVec3(vec3s + i * 3);
+			const __m128 result = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, Broadcast(v, 0)), _mm_mul_ps(c1, Broadcast(v, 1))),
+				_mm_mul_ps(c2, Broadcast(v, 2))), c3);
+			StoreVec3(_out_Vec3s + i * 3, result);
+		}
+	}
+
+	void TransformAABBs(const float* mat4, const float* aabbs, unsigned int count, float* _out_AABBs)
+	{
+		const __m128 c0 = _mm_loadu_ps(mat4);
+		const __m128 c1 = _mm_loadu_ps(mat4 + 4);
+		const __m128 c2 = _mm_loadu_ps(mat4 + 8);
+		const __m128 c3 = _mm_loadu_ps(mat4 + 12);
+		const __m128 abs0 = Abs(c0);
+		const __m128 abs1 = Abs(c1);
+		const __m128 abs2 = Abs(c2);
+		const __m128 half = _mm_set1_ps(0.5f);
+
+		for (unsigned int i = 0; i < count; ++i) {
+			const __m128 min = LoadVec3(aabbs + i * 6);
+			const __m128 max = LoadVec3(aabbs + i * 6 + 3);
+			const __m128 center = _mm_mul_ps(_mm_add_ps(min, max), half);
+			const __m128 extents = _mm_mul_ps(_mm_sub_ps(max, min), half);
+
+			const __m128 c = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, Broadcast(center, 0)), _mm_mul_ps(c1, Broadcast(center, 1))),
+				_mm_mul_ps(c2, Broadcast(center, 2))), c3);
+			const __m128 e = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs0, Broadcast(extents, 0)), _mm_mul_ps(abs1, Broadcast(extents, 1))),
+				_mm_mul_ps(abs2, Broadcast(extents, 2)));
+
+			float* out = _out_AABBs + i * 6;
+			StoreVec3(out, _mm_sub_ps(c, e));
+			StoreVec3(out + 3, _mm_add_ps(c, e));
+		}
+	}
+
+	/*!
+		\brief The six frustum planes transposed so that each register holds one component of four planes
+	*/
+	struct Planes
+	{
+		__m128 x[2], y[2], z[2], w[2];
+		__m128 absX[2], absY[2], absZ[2];
+
+		Planes(const float* planes) {
+			for (int group = 0; group < 2; ++group) {
+				const float* p = planes + group * 16;
+				__m128 p0 = _mm_loadu_ps(p);
+				__m128 p1 = _mm_loadu_ps(p + 4);
+				__m128 p2 = group == 0 ? _mm_loadu_ps(p + 8) : _mm_setzero_ps();
+				__m128 p3 = group == 0 ? _mm_loadu_ps(p + 12) : _mm_setzero_ps();
+				_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+				x[group] = p0;
+				y[group] = p1;
+				z[group] = p2;
+				w[group] = p3;
+				absX[group] = Abs(p0);
+				absY[group] = Abs(p1);
+				absZ[group] = Abs(p2);
+			}
+		}
+
+		/*!
+			\brief Retrieves a bit for each plane the supplied volume is completely behind
+
+			\param cx, cy, cz
+					The center of the sphere, broadcasted to every lane
+			\param negRadius
+					The negated radius of the sphere, broadcasted to every lane
+		*/
+		inline int Outside(__m128 cx, __m128 cy, __m128 cz, __m128 negRadius) const {
+			int mask = 0;
+			for (int group = 0; group < 2; ++group) {
+				const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x[group], cx), _mm_mul_ps(y[group], cy)), _mm_mul_ps(z[group], cz)), w[group]);
+				mask |= _mm_movemask_ps(_mm_cmplt_ps(distance, negRadius)) << (group * 4);
+			}
+			return mask & 0x3F;
+		}
+
+		/*!
+			\brief Retrieves a bit for each plane the supplied box is completely behind
+		*/
+		inline int Outside(__m128 cx, __m128 cy, __m128 cz, __m128 ex, __m128 ey, __m128 ez) const {
+			int mask = 0;
+			for (int group = 0; group < 2; ++group) {
+				const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x[group], cx), _mm_mul_ps(y[group], cy)), _mm_mul_ps(z[group], cz)), w[group]);
+				const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absX[group], ex), _mm_mul_ps(absY[group], ey)), _mm_mul_ps(absZ[group], ez));
+				mask |= _mm_movemask_ps(_mm_cmplt_ps(distance, _mm_xor_ps(radius, _mm_set1_ps(-0.0f)))) << (group * 4);
+			}
+			return mask & 0x3F;
+		}
+	};
+
+	void Mat4MultiplyArray(const float* lhs, const float* rhs, unsigned int count, float* _out_Mat4s)
+	{
+		const __m128 a0 = _mm_loadu_ps(lhs);
+		const __m128 a1 = _mm_loadu_ps(lhs + 4);
+		const __m128 a2 = _mm_loadu_ps(lhs + 8);
+		const __m128 a3 = _mm_loadu_ps(lhs + 12);
+
+		for (unsigned int i = 0; i < count; ++i) {
+			const float* rhsMat4 = rhs + i * 16;
+			float* out = _out_Mat4s + i * 16;
+
+			__m128 result[4];
+			for (int col = 0; col < 4; ++col) {
+				const __m128 b = _mm_loadu_ps(rhsMat4 + col * 4);
+				__m128 sum = _mm_mul_ps(a0, Broadcast(b, 0));
+				sum = _mm_add_ps(sum, _mm_mul_ps(a1, Broadcast(b, 1)));
+				sum = _mm_add_ps(sum, _mm_mul_ps(a2, Broadcast(b, 2)));
+				sum = _mm_add_ps(sum, _mm_mul_ps(a3, Broadcast(b, 3)));
+				result[col] = sum;
+			}
+
+			_mm_storeu_ps(out, result[0]);
+			_mm_storeu_ps(out + 4, result[1]);
+			_mm_storeu_ps(out + 8, result[2]);
+			_mm_storeu_ps(out + 12, result[3]);
+		}
+	}
+
+	void TransformSoA(const float* m, const float* xs, const float* ys, const float* zs, unsigned int count, float w,
+		float* _out_Xs, float* _out_Ys, float* _out_Zs)
+	{
+		__m128 column[4][3];
+		for (int col = 0; col < 4; ++col) {
+			for (int row = 0; row < 3; ++row)
+				column[col][row] = _mm_set1_ps(m[col * 4 + row]);
+		}
+
+		const float wx = m[12] * w;
+		const float wy = m[13] * w;
+		const float wz = m[14] * w;
+		const __m128 translation[3] = { _mm_set1_ps(wx), _mm_set1_ps(wy), _mm_set1_ps(wz) };
+		float* outs[3] = { _out_Xs, _out_Ys, _out_Zs };
+
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			const __m128 x = _mm_loadu_ps(xs + i);
+			const __m128 y = _mm_loadu_ps(ys + i);
+			const __m128 z = _mm_loadu_ps(zs + i);
+			__m128 result[3];
+			for (int row = 0; row < 3; ++row) {
+				result[row] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(column[0][row], x), _mm_mul_ps(column[1][row], y)),
+					_mm_mul_ps(column[2][row], z)), translation[row]);
+			}
+			for (int row = 0; row < 3; ++row)
+				_mm_storeu_ps(outs[row] + i, result[row]);
+		}
+
+		for (; i < count; ++i) {
+			const float x = xs[i];
+			const float y = ys[i];
+			const float z = zs[i];
+			_out_Xs[i] = m[0] * x + m[4] * y + m[8] * z + wx;
+			_out_Ys[i] = m[1] * x + m[5] * y + m[9] * z + wy;
+			_out_Zs[i] = m[2] * x + m[6] * y + m[10] * z + wz;
+		}
+	}
+
+	void CullSpheres(const float* planes, const float* spheres, unsigned int count, unsigned int* _out_Mask)
+	{
+		const Planes frustum(planes);
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			const __m128 sphere = _mm_loadu_ps(spheres + i * 4);
+			const int outside = frustum.Outside(Broadcast(sphere, 0), Broadcast(sphere, 1), Broadcast(sphere, 2),
+				_mm_xor_ps(Broadcast(sphere, 3), signMask));
+
+			if (outside == 0)
+				word |= 1U << (i & 31);
+			if ((i & 31) == 31 || i == count - 1) {
+				_out_Mask[i >> 5] = word;
+				word = 0;
+			}
+		}
+	}
+
+	void CullAABBs(const float* planes, const float* aabbs, unsigned int count, unsigned int* _out_Mask)
+	{
+		const Planes frustum(planes);
+		const __m128 half = _mm_set1_ps(0.5f);
+
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			const __m128 min = LoadVec3(aabbs + i * 6);
+			const __m128 max = LoadVec3(aabbs + i * 6 + 3);
+			const __m128 center = _mm_mul_ps(_mm_add_ps(min, max), half);
+			const __m128 extents = _mm_mul_ps(_mm_sub_ps(max, min), half);
+			const int outside = frustum.Outside(Broadcast(center, 0), Broadcast(center, 1), Broadcast(center, 2),
+				Broadcast(extents, 0), Broadcast(extents, 1), Broadcast(extents, 2));
+
+			if (outside == 0)
+				word |= 1U << (i & 31);
+			if ((i & 31) == 31 || i == count - 1) {
+				_out_Mask[i >> 5] = word;
+				word = 0;
+			}
+		}
+	}
+
+	/*!
+		\brief Calculate the matrix translation * rotation * scale for the supplied pose as four columns
+
+		The rotation terms are calculated in the same order as the scalar code
+	*/
+	inline void Compose(const float* pose, __m128* _out_Columns) {
+		const float* t = pose;
+		const float* q = pose + 3;
+
+		const float x2 = q[0] + q[0], y2 = q[1] + q[1], z2 = q[2] + q[2];
+		const float xx = q[0] * x2, yy = q[1] * y2, zz = q[2] * z2;
+		const float xy = q[0] * y2, xz = q[0] * z2, yz = q[1] * z2;
+		const float wx = q[3] * x2, wy = q[3] * y2, wz = q[3] * z2;
+
+		// Column i is (a + b * sign) * scale, where the subtraction is done by flipping the sign of b
+		const __m128 sign0 = _mm_castsi128_ps(_mm_setr_epi32(0x80000000, 0, 0x80000000, 0));
+		const __m128 sign1 = _mm_castsi128_ps(_mm_setr_epi32(0x80000000, 0x80000000, 0, 0));
+		const __m128 sign2 = _mm_castsi128_ps(_mm_setr_epi32(0, 0x80000000, 0x80000000, 0));
+		const __m128 a0 = _mm_setr_ps(1.0f, xy, xz, 0.0f);
+		const __m128 b0 = _mm_setr_ps(yy + zz, wz, wy, 0.0f);
+		const __m128 a1 = _mm_setr_ps(xy, 1.0f, yz, 0.0f);
+		const __m128 b1 = _mm_setr_ps(wz, xx + zz, wx, 0.0f);
+		const __m128 a2 = _mm_setr_ps(xz, yz, 1.0f, 0.0f);
+		const __m128 b2 = _mm_setr_ps(wy, wx, xx + yy, 0.0f);
+
+		// The w lane is masked away so that a negative scale doesn't give -0
+		const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+		// Lanes 1 to 3 are the scale
+		const __m128 scale = _mm_loadu_ps(pose + 6);
+		_out_Columns[0] = _mm_and_ps(_mm_mul_ps(_mm_add_ps(a0, _mm_xor_ps(b0, sign0)), Broadcast(scale, 1)), xyzMask);
+		_out_Columns[1] = _mm_and_ps(_mm_mul_ps(_mm_add_ps(a1, _mm_xor_ps(b1, sign1)), Broadcast(scale, 2)), xyzMask);
+		_out_Columns[2] = _mm_and_ps(_mm_mul_ps(_mm_add_ps(a2, _mm_xor_ps(b2, sign2)), Broadcast(scale, 3)), xyzMask);
+		_out_Columns[3] = _mm_setr_ps(t[0], t[1], t[2], 1.0f);
+	}
+
+	/*!
+		\brief Multiply the supplied matrix with the matrix stored as four columns
+	*/
+	inline void Multiply(const float* lhs, const __m128* rhs, __m128* _out_Columns) {
+		const __m128 a0 = _mm_loadu_ps(lhs);
+		const __m128 a1 = _mm_loadu_ps(lhs + 4);
+		const __m128 a2 = _mm_loadu_ps(lhs + 8);
+		const __m128 a3 = _mm_loadu_ps(lhs + 12);
+		for (int col = 0; col < 4; ++col) {
+			const __m128 b = rhs[col];
+			__m128 sum = _mm_mul_ps(a0, Broadcast(b, 0));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a1, Broadcast(b, 1)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a2, Broadcast(b, 2)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a3, Broadcast(b, 3)));
+			_out_Columns[col] = sum;
+		}
+	}
+
+	void SkinningPalette(const float* poses, const int* parents, const float* inverseBindPoses, unsigned int count,
+		float* _out_Worlds, float* _out_Palette)
+	{
+		// The world matrix stays in registers for the multiplication with the inverse bind pose
+		for (unsigned int i = 0; i < count; ++i) {
+			__m128 local[4], world[4];
+			Compose(poses + i * 10, local);
+
+			const int parent = parents[i];
+			if (parent < 0) {
+				for (int col = 0; col < 4; ++col)
+					world[col] = local[col];
+			}
+			else
+				Multiply(_out_Worlds + parent * 16, local, world);
+
+			float* out = _out_Worlds + i * 16;
+			for (int col = 0; col < 4; ++col)
+				_mm_storeu_ps(out + col * 4, world[col]);
+
+			if (inverseBindPoses == nullptr)
+				continue;
+
+			// palette = world * inverseBindPose, where the world matrix is the left-hand side
+			const float* inverseBindPose = inverseBindPoses + i * 16;
+			out = _out_Palette + i * 16;
+			for (int col = 0; col < 4; ++col) {
+				const __m128 b = _mm_loadu_ps(inverseBindPose + col * 4);
+				__m128 sum = _mm_mul_ps(world[0], Broadcast(b, 0));
+				sum = _mm_add_ps(sum, _mm_mul_ps(world[1], Broadcast(b, 1)));
+				sum = _mm_add_ps(sum, _mm_mul_ps(world[2], Broadcast(b, 2)));
+				sum = _mm_add_ps(sum, _mm_mul_ps(world[3], Broadcast(b, 3)));
+				_mm_storeu_ps(out + col * 4, sum);
+			}
+		}
+	}
+}
+
+const POGL_MATH_KERNELS POGL_MATH_KERNELS_SSE2 = {
+	Mat4Multiply,
+	Mat4Transpose,
+	Mat4Inverse,
+	Vec3Length,
+	Vec3SqrdLength,
+	Vec3Normalize,
+	Vec3Cross,
+	Mat4MultiplyArray,
+	TransformAoS,
+	TransformSoA,
+	TransformAABBs,
+	CullSpheres,
+	CullAABBs,
+	SkinningPalette
+};
+
+#endif
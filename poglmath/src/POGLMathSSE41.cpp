@@ -0,0 +1,61 @@
+#include "POGLMathKernels.h"
+
+#if defined(POGLMATH_X86)
+#include <smmintrin.h>
+
+namespace {
+	inline __m128 LoadVec3(const float* v) {
+		return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)v), _mm_load_ss(v + 2));
+	}
+
+	inline void StoreVec3(float* v, __m128 value) {
+		_mm_storel_pi((__m64*)v, value);
+		_mm_store_ss(v + 2, _mm_movehl_ps(value, value));
+	}
+
+	//
+	// The dot product instruction doesn't specify the order in which the products are summed, so these results are
+	// allowed to differ from the scalar version by one ULP
+	//
+
+	float Vec3SqrdLength(const float* v)
+	{
+		const __m128 a = LoadVec3(v);
+		return _mm_cvtss_f32(_mm_dp_ps(a, a, 0x71));
+	}
+
+	float Vec3Length(const float* v)
+	{
+		const __m128 a = LoadVec3(v);
+		return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(a, a, 0x71)));
+	}
+
+	void Vec3Normalize(float* _in_out_Vec3)
+	{
+		const __m128 a = LoadVec3(_in_out_Vec3);
+		__m128 len = _mm_sqrt_ps(_mm_dp_ps(a, a, 0x7F));
+		if (_mm_cvtss_f32(len) == 0.0f)
+			len = _mm_set1_ps(1.0f);
+
+		StoreVec3(_in_out_Vec3, _mm_mul_ps(a, _mm_div_ps(_mm_set1_ps(1.0f), len)));
+	}
+}
+
+const POGL_MATH_KERNELS POGL_MATH_KERNELS_SSE41 = {
+	nullptr,
+	nullptr,
+	nullptr,
+	Vec3Length,
+	Vec3SqrdLength,
+	Vec3Normalize,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr
+};
+
+#endif
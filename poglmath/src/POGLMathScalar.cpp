@@ -0,0 +1,407 @@
+#include "POGLMathKernels.h"
+#include <cmath>
+
+/*
+	Parts of the mathematical algorithms used below has been influenced by Mesa3D (http://www.mesa3d.org)
+
+	MESA3D LICENSE:
+
+	Copyright (C) 1999-2007  Brian Paul   All Rights Reserved.
+
+	Permission is hereby granted, free of charge, to any person obtaining a
+	copy of this software and associated documentation files (the "Software"),
+	to deal in the Software without restriction, including without limitation
+	the rights to use, copy, modify, merge, publish, distribute, sublicense,
+	and/or sell copies of the Software, and to permit persons to whom the
+	Software is furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included
+	in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+	OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+	BRIAN PAUL BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+	AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MREF
+#define MREF(m, row, col) m[col * 4 + row]
+#endif
+
+namespace {
+	void Mat4Multiply(const float* a, const float* b, float* _out_Mat4)
+	{
+		float tmp_M[16];
+
+		tmp_M[0] = (a[0] * b[0] + a[4] * b[1] + a[8] * b[2] + a[12] * b[3]);
+		tmp_M[1] = (a[1] * b[0] + a[5] * b[1] + a[9] * b[2] + a[13] * b[3]);
+		tmp_M[2] = (a[2] * b[0] + a[6] * b[1] + a[10] * b[2] + a[14] * b[3]);
+		tmp_M[3] = (a[3] * b[0] + a[7] * b[1] + a[11] * b[2] + a[15] * b[3]);
+
+		tmp_M[4] = (a[0] * b[4] + a[4] * b[5] + a[8] * b[6] + a[12] * b[7]);
+		tmp_M[5] = (a[1] * b[4] + a[5] * b[5] + a[9] * b[6] + a[13] * b[7]);
+		tmp_M[6] = (a[2] * b[4] + a[6] * b[5] + a[10] * b[6] + a[14] * b[7]);
+		tmp_M[7] = (a[3] * b[4] + a[7] * b[5] + a[11] * b[6] + a[15] * b[7]);
+
+		tmp_M[8] = (a[0] * b[8] + a[4] * b[9] + a[8] * b[10] + a[12] * b[11]);
+		tmp_M[9] = (a[1] * b[8] + a[5] * b[9] + a[9] * b[10] + a[13] * b[11]);
+		tmp_M[10] = (a[2] * b[8] + a[6] * b[9] + a[10] * b[10] + a[14] * b[11]);
+		tmp_M[11] = (a[3] * b[8] + a[7] * b[9] + a[11] * b[10] + a[15] * b[11]);
+
+		tmp_M[12] = (a[0] * b[12] + a[4] * b[13] + a[8] * b[14] + a[12] * b[15]);
+		tmp_M[13] = (a[1] * b[12] + a[5] * b[13] + a[9] * b[14] + a[13] * b[15]);
+		tmp_M[14] = (a[2] * b[12] + a[6] * b[13] + a[10] * b[14] + a[14] * b[15]);
+		tmp_M[15] = (a[3] * b[12] + a[7] * b[13] + a[11] * b[14] + a[15] * b[15]);
+
+		for (int i = 0; i < 16; ++i)
+			_out_Mat4[i] = tmp_M[i];
+	}
+
+	void Mat4Transpose(const float* m, float* _out_Mat4)
+	{
+		// Copied first, so that a matrix can be transposed in place
+		float from[16];
+		for (int i = 0; i < 16; ++i)
+			from[i] = m[i];
+
+		float* to = _out_Mat4;
+		to[0] = from[0];
+		to[1] = from[4];
+		to[2] = from[8];
+		to[3] = from[12];
+		to[4] = from[1];
+		to[5] = from[5];
+		to[6] = from[9];
+		to[7] = from[13];
+		to[8] = from[2];
+		to[9] = from[6];
+		to[10] = from[10];
+		to[11] = from[14];
+		to[12] = from[3];
+		to[13] = from[7];
+		to[14] = from[11];
+		to[15] = from[15];
+	}
+
+	bool Mat4Inverse(const float* m, float* out)
+	{
+#define SWAP_ROWS(a, b) { float *_tmp = a; (a)=(b); (b)=_tmp; }
+		float wtmp[4][8];
+		float m0, m1, m2, m3, s;
+		float *r0, *r1, *r2, *r3;
+
+		r0 = wtmp[0], r1 = wtmp[1], r2 = wtmp[2], r3 = wtmp[3];
+
+		r0[0] = MREF(m, 0, 0), r0[1] = MREF(m, 0, 1),
+		r0[2] = MREF(m, 0, 2), r0[3] = MREF(m, 0, 3),
+		r0[4] = 1.0, r0[5] = r0[6] = r0[7] = 0.0,
+
+		r1[0] = MREF(m, 1, 0), r1[1] = MREF(m, 1, 1),
+		r1[2] = MREF(m, 1, 2), r1[3] = MREF(m, 1, 3),
+		r1[5] = 1.0, r1[4] = r1[6] = r1[7] = 0.0,
+
+		r2[0] = MREF(m, 2, 0), r2[1] = MREF(m, 2, 1),
+		r2[2] = MREF(m, 2, 2), r2[3] = MREF(m, 2, 3),
+		r2[6] = 1.0, r2[4] = r2[5] = r2[7] = 0.0,
+
+		r3[0] = MREF(m, 3, 0), r3[1] = MREF(m, 3, 1),
+		r3[2] = MREF(m, 3, 2), r3[3] = MREF(m, 3, 3),
+		r3[7] = 1.0, r3[4] = r3[5] = r3[6] = 0.0;
+
+		/* choose pivot - or die */
+		if (fabsf(r3[0])>fabsf(r2[0])) SWAP_ROWS(r3, r2);
+		if (fabsf(r2[0])>fabsf(r1[0])) SWAP_ROWS(r2, r1);
+		if (fabsf(r1[0])>fabsf(r0[0])) SWAP_ROWS(r1, r0);
+		if (0.0 == r0[0]) return false;
+
+		/* eliminate first variable     */
+		m1 = r1[0]/r0[0]; m2 = r2[0]/r0[0]; m3 = r3[0]/r0[0];
+		s = r0[1]; r1[1] -= m1 * s; r2[1] -= m2 * s; r3[1] -= m3 * s;
+		s = r0[2]; r1[2] -= m1 * s; r2[2] -= m2 * s; r3[2] -= m3 * s;
+		s = r0[3]; r1[3] -= m1 * s; r2[3] -= m2 * s; r3[3] -= m3 * s;
+		s = r0[4];
+		if (s != 0.0) { r1[4] -= m1 * s; r2[4] -= m2 * s; r3[4] -= m3 * s; }
+		s = r0[5];
+		if (s != 0.0) { r1[5] -= m1 * s; r2[5] -= m2 * s; r3[5] -= m3 * s; }
+		s = r0[6];
+		if (s != 0.0) { r1[6] -= m1 * s; r2[6] -= m2 * s; r3[6] -= m3 * s; }
+		s = r0[7];
+		if (s != 0.0) { r1[7] -= m1 * s; r2[7] -= m2 * s; r3[7] -= m3 * s; }
+
+		/* choose pivot - or die */
+		if (fabsf(r3[1])>fabsf(r2[1])) SWAP_ROWS(r3, r2);
+		if (fabsf(r2[1])>fabsf(r1[1])) SWAP_ROWS(r2, r1);
+		if (0.0 == r1[1]) return false;
+
+		/* eliminate second variable */
+		m2 = r2[1]/r1[1]; m3 = r3[1]/r1[1];
+		r2[2] -= m2 * r1[2]; r3[2] -= m3 * r1[2];
+		r2[3] -= m2 * r1[3]; r3[3] -= m3 * r1[3];
+		s = r1[4]; if (0.0 != s) { r2[4] -= m2 * s; r3[4] -= m3 * s; }
+		s = r1[5]; if (0.0 != s) { r2[5] -= m2 * s; r3[5] -= m3 * s; }
+		s = r1[6]; if (0.0 != s) { r2[6] -= m2 * s; r3[6] -= m3 * s; }
+		s = r1[7]; if (0.0 != s) { r2[7] -= m2 * s; r3[7] -= m3 * s; }
+
+		/* choose pivot - or die */
+		if (fabsf(r3[2])>fabsf(r2[2])) SWAP_ROWS(r3, r2);
+		if (0.0 == r2[2])  return false;
+
+		/* eliminate third variable */
+		m3 = r3[2]/r2[2];
+		r3[3] -= m3 * r2[3], r3[4] -= m3 * r2[4],
+		r3[5] -= m3 * r2[5], r3[6] -= m3 * r2[6],
+		r3[7] -= m3 * r2[7];
+
+		/* last check */
+		if (0.0 == r3[3]) return false;
+
+		s = 1.0F/r3[3];             /* now back substitute row 3 */
+		r3[4] *= s; r3[5] *= s; r3[6] *= s; r3[7] *= s;
+
+		m2 = r2[3];                 /* now back substitute row 2 */
+		s  = 1.0F/r2[2];
+		r2[4] = s * (r2[4] - r3[4] * m2), r2[5] = s * (r2[5] - r3[5] * m2),
+		r2[6] = s * (r2[6] - r3[6] * m2), r2[7] = s * (r2[7] - r3[7] * m2);
+		m1 = r1[3];
+		r1[4] -= r3[4] * m1, r1[5] -= r3[5] * m1,
+		r1[6] -= r3[6] * m1, r1[7] -= r3[7] * m1;
+		m0 = r0[3];
+		r0[4] -= r3[4] * m0, r0[5] -= r3[5] * m0,
+		r0[6] -= r3[6] * m0, r0[7] -= r3[7] * m0;
+
+		m1 = r1[2];                 /* now back substitute row 1 */
+		s  = 1.0F/r1[1];
+		r1[4] = s * (r1[4] - r2[4] * m1), r1[5] = s * (r1[5] - r2[5] * m1),
+		r1[6] = s * (r1[6] - r2[6] * m1), r1[7] = s * (r1[7] - r2[7] * m1);
+		m0 = r0[2];
+		r0[4] -= r2[4] * m0, r0[5] -= r2[5] * m0,
+		r0[6] -= r2[6] * m0, r0[7] -= r2[7] * m0;
+
+		m0 = r0[1];                 /* now back substitute row 0 */
+		s  = 1.0F/r0[0];
+		r0[4] = s * (r0[4] - r1[4] * m0), r0[5] = s * (r0[5] - r1[5] * m0),
+		r0[6] = s * (r0[6] - r1[6] * m0), r0[7] = s * (r0[7] - r1[7] * m0);
+
+		MREF(out, 0, 0) = r0[4]; MREF(out, 0, 1) = r0[5],
+		MREF(out, 0, 2) = r0[6]; MREF(out, 0, 3) = r0[7],
+		MREF(out, 1, 0) = r1[4]; MREF(out, 1, 1) = r1[5],
+		MREF(out, 1, 2) = r1[6]; MREF(out, 1, 3) = r1[7],
+		MREF(out, 2, 0) = r2[4]; MREF(out, 2, 1) = r2[5],
+		MREF(out, 2, 2) = r2[6]; MREF(out, 2, 3) = r2[7],
+		MREF(out, 3, 0) = r3[4]; MREF(out, 3, 1) = r3[5],
+		MREF(out, 3, 2) = r3[6]; MREF(out, 3, 3) = r3[7];
+
+#undef SWAP_ROWS
+		return true;
+	}
+
+	float Vec3SqrdLength(const float* v)
+	{
+		return v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	}
+
+	float Vec3Length(const float* v)
+	{
+		return sqrtf(Vec3SqrdLength(v));
+	}
+
+	void Vec3Normalize(float* _in_out_Vec3)
+	{
+		float len = Vec3Length(_in_out_Vec3);
+		len = (len != 0.0f ? len : 1.0f);
+
+		const float lengthMul = 1.0f / len;
+		_in_out_Vec3[0] *= lengthMul;
+		_in_out_Vec3[1] *= lengthMul;
+		_in_out_Vec3[2] *= lengthMul;
+	}
+
+	void Vec3Cross(const float* v1, const float* v2, float* _out_Vec3)
+	{
+		const float x = (v1[1] * v2[2] - v1[2] * v2[1]);
+		const float y = (v1[2] * v2[0] - v1[0] * v2[2]);
+		const float z = (v1[0] * v2[1] - v1[1] * v2[0]);
+		_out_Vec3[0] = x;
+		_out_Vec3[1] = y;
+		_out_Vec3[2] = z;
+	}
+
+	void Mat4MultiplyArray(const float* lhs, const float* rhs, unsigned int count, float* _out_Mat4s)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			Mat4Multiply(lhs, rhs + i * 16, _out_Mat4s + i * 16);
+	}
+
+	void TransformAoS(const float* m, const float* vec3s, unsigned int count, float w, float* _out_Vec3s)
+	{
+		for (unsigned int i = 0; i < count; ++i) {
+			const float x = vec3s[i * 3];
+			const float y = vec3s[i * 3 + 1];
+			const float z = vec3s[i * 3 + 2];
+			_out_Vec3s[i * 3] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+			_out_Vec3s[i * 3 + 1] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+			_out_Vec3s[i * 3 + 2] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+		}
+	}
+
+	void TransformSoA(const float* m, const float* xs, const float* ys, const float* zs, unsigned int count, float w,
+		float* _out_Xs, float* _out_Ys, float* _out_Zs)
+	{
+		for (unsigned int i = 0; i < count; ++i) {
+			const float x = xs[i];
+			const float y = ys[i];
+			const float z = zs[i];
+			_out_Xs[i] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+			_out_Ys[i] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+			_out_Zs[i] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+		}
+	}
+
+	void TransformAABBs(const float* m, const float* aabbs, unsigned int count, float* _out_AABBs)
+	{
+		// The center is transformed and the extents are projected onto the transformed axes, as described by Jim Arvo
+		// in "Transforming Axis-Aligned Bounding Boxes" (Graphics Gems, 1990)
+		for (unsigned int i = 0; i < count; ++i) {
+			const float* aabb = aabbs + i * 6;
+			float center[3], extents[3];
+			for (int axis = 0; axis < 3; ++axis) {
+				center[axis] = (aabb[axis] + aabb[axis + 3]) * 0.5f;
+				extents[axis] = (aabb[axis + 3] - aabb[axis]) * 0.5f;
+			}
+
+			float* out = _out_AABBs + i * 6;
+			for (int row = 0; row < 3; ++row) {
+				const float c = m[row] * center[0] + m[row + 4] * center[1] + m[row + 8] * center[2] + m[row + 12];
+				const float e = fabsf(m[row]) * extents[0] + fabsf(m[row + 4]) * extents[1] + fabsf(m[row + 8]) * extents[2];
+				out[row] = c - e;
+				out[row + 3] = c + e;
+			}
+		}
+	}
+
+	void CullSpheres(const float* planes, const float* spheres, unsigned int count, unsigned int* _out_Mask)
+	{
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			const float* sphere = spheres + i * 4;
+			bool visible = true;
+			for (int p = 0; p < 6; ++p) {
+				const float* plane = planes + p * 4;
+				const float distance = plane[0] * sphere[0] + plane[1] * sphere[1] + plane[2] * sphere[2] + plane[3];
+				if (distance < -sphere[3])
+					visible = false;
+			}
+
+			if (visible)
+				word |= 1U << (i & 31);
+			if ((i & 31) == 31 || i == count - 1) {
+				_out_Mask[i >> 5] = word;
+				word = 0;
+			}
+		}
+	}
+
+	void CullAABBs(const float* planes, const float* aabbs, unsigned int count, unsigned int* _out_Mask)
+	{
+		unsigned int word = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			const float* aabb = aabbs + i * 6;
+			float center[3], extents[3];
+			for (int axis = 0; axis < 3; ++axis) {
+				center[axis] = (aabb[axis] + aabb[axis + 3]) * 0.5f;
+				extents[axis] = (aabb[axis + 3] - aabb[axis]) * 0.5f;
+			}
+
+			// The box is outside if the corner furthest along the plane normal is behind the plane
+			bool visible = true;
+			for (int p = 0; p < 6; ++p) {
+				const float* plane = planes + p * 4;
+				const float distance = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+				const float radius = fabsf(plane[0]) * extents[0] + fabsf(plane[1]) * extents[1] + fabsf(plane[2]) * extents[2];
+				if (distance < -radius)
+					visible = false;
+			}
+
+			if (visible)
+				word |= 1U << (i & 31);
+			if ((i & 31) == 31 || i == count - 1) {
+				_out_Mask[i >> 5] = word;
+				word = 0;
+			}
+		}
+	}
+
+	/*!
+		\brief Calculate the matrix translation * rotation * scale for the supplied pose
+	*/
+	void Compose(const float* pose, float* _out_Mat4)
+	{
+		const float* t = pose;
+		const float* q = pose + 3;
+		const float* s = pose + 7;
+
+		const float x2 = q[0] + q[0], y2 = q[1] + q[1], z2 = q[2] + q[2];
+		const float xx = q[0] * x2, yy = q[1] * y2, zz = q[2] * z2;
+		const float xy = q[0] * y2, xz = q[0] * z2, yz = q[1] * z2;
+		const float wx = q[3] * x2, wy = q[3] * y2, wz = q[3] * z2;
+
+		float* m = _out_Mat4;
+		m[0] = (1.0f - (yy + zz)) * s[0];
+		m[1] = (xy + wz) * s[0];
+		m[2] = (xz - wy) * s[0];
+		m[3] = 0.0f;
+
+		m[4] = (xy - wz) * s[1];
+		m[5] = (1.0f - (xx + zz)) * s[1];
+		m[6] = (yz + wx) * s[1];
+		m[7] = 0.0f;
+
+		m[8] = (xz + wy) * s[2];
+		m[9] = (yz - wx) * s[2];
+		m[10] = (1.0f - (xx + yy)) * s[2];
+		m[11] = 0.0f;
+
+		m[12] = t[0];
+		m[13] = t[1];
+		m[14] = t[2];
+		m[15] = 1.0f;
+	}
+
+	void SkinningPalette(const float* poses, const int* parents, const float* inverseBindPoses, unsigned int count,
+		float* _out_Worlds, float* _out_Palette)
+	{
+		for (unsigned int i = 0; i < count; ++i) {
+			float* world = _out_Worlds + i * 16;
+			const int parent = parents[i];
+			if (parent < 0)
+				Compose(poses + i * 10, world);
+			else {
+				float local[16];
+				Compose(poses + i * 10, local);
+				Mat4Multiply(_out_Worlds + parent * 16, local, world);
+			}
+
+			if (inverseBindPoses != nullptr)
+				Mat4Multiply(world, inverseBindPoses + i * 16, _out_Palette + i * 16);
+		}
+	}
+}
+
+const POGL_MATH_KERNELS POGL_MATH_KERNELS_SCALAR = {
+	Mat4Multiply,
+	Mat4Transpose,
+	Mat4Inverse,
+	Vec3Length,
+	Vec3SqrdLength,
+	Vec3Normalize,
+	Vec3Cross,
+	Mat4MultiplyArray,
+	TransformAoS,
+	TransformSoA,
+	TransformAABBs,
+	CullSpheres,
+	CullAABBs,
+	SkinningPalette
+};
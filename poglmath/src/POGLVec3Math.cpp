@@ -1,54 +1,41 @@
 #include "config.h"
+#include "POGLMathKernels.h"
 
 POGL_FLOAT POGLVec3Length(const POGL_VECTOR3& v)
 {
-	return sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+	return POGLMathGetKernels()->Vec3Length(v.vec);
 }
 
 POGL_FLOAT POGLVec3SqrdLength(const POGL_VECTOR3& v)
 {
-	return v.x * v.x + v.y * v.y + v.z * v.z;
+	return POGLMathGetKernels()->Vec3SqrdLength(v.vec);
 }
 
 void POGLVec3Normalize(POGL_VECTOR3* _in_out_Vec3)
 {
-	POGL_FLOAT len = POGLVec3Length(*_in_out_Vec3);
-	len = (len != 0.0f ? len : 1.0f);
-
-	POGL_FLOAT lengthMul = 1.0f / len;
-	_in_out_Vec3->x *= lengthMul;
-	_in_out_Vec3->y *= lengthMul;
-	_in_out_Vec3->z *= lengthMul;
+	POGLMathGetKernels()->Vec3Normalize(_in_out_Vec3->vec);
 }
 
 void POGLVec3Cross(const POGL_VECTOR3& v1, const POGL_VECTOR3& v2, POGL_VECTOR3* _out_Vec3)
 {
-	_out_Vec3->x = (v1.y * v2.z - v1.z * v2.y);
-	_out_Vec3->y = (v1.z * v2.x - v1.x * v2.z);
-	_out_Vec3->z = (v1.x * v2.y - v1.y * v2.x);
+	POGLMathGetKernels()->Vec3Cross(v1.vec, v2.vec, _out_Vec3->vec);
 }
 
 POGL_VECTOR3 POGLVec3Cross(const POGL_VECTOR3& v1, const POGL_VECTOR3& v2)
 {
-	return POGL_VECTOR3(
-		v1.y * v2.z - v1.z * v2.y,
-		v1.z * v2.x - v1.x * v2.z,
-		v1.x * v2.y - v1.y * v2.x
-		);
+	POGL_VECTOR3 out;
+	POGLVec3Cross(v1, v2, &out);
+	return out;
 }
 
 void POGLVec3Invert(const POGL_VECTOR3& v, POGL_VECTOR3* _out_Vec3)
 {
-	_out_Vec3->x = v.x * -1.f;
-	_out_Vec3->y = v.y * -1.f;
-	_out_Vec3->z = v.z * -1.f;
+	*_out_Vec3 = -POGL_VEC3F(v);
 }
 
 void POGLVec3Invert(POGL_VECTOR3* _in_out_Vec3)
 {
-	_in_out_Vec3->x *= -1.f;
-	_in_out_Vec3->y *= -1.f;
-	_in_out_Vec3->z *= -1.f;
+	*_in_out_Vec3 = -POGL_VEC3F(*_in_out_Vec3);
 }
 
 void POGLVec3Perp(const POGL_VECTOR3& v, POGL_VECTOR3* _out_Vec3)
@@ -85,10 +72,7 @@ POGL_FLOAT POGLVec3AngleInDegree(const POGL_VECTOR3& v1, const POGL_VECTOR3& v2)
 
 POGL_FLOAT POGLVec3AngleInRadians(const POGL_VECTOR3& v1, const POGL_VECTOR3& v2)
 {
-	const POGL_FLOAT x = v1.x;
-	const POGL_FLOAT y = v1.y;
-	const POGL_FLOAT z = v1.z;
-	return acosf((v2.x * x) + (v2.y * y) + (v2.z * z));
+	return acosf(POGLDot(v1, v2));
 }
 
 POGL_VECTOR3 POGL_VECTOR3X::GetNormalized() const
@@ -151,10 +135,10 @@ POGL_FLOAT POGL_VECTOR3X::GetAngleRadians(const POGL_VECTOR3& v) const
 
 POGL_VECTOR3X POGL_VECTOR3X::operator + (const POGL_VECTOR3X& rhs) const
 {
-	return POGL_VECTOR3X(x + rhs.x, y + rhs.y, z + rhs.z);
+	return POGL_VECTOR3X(POGL_VEC3F(*this) + POGL_VEC3F(rhs));
 }
 
 POGL_VECTOR3X POGL_VECTOR3X::operator * (const POGL_FLOAT rhs) const
 {
-	return POGL_VECTOR3X(x * rhs, y * rhs, z * rhs);
+	return POGL_VECTOR3X(POGL_VEC3F(*this) * rhs);
 }